@@ -262,11 +262,12 @@ def envoy_cc_test_binary(
         deps = [],
         stamp = 0,
         linkstatic = True,
+        linkopts = [],
         **kargs):
     envoy_cc_binary(
         name,
         testonly = 1,
-        linkopts = _envoy_test_linkopts(),
+        linkopts = _envoy_test_linkopts() + linkopts,
         tags = tags + ["compilation_db_dep"],
         deps = deps + [
             "@envoy//test/test_common:test_version_linkstamp",
@@ -359,7 +359,7 @@ void DlbConnectionBalancerImpl::unregisterHandler(
 }
 
 Envoy::Network::BalancedConnectionHandler& DlbConnectionBalancerImpl::pickTargetHandler(
-    Envoy::Network::BalancedConnectionHandler& current_handler) {
+    Envoy::Network::BalancedConnectionHandler& current_handler, Envoy::Network::ConnectionSocket&) {
   auto listener = dynamic_cast<Envoy::Server::ActiveTcpListener*>(&current_handler);
   auto worker_name = listener->dispatcher().name();
   const int index =
@@ -185,7 +185,8 @@ public:
 
   // Return DlbBalancedConnectionHandlerImpl to handle Dlb send/recv.
   Envoy::Network::BalancedConnectionHandler&
-  pickTargetHandler(Envoy::Network::BalancedConnectionHandler& current_handler) override;
+  pickTargetHandler(Envoy::Network::BalancedConnectionHandler& current_handler,
+                    Envoy::Network::ConnectionSocket& socket) override;
 };
 
 } // namespace Dlb
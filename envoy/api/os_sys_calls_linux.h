@@ -25,6 +25,24 @@ public:
    * @see sched_getaffinity (man 2 sched_getaffinity)
    */
   virtual SysCallIntResult sched_getaffinity(pid_t pid, size_t cpusetsize, cpu_set_t* mask) PURE;
+
+  /**
+   * @see sched_setaffinity (man 2 sched_setaffinity)
+   */
+  virtual SysCallIntResult sched_setaffinity(pid_t pid, size_t cpusetsize,
+                                             const cpu_set_t* mask) PURE;
+
+  /**
+   * @see man 2 pipe2
+   */
+  virtual SysCallIntResult pipe2(os_fd_t pipefd[2], int flags) PURE;
+
+  /**
+   * @see man 2 splice. Offsets are not supported, so both ends are read from and written to at
+   * their current position.
+   */
+  virtual SysCallSizeResult splice(os_fd_t fd_in, os_fd_t fd_out, size_t len,
+                                   unsigned int flags) PURE;
 };
 
 using LinuxOsSysCallsPtr = std::unique_ptr<LinuxOsSysCalls>;
@@ -42,9 +42,23 @@ public:
    */
   IoUringSocket& socket() const { return socket_; }
 
+  /**
+   * Returns the flags of the completion being handled, e.g. whether the data was received into a
+   * provided buffer and whether a multishot request remains armed. Only valid while the request's
+   * completion is being handled, and always 0 for injected completions.
+   */
+  uint32_t completionFlags() const { return completion_flags_; }
+
+  /**
+   * Set the flags of the completion being handled. Called by the IoUring before the completion
+   * callback.
+   */
+  void setCompletionFlags(uint32_t flags) { completion_flags_ = flags; }
+
 private:
   RequestType type_;
   IoUringSocket& socket_;
+  uint32_t completion_flags_{};
 };
 
 /**
@@ -101,6 +115,15 @@ public:
   virtual IoUringResult prepareAccept(os_fd_t fd, struct sockaddr* remote_addr,
                                       socklen_t* remote_addr_len, Request* user_data) PURE;
 
+  /**
+   * Prepares a multishot accept on a listening socket and puts it into the submission queue. The
+   * request completes once per accepted connection, with IORING_CQE_F_MORE set in the completion
+   * flags until the request terminates. The accepted sockets are non-blocking.
+   * Returns IoUringResult::Failed in case the submission queue is full already
+   * and IoUringResult::Ok otherwise.
+   */
+  virtual IoUringResult prepareAcceptMultishot(os_fd_t fd, Request* user_data) PURE;
+
   /**
    * Prepares a connect system call and puts it into the submission queue.
    * Returns IoUringResult::Failed in case the submission queue is full already
@@ -110,6 +133,38 @@ public:
                                        const Network::Address::InstanceConstSharedPtr& address,
                                        Request* user_data) PURE;
 
+  /**
+   * Registers a ring of provided buffers for a buffer group. Receive requests for the group pick
+   * their buffer from the ring, and report the chosen buffer in the completion flags.
+   * Returns IoUringResult::Failed if the kernel does not support provided buffer rings.
+   * @param group_id the buffer group.
+   * @param num_buffers the capacity of the ring. Must be a power of 2, at most 32768.
+   */
+  virtual IoUringResult registerBufferRing(uint16_t group_id, uint32_t num_buffers) PURE;
+
+  /**
+   * Unregisters the ring of a buffer group. Buffers in the ring are not touched by the kernel
+   * anymore, and are still owned by the caller.
+   */
+  virtual void unregisterBufferRing(uint16_t group_id) PURE;
+
+  /**
+   * Hands a buffer to the ring of a buffer group. The buffer must stay valid until it is reported
+   * by a completion or the ring is unregistered.
+   */
+  virtual void provideBuffer(uint16_t group_id, uint16_t buffer_id, uint8_t* buf,
+                             uint32_t len) PURE;
+
+  /**
+   * Prepares a multishot recv which receives into buffers of the given group, and puts it into the
+   * submission queue. The request completes once per received buffer, with IORING_CQE_F_MORE set
+   * in the completion flags until the request terminates.
+   * Returns IoUringResult::Failed in case the submission queue is full already
+   * and IoUringResult::Ok otherwise.
+   */
+  virtual IoUringResult prepareRecvMultishot(os_fd_t fd, uint16_t group_id,
+                                             Request* user_data) PURE;
+
   /**
    * Prepares a readv system call and puts it into the submission queue.
    * Returns IoUringResult::Failed in case the submission queue is full already
@@ -264,6 +319,13 @@ public:
    */
   virtual void connect(const Network::Address::InstanceConstSharedPtr& address) PURE;
 
+  /**
+   * Take a connection accepted by a listening socket. This is used when the socket delivers a file
+   * read event.
+   * @return the fd of the accepted connection, or INVALID_SOCKET if there is none.
+   */
+  virtual os_fd_t takeAcceptedSocket() PURE;
+
   /**
    * Write data to the socket.
    * @param data is going to write.
@@ -405,11 +467,24 @@ public:
   virtual IoUringSocket& addClientSocket(os_fd_t fd, Event::FileReadyCb cb,
                                          bool enable_close_event) PURE;
 
+  /**
+   * Add a listening socket to the worker. The socket accepts connections through io_uring and
+   * delivers a file read event when there are accepted connections.
+   */
+  virtual IoUringSocket& addAcceptSocket(os_fd_t fd, Event::FileReadyCb cb,
+                                         bool enable_close_event) PURE;
+
   /**
    * Return the current thread's dispatcher.
    */
   virtual Event::Dispatcher& dispatcher() PURE;
 
+  /**
+   * Submit an accept request for a listening socket.
+   * @param multishot whether the request keeps accepting connections until it is canceled.
+   */
+  virtual Request* submitAcceptRequest(IoUringSocket& socket, bool multishot) PURE;
+
   /**
    * Submit a connect request for a socket.
    */
@@ -471,6 +546,11 @@ public:
    * Indicates whether the current thread has been registered for a IoUringWorker.
    */
   virtual bool currentThreadRegistered() PURE;
+
+  /**
+   * Indicates whether listeners should accept connections with io_uring accept operations.
+   */
+  virtual bool acceptEnabled() const PURE;
 };
 
 } // namespace Io
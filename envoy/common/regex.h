@@ -1,6 +1,8 @@
 #pragma once
 
 #include <memory>
+#include <string>
+#include <vector>
 
 #include "envoy/common/matchers.h"
 #include "envoy/config/typed_config.h"
@@ -34,6 +36,32 @@ public:
 
 using CompiledMatcherPtr = std::unique_ptr<const CompiledMatcher>;
 
+/**
+ * A set of regex expressions compiled into a single matcher, which finds all expressions that
+ * match a value in one pass.
+ */
+class CompiledSetMatcher {
+public:
+  virtual ~CompiledSetMatcher() = default;
+
+  /**
+   * Finds the expressions which match all of value, like CompiledMatcher::match() does.
+   * @param value supplies the value to match.
+   * @param matches receives the positions of the matching expressions in the set, in increasing
+   *        order.
+   * @return false if the engine could not complete the match, for example because it ran out of
+   *         memory. The caller then needs to match the expressions one by one.
+   */
+  virtual bool match(absl::string_view value, std::vector<int>& matches) const PURE;
+
+  /**
+   * @return the number of expressions in the set.
+   */
+  virtual size_t size() const PURE;
+};
+
+using CompiledSetMatcherPtr = std::unique_ptr<const CompiledSetMatcher>;
+
 /**
  * A regular expression engine which turns regular expressions into compiled matchers.
  */
@@ -46,6 +74,17 @@ public:
    * @param regex the regex expression match string
    */
   virtual absl::StatusOr<CompiledMatcherPtr> matcher(const std::string& regex) const PURE;
+
+  /**
+   * Create a @ref CompiledSetMatcher with the given regex expressions. Engines which cannot match
+   * several expressions at once return an Unimplemented error, which callers handle by matching
+   * the expressions one by one.
+   * @param regexes the regex expression match strings, in the order of their positions in the set.
+   */
+  virtual absl::StatusOr<CompiledSetMatcherPtr>
+  setMatcher(const std::vector<std::string>& /*regexes*/) const {
+    return absl::UnimplementedError("regex engine does not support expression sets");
+  }
 };
 
 using EnginePtr = std::shared_ptr<Engine>;
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <chrono>
 #include <cstdint>
 #include <functional>
 #include <memory>
@@ -40,7 +41,14 @@ namespace Event {
  */
 #define ALL_DISPATCHER_STATS(HISTOGRAM)                                                            \
   HISTOGRAM(loop_duration_us, Microseconds)                                                        \
-  HISTOGRAM(poll_delay_us, Microseconds)
+  HISTOGRAM(poll_delay_us, Microseconds)                                                           \
+  HISTOGRAM(post_queue_depth, Unspecified)                                                         \
+  HISTOGRAM(post_delay_us, Microseconds)                                                           \
+  HISTOGRAM(events_per_loop, Unspecified)                                                          \
+  HISTOGRAM(file_event_us, Microseconds)                                                           \
+  HISTOGRAM(timer_us, Microseconds)                                                                \
+  HISTOGRAM(post_callback_us, Microseconds)                                                        \
+  HISTOGRAM(deferred_delete_us, Microseconds)
 
 /**
  * Struct definition for all dispatcher stats. @see stats_macros.h
@@ -51,6 +59,16 @@ struct DispatcherStats {
 
 using DispatcherStatsPtr = std::unique_ptr<DispatcherStats>;
 
+/**
+ * Adaptive busy polling parameters, @see Dispatcher::enableBusyPoll().
+ */
+struct BusyPollConfig {
+  // How long the event loop keeps polling without blocking after it handled I/O events.
+  std::chrono::microseconds spin_duration_;
+  // The largest fraction of each second the event loop may spend in spins which find no events.
+  double max_idle_spin_fraction_;
+};
+
 /**
  * Callback invoked when a dispatcher post() runs.
  */
@@ -187,6 +205,17 @@ public:
   virtual void initializeStats(Stats::Scope& scope,
                                const absl::optional<std::string>& prefix = absl::nullopt) PURE;
 
+  /**
+   * Makes the event loop keep polling without blocking for a while after it handled I/O events,
+   * instead of sleeping until the next event arrives. This saves the wakeup latency of the events
+   * which arrive in that window at the cost of CPU. Like initializeStats(), this takes effect once
+   * the dispatcher runs.
+   * @param config the busy polling parameters.
+   * @param scope the scope to contain the busy polling stats, which are identified like the stats
+   *              of initializeStats() without a prefix.
+   */
+  virtual void enableBusyPoll(const BusyPollConfig& config, Stats::Scope& scope) PURE;
+
   /**
    * Clears any items in the deferred deletion queue.
    */
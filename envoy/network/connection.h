@@ -417,6 +417,14 @@ public:
    * return value is cwnd(in packets) times the connection's MSS.
    */
   virtual absl::optional<uint64_t> congestionWindowInBytes() const PURE;
+
+  /**
+   * @return true if the connection's transport socket passes bytes through unchanged (i.e. the
+   * raw_buffer transport socket), the connection has no write filter and at most one read filter,
+   * and neither the read nor the write buffer holds any data, so that the underlying socket may be
+   * read and written directly without losing, reordering or hiding bytes from another filter.
+   */
+  virtual bool canBypassBuffers() const { return false; }
 };
 
 using ConnectionPtr = std::unique_ptr<Connection>;
@@ -66,14 +66,15 @@ public:
   /**
    * Pick a target handler to send a connection to.
    * @param current_handler supplies the currently executing connection handler.
+   * @param socket supplies the accepted socket which is being balanced.
    * @return current_handler if the connection should stay bound to the current handler, or a
    *         different handler if the connection should be rebalanced.
    *
    * NOTE: It is the responsibility of the balancer to call incNumConnections() on the returned
    *       balancer. See the comments above for more explanation.
    */
-  virtual BalancedConnectionHandler&
-  pickTargetHandler(BalancedConnectionHandler& current_handler) PURE;
+  virtual BalancedConnectionHandler& pickTargetHandler(BalancedConnectionHandler& current_handler,
+                                                       ConnectionSocket& socket) PURE;
 };
 
 using ConnectionBalancerSharedPtr = std::shared_ptr<ConnectionBalancer>;
@@ -94,6 +94,12 @@ public:
    * @return uint32_t a multiple of the flush interval to perform stats eviction, or 0 if disabled.
    */
   virtual uint32_t evictOnFlush() const PURE;
+
+  /**
+   * @return uint32_t a multiple of the flush interval to flush all stats, with only the changed
+   *         stats being flushed in between, or 0 if every flush includes all stats.
+   */
+  virtual uint32_t fullFlushOnFlush() const PURE;
 };
 
 /**
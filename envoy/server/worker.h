@@ -57,6 +57,14 @@ public:
    */
   virtual void initializeStats(Stats::Scope& scope) PURE;
 
+  /**
+   * Enable adaptive busy polling of this worker's dispatcher. @see
+   * Event::Dispatcher::enableBusyPoll().
+   * @param config the busy polling parameters.
+   * @param scope the scope to contain the per-dispatcher busy polling stats.
+   */
+  virtual void enableBusyPoll(const Event::BusyPollConfig& config, Stats::Scope& scope) PURE;
+
   /**
    * Stop the worker thread.
    */
@@ -94,11 +94,39 @@ public:
   virtual void forEachSinkedGauge(SizeFn f_size, StatFn<Gauge> f_stat) const PURE;
   virtual void forEachSinkedTextReadout(SizeFn f_size, StatFn<TextReadout> f_stat) const PURE;
 
+  /**
+   * Start recording which counters, gauges and text readouts change, so that
+   * forEachChangedSinkedStat() can visit them without iterating over all stats. Changes made
+   * before this is called are not recorded. Calling it again has no effect.
+   */
+  virtual void trackChanges() PURE;
+
+  /**
+   * Iterate over the stats that need to be flushed to sinks and that changed since the previous
+   * call, and forget that they changed. Counters change when they are incremented, gauges when
+   * they are updated and text readouts when they are set. New gauges and text readouts are
+   * considered changed. The same locking caveats as forEachSinkedCounter() apply.
+   * @param f_counter functor that is provided one changed counter at a time.
+   * @param f_gauge functor that is provided one changed gauge at a time.
+   * @param f_text_readout functor that is provided one changed text readout at a time.
+   */
+  virtual void forEachChangedSinkedStat(StatFn<Counter> f_counter, StatFn<Gauge> f_gauge,
+                                        StatFn<TextReadout> f_text_readout) PURE;
+
   /**
    * Set the predicates to filter stats for sink.
    */
   virtual void setSinkPredicates(std::unique_ptr<SinkPredicates>&& sink_predicates) PURE;
 
+  /**
+   * Enable sharding of counters created after this call. A sharded counter which is incremented
+   * from more than one thread spreads its increments over per-thread slots on separate cache
+   * lines, which are summed when the counter is read or latched.
+   * @param num_shards the number of slots per contended counter, which must be a power of 2, or
+   *        0 to create regular counters.
+   */
+  virtual void setCounterShards(uint32_t num_shards) PURE;
+
   // TODO(jmarantz): create a parallel mechanism to instantiate histograms. At
   // the moment, histograms don't fit the same pattern of counters and gauges
   // as they are not actually created in the context of a stats allocator.
@@ -31,6 +31,12 @@ public:
    * @return An optional override for the number of bins.
    */
   virtual absl::optional<uint32_t> bins(absl::string_view stat_name) const PURE;
+
+  /**
+   * @return whether thread local instances of the histogram only count values per bucket, as
+   *         returned by buckets(), rather than recording each value precisely.
+   */
+  virtual bool bucketedRecording(absl::string_view stat_name) const PURE;
 };
 
 using HistogramSettingsConstPtr = std::unique_ptr<const HistogramSettings>;
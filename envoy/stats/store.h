@@ -145,6 +145,21 @@ public:
   virtual void forEachSinkedTextReadout(SizeFn f_size, StatFn<TextReadout> f_stat) const PURE;
   virtual void forEachSinkedHistogram(SizeFn f_size, StatFn<ParentHistogram> f_stat) const PURE;
 
+  /**
+   * Start recording which stats change, so that they can be flushed incrementally. @see
+   * Allocator::trackChanges().
+   */
+  virtual void trackChanges() PURE;
+
+  /**
+   * Iterate over the counters, gauges and text readouts that need to be flushed to sinks and that
+   * changed since the previous call, and forget that they changed. This is used to flush stats
+   * incrementally. Stores which do not track changes visit all stats. @see
+   * Allocator::forEachChangedSinkedStat().
+   */
+  virtual void forEachChangedSinkedStat(StatFn<Counter> f_counter, StatFn<Gauge> f_gauge,
+                                        StatFn<TextReadout> f_text_readout) PURE;
+
   /**
    * Calls 'fn' for every stat. Note that in the case of overlapping scopes, the
    * implementation may call fn more than one time for each counter. Iteration
@@ -275,6 +290,12 @@ public:
   virtual void setSinkPredicates(std::unique_ptr<SinkPredicates>&& sink_predicates) PURE;
 
   virtual OptRef<SinkPredicates> sinkPredicates() PURE;
+
+  /**
+   * Enable sharding of counters created after this call. See Allocator::setCounterShards().
+   * @param num_shards the number of slots per contended counter, or 0 to disable sharding.
+   */
+  virtual void setCounterShards(uint32_t num_shards) PURE;
 };
 
 using StoreRootPtr = std::unique_ptr<StoreRoot>;
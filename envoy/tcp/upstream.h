@@ -181,6 +181,12 @@ public:
    * @return the failure reason of the local close.
    */
   virtual absl::string_view localCloseReason() const { return ""; }
+
+  /**
+   * @return the upstream connection if data is written to it without any framing, or nullptr if
+   * the upstream is not a plain TCP connection (e.g. when tunneling over HTTP).
+   */
+  virtual Network::Connection* rawConnection() { return nullptr; }
 };
 
 using GenericConnPoolPtr = std::unique_ptr<GenericConnPool>;
@@ -96,6 +96,20 @@ SysCallIntResult OsSysCallsImpl::recvmmsg(os_fd_t sockfd, struct mmsghdr* msgvec
 #endif
 }
 
+SysCallIntResult OsSysCallsImpl::sendmmsg(os_fd_t sockfd, struct mmsghdr* msgvec, unsigned int vlen,
+                                          int flags) {
+#if ENVOY_MMSG_MORE
+  const int rc = ::sendmmsg(sockfd, msgvec, vlen, flags);
+  return {rc, rc != -1 ? 0 : errno};
+#else
+  UNREFERENCED_PARAMETER(sockfd);
+  UNREFERENCED_PARAMETER(msgvec);
+  UNREFERENCED_PARAMETER(vlen);
+  UNREFERENCED_PARAMETER(flags);
+  return {-1, EOPNOTSUPP};
+#endif
+}
+
 bool OsSysCallsImpl::supportsMmsg() const {
 #if ENVOY_MMSG_MORE
   return true;
@@ -4,7 +4,9 @@
 
 #include "source/common/api/os_sys_calls_impl_linux.h"
 
+#include <fcntl.h>
 #include <sched.h>
+#include <unistd.h>
 
 #include <cerrno>
 
@@ -17,10 +19,27 @@ SysCallIntResult LinuxOsSysCallsImpl::sched_getaffinity(pid_t pid, size_t cpuset
   return {rc, errno};
 }
 
+SysCallIntResult LinuxOsSysCallsImpl::sched_setaffinity(pid_t pid, size_t cpusetsize,
+                                                        const cpu_set_t* mask) {
+  const int rc = ::sched_setaffinity(pid, cpusetsize, mask);
+  return {rc, errno};
+}
+
 SysCallIntResult LinuxOsSysCallsImpl::setns(int fd, int nstype) const {
   const int rc = ::setns(fd, nstype);
   return {rc, errno};
 }
 
+SysCallIntResult LinuxOsSysCallsImpl::pipe2(os_fd_t pipefd[2], int flags) {
+  const int rc = ::pipe2(pipefd, flags);
+  return {rc, rc != -1 ? 0 : errno};
+}
+
+SysCallSizeResult LinuxOsSysCallsImpl::splice(os_fd_t fd_in, os_fd_t fd_out, size_t len,
+                                              unsigned int flags) {
+  const ssize_t rc = ::splice(fd_in, nullptr, fd_out, nullptr, len, flags);
+  return {rc, rc != -1 ? 0 : errno};
+}
+
 } // namespace Api
 } // namespace Envoy
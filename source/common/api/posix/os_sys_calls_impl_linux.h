@@ -15,7 +15,10 @@ class LinuxOsSysCallsImpl : public LinuxOsSysCalls {
 public:
   // Api::LinuxOsSysCalls
   SysCallIntResult sched_getaffinity(pid_t pid, size_t cpusetsize, cpu_set_t* mask) override;
+  SysCallIntResult sched_setaffinity(pid_t pid, size_t cpusetsize, const cpu_set_t* mask) override;
   SysCallIntResult setns(int fd, int nstype) const override;
+  SysCallIntResult pipe2(os_fd_t pipefd[2], int flags) override;
+  SysCallSizeResult splice(os_fd_t fd_in, os_fd_t fd_out, size_t len, unsigned int flags) override;
 };
 
 using LinuxOsSysCallsSingleton = ThreadSafeSingleton<LinuxOsSysCallsImpl>;
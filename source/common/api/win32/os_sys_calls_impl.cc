@@ -197,6 +197,11 @@ SysCallIntResult OsSysCallsImpl::recvmmsg(os_fd_t sockfd, struct mmsghdr* msgvec
   PANIC("not implemented");
 }
 
+SysCallIntResult OsSysCallsImpl::sendmmsg(os_fd_t sockfd, struct mmsghdr* msgvec, unsigned int vlen,
+                                          int flags) {
+  PANIC("not implemented");
+}
+
 bool OsSysCallsImpl::supportsMmsg() const {
   // Windows doesn't support it.
   return false;
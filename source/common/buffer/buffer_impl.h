@@ -9,6 +9,7 @@
 #include "envoy/buffer/buffer.h"
 #include "envoy/http/stream_reset_handler.h"
 
+#include "source/common/buffer/slice_storage_pool.h"
 #include "source/common/common/assert.h"
 #include "source/common/common/non_copyable.h"
 #include "source/common/common/utility.h"
@@ -37,7 +38,7 @@ namespace Buffer {
 class Slice {
 public:
   using Reservation = RawSlice;
-  using StoragePtr = std::unique_ptr<uint8_t[]>;
+  using StoragePtr = SliceStoragePool::StoragePtr;
 
   struct SizedStorage {
     StoragePtr mem_{};
@@ -57,7 +58,7 @@ public:
    * @param account the account to charge.
    */
   Slice(uint64_t min_capacity, const BufferMemoryAccountSharedPtr& account)
-      : capacity_(sliceSize(min_capacity)), storage_(new uint8_t[capacity_]),
+      : capacity_(sliceSize(min_capacity)), storage_(SliceStoragePool::allocate(capacity_)),
         base_(storage_.get()) {
     if (account) {
       account->charge(capacity_);
@@ -114,6 +115,7 @@ public:
   Slice& operator=(Slice&& rhs) noexcept {
     if (this != &rhs) {
       callAndClearDrainTrackersAndCharges();
+      releaseStorage();
 
       capacity_ = rhs.capacity_;
       storage_ = std::move(rhs.storage_);
@@ -139,6 +141,7 @@ public:
 
   ~Slice() {
     callAndClearDrainTrackersAndCharges();
+    releaseStorage();
     if (releasor_) {
       releasor_();
     }
@@ -365,10 +368,20 @@ public:
    */
   static inline SizedStorage newStorage(uint64_t min_capacity) {
     const uint64_t slice_size = sliceSize(min_capacity);
-    return {StoragePtr{new uint8_t[slice_size]}, static_cast<size_t>(slice_size)};
+    return {SliceStoragePool::allocate(slice_size), static_cast<size_t>(slice_size)};
   }
 
 protected:
+  /**
+   * Hand owned backing storage back to the slice storage pool, if it is enabled. Otherwise the
+   * storage is freed as usual when storage_ is reset or destroyed.
+   */
+  void releaseStorage() {
+    if (storage_ != nullptr && SliceStoragePool::enabled()) {
+      SliceStoragePool::release(std::move(storage_), capacity_);
+    }
+  }
+
   /** Length of the byte array that base_ points to. This is also the offset in bytes from the start
    * of the slice to the end of the Reservable section. */
   uint64_t capacity_ = 0;
@@ -772,6 +785,8 @@ private:
           ASSERT(r->len_ == Slice::default_slice_size_);
           if (free_list_ref_.size() < free_list_max_) {
             free_list_ref_.push_back(std::move(r->mem_));
+          } else {
+            SliceStoragePool::release(std::move(r->mem_), r->len_);
           }
         }
       }
@@ -785,7 +800,7 @@ private:
         storage.mem_ = std::move(free_list_ref_.back());
         free_list_ref_.pop_back();
       } else {
-        storage.mem_.reset(new uint8_t[Slice::default_slice_size_]);
+        storage.mem_ = SliceStoragePool::allocate(Slice::default_slice_size_);
       }
 
       return storage;
@@ -0,0 +1,79 @@
+#include "source/common/buffer/slice_storage_pool.h"
+
+#include "source/common/common/assert.h"
+#include "source/common/common/per_thread_free_lists.h"
+
+#include "absl/numeric/bits.h"
+
+namespace Envoy {
+namespace Buffer {
+
+std::atomic<uint32_t> SliceStoragePool::max_slices_per_size_class_{0};
+
+namespace {
+
+struct SliceStorageTag {};
+using FreeLists = PerThreadFreeLists<SliceStorageTag, SliceStoragePool::StoragePtr,
+                                     SliceStoragePool::NumSizeClasses>;
+
+} // namespace
+
+void SliceStoragePool::configure(uint32_t max_slices_per_size_class) {
+  max_slices_per_size_class_.store(max_slices_per_size_class, std::memory_order_relaxed);
+  if (max_slices_per_size_class == 0) {
+    clearThreadCache();
+  }
+}
+
+int SliceStoragePool::sizeClass(uint64_t size) {
+  if (size == 0 || size % PageSize != 0) {
+    return -1;
+  }
+  const uint64_t pages = size / PageSize;
+  if (!absl::has_single_bit(pages)) {
+    return -1;
+  }
+  const int size_class = absl::countr_zero(pages);
+  return size_class < static_cast<int>(NumSizeClasses) ? size_class : -1;
+}
+
+SliceStoragePool::StoragePtr SliceStoragePool::allocate(uint64_t size) {
+  ASSERT(size % PageSize == 0);
+  const int size_class = enabled() ? sizeClass(size) : -1;
+  if (size_class >= 0) {
+    StoragePtr storage = FreeLists::pop(size_class, size);
+    if (storage != nullptr) {
+      return storage;
+    }
+  }
+  return StoragePtr{new uint8_t[size]};
+}
+
+void SliceStoragePool::release(StoragePtr&& storage, uint64_t size) {
+  // Take ownership unconditionally so that the storage is freed on every early return.
+  StoragePtr owned = std::move(storage);
+  const uint32_t max_slices = max_slices_per_size_class_.load(std::memory_order_relaxed);
+  if (owned == nullptr || max_slices == 0) {
+    return;
+  }
+  const int size_class = sizeClass(size);
+  if (size_class < 0) {
+    return;
+  }
+  FreeLists::push(size_class, std::move(owned), size, max_slices);
+}
+
+SliceStoragePool::Stats SliceStoragePool::stats() {
+  Stats stats;
+  for (const FreeLists::ListStats& list_stats : FreeLists::stats()) {
+    stats.hits_ += list_stats.reused_;
+    stats.misses_ += list_stats.allocated_;
+    stats.retained_bytes_ += list_stats.retained_;
+  }
+  return stats;
+}
+
+void SliceStoragePool::clearThreadCache() { FreeLists::clearThreadCache(); }
+
+} // namespace Buffer
+} // namespace Envoy
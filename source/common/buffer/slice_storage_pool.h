@@ -0,0 +1,89 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+namespace Envoy {
+namespace Buffer {
+
+/**
+ * Optional per-thread pool for the backing storage of Buffer::Slice. Storage is cached in a small
+ * number of page-multiple size classes with a bounded free list per class, so that slices which
+ * are repeatedly allocated and released on a worker's read/write path are recycled without going
+ * back to the general heap. Each thread (and thus each dispatcher) owns its own free lists, so
+ * the fast path never takes a lock.
+ *
+ * The pool is disabled by default, in which case allocate() and release() degrade to plain
+ * new[]/delete[]. Storage handed out by the pool is always allocated with new[], so it is safe
+ * for it to be released through the pool on a different thread or freed directly.
+ */
+class SliceStoragePool {
+public:
+  using StoragePtr = std::unique_ptr<uint8_t[]>;
+
+  struct Stats {
+    // Number of allocations of a poolable size served from a free list.
+    uint64_t hits_{};
+    // Number of allocations of a poolable size which had to go to the heap.
+    uint64_t misses_{};
+    // Number of bytes currently held in free lists across all threads.
+    uint64_t retained_bytes_{};
+  };
+
+  static constexpr uint64_t PageSize = 4096;
+  // Size classes are 1, 2, 4, 8 and 16 pages. 16 KiB (Slice::default_slice_size_) is the size
+  // used by reads and so is expected to dominate.
+  static constexpr uint32_t NumSizeClasses = 5;
+  static constexpr uint32_t DefaultMaxSlicesPerSizeClass = 32;
+
+  /**
+   * Configure the pool for the whole process. This should be called during server startup before
+   * workers are started.
+   * @param max_slices_per_size_class the bound on each per-thread free list. A value of 0
+   *        disables the pool and drops any storage cached by the calling thread.
+   */
+  static void configure(uint32_t max_slices_per_size_class);
+
+  /**
+   * @return whether the pool has been enabled by configure().
+   */
+  static bool enabled() { return max_slices_per_size_class_.load(std::memory_order_relaxed) > 0; }
+
+  /**
+   * Allocate backing storage.
+   * @param size the storage size in bytes. Must be a multiple of PageSize.
+   * @return storage of exactly `size` bytes.
+   */
+  static StoragePtr allocate(uint64_t size);
+
+  /**
+   * Return backing storage to the calling thread's pool, or free it if the pool is disabled, the
+   * size is not poolable, or the free list for the size class is full.
+   * @param storage the storage to release.
+   * @param size the size the storage was allocated with.
+   */
+  static void release(StoragePtr&& storage, uint64_t size);
+
+  /**
+   * @return stats aggregated across all threads.
+   */
+  static Stats stats();
+
+  /**
+   * Free all storage cached by the calling thread.
+   */
+  static void clearThreadCache();
+
+  /**
+   * @return the size class index for `size`, or -1 if storage of this size is never pooled.
+   */
+  static int sizeClass(uint64_t size);
+
+private:
+  static std::atomic<uint32_t> max_slices_per_size_class_;
+};
+
+} // namespace Buffer
+} // namespace Envoy
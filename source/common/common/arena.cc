@@ -0,0 +1,31 @@
+#include "source/common/common/arena.h"
+
+namespace Envoy {
+
+Arena::~Arena() {
+  while (blocks_head_ != nullptr) {
+    Block* next = blocks_head_->next_;
+    ::operator delete(blocks_head_);
+    blocks_head_ = next;
+  }
+}
+
+void* Arena::allocateBlock(size_t size) {
+  // Large allocations get a block of their own, so that they do not waste the rest of the current
+  // block.
+  const bool dedicated = size > block_size_ / 4;
+  const size_t data_size = dedicated ? size : block_size_;
+  Block* block = static_cast<Block*>(::operator new(sizeof(Block) + data_size));
+  block->next_ = blocks_head_;
+  blocks_head_ = block;
+  ++blocks_;
+
+  char* data = reinterpret_cast<char*>(block + 1);
+  if (!dedicated) {
+    cursor_ = data + size;
+    end_ = data + data_size;
+  }
+  return data;
+}
+
+} // namespace Envoy
@@ -0,0 +1,147 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+
+#include "source/common/common/assert.h"
+#include "source/common/common/non_copyable.h"
+
+namespace Envoy {
+
+/**
+ * A bump allocator for objects which live as long as their owner, such as the per-request objects
+ * of an HTTP stream. Memory is taken from the heap in blocks and only freed when the arena is
+ * destroyed, so allocating is a pointer bump and freeing is a no-op.
+ *
+ * The arena does not run destructors. Objects are created with makeArenaPtr() and destroyed
+ * through their ArenaPtr, or stored in containers using ArenaAllocator. Both must be destroyed
+ * before the arena. Not thread safe.
+ */
+class Arena : NonCopyable {
+public:
+  static constexpr size_t DefaultBlockSize = 4096;
+
+  explicit Arena(size_t block_size = DefaultBlockSize) : block_size_(block_size) {}
+  ~Arena();
+
+  /**
+   * @param size supplies the number of bytes to allocate.
+   * @param alignment supplies the alignment of the storage, a power of two which is at most
+   *        alignof(std::max_align_t).
+   * @return storage which remains valid until the arena is destroyed.
+   */
+  void* allocate(size_t size, size_t alignment) {
+    ASSERT(alignment <= alignof(std::max_align_t) && (alignment & (alignment - 1)) == 0);
+    ++allocations_;
+    const size_t padding = -reinterpret_cast<uintptr_t>(cursor_) & (alignment - 1);
+    if (padding + size > static_cast<size_t>(end_ - cursor_)) {
+      return allocateBlock(size);
+    }
+    void* ptr = cursor_ + padding;
+    cursor_ += padding + size;
+    return ptr;
+  }
+
+  /**
+   * @return the number of allocations served by the arena.
+   */
+  uint32_t allocations() const { return allocations_; }
+
+  /**
+   * @return the number of blocks the arena took from the heap.
+   */
+  uint32_t blocks() const { return blocks_; }
+
+private:
+  struct alignas(std::max_align_t) Block {
+    Block* next_;
+  };
+
+  void* allocateBlock(size_t size);
+
+  const size_t block_size_;
+  Block* blocks_head_{};
+  char* cursor_{};
+  char* end_{};
+  uint32_t allocations_{};
+  uint32_t blocks_{};
+};
+
+/**
+ * Deleter of objects which may have been created in an Arena. It runs the destructor of the
+ * object, and only frees its memory if the object was created on the heap.
+ */
+template <class T> class ArenaDeleter {
+public:
+  ArenaDeleter() = default;
+  explicit ArenaDeleter(bool in_arena) : in_arena_(in_arena) {}
+
+  void operator()(T* ptr) const {
+    if (in_arena_) {
+      ptr->~T();
+    } else {
+      delete ptr;
+    }
+  }
+
+private:
+  bool in_arena_{};
+};
+
+template <class T> using ArenaPtr = std::unique_ptr<T, ArenaDeleter<T>>;
+
+/**
+ * Creates an object in an arena, or on the heap if there is no arena.
+ * @param arena supplies the arena, or nullptr.
+ * @param args supplies the arguments of the constructor of T.
+ */
+template <class T, class... Args> ArenaPtr<T> makeArenaPtr(Arena* arena, Args&&... args) {
+  if (arena == nullptr) {
+    return ArenaPtr<T>(new T(std::forward<Args>(args)...));
+  }
+  return ArenaPtr<T>(new (arena->allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...),
+                     ArenaDeleter<T>(true));
+}
+
+/**
+ * Standard allocator which allocates from an arena, or from the heap if there is no arena. Memory
+ * given back to the arena is only reclaimed when the arena is destroyed, so this suits containers
+ * which grow a few times and are then destroyed with their owner.
+ */
+template <class T> class ArenaAllocator {
+public:
+  using value_type = T;
+
+  explicit ArenaAllocator(Arena* arena = nullptr) : arena_(arena) {}
+  template <class U> ArenaAllocator(const ArenaAllocator<U>& other) : arena_(other.arena()) {}
+
+  T* allocate(size_t n) {
+    if (arena_ == nullptr) {
+      return std::allocator<T>().allocate(n);
+    }
+    return static_cast<T*>(arena_->allocate(n * sizeof(T), alignof(T)));
+  }
+
+  void deallocate(T* ptr, size_t n) {
+    if (arena_ == nullptr) {
+      std::allocator<T>().deallocate(ptr, n);
+    }
+  }
+
+  Arena* arena() const { return arena_; }
+
+  friend bool operator==(const ArenaAllocator& lhs, const ArenaAllocator& rhs) {
+    return lhs.arena_ == rhs.arena_;
+  }
+  friend bool operator!=(const ArenaAllocator& lhs, const ArenaAllocator& rhs) {
+    return lhs.arena_ != rhs.arena_;
+  }
+
+private:
+  Arena* arena_;
+};
+
+} // namespace Envoy
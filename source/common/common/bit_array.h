@@ -2,9 +2,11 @@
 
 #include <cstdint>
 #include <cstring>
+#include <vector>
 
 #include "source/common/common/assert.h"
 #include "source/common/common/safe_memcpy.h"
+#include "source/common/memory/huge_page_allocator.h"
 
 namespace Envoy {
 
@@ -41,7 +43,7 @@ public:
    * @param num_items the number of elements the bit array must hold.
    */
   BitArray(int width, size_t num_items)
-      : array_start_(std::make_unique<uint8_t[]>(bytesNeeded(width, num_items))), bit_width_(width),
+      : array_start_(bytesNeeded(width, num_items)), bit_width_(width),
         // This will fit in a uint32_t as with the maximum shift of 32, we'd
         // subtract one to fit in 32 bits.
         mask_(static_cast<uint32_t>((static_cast<uint64_t>(1) << width) - 1)),
@@ -49,7 +51,7 @@ public:
     RELEASE_ASSERT(width <= MaxBitWidth, "Using BitArray with invalid parameters.");
     RELEASE_ASSERT(ENVOY_BIT_ARRAY_SUPPORTED, "BitArray requires 64-bit architecture.");
     // Init padding to avoid sanitizer complaints if reading the last elements.
-    uint8_t* padding_start = array_start_.get() + (bytesNeeded(width, num_items) - WordSize);
+    uint8_t* padding_start = array_start_.data() + (bytesNeeded(width, num_items) - WordSize);
     storeUnsignedWord(padding_start, 0);
   }
 
@@ -66,7 +68,7 @@ public:
     // the given index.
     const size_t bit0_offset = index * bit_width_;
     const size_t byte0_offset = bit0_offset >> 3;
-    const uint8_t* byte0 = array_start_.get() + byte0_offset;
+    const uint8_t* byte0 = array_start_.data() + byte0_offset;
     // Find the starting bit within byte0 of this element.
     // It will be in the range of 0-7.
     const size_t index_of_0th_bit = bit0_offset & 0x7;
@@ -89,7 +91,7 @@ public:
     // the given index.
     const size_t bit0_offset = index * bit_width_;
     const size_t byte0_offset = bit0_offset >> 3;
-    uint8_t* byte0 = array_start_.get() + byte0_offset;
+    uint8_t* byte0 = array_start_.data() + byte0_offset;
 
     // Find the starting bit within byte0 of this element.
     // It will be in the range of 0-7.
@@ -139,8 +141,9 @@ private:
     return le64toh(destination);
   }
 
-  // Backing storage for the underlying array of bits.
-  std::unique_ptr<uint8_t[]> array_start_;
+  // Backing storage for the underlying array of bits. Large arrays, such as Maglev tables, are
+  // looked up at random and are placed on huge pages when huge page regions are enabled.
+  std::vector<uint8_t, Memory::HugePageAllocator<uint8_t>> array_start_;
   // Pointer to the end of the array. In cases where we allocate a word size of
   // bytes it's possible that the logical "end" of the e.g. based on num_items
   // is before this address.
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+#include "source/common/common/non_copyable.h"
+
+#include "absl/types/optional.h"
+
+namespace Envoy {
+
+/**
+ * An unbounded multi-producer single-consumer FIFO queue, after Dmitry Vyukov's node based MPSC
+ * queue. push() is wait-free and may be called from any thread. pop() must only be called from
+ * one consumer thread at a time.
+ *
+ * A push is a single atomic exchange of the tail, after which the producer links the previous tail
+ * to the new node. A consumer which reaches a node whose successor is not linked yet sees the
+ * queue as empty until the producer finishes, while size() already counts the node.
+ */
+template <class T> class MpscQueue : NonCopyable {
+public:
+  MpscQueue() = default;
+  ~MpscQueue() {
+    while (pop().has_value()) {
+    }
+  }
+
+  /**
+   * Appends a value to the queue.
+   * @return the number of values in the queue before this one, counting those which are still
+   *         being pushed. Zero means the consumer may have seen the queue empty and needs a wakeup.
+   */
+  size_t push(T value) {
+    const size_t previous_size = size_.fetch_add(1, std::memory_order_acq_rel);
+    pushNode(new Node(std::move(value)));
+    return previous_size;
+  }
+
+  /**
+   * Removes the value at the front of the queue.
+   * @return the value, or absl::nullopt if the queue is empty or its front is still being pushed.
+   */
+  absl::optional<T> pop() {
+    NodeBase* head = head_;
+    NodeBase* next = head->next_.load(std::memory_order_acquire);
+    if (head == &stub_) {
+      if (next == nullptr) {
+        return absl::nullopt;
+      }
+      head_ = next;
+      head = next;
+      next = next->next_.load(std::memory_order_acquire);
+    }
+    if (next != nullptr) {
+      head_ = next;
+      return take(head);
+    }
+    if (head != tail_.load(std::memory_order_acquire)) {
+      // A producer has exchanged the tail but not linked its node yet.
+      return absl::nullopt;
+    }
+    // head is the last node, so push the stub behind it to be able to remove it.
+    pushNode(&stub_);
+    next = head->next_.load(std::memory_order_acquire);
+    if (next != nullptr) {
+      head_ = next;
+      return take(head);
+    }
+    return absl::nullopt;
+  }
+
+  /**
+   * @return the number of values pushed and not popped yet. This is exact only when no producer is
+   *         running concurrently.
+   */
+  size_t size() const { return size_.load(std::memory_order_acquire); }
+
+private:
+  struct NodeBase {
+    std::atomic<NodeBase*> next_{nullptr};
+  };
+  struct Node : public NodeBase {
+    explicit Node(T&& value) : value_(std::move(value)) {}
+    T value_;
+  };
+
+  void pushNode(NodeBase* node) {
+    node->next_.store(nullptr, std::memory_order_relaxed);
+    NodeBase* previous = tail_.exchange(node, std::memory_order_acq_rel);
+    previous->next_.store(node, std::memory_order_release);
+  }
+
+  absl::optional<T> take(NodeBase* head) {
+    Node* node = static_cast<Node*>(head);
+    absl::optional<T> value(std::move(node->value_));
+    delete node;
+    size_.fetch_sub(1, std::memory_order_acq_rel);
+    return value;
+  }
+
+  NodeBase stub_;
+  // Only accessed by the consumer.
+  NodeBase* head_{&stub_};
+  // Producers and the consumer exchange the tail. It is on its own cache line to keep producers
+  // from invalidating the consumer's head.
+  alignas(64) std::atomic<NodeBase*> tail_{&stub_};
+  alignas(64) std::atomic<size_t> size_{0};
+};
+
+} // namespace Envoy
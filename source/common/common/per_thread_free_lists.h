@@ -0,0 +1,196 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "source/common/common/macros.h"
+
+#include "absl/container/flat_hash_set.h"
+#include "absl/synchronization/mutex.h"
+
+namespace Envoy {
+
+/**
+ * Bounded per-thread free lists of storage, for pools which recycle storage that workers
+ * allocate and free at very high rates. Each thread owns its own lists, so that popping and
+ * pushing never takes a lock. The lists of all threads are registered so that their stats can be
+ * aggregated from any thread, and the totals of threads which have exited are kept.
+ *
+ * All members are static, as the lists are per thread.
+ * @tparam Tag distinguishes the pools, each of which has its own lists.
+ * @tparam StoragePtr an owning pointer to a block of storage, which frees it when destroyed.
+ * @tparam NumLists the number of lists per thread.
+ */
+template <class Tag, class StoragePtr, uint32_t NumLists> class PerThreadFreeLists {
+public:
+  struct ListStats {
+    // Number of pops served from the list.
+    uint64_t reused_{};
+    // Number of pops which found the list empty.
+    uint64_t allocated_{};
+    // Total weight of the storage currently held in the list across all threads.
+    uint64_t retained_{};
+  };
+
+  /**
+   * Pop storage from one of the calling thread's lists.
+   * @param list the index of the list.
+   * @param weight the weight of the storage, such as its size, to deduct from the retained total.
+   * @return the storage, or nullptr if the list is empty or the calling thread is exiting.
+   */
+  static StoragePtr pop(uint32_t list, uint64_t weight) {
+    ThreadCache* cache = threadCache();
+    if (cache == nullptr) {
+      return nullptr;
+    }
+    List& free_list = cache->lists_[list];
+    if (free_list.storage_.empty()) {
+      bump(free_list.allocated_, 1);
+      return nullptr;
+    }
+    StoragePtr storage = std::move(free_list.storage_.back());
+    free_list.storage_.pop_back();
+    bump(free_list.reused_, 1);
+    drop(free_list.retained_, weight);
+    return storage;
+  }
+
+  /**
+   * Push storage to one of the calling thread's lists. The storage is freed instead if the list
+   * already holds `max_size` blocks, or if the calling thread is exiting.
+   * @param list the index of the list.
+   * @param storage the storage to push.
+   * @param weight the weight of the storage, such as its size, to add to the retained total.
+   * @param max_size the bound on the list.
+   */
+  static void push(uint32_t list, StoragePtr&& storage, uint64_t weight, uint32_t max_size) {
+    // Take ownership unconditionally so that the storage is freed on every early return.
+    StoragePtr owned = std::move(storage);
+    ThreadCache* cache = threadCache();
+    if (cache == nullptr) {
+      return;
+    }
+    List& free_list = cache->lists_[list];
+    if (free_list.storage_.size() >= max_size) {
+      return;
+    }
+    free_list.storage_.push_back(std::move(owned));
+    bump(free_list.retained_, weight);
+  }
+
+  /**
+   * @return the stats of every list, aggregated across all threads.
+   */
+  static std::array<ListStats, NumLists> stats() {
+    std::array<ListStats, NumLists> stats;
+    Registry& reg = registry();
+    absl::MutexLock lock(&reg.mutex_);
+    for (uint32_t i = 0; i < NumLists; ++i) {
+      stats[i].reused_ = reg.retired_reused_[i];
+      stats[i].allocated_ = reg.retired_allocated_[i];
+    }
+    for (const ThreadCache* cache : reg.caches_) {
+      for (uint32_t i = 0; i < NumLists; ++i) {
+        const List& free_list = cache->lists_[i];
+        stats[i].reused_ += free_list.reused_.load(std::memory_order_relaxed);
+        stats[i].allocated_ += free_list.allocated_.load(std::memory_order_relaxed);
+        stats[i].retained_ += free_list.retained_.load(std::memory_order_relaxed);
+      }
+    }
+    return stats;
+  }
+
+  /**
+   * Free all storage held by the calling thread's lists.
+   */
+  static void clearThreadCache() {
+    if (threadCachePtr() != nullptr) {
+      threadCachePtr()->clear();
+    }
+  }
+
+private:
+  struct List {
+    std::vector<StoragePtr> storage_;
+    std::atomic<uint64_t> reused_{0};
+    std::atomic<uint64_t> allocated_{0};
+    std::atomic<uint64_t> retained_{0};
+  };
+
+  class ThreadCache;
+
+  struct Registry {
+    absl::Mutex mutex_;
+    absl::flat_hash_set<ThreadCache*> caches_ ABSL_GUARDED_BY(mutex_);
+    // Totals of threads which have exited.
+    std::array<uint64_t, NumLists> retired_reused_ ABSL_GUARDED_BY(mutex_){};
+    std::array<uint64_t, NumLists> retired_allocated_ ABSL_GUARDED_BY(mutex_){};
+  };
+
+  class ThreadCache {
+  public:
+    ThreadCache() {
+      absl::MutexLock lock(&registry().mutex_);
+      registry().caches_.insert(this);
+    }
+
+    ~ThreadCache() {
+      threadCachePtr() = nullptr;
+      threadCacheDestroyed() = true;
+      clear();
+      absl::MutexLock lock(&registry().mutex_);
+      registry().caches_.erase(this);
+      for (uint32_t i = 0; i < NumLists; ++i) {
+        registry().retired_reused_[i] += lists_[i].reused_.load(std::memory_order_relaxed);
+        registry().retired_allocated_[i] += lists_[i].allocated_.load(std::memory_order_relaxed);
+      }
+    }
+
+    void clear() {
+      for (List& free_list : lists_) {
+        free_list.storage_.clear();
+        free_list.retained_.store(0, std::memory_order_relaxed);
+      }
+    }
+
+    std::array<List, NumLists> lists_;
+  };
+
+  // Counters in a ThreadCache are only ever written by the owning thread, and read by stats() from
+  // any thread, so a relaxed load/store pair is enough and avoids a locked read-modify-write.
+  static void bump(std::atomic<uint64_t>& value, uint64_t delta) {
+    value.store(value.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+  }
+
+  static void drop(std::atomic<uint64_t>& value, uint64_t delta) {
+    value.store(value.load(std::memory_order_relaxed) - delta, std::memory_order_relaxed);
+  }
+
+  // Leaked so that threads exiting during static destruction can still deregister.
+  static Registry& registry() { MUTABLE_CONSTRUCT_ON_FIRST_USE(Registry); }
+
+  // Both of these are trivially destructible, so they remain usable while other thread_local
+  // objects which own pooled storage are being destroyed after the cache itself.
+  static ThreadCache*& threadCachePtr() {
+    static thread_local ThreadCache* thread_cache = nullptr;
+    return thread_cache;
+  }
+
+  static bool& threadCacheDestroyed() {
+    static thread_local bool thread_cache_destroyed = false;
+    return thread_cache_destroyed;
+  }
+
+  static ThreadCache* threadCache() {
+    if (threadCachePtr() == nullptr && !threadCacheDestroyed()) {
+      static thread_local ThreadCache cache;
+      threadCachePtr() = &cache;
+    }
+    return threadCachePtr();
+  }
+};
+
+} // namespace Envoy
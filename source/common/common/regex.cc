@@ -1,5 +1,7 @@
 #include "source/common/common/regex.h"
 
+#include <algorithm>
+
 #include "envoy/common/exception.h"
 #include "envoy/extensions/regex_engines/v3/google_re2.pb.h"
 #include "envoy/extensions/regex_engines/v3/google_re2.pb.validate.h"
@@ -92,10 +94,62 @@ CompiledGoogleReMatcher::CompiledGoogleReMatcher(
   }
 }
 
+namespace {
+
+re2::RE2::Options quietOptions() {
+  re2::RE2::Options options;
+  options.set_log_errors(false);
+  return options;
+}
+
+} // namespace
+
+absl::StatusOr<std::unique_ptr<CompiledGoogleReSetMatcher>>
+CompiledGoogleReSetMatcher::create(const std::vector<std::string>& regexes) {
+  absl::Status creation_status = absl::OkStatus();
+  auto ret = std::unique_ptr<CompiledGoogleReSetMatcher>(
+      new CompiledGoogleReSetMatcher(regexes, creation_status));
+  RETURN_IF_NOT_OK(creation_status);
+  return ret;
+}
+
+// The set is anchored at both ends to match whole values, like RE2::FullMatch().
+CompiledGoogleReSetMatcher::CompiledGoogleReSetMatcher(const std::vector<std::string>& regexes,
+                                                       absl::Status& creation_status)
+    : set_(quietOptions(), re2::RE2::ANCHOR_BOTH), size_(regexes.size()) {
+  for (const std::string& regex : regexes) {
+    std::string error;
+    if (set_.Add(regex, &error) < 0) {
+      creation_status = absl::InvalidArgumentError(error);
+      return;
+    }
+  }
+  if (!set_.Compile()) {
+    creation_status = absl::ResourceExhaustedError("out of memory compiling regex set");
+  }
+}
+
+bool CompiledGoogleReSetMatcher::match(absl::string_view value, std::vector<int>& matches) const {
+  matches.clear();
+  re2::RE2::Set::ErrorInfo error_info;
+  if (!set_.Match(value, &matches, &error_info)) {
+    // No match also returns false, with kNoError.
+    return error_info.kind == re2::RE2::Set::kNoError;
+  }
+  // RE2 reports the matching regexes in no particular order.
+  std::sort(matches.begin(), matches.end());
+  return true;
+}
+
 absl::StatusOr<CompiledMatcherPtr> GoogleReEngine::matcher(const std::string& regex) const {
   return CompiledGoogleReMatcher::createAndSizeCheck(regex);
 }
 
+absl::StatusOr<CompiledSetMatcherPtr>
+GoogleReEngine::setMatcher(const std::vector<std::string>& regexes) const {
+  return CompiledGoogleReSetMatcher::create(regexes);
+}
+
 EnginePtr GoogleReEngineFactory::createEngine(const Protobuf::Message&,
                                               Server::Configuration::ServerFactoryContext&) {
   return std::make_shared<GoogleReEngine>();
@@ -13,6 +13,7 @@
 #include "source/common/stats/symbol_table.h"
 
 #include "re2/re2.h"
+#include "re2/set.h"
 #include "xds/type/matcher/v3/regex.pb.h"
 
 namespace Envoy {
@@ -67,9 +68,31 @@ public:
       : CompiledGoogleReMatcher(regex) {}
 };
 
+/**
+ * A set of regexes matched with a single RE2 automaton.
+ */
+class CompiledGoogleReSetMatcher : public CompiledSetMatcher {
+public:
+  static absl::StatusOr<std::unique_ptr<CompiledGoogleReSetMatcher>>
+  create(const std::vector<std::string>& regexes);
+
+  // CompiledSetMatcher
+  bool match(absl::string_view value, std::vector<int>& matches) const override;
+  size_t size() const override { return size_; }
+
+private:
+  explicit CompiledGoogleReSetMatcher(const std::vector<std::string>& regexes,
+                                      absl::Status& creation_status);
+
+  re2::RE2::Set set_;
+  const size_t size_;
+};
+
 class GoogleReEngine : public Engine {
 public:
   absl::StatusOr<CompiledMatcherPtr> matcher(const std::string& regex) const override;
+  absl::StatusOr<CompiledSetMatcherPtr>
+  setMatcher(const std::vector<std::string>& regexes) const override;
 };
 
 class GoogleReEngineFactory : public EngineFactory {
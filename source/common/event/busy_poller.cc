@@ -0,0 +1,52 @@
+#include "source/common/event/busy_poller.h"
+
+namespace Envoy {
+namespace Event {
+
+namespace {
+constexpr std::chrono::seconds BudgetWindow(1);
+} // namespace
+
+BusyPoller::BusyPoller(const BusyPollConfig& config, const BusyPollStats& stats,
+                       Dispatcher& dispatcher)
+    : spin_duration_(config.spin_duration_),
+      max_idle_spin_time_(std::chrono::duration_cast<std::chrono::nanoseconds>(
+          BudgetWindow * config.max_idle_spin_fraction_)),
+      stats_(stats), time_source_(dispatcher.timeSource()),
+      spin_cb_(dispatcher.createSchedulableCallback(
+          [this]() { spin(time_source_.monotonicTime()); })) {}
+
+void BusyPoller::onPoll(MonotonicTime now, bool found_events) {
+  if (now - window_start_ >= BudgetWindow) {
+    window_start_ = now;
+    idle_spin_time_ = std::chrono::nanoseconds(0);
+  }
+  // The pending spin callback is what made this poll non-blocking.
+  if (spin_cb_->enabled()) {
+    stats_.busy_poll_spins_.inc();
+    if (found_events) {
+      stats_.busy_poll_spins_with_events_.inc();
+    } else {
+      idle_spin_time_ += now - spin_start_;
+    }
+  }
+  if (found_events) {
+    spin_deadline_ = now + spin_duration_;
+    spin(now);
+  }
+}
+
+void BusyPoller::spin(MonotonicTime now) {
+  if (now >= spin_deadline_) {
+    return;
+  }
+  if (idle_spin_time_ >= max_idle_spin_time_) {
+    stats_.busy_poll_budget_exhausted_.inc();
+    return;
+  }
+  spin_start_ = now;
+  spin_cb_->scheduleCallbackNextIteration();
+}
+
+} // namespace Event
+} // namespace Envoy
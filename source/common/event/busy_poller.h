@@ -0,0 +1,66 @@
+#pragma once
+
+#include <chrono>
+
+#include "envoy/common/time.h"
+#include "envoy/event/dispatcher.h"
+#include "envoy/event/schedulable_cb.h"
+#include "envoy/stats/stats_macros.h"
+
+namespace Envoy {
+namespace Event {
+
+/**
+ * All busy poll stats. @see stats_macros.h
+ */
+#define ALL_BUSY_POLL_STATS(COUNTER)                                                               \
+  COUNTER(busy_poll_budget_exhausted)                                                              \
+  COUNTER(busy_poll_spins)                                                                         \
+  COUNTER(busy_poll_spins_with_events)
+
+/**
+ * Struct definition for all busy poll stats. @see stats_macros.h
+ */
+struct BusyPollStats {
+  ALL_BUSY_POLL_STATS(GENERATE_COUNTER_STRUCT)
+};
+
+/**
+ * Adaptive busy polling of an event loop, which calls onPoll() after each poll. A spin is a poll
+ * made non-blocking by keeping a callback scheduled for the next iteration of the loop. Spinning
+ * starts when a poll finds events and stops once spin_duration passes without events, or once the
+ * spins which found no events used up the CPU budget of the current second.
+ */
+class BusyPoller {
+public:
+  BusyPoller(const BusyPollConfig& config, const BusyPollStats& stats, Dispatcher& dispatcher);
+
+  /**
+   * Called after each poll of the event loop, before the events it found are handled.
+   * @param now supplies the time the poll returned.
+   * @param found_events supplies whether the poll found I/O events.
+   */
+  void onPoll(MonotonicTime now, bool found_events);
+
+private:
+  void spin(MonotonicTime now);
+
+  const std::chrono::microseconds spin_duration_;
+  const std::chrono::nanoseconds max_idle_spin_time_;
+  BusyPollStats stats_;
+  TimeSource& time_source_;
+  SchedulableCallbackPtr spin_cb_;
+  // Spinning stops at this time unless a poll finds events before.
+  MonotonicTime spin_deadline_;
+  // When the pending spin was scheduled.
+  MonotonicTime spin_start_;
+  // The start of the current budget window, and the time spent in spins which found no events
+  // within it.
+  MonotonicTime window_start_;
+  std::chrono::nanoseconds idle_spin_time_{};
+};
+
+using BusyPollerPtr = std::unique_ptr<BusyPoller>;
+
+} // namespace Event
+} // namespace Envoy
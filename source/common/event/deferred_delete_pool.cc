@@ -0,0 +1,99 @@
+#include "source/common/event/deferred_delete_pool.h"
+
+#include <array>
+#include <memory>
+#include <new>
+
+#include "source/common/common/assert.h"
+#include "source/common/common/macros.h"
+#include "source/common/common/per_thread_free_lists.h"
+
+#include "absl/synchronization/mutex.h"
+
+namespace Envoy {
+namespace Event {
+
+std::atomic<uint32_t> DeferredDeletePool::max_objects_per_type_{0};
+
+namespace {
+
+struct TypeInfo {
+  std::string name_;
+  size_t object_size_{};
+};
+
+struct Registry {
+  absl::Mutex mutex_;
+  // Types are only ever appended, and num_types_ is published after the entry is written.
+  std::array<TypeInfo, DeferredDeletePool::MaxTypes> types_;
+  std::atomic<uint32_t> num_types_{0};
+};
+
+// Leaked so that pooled objects destroyed during static destruction can still look up their type.
+Registry& registry() { MUTABLE_CONSTRUCT_ON_FIRST_USE(Registry); }
+
+struct OperatorDelete {
+  void operator()(void* ptr) const { ::operator delete(ptr); }
+};
+using StoragePtr = std::unique_ptr<void, OperatorDelete>;
+
+struct DeferredDeleteTag {};
+using FreeLists = PerThreadFreeLists<DeferredDeleteTag, StoragePtr, DeferredDeletePool::MaxTypes>;
+
+} // namespace
+
+void DeferredDeletePool::configure(uint32_t max_objects_per_type) {
+  max_objects_per_type_.store(max_objects_per_type, std::memory_order_relaxed);
+  if (max_objects_per_type == 0) {
+    clearThreadCache();
+  }
+}
+
+uint32_t DeferredDeletePool::registerType(absl::string_view name, size_t object_size) {
+  Registry& reg = registry();
+  absl::MutexLock lock(&reg.mutex_);
+  const uint32_t type = reg.num_types_.load(std::memory_order_relaxed);
+  RELEASE_ASSERT(type < MaxTypes, "too many deferred delete pool types");
+  reg.types_[type].name_ = std::string(name);
+  reg.types_[type].object_size_ = object_size;
+  reg.num_types_.store(type + 1, std::memory_order_release);
+  return type;
+}
+
+void* DeferredDeletePool::allocate(uint32_t type, size_t size) {
+  if (enabled() && size == registry().types_[type].object_size_) {
+    StoragePtr storage = FreeLists::pop(type, 1);
+    if (storage != nullptr) {
+      return storage.release();
+    }
+  }
+  return ::operator new(size);
+}
+
+void DeferredDeletePool::release(uint32_t type, void* ptr, size_t size) {
+  StoragePtr storage(ptr);
+  const uint32_t max_objects = max_objects_per_type_.load(std::memory_order_relaxed);
+  if (storage == nullptr || max_objects == 0 || size != registry().types_[type].object_size_) {
+    return;
+  }
+  FreeLists::push(type, std::move(storage), 1, max_objects);
+}
+
+std::vector<DeferredDeletePool::TypeStats> DeferredDeletePool::stats() {
+  Registry& reg = registry();
+  const uint32_t num_types = reg.num_types_.load(std::memory_order_acquire);
+  const std::array<FreeLists::ListStats, MaxTypes> list_stats = FreeLists::stats();
+  std::vector<TypeStats> stats(num_types);
+  for (uint32_t i = 0; i < num_types; ++i) {
+    stats[i].name_ = reg.types_[i].name_;
+    stats[i].reused_ = list_stats[i].reused_;
+    stats[i].allocated_ = list_stats[i].allocated_;
+    stats[i].retained_ = list_stats[i].retained_;
+  }
+  return stats;
+}
+
+void DeferredDeletePool::clearThreadCache() { FreeLists::clearThreadCache(); }
+
+} // namespace Event
+} // namespace Envoy
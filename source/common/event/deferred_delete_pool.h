@@ -0,0 +1,110 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+
+namespace Envoy {
+namespace Event {
+
+/**
+ * Optional per-thread recycling of the storage of objects which are created and deferred-deleted
+ * at very high rates, such as HTTP streams and upstream requests. Each pooled type has its own
+ * bounded free list per thread (and thus per dispatcher), so a worker which destroys a stream in
+ * its deferred delete pass hands the memory straight to the next stream it creates, without going
+ * back to the general heap or taking a lock.
+ *
+ * Types opt in by deriving from PooledDeferredDeletable<T>. The pool is disabled by default, in
+ * which case allocation degrades to the global operator new/delete. Storage is always obtained
+ * from the global operator new, so objects may be freed on a different thread than the one which
+ * allocated them.
+ */
+class DeferredDeletePool {
+public:
+  struct TypeStats {
+    std::string name_;
+    // Number of objects whose storage was recycled from a free list.
+    uint64_t reused_{};
+    // Number of objects whose storage had to be allocated from the heap.
+    uint64_t allocated_{};
+    // Number of free storage blocks currently held across all threads.
+    uint64_t retained_{};
+  };
+
+  static constexpr uint32_t MaxTypes = 16;
+  static constexpr uint32_t DefaultMaxObjectsPerType = 256;
+
+  /**
+   * Configure the pool for the whole process. This should be called during server startup before
+   * workers are started.
+   * @param max_objects_per_type the bound on each per-thread free list. A value of 0 disables the
+   *        pool and drops any storage cached by the calling thread.
+   */
+  static void configure(uint32_t max_objects_per_type);
+
+  /**
+   * @return whether the pool has been enabled by configure().
+   */
+  static bool enabled() { return max_objects_per_type_.load(std::memory_order_relaxed) > 0; }
+
+  /**
+   * Register a pooled type. Called once per type by PooledDeferredDeletable.
+   * @param name the name used for the type's stats.
+   * @param object_size the size of the type. Only allocations of exactly this size are pooled, so
+   *        that subclasses of a pooled type fall back to the heap.
+   * @return the type's index.
+   */
+  static uint32_t registerType(absl::string_view name, size_t object_size);
+
+  /**
+   * Allocate storage for an object of a pooled type.
+   */
+  static void* allocate(uint32_t type, size_t size);
+
+  /**
+   * Return storage obtained from allocate() to the calling thread's pool, or free it if the pool
+   * is disabled, the size does not match the type, or the type's free list is full.
+   */
+  static void release(uint32_t type, void* ptr, size_t size);
+
+  /**
+   * @return stats of every registered type, aggregated across all threads.
+   */
+  static std::vector<TypeStats> stats();
+
+  /**
+   * Free all storage cached by the calling thread.
+   */
+  static void clearThreadCache();
+
+private:
+  static std::atomic<uint32_t> max_objects_per_type_;
+};
+
+/**
+ * Mixin which routes the allocation of T through DeferredDeletePool. T must define
+ *   static constexpr absl::string_view DeferredDeletePoolName = "...";
+ * and must be destroyed through a pointer to T or through a virtual destructor, so that the sized
+ * operator delete below is called with the dynamic size of the object.
+ */
+template <class T> class PooledDeferredDeletable {
+public:
+  static void* operator new(size_t size) { return DeferredDeletePool::allocate(type(), size); }
+  static void operator delete(void* ptr, size_t size) {
+    DeferredDeletePool::release(type(), ptr, size);
+  }
+
+private:
+  static uint32_t type() {
+    static const uint32_t type =
+        DeferredDeletePool::registerType(T::DeferredDeletePoolName, sizeof(T));
+    return type;
+  }
+};
+
+} // namespace Event
+} // namespace Envoy
@@ -23,6 +23,7 @@
 #include "source/common/event/scaled_range_timer_manager_impl.h"
 #include "source/common/event/signal_impl.h"
 #include "source/common/event/timer_impl.h"
+#include "source/common/event/timer_wheel.h"
 #include "source/common/filesystem/watcher_impl.h"
 #include "source/common/network/address_impl.h"
 #include "source/common/network/connection_impl.h"
@@ -38,6 +39,18 @@
 namespace Envoy {
 namespace Event {
 
+namespace {
+
+SchedulerPtr createScheduler(TimeSystem& time_system, LibeventScheduler& base_scheduler) {
+  SchedulerPtr scheduler = time_system.createScheduler(base_scheduler, base_scheduler);
+  if (TimerWheelScheduler::enabled()) {
+    return std::make_unique<TimerWheelScheduler>(std::move(scheduler), time_system);
+  }
+  return scheduler;
+}
+
+} // namespace
+
 DispatcherImpl::DispatcherImpl(const std::string& name, Api::Api& api,
                                Event::TimeSystem& time_system)
     : DispatcherImpl(name, api, time_system, {}) {}
@@ -70,7 +83,7 @@ DispatcherImpl::DispatcherImpl(const std::string& name, Thread::ThreadFactory& t
                                const Buffer::WatermarkFactorySharedPtr& watermark_factory)
     : name_(name), thread_factory_(thread_factory), time_source_(time_source),
       file_system_(file_system), buffer_factory_(watermark_factory),
-      scheduler_(time_system.createScheduler(base_scheduler_, base_scheduler_)),
+      scheduler_(createScheduler(time_system, base_scheduler_)),
       thread_local_delete_cb_(
           base_scheduler_.createSchedulableCallback([this]() -> void { runThreadLocalDelete(); })),
       deferred_delete_cb_(base_scheduler_.createSchedulableCallback(
@@ -80,8 +93,7 @@ DispatcherImpl::DispatcherImpl(const std::string& name, Thread::ThreadFactory& t
   ASSERT(!name_.empty());
   FatalErrorHandler::registerFatalErrorHandler(*this);
   updateApproximateMonotonicTimeInternal();
-  base_scheduler_.registerOnCheckCallback(
-      std::bind(&DispatcherImpl::updateApproximateMonotonicTime, this));
+  base_scheduler_.registerOnCheckCallback([this]() { onPollDone(); });
 }
 
 DispatcherImpl::~DispatcherImpl() {
@@ -107,10 +119,21 @@ void DispatcherImpl::initializeStats(Stats::Scope& scope,
     stats_ = std::make_unique<DispatcherStats>(
         DispatcherStats{ALL_DISPATCHER_STATS(POOL_HISTOGRAM_PREFIX(scope, stats_prefix_ + "."))});
     base_scheduler_.initializeStats(stats_.get());
+    base_scheduler_.registerOnPrepareCallback([this]() { recordLoopCallbackStats(); });
+    record_post_delay_.store(true, std::memory_order_release);
     ENVOY_LOG(debug, "running {} on thread {}", stats_prefix_, run_tid_.debugString());
   });
 }
 
+void DispatcherImpl::enableBusyPoll(const BusyPollConfig& config, Stats::Scope& scope) {
+  // The spin callback must be created in the dispatcher's thread.
+  post([this, config, &scope] {
+    const std::string prefix = absl::StrCat(name_, ".dispatcher.");
+    busy_poller_ = std::make_unique<BusyPoller>(
+        config, BusyPollStats{ALL_BUSY_POLL_STATS(POOL_COUNTER_PREFIX(scope, prefix))}, *this);
+  });
+}
+
 void DispatcherImpl::clearDeferredDeleteList() {
   ASSERT(isThreadSafe());
   std::vector<DeferredDeletablePtr>* to_delete = current_to_delete_;
@@ -131,6 +154,7 @@ void DispatcherImpl::clearDeferredDeleteList() {
   }
 
   touchWatchdog();
+  ScopedCallbackTimer timer(*this, deferred_delete_time_, num_to_delete);
   deferred_deleting_ = true;
 
   // Calling clear() on the vector does not specify which order destructors run in. We want to
@@ -198,6 +222,7 @@ FileEventPtr DispatcherImpl::createFileEvent(os_fd_t fd, FileReadyCb cb, FileTri
   return FileEventPtr{new FileEventImpl(
       *this, fd,
       [this, cb](uint32_t events) {
+        ScopedCallbackTimer timer(*this, file_event_time_);
         touchWatchdog();
         return cb(events);
       },
@@ -235,6 +260,7 @@ Event::SchedulableCallbackPtr DispatcherImpl::createSchedulableCallback(std::fun
 TimerPtr DispatcherImpl::createTimerInternal(TimerCb cb) {
   return scheduler_->createTimer(
       [this, cb]() {
+        ScopedCallbackTimer timer(*this, timer_time_);
         touchWatchdog();
         cb();
       },
@@ -261,14 +287,11 @@ SignalEventPtr DispatcherImpl::listenForSignal(signal_t signal_num, SignalCb cb)
 }
 
 void DispatcherImpl::post(PostCb callback) {
-  bool do_post;
-  {
-    Thread::LockGuard lock(post_lock_);
-    do_post = post_callbacks_.empty();
-    post_callbacks_.push_back(std::move(callback));
+  MonotonicTime posted_time;
+  if (record_post_delay_.load(std::memory_order_acquire)) {
+    posted_time = time_source_.monotonicTime();
   }
-
-  if (do_post) {
+  if (post_callbacks_.push({std::move(callback), posted_time}) == 0) {
     post_cb_->scheduleCallbackCurrentIteration();
   }
 }
@@ -308,11 +331,7 @@ void DispatcherImpl::shutdown() {
   // callbacks and dispatcher thread deletable objects.
   ASSERT(isThreadSafe());
   auto deferred_deletables_size = current_to_delete_->size();
-  std::list<std::function<void()>>::size_type post_callbacks_size;
-  {
-    Thread::LockGuard lock(post_lock_);
-    post_callbacks_size = post_callbacks_.size();
-  }
+  const size_t post_callbacks_size = post_callbacks_.size();
 
   std::list<DispatcherThreadDeletableConstPtr> local_deletables;
   {
@@ -333,6 +352,13 @@ void DispatcherImpl::shutdown() {
 
 void DispatcherImpl::updateApproximateMonotonicTime() { updateApproximateMonotonicTimeInternal(); }
 
+void DispatcherImpl::onPollDone() {
+  updateApproximateMonotonicTimeInternal();
+  if (busy_poller_ != nullptr) {
+    busy_poller_->onPoll(approximate_monotonic_time_, base_scheduler_.hasActiveEvents());
+  }
+}
+
 void DispatcherImpl::updateApproximateMonotonicTimeInternal() {
   approximate_monotonic_time_ = time_source_.monotonicTime();
 }
@@ -358,27 +384,86 @@ void DispatcherImpl::runPostCallbacks() {
   // objects that is being deferred deleted.
   clearDeferredDeleteList();
 
-  std::list<PostCb> callbacks;
-  {
-    // Take ownership of the callbacks under the post_lock_. The lock must be released before
-    // callbacks execute. Callbacks added after this transfer will re-arm post_cb_ and will execute
-    // later in the event loop.
-    Thread::LockGuard lock(post_lock_);
-    callbacks = std::move(post_callbacks_);
-    // post_callbacks_ should be empty after the move.
-    ASSERT(post_callbacks_.empty());
+  // Only run the callbacks posted so far. Callbacks posted while these run, including by the
+  // callbacks themselves, execute later in the event loop.
+  const size_t num_callbacks = post_callbacks_.size();
+  if (stats_ != nullptr) {
+    stats_->post_queue_depth_.recordValue(num_callbacks);
   }
-  // It is important that the execution and deletion of the callback happen while post_lock_ is not
-  // held. Either the invocation or destructor of the callback can call post() on this dispatcher.
-  while (!callbacks.empty()) {
+  // Each callback starts when the previous one ends, so that timing them takes one clock read each.
+  const bool record_stats = stats_ != nullptr;
+  MonotonicTime start_time = record_stats ? time_source_.monotonicTime() : MonotonicTime();
+  size_t num_run = 0;
+  for (; num_run < num_callbacks; ++num_run) {
+    absl::optional<PostedCallback> callback = post_callbacks_.pop();
+    if (!callback.has_value()) {
+      // The remaining callbacks are still being pushed.
+      break;
+    }
+    if (record_stats && callback->posted_time_ != MonotonicTime()) {
+      stats_->post_delay_us_.recordValue(
+          std::chrono::duration_cast<std::chrono::microseconds>(start_time - callback->posted_time_)
+              .count());
+    }
     // Touch the watchdog before executing the callback to avoid spurious watchdog miss events when
     // executing a long list of callbacks.
     touchWatchdog();
-    // Run the callback.
-    callbacks.front()();
-    // Pop the front so that the destructor of the callback that just executed runs before the next
-    // callback executes.
-    callbacks.pop_front();
+    // Run the callback, and destroy it before the next callback executes.
+    callback->callback_();
+    callback.reset();
+    if (record_stats) {
+      const MonotonicTime end_time = time_source_.monotonicTime();
+      post_callback_time_.duration_ += end_time - start_time;
+      post_callback_time_.count_++;
+      start_time = end_time;
+    }
+  }
+
+  // Callbacks which were posted while the queue was not empty did not schedule post_cb_.
+  if (post_callbacks_.size() > 0) {
+    if (num_run == 0) {
+      // Give the producers which have not finished pushing a chance to run.
+      post_cb_->scheduleCallbackNextIteration();
+    } else {
+      post_cb_->scheduleCallbackCurrentIteration();
+    }
+  }
+}
+
+void DispatcherImpl::recordLoopCallbackStats() {
+  const uint32_t num_events = file_event_time_.count_ + timer_time_.count_ +
+                              post_callback_time_.count_ + deferred_delete_time_.count_;
+  if (num_events == 0) {
+    return;
+  }
+  stats_->events_per_loop_.recordValue(num_events);
+  const auto record = [](Stats::Histogram& histogram, LoopCallbackTime& category) {
+    if (category.count_ > 0) {
+      histogram.recordValue(
+          std::chrono::duration_cast<std::chrono::microseconds>(category.duration_).count());
+      category = LoopCallbackTime();
+    }
+  };
+  record(stats_->file_event_us_, file_event_time_);
+  record(stats_->timer_us_, timer_time_);
+  record(stats_->post_callback_us_, post_callback_time_);
+  record(stats_->deferred_delete_us_, deferred_delete_time_);
+}
+
+DispatcherImpl::ScopedCallbackTimer::ScopedCallbackTimer(DispatcherImpl& dispatcher,
+                                                         LoopCallbackTime& category,
+                                                         uint32_t count)
+    : time_source_(dispatcher.stats_ != nullptr ? &dispatcher.time_source_ : nullptr),
+      category_(category), count_(count) {
+  if (time_source_ != nullptr) {
+    start_ = time_source_->monotonicTime();
+  }
+}
+
+DispatcherImpl::ScopedCallbackTimer::~ScopedCallbackTimer() {
+  if (time_source_ != nullptr) {
+    category_.duration_ += time_source_->monotonicTime() - start_;
+    category_.count_ += count_;
   }
 }
 
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <atomic>
+#include <chrono>
 #include <cstdint>
 #include <functional>
 #include <list>
@@ -15,7 +17,9 @@
 #include "envoy/stats/scope.h"
 
 #include "source/common/common/logger.h"
+#include "source/common/common/mpsc_queue.h"
 #include "source/common/common/thread.h"
+#include "source/common/event/busy_poller.h"
 #include "source/common/event/libevent.h"
 #include "source/common/event/libevent_scheduler.h"
 #include "source/common/signal/fatal_error_handler.h"
@@ -61,6 +65,7 @@ public:
                         std::chrono::milliseconds min_touch_interval) override;
   TimeSource& timeSource() override { return time_source_; }
   void initializeStats(Stats::Scope& scope, const absl::optional<std::string>& prefix) override;
+  void enableBusyPoll(const BusyPollConfig& config, Stats::Scope& scope) override;
   void clearDeferredDeleteList() override;
   Network::ServerConnectionPtr
   createServerConnection(Network::ConnectionSocketPtr&& socket,
@@ -125,9 +130,37 @@ private:
   };
   using WatchdogRegistrationPtr = std::unique_ptr<WatchdogRegistration>;
 
+  // A posted callback, with the time it was posted at if post delays are recorded.
+  struct PostedCallback {
+    PostCb callback_;
+    MonotonicTime posted_time_;
+  };
+
+  // The time spent in one category of callbacks in the current event loop iteration.
+  struct LoopCallbackTime {
+    std::chrono::nanoseconds duration_{};
+    uint32_t count_{};
+  };
+
+  // Accounts the lifetime of the timer to a category of callbacks once stats are initialized.
+  class ScopedCallbackTimer {
+  public:
+    ScopedCallbackTimer(DispatcherImpl& dispatcher, LoopCallbackTime& category, uint32_t count = 1);
+    ~ScopedCallbackTimer();
+
+  private:
+    TimeSource* const time_source_;
+    LoopCallbackTime& category_;
+    const uint32_t count_;
+    MonotonicTime start_;
+  };
+
   TimerPtr createTimerInternal(TimerCb cb);
   void updateApproximateMonotonicTimeInternal();
+  void onPollDone();
   void runPostCallbacks();
+  // Records the callback stats of the event loop iteration which just ended.
+  void recordLoopCallbackStats();
   void runThreadLocalDelete();
 
   // Helper used to touch the watchdog after most schedulable, fd, and timer callbacks.
@@ -161,8 +194,14 @@ private:
   SchedulableCallbackPtr deferred_delete_cb_;
 
   SchedulableCallbackPtr post_cb_;
-  Thread::MutexBasicLockable post_lock_;
-  std::list<PostCb> post_callbacks_ ABSL_GUARDED_BY(post_lock_);
+  // Only the post() which finds the queue empty schedules post_cb_.
+  MpscQueue<PostedCallback> post_callbacks_;
+  // Set once stats are initialized, and read by the threads which post callbacks.
+  std::atomic<bool> record_post_delay_{false};
+  LoopCallbackTime file_event_time_;
+  LoopCallbackTime timer_time_;
+  LoopCallbackTime post_callback_time_;
+  LoopCallbackTime deferred_delete_time_;
 
   std::vector<DeferredDeletablePtr> to_delete_1_;
   std::vector<DeferredDeletablePtr> to_delete_2_;
@@ -173,6 +212,7 @@ private:
   bool deferred_deleting_{};
   MonotonicTime approximate_monotonic_time_;
   WatchdogRegistrationPtr watchdog_registration_;
+  BusyPollerPtr busy_poller_;
   const ScaledRangeTimerManagerPtr scaled_timer_manager_;
 };
 
@@ -63,6 +63,10 @@ void LibeventScheduler::run(Dispatcher::RunType mode) {
 
 void LibeventScheduler::loopExit() { event_base_loopexit(libevent_.get(), nullptr); }
 
+bool LibeventScheduler::hasActiveEvents() {
+  return event_base_get_num_events(libevent_.get(), EVENT_BASE_COUNT_ACTIVE) > 0;
+}
+
 void LibeventScheduler::registerOnPrepareCallback(OnPrepareCallback&& callback) {
   ASSERT(callback);
   ASSERT(!prepare_callback_);
@@ -87,6 +87,12 @@ public:
    */
   event_base& base() { return *libevent_; }
 
+  /**
+   * @return whether any events are active. Right after polling, in the "check" callback, this is
+   *         whether the poll found events.
+   */
+  bool hasActiveEvents();
+
   /**
    * Register callback to be called in the event loop prior to polling for
    * events. Must not be called more than once. |callback| must not be null.
@@ -0,0 +1,294 @@
+#include "source/common/event/timer_wheel.h"
+
+#include <algorithm>
+
+#include "source/common/common/assert.h"
+#include "source/common/common/scope_tracker.h"
+
+#include "absl/numeric/bits.h"
+
+namespace Envoy {
+namespace Event {
+
+std::atomic<bool> TimerWheelScheduler::enabled_{false};
+
+namespace {
+
+constexpr uint64_t SlotMask = TimerWheelScheduler::NumSlots - 1;
+constexpr uint64_t MicrosecondsPerTick = 1000;
+// Longer timeouts are clipped, matching TimerUtils::durationToTimeval().
+constexpr int64_t MaxTimeoutMs = int64_t{INT32_MAX} * 1000;
+
+constexpr uint32_t levelShift(uint32_t level) { return level * TimerWheelScheduler::SlotBits; }
+
+// Returns the index of the first bit set in [from, to), or `to` if there is none.
+template <class Bitmap> uint32_t findSetBit(const Bitmap& bitmap, uint32_t from, uint32_t to) {
+  while (from < to) {
+    const uint64_t word = bitmap[from / 64] >> (from % 64);
+    if (word != 0) {
+      return std::min<uint32_t>(from + absl::countr_zero(word), to);
+    }
+    from = (from / 64 + 1) * 64;
+  }
+  return to;
+}
+
+} // namespace
+
+void TimerWheelList::pushBack(WheelTimerImpl& timer) {
+  ASSERT(timer.list_ == nullptr);
+  timer.list_ = this;
+  timer.prev_ = tail_;
+  timer.next_ = nullptr;
+  if (tail_ != nullptr) {
+    tail_->next_ = &timer;
+  } else {
+    head_ = &timer;
+  }
+  tail_ = &timer;
+}
+
+void TimerWheelList::remove(WheelTimerImpl& timer) {
+  ASSERT(timer.list_ == this);
+  if (timer.prev_ != nullptr) {
+    timer.prev_->next_ = timer.next_;
+  } else {
+    head_ = timer.next_;
+  }
+  if (timer.next_ != nullptr) {
+    timer.next_->prev_ = timer.prev_;
+  } else {
+    tail_ = timer.prev_;
+  }
+  timer.list_ = nullptr;
+  timer.prev_ = nullptr;
+  timer.next_ = nullptr;
+}
+
+WheelTimerImpl* TimerWheelList::popFront() {
+  WheelTimerImpl* timer = head_;
+  if (timer != nullptr) {
+    remove(*timer);
+  }
+  return timer;
+}
+
+WheelTimerImpl::WheelTimerImpl(TimerWheelScheduler& wheel, const TimerCb& cb,
+                               Dispatcher& dispatcher)
+    : wheel_(wheel), cb_(cb), dispatcher_(dispatcher) {
+  ASSERT(cb_);
+}
+
+WheelTimerImpl::~WheelTimerImpl() {
+  if (list_ != nullptr) {
+    wheel_.remove(*this);
+  }
+}
+
+void WheelTimerImpl::disableTimer() {
+  ASSERT(dispatcher_.isThreadSafe());
+  if (list_ != nullptr) {
+    wheel_.remove(*this);
+  }
+  if (fallback_timer_ != nullptr) {
+    fallback_timer_->disableTimer();
+  }
+}
+
+void WheelTimerImpl::enableTimer(std::chrono::milliseconds d, const ScopeTrackedObject* object) {
+  if (d.count() <= 0) {
+    // Zero timeouts must fire in the next event loop iteration rather than on the next tick, and
+    // negative ones are reported by the fallback timer.
+    enableHRTimer(d, object);
+    return;
+  }
+  ASSERT(dispatcher_.isThreadSafe());
+  if (fallback_timer_ != nullptr) {
+    fallback_timer_->disableTimer();
+  }
+  if (list_ != nullptr) {
+    wheel_.remove(*this);
+  }
+  object_ = object;
+  wheel_.schedule(*this, wheel_.deadlineTick(d), dispatcher_);
+}
+
+void WheelTimerImpl::enableHRTimer(std::chrono::microseconds d,
+                                   const ScopeTrackedObject* object) {
+  ASSERT(dispatcher_.isThreadSafe());
+  if (list_ != nullptr) {
+    wheel_.remove(*this);
+  }
+  if (fallback_timer_ == nullptr) {
+    fallback_timer_ = wheel_.base_scheduler_->createTimer([this]() { cb_(); }, dispatcher_);
+  }
+  fallback_timer_->enableHRTimer(d, object);
+}
+
+bool WheelTimerImpl::enabled() {
+  ASSERT(dispatcher_.isThreadSafe());
+  return list_ != nullptr || (fallback_timer_ != nullptr && fallback_timer_->enabled());
+}
+
+void WheelTimerImpl::fire() {
+  if (object_ == nullptr) {
+    cb_();
+    return;
+  }
+  ScopeTrackerScopeState scope(object_, dispatcher_);
+  object_ = nullptr;
+  cb_();
+}
+
+TimerWheelScheduler::TimerWheelScheduler(SchedulerPtr&& base_scheduler, TimeSource& time_source)
+    : base_scheduler_(std::move(base_scheduler)), time_source_(time_source),
+      start_(time_source_.monotonicTime()) {}
+
+TimerWheelScheduler::~TimerWheelScheduler() {
+  // Timers must be freed before the dispatcher, and so before the wheel.
+  ASSERT(size_ == 0 && ready_.empty());
+}
+
+TimerPtr TimerWheelScheduler::createTimer(const TimerCb& cb, Dispatcher& dispatcher) {
+  return std::make_unique<WheelTimerImpl>(*this, cb, dispatcher);
+}
+
+uint64_t TimerWheelScheduler::elapsedMicroseconds() const {
+  return std::chrono::duration_cast<std::chrono::microseconds>(time_source_.monotonicTime() -
+                                                               start_)
+      .count();
+}
+
+uint64_t TimerWheelScheduler::deadlineTick(std::chrono::milliseconds d) const {
+  const uint64_t deadline_us =
+      elapsedMicroseconds() + std::min<int64_t>(d.count(), MaxTimeoutMs) * MicrosecondsPerTick;
+  // Round up, so that timers never fire early.
+  return (deadline_us + MicrosecondsPerTick - 1) / MicrosecondsPerTick;
+}
+
+void TimerWheelScheduler::schedule(WheelTimerImpl& timer, uint64_t deadline,
+                                   Dispatcher& dispatcher) {
+  timer.deadline_ = std::max(deadline, current_tick_ + 1);
+  insert(timer);
+  if (tick_timer_ == nullptr) {
+    tick_timer_ = base_scheduler_->createTimer([this]() { onTick(); }, dispatcher);
+  }
+  // Removing timers never re-arms the tick timer; it may fire early with nothing to do.
+  const uint64_t due = nextDueTick();
+  if (due < armed_tick_) {
+    armTickTimer(due);
+  }
+}
+
+void TimerWheelScheduler::insert(WheelTimerImpl& timer) {
+  ASSERT(timer.deadline_ >= current_tick_);
+  uint32_t level = 0;
+  uint64_t slot_tick = timer.deadline_ >> levelShift(level);
+  // A timer goes in the lowest level whose span covers its deadline. Timers beyond the span of the
+  // whole wheel go in the last slot of the top level, and are placed again when it cascades.
+  while ((slot_tick - (current_tick_ >> levelShift(level))) >= NumSlots) {
+    if (level == NumLevels - 1) {
+      slot_tick = (current_tick_ >> levelShift(level)) + NumSlots - 1;
+      break;
+    }
+    ++level;
+    slot_tick = timer.deadline_ >> levelShift(level);
+  }
+  const uint32_t slot = slot_tick & SlotMask;
+  timer.level_ = level;
+  timer.slot_ = slot;
+  slots_[level][slot].pushBack(timer);
+  occupied_[level][slot / 64] |= uint64_t{1} << (slot % 64);
+  ++size_;
+}
+
+void TimerWheelScheduler::remove(WheelTimerImpl& timer) {
+  TimerWheelList* list = timer.list_;
+  list->remove(timer);
+  if (list == &ready_) {
+    return;
+  }
+  --size_;
+  if (list->empty()) {
+    clearOccupied(timer.level_, timer.slot_);
+  }
+}
+
+void TimerWheelScheduler::clearOccupied(uint32_t level, uint32_t slot) {
+  occupied_[level][slot / 64] &= ~(uint64_t{1} << (slot % 64));
+}
+
+void TimerWheelScheduler::onTick() {
+  armed_tick_ = UINT64_MAX;
+  const uint64_t now = elapsedMicroseconds() / MicrosecondsPerTick;
+  for (uint64_t due = nextDueTick(); due <= now; due = nextDueTick()) {
+    current_tick_ = due;
+    processTick(due);
+  }
+  current_tick_ = std::max(current_tick_, now);
+
+  // Callbacks may enable, disable or destroy any timer, including the ones in ready_.
+  while (WheelTimerImpl* timer = ready_.popFront()) {
+    timer->fire();
+  }
+
+  const uint64_t due = nextDueTick();
+  if (due != UINT64_MAX && due < armed_tick_) {
+    armTickTimer(due);
+  }
+}
+
+void TimerWheelScheduler::processTick(uint64_t tick) {
+  // Cascade from the top, so that timers moved down land in a slot which is cascaded next.
+  for (uint32_t level = NumLevels - 1; level > 0; --level) {
+    if ((tick & ((uint64_t{1} << levelShift(level)) - 1)) != 0) {
+      continue;
+    }
+    const uint32_t slot = (tick >> levelShift(level)) & SlotMask;
+    TimerWheelList& list = slots_[level][slot];
+    while (WheelTimerImpl* timer = list.popFront()) {
+      --size_;
+      insert(*timer);
+    }
+    clearOccupied(level, slot);
+  }
+
+  const uint32_t slot = tick & SlotMask;
+  TimerWheelList& list = slots_[0][slot];
+  while (WheelTimerImpl* timer = list.popFront()) {
+    ASSERT(timer->deadline_ == tick);
+    --size_;
+    ready_.pushBack(*timer);
+  }
+  clearOccupied(0, slot);
+}
+
+uint64_t TimerWheelScheduler::nextDueTick() const {
+  uint64_t due = UINT64_MAX;
+  for (uint32_t level = 0; level < NumLevels; ++level) {
+    const uint64_t base = current_tick_ >> levelShift(level);
+    const uint32_t current = base & SlotMask;
+    // Slots after the current one are due in this rotation, and slots up to it in the next one.
+    uint32_t slot = findSetBit(occupied_[level], current + 1, NumSlots);
+    if (slot == NumSlots) {
+      slot = findSetBit(occupied_[level], 0, current + 1);
+      if (slot == current + 1) {
+        continue;
+      }
+    }
+    const uint64_t distance = (slot - current) & SlotMask;
+    due = std::min(due, (base + (distance == 0 ? NumSlots : distance)) << levelShift(level));
+  }
+  return due;
+}
+
+void TimerWheelScheduler::armTickTimer(uint64_t tick) {
+  armed_tick_ = tick;
+  const uint64_t deadline_us = tick * MicrosecondsPerTick;
+  const uint64_t elapsed_us = elapsedMicroseconds();
+  tick_timer_->enableHRTimer(
+      std::chrono::microseconds(deadline_us > elapsed_us ? deadline_us - elapsed_us : 0));
+}
+
+} // namespace Event
+} // namespace Envoy
@@ -0,0 +1,154 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#include "envoy/common/time.h"
+#include "envoy/event/dispatcher.h"
+#include "envoy/event/timer.h"
+
+#include "source/common/common/non_copyable.h"
+
+namespace Envoy {
+namespace Event {
+
+class TimerWheelScheduler;
+class WheelTimerImpl;
+
+/**
+ * Intrusive FIFO list of wheel timers, used for the wheel slots.
+ */
+class TimerWheelList : NonCopyable {
+public:
+  bool empty() const { return head_ == nullptr; }
+  void pushBack(WheelTimerImpl& timer);
+  void remove(WheelTimerImpl& timer);
+  WheelTimerImpl* popFront();
+
+private:
+  WheelTimerImpl* head_{};
+  WheelTimerImpl* tail_{};
+};
+
+/**
+ * Timer managed by a TimerWheelScheduler. Millisecond timeouts are kept in the wheel; high
+ * resolution and zero timeouts are delegated to a timer of the wrapped scheduler, which is created
+ * on first use.
+ */
+class WheelTimerImpl : public Timer {
+public:
+  WheelTimerImpl(TimerWheelScheduler& wheel, const TimerCb& cb, Dispatcher& dispatcher);
+  ~WheelTimerImpl() override;
+
+  // Timer
+  void disableTimer() override;
+  void enableTimer(std::chrono::milliseconds d, const ScopeTrackedObject* object) override;
+  void enableHRTimer(std::chrono::microseconds d, const ScopeTrackedObject* object) override;
+  bool enabled() override;
+
+private:
+  friend class TimerWheelList;
+  friend class TimerWheelScheduler;
+
+  void fire();
+
+  TimerWheelScheduler& wheel_;
+  TimerCb cb_;
+  Dispatcher& dispatcher_;
+  const ScopeTrackedObject* object_{};
+  // Absolute expiry, in wheel ticks.
+  uint64_t deadline_{};
+  // The list holding this timer while it is armed in the wheel, and its position in the wheel.
+  TimerWheelList* list_{};
+  uint32_t level_{};
+  uint32_t slot_{};
+  WheelTimerImpl* prev_{};
+  WheelTimerImpl* next_{};
+  TimerPtr fallback_timer_;
+};
+
+/**
+ * Scheduler which keeps millisecond timers in a hierarchical timing wheel, rather than in
+ * libevent's timer min-heap. The wheel has NumLevels levels of NumSlots slots each; a slot of level
+ * L spans NumSlots^L ticks of 1ms. Arming, re-arming and disabling a timer are constant time list
+ * operations, and timers which expire in the same tick share a slot, which suits the many idle and
+ * stream timeouts of a large number of mostly-idle connections. Timers in the upper levels are
+ * moved down a level ("cascaded") when the lower levels wrap around to their slot.
+ *
+ * The wheel drives itself with a single high resolution timer of the wrapped scheduler, armed for
+ * the next tick which has timers to expire or cascade. Timers therefore fire at the same point of
+ * the event loop as libevent timers, with deadlines rounded up to the next millisecond.
+ *
+ * Dispatchers created after configure(true) use the wheel.
+ */
+class TimerWheelScheduler : public Scheduler {
+public:
+  static constexpr uint32_t SlotBits = 8;
+  static constexpr uint32_t NumSlots = 1 << SlotBits;
+  static constexpr uint32_t NumLevels = 4;
+
+  /**
+   * @param base_scheduler the scheduler used for the wheel's own timer and for high resolution
+   *        timers.
+   * @param time_source the time source matching base_scheduler.
+   */
+  TimerWheelScheduler(SchedulerPtr&& base_scheduler, TimeSource& time_source);
+  ~TimerWheelScheduler() override;
+
+  /**
+   * Select the scheduler for dispatchers created from now on, for the whole process. This should
+   * be called during server startup before the workers are created.
+   */
+  static void configure(bool enabled) { enabled_.store(enabled, std::memory_order_relaxed); }
+
+  /**
+   * @return whether new dispatchers use the wheel.
+   */
+  static bool enabled() { return enabled_.load(std::memory_order_relaxed); }
+
+  // Scheduler
+  TimerPtr createTimer(const TimerCb& cb, Dispatcher& dispatcher) override;
+
+  /**
+   * @return the number of timers armed in the wheel.
+   */
+  uint64_t size() const { return size_; }
+
+private:
+  friend class WheelTimerImpl;
+
+  using SlotBitmap = std::array<uint64_t, NumSlots / 64>;
+
+  uint64_t elapsedMicroseconds() const;
+  uint64_t deadlineTick(std::chrono::milliseconds d) const;
+  void schedule(WheelTimerImpl& timer, uint64_t deadline, Dispatcher& dispatcher);
+  void insert(WheelTimerImpl& timer);
+  void remove(WheelTimerImpl& timer);
+  void clearOccupied(uint32_t level, uint32_t slot);
+  void onTick();
+  void processTick(uint64_t tick);
+  // Returns the next tick at which a timer expires or cascades, or UINT64_MAX if the wheel is
+  // empty.
+  uint64_t nextDueTick() const;
+  void armTickTimer(uint64_t tick);
+
+  static std::atomic<bool> enabled_;
+
+  const SchedulerPtr base_scheduler_;
+  TimeSource& time_source_;
+  const MonotonicTime start_;
+  TimerPtr tick_timer_;
+  uint64_t armed_tick_{UINT64_MAX};
+  // All ticks up to and including this one have been processed.
+  uint64_t current_tick_{0};
+  uint64_t size_{0};
+  std::array<std::array<TimerWheelList, NumSlots>, NumLevels> slots_;
+  std::array<SlotBitmap, NumLevels> occupied_{};
+  // Timers which have expired, and whose callbacks are about to run.
+  TimerWheelList ready_;
+};
+
+} // namespace Event
+} // namespace Envoy
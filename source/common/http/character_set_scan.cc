@@ -0,0 +1,200 @@
+#include "source/common/http/character_set_scan.h"
+
+#include <array>
+#include <cstdint>
+
+#include "source/common/http/character_set_validation.h"
+
+#if defined(__x86_64__) && !defined(_MSC_VER)
+#define ENVOY_CHARACTER_SET_SCAN_X86 1
+#include <immintrin.h>
+#endif
+
+namespace Envoy {
+namespace Http {
+
+namespace {
+
+size_t scalarFind(const std::array<uint32_t, 8>& table, const char* data, size_t begin,
+                  size_t size) {
+  for (size_t i = begin; i < size; ++i) {
+    if (!testCharInTable(table, data[i])) {
+      return i;
+    }
+  }
+  return absl::string_view::npos;
+}
+
+size_t scalarFindCrOrLf(const char* data, size_t begin, size_t size) {
+  for (size_t i = begin; i < size; ++i) {
+    if (data[i] == '\r' || data[i] == '\n') {
+      return i;
+    }
+  }
+  return absl::string_view::npos;
+}
+
+#ifdef ENVOY_CHARACTER_SET_SCAN_X86
+
+// Nibble lookup tables for testing bytes against a set of ASCII characters with two shuffles, after
+// Wojciech Muła's SIMD byte lookup. Bit h of the low nibble entry l is set if the character
+// (h << 4) | l is in the set, and the high nibble entry h is the bit h for ASCII and 0 otherwise,
+// so that a byte is in the set iff the AND of its two entries is not 0.
+struct NibbleTables {
+  std::array<uint8_t, 16> low_;
+  std::array<uint8_t, 16> high_;
+};
+
+constexpr NibbleTables buildNibbleTables(const std::array<uint32_t, 8>& table) {
+  NibbleTables tables{};
+  for (int high = 0; high < 8; ++high) {
+    tables.high_[high] = static_cast<uint8_t>(1 << high);
+    for (int low = 0; low < 16; ++low) {
+      if (testCharInTable(table, static_cast<char>((high << 4) | low))) {
+        tables.low_[low] |= static_cast<uint8_t>(1 << high);
+      }
+    }
+  }
+  return tables;
+}
+
+constexpr NibbleTables kHeaderNameNibbleTables = buildNibbleTables(kGenericHeaderNameCharTable);
+
+// Only consulted after static initialization. Scans which run before it use SSE2, which every
+// x86-64 CPU supports.
+const bool kHasAvx2 = []() {
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("avx2") != 0;
+}();
+
+__attribute__((target("avx2"))) __m256i broadcastTable(const std::array<uint8_t, 16>& table) {
+  return _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&table)));
+}
+
+__attribute__((target("avx2"))) size_t avx2FindInvalidHeaderNameChar(const char* data,
+                                                                      size_t size) {
+  const __m256i low_table = broadcastTable(kHeaderNameNibbleTables.low_);
+  const __m256i high_table = broadcastTable(kHeaderNameNibbleTables.high_);
+  const __m256i low_nibble_mask = _mm256_set1_epi8(0x0f);
+  size_t i = 0;
+  for (; i + 32 <= size; i += 32) {
+    const __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+    const __m256i low = _mm256_shuffle_epi8(low_table, _mm256_and_si256(bytes, low_nibble_mask));
+    const __m256i high = _mm256_shuffle_epi8(
+        high_table, _mm256_and_si256(_mm256_srli_epi16(bytes, 4), low_nibble_mask));
+    const __m256i invalid = _mm256_cmpeq_epi8(_mm256_and_si256(low, high), _mm256_setzero_si256());
+    const uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(invalid));
+    if (mask != 0) {
+      return i + __builtin_ctz(mask);
+    }
+  }
+  return scalarFind(kGenericHeaderNameCharTable, data, i, size);
+}
+
+__attribute__((target("avx2"))) size_t avx2FindInvalidHeaderValueChar(const char* data,
+                                                                       size_t size) {
+  const __m256i control_max = _mm256_set1_epi8(0x1f);
+  const __m256i tab = _mm256_set1_epi8('\t');
+  const __m256i del = _mm256_set1_epi8(0x7f);
+  size_t i = 0;
+  for (; i + 32 <= size; i += 32) {
+    const __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+    // Unsigned bytes <= 0x1f are control characters.
+    const __m256i control = _mm256_cmpeq_epi8(_mm256_max_epu8(bytes, control_max), control_max);
+    const __m256i invalid =
+        _mm256_or_si256(_mm256_andnot_si256(_mm256_cmpeq_epi8(bytes, tab), control),
+                        _mm256_cmpeq_epi8(bytes, del));
+    const uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(invalid));
+    if (mask != 0) {
+      return i + __builtin_ctz(mask);
+    }
+  }
+  return scalarFind(kHeaderValueCharTable, data, i, size);
+}
+
+__attribute__((target("avx2"))) size_t avx2FindCrOrLf(const char* data, size_t size) {
+  const __m256i cr = _mm256_set1_epi8('\r');
+  const __m256i lf = _mm256_set1_epi8('\n');
+  size_t i = 0;
+  for (; i + 32 <= size; i += 32) {
+    const __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+    const __m256i found =
+        _mm256_or_si256(_mm256_cmpeq_epi8(bytes, cr), _mm256_cmpeq_epi8(bytes, lf));
+    const uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(found));
+    if (mask != 0) {
+      return i + __builtin_ctz(mask);
+    }
+  }
+  return scalarFindCrOrLf(data, i, size);
+}
+
+size_t sse2FindInvalidHeaderValueChar(const char* data, size_t size) {
+  const __m128i control_max = _mm_set1_epi8(0x1f);
+  const __m128i tab = _mm_set1_epi8('\t');
+  const __m128i del = _mm_set1_epi8(0x7f);
+  size_t i = 0;
+  for (; i + 16 <= size; i += 16) {
+    const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+    const __m128i control = _mm_cmpeq_epi8(_mm_max_epu8(bytes, control_max), control_max);
+    const __m128i invalid = _mm_or_si128(_mm_andnot_si128(_mm_cmpeq_epi8(bytes, tab), control),
+                                         _mm_cmpeq_epi8(bytes, del));
+    const uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(invalid));
+    if (mask != 0) {
+      return i + __builtin_ctz(mask);
+    }
+  }
+  return scalarFind(kHeaderValueCharTable, data, i, size);
+}
+
+size_t sse2FindCrOrLf(const char* data, size_t size) {
+  const __m128i cr = _mm_set1_epi8('\r');
+  const __m128i lf = _mm_set1_epi8('\n');
+  size_t i = 0;
+  for (; i + 16 <= size; i += 16) {
+    const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+    const __m128i found = _mm_or_si128(_mm_cmpeq_epi8(bytes, cr), _mm_cmpeq_epi8(bytes, lf));
+    const uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(found));
+    if (mask != 0) {
+      return i + __builtin_ctz(mask);
+    }
+  }
+  return scalarFindCrOrLf(data, i, size);
+}
+
+#endif
+
+} // namespace
+
+size_t findInvalidHeaderNameChar(absl::string_view name) {
+#ifdef ENVOY_CHARACTER_SET_SCAN_X86
+  if (kHasAvx2) {
+    return avx2FindInvalidHeaderNameChar(name.data(), name.size());
+  }
+#endif
+  return scalarFind(kGenericHeaderNameCharTable, name.data(), 0, name.size());
+}
+
+size_t findInvalidHeaderValueChar(absl::string_view value) {
+#ifdef ENVOY_CHARACTER_SET_SCAN_X86
+  if (kHasAvx2) {
+    return avx2FindInvalidHeaderValueChar(value.data(), value.size());
+  }
+  return sse2FindInvalidHeaderValueChar(value.data(), value.size());
+#else
+  return scalarFind(kHeaderValueCharTable, value.data(), 0, value.size());
+#endif
+}
+
+size_t findCrOrLf(absl::string_view value) {
+#ifdef ENVOY_CHARACTER_SET_SCAN_X86
+  if (kHasAvx2) {
+    return avx2FindCrOrLf(value.data(), value.size());
+  }
+  return sse2FindCrOrLf(value.data(), value.size());
+#else
+  return scalarFindCrOrLf(value.data(), 0, value.size());
+#endif
+}
+
+} // namespace Http
+} // namespace Envoy
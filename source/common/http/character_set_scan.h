@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstddef>
+
+#include "absl/strings/string_view.h"
+
+// Vectorized scans of HTTP/1 header names and values. On x86-64 the scans use AVX2 when the CPU
+// supports it and SSE2 otherwise, and fall back to the lookup tables of
+// character_set_validation.h on other platforms and for the bytes which do not fill a vector.
+
+namespace Envoy {
+namespace Http {
+
+/**
+ * @return the offset of the first byte of name which is not a tchar of RFC 9110, or
+ *         absl::string_view::npos if all bytes are. @see kGenericHeaderNameCharTable.
+ */
+size_t findInvalidHeaderNameChar(absl::string_view name);
+
+/**
+ * @return the offset of the first byte of value which is neither HTAB, SP, VCHAR nor obs-text, or
+ *         absl::string_view::npos if there is none. @see kHeaderValueCharTable.
+ */
+size_t findInvalidHeaderValueChar(absl::string_view value);
+
+/**
+ * @return the offset of the first CR or LF in value, or absl::string_view::npos if there is none.
+ */
+size_t findCrOrLf(absl::string_view value);
+
+} // namespace Http
+} // namespace Envoy
@@ -49,6 +49,32 @@ inline constexpr std::array<uint32_t, 8> kGenericHeaderNameCharTable = {
     0b00000000000000000000000000000000,
 };
 
+// Header value character table.
+// From RFC 9110, https://www.rfc-editor.org/rfc/rfc9110.html#section-5.5:
+//
+// SPELLCHECKER(off)
+// field-value    = *field-content
+// field-content  = field-vchar
+//                  [ 1*( SP / HTAB / field-vchar ) field-vchar ]
+// field-vchar    = VCHAR / obs-text
+// obs-text       = %x80-FF
+// SPELLCHECKER(on)
+inline constexpr std::array<uint32_t, 8> kHeaderValueCharTable = {
+    // control characters, of which only HTAB is allowed
+    0b00000000010000000000000000000000,
+    // !"#$%&'()*+,-./0123456789:;<=>?
+    0b11111111111111111111111111111111,
+    //@ABCDEFGHIJKLMNOPQRSTUVWXYZ[\]^_
+    0b11111111111111111111111111111111,
+    //`abcdefghijklmnopqrstuvwxyz{|}~
+    0b11111111111111111111111111111110,
+    // obs-text
+    0b11111111111111111111111111111111,
+    0b11111111111111111111111111111111,
+    0b11111111111111111111111111111111,
+    0b11111111111111111111111111111111,
+};
+
 // A URI query and fragment character table. From RFC 3986:
 // https://datatracker.ietf.org/doc/html/rfc3986#section-3.4
 //
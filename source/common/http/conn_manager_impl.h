@@ -39,6 +39,7 @@
 #include "source/common/buffer/watermark_buffer.h"
 #include "source/common/common/dump_state_utils.h"
 #include "source/common/common/linked_object.h"
+#include "source/common/event/deferred_delete_pool.h"
 #include "source/common/grpc/common.h"
 #include "source/common/http/conn_manager_config.h"
 #include "source/common/http/filter_manager.h"
@@ -144,6 +145,7 @@ private:
    */
   struct ActiveStream final : LinkedObject<ActiveStream>,
                               public Event::DeferredDeletable,
+                              public Event::PooledDeferredDeletable<ActiveStream>,
                               public StreamCallbacks,
                               public CodecEventCallbacks,
                               public RequestDecoder,
@@ -155,6 +157,9 @@ private:
     ActiveStream(ConnectionManagerImpl& connection_manager, uint32_t buffer_limit,
                  Buffer::BufferMemoryAccountSharedPtr account);
 
+    // Event::PooledDeferredDeletable
+    static constexpr absl::string_view DeferredDeletePoolName = "http_active_stream";
+
     // Event::DeferredDeletable
     void deleteIsPending() override {
       // The stream should not be accessed once deferred delete has been called.
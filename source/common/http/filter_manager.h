@@ -14,6 +14,7 @@
 #include "envoy/protobuf/message_validator.h"
 
 #include "source/common/buffer/watermark_buffer.h"
+#include "source/common/common/arena.h"
 #include "source/common/common/dump_state_utils.h"
 #include "source/common/common/linked_object.h"
 #include "source/common/common/logger.h"
@@ -37,8 +38,8 @@ class DownstreamFilterManager;
 struct ActiveStreamFilterBase;
 struct ActiveStreamDecoderFilter;
 struct ActiveStreamEncoderFilter;
-using ActiveStreamDecoderFilterPtr = std::unique_ptr<ActiveStreamDecoderFilter>;
-using ActiveStreamEncoderFilterPtr = std::unique_ptr<ActiveStreamEncoderFilter>;
+using ActiveStreamDecoderFilterPtr = ArenaPtr<ActiveStreamDecoderFilter>;
+using ActiveStreamEncoderFilterPtr = ArenaPtr<ActiveStreamEncoderFilter>;
 
 constexpr absl::string_view LocalReplyFilterStateKey =
     "envoy.filters.network.http_connection_manager.local_reply_owner";
@@ -72,12 +73,17 @@ private:
 // The decoder filter chain will iterate through filters A, B, C.
 struct StreamDecoderFilters {
   using Element = ActiveStreamDecoderFilter;
-  using Iterator = std::vector<ActiveStreamDecoderFilterPtr>::iterator;
+  using Entries =
+      std::vector<ActiveStreamDecoderFilterPtr, ArenaAllocator<ActiveStreamDecoderFilterPtr>>;
+  using Iterator = Entries::iterator;
+
+  explicit StreamDecoderFilters(Arena* arena)
+      : entries_(ArenaAllocator<ActiveStreamDecoderFilterPtr>(arena)) {}
 
   Iterator begin() { return entries_.begin(); }
   Iterator end() { return entries_.end(); }
 
-  std::vector<ActiveStreamDecoderFilterPtr> entries_;
+  Entries entries_;
 };
 
 // HTTP encoder filters. If filters are configured in the following order (assume all three
@@ -91,12 +97,17 @@ struct StreamDecoderFilters {
 // here.
 struct StreamEncoderFilters {
   using Element = ActiveStreamEncoderFilter;
-  using Iterator = std::vector<ActiveStreamEncoderFilterPtr>::reverse_iterator;
+  using Entries =
+      std::vector<ActiveStreamEncoderFilterPtr, ArenaAllocator<ActiveStreamEncoderFilterPtr>>;
+  using Iterator = Entries::reverse_iterator;
+
+  explicit StreamEncoderFilters(Arena* arena)
+      : entries_(ArenaAllocator<ActiveStreamEncoderFilterPtr>(arena)) {}
 
   Iterator begin() { return entries_.rbegin(); }
   Iterator end() { return entries_.rend(); }
 
-  std::vector<ActiveStreamEncoderFilterPtr> entries_;
+  Entries entries_;
 };
 
 /**
@@ -684,7 +695,12 @@ public:
                 uint64_t buffer_limit)
       : filter_manager_callbacks_(filter_manager_callbacks), dispatcher_(dispatcher),
         connection_(connection), stream_id_(stream_id), account_(std::move(account)),
-        proxy_100_continue_(proxy_100_continue), buffer_limit_(buffer_limit) {}
+        proxy_100_continue_(proxy_100_continue),
+        arena_(Runtime::runtimeFeatureEnabled("envoy.reloadable_features.http_stream_arena")
+                   ? absl::optional<Arena>(absl::in_place)
+                   : absl::optional<Arena>()),
+        decoder_filters_(mutableArena()), encoder_filters_(mutableArena()),
+        filters_(ArenaAllocator<StreamFilterBase*>(mutableArena())), buffer_limit_(buffer_limit) {}
 
   ~FilterManager() override {
     ASSERT(state_.destroyed_);
@@ -716,6 +732,13 @@ public:
 
   const AccessLog::InstanceSharedPtrVector& accessLogHandlers() { return access_log_handlers_; }
 
+  /**
+   * @return the arena which backs the filter wrappers and filter lists of the stream, or nullptr
+   *         if the envoy.reloadable_features.http_stream_arena runtime feature was disabled when
+   *         the stream was created.
+   */
+  const Arena* arena() const { return arena_.has_value() ? &arena_.value() : nullptr; }
+
   void onStreamComplete() {
     for (auto filter : filters_) {
       filter->onStreamComplete();
@@ -986,24 +1009,24 @@ private:
     void addStreamDecoderFilter(Http::StreamDecoderFilterSharedPtr filter) override {
       manager_.filters_.push_back(filter.get());
 
-      manager_.decoder_filters_.entries_.emplace_back(std::make_unique<ActiveStreamDecoderFilter>(
-          manager_, std::move(filter), filter_config_name_));
+      manager_.decoder_filters_.entries_.emplace_back(makeArenaPtr<ActiveStreamDecoderFilter>(
+          manager_.mutableArena(), manager_, std::move(filter), filter_config_name_));
     }
 
     void addStreamEncoderFilter(Http::StreamEncoderFilterSharedPtr filter) override {
       manager_.filters_.push_back(filter.get());
 
-      manager_.encoder_filters_.entries_.emplace_back(std::make_unique<ActiveStreamEncoderFilter>(
-          manager_, std::move(filter), filter_config_name_));
+      manager_.encoder_filters_.entries_.emplace_back(makeArenaPtr<ActiveStreamEncoderFilter>(
+          manager_.mutableArena(), manager_, std::move(filter), filter_config_name_));
     }
 
     void addStreamFilter(Http::StreamFilterSharedPtr filter) override {
       manager_.filters_.push_back(filter.get());
 
-      manager_.decoder_filters_.entries_.emplace_back(
-          std::make_unique<ActiveStreamDecoderFilter>(manager_, filter, filter_config_name_));
-      manager_.encoder_filters_.entries_.emplace_back(std::make_unique<ActiveStreamEncoderFilter>(
-          manager_, std::move(filter), filter_config_name_));
+      manager_.decoder_filters_.entries_.emplace_back(makeArenaPtr<ActiveStreamDecoderFilter>(
+          manager_.mutableArena(), manager_, filter, filter_config_name_));
+      manager_.encoder_filters_.entries_.emplace_back(makeArenaPtr<ActiveStreamEncoderFilter>(
+          manager_.mutableArena(), manager_, std::move(filter), filter_config_name_));
     }
 
     void addAccessLogHandler(AccessLog::InstanceSharedPtr handler) override {
@@ -1105,6 +1128,8 @@ private:
 
   bool isTerminalDecoderFilter(const ActiveStreamDecoderFilter& filter) const;
 
+  Arena* mutableArena() { return arena_.has_value() ? &arena_.value() : nullptr; }
+
   FilterManagerCallbacks& filter_manager_callbacks_;
   Event::Dispatcher& dispatcher_;
   // This is unset if there is no downstream connection, e.g. for health check or
@@ -1114,9 +1139,11 @@ private:
   Buffer::BufferMemoryAccountSharedPtr account_;
   const bool proxy_100_continue_;
 
+  // Declared before everything allocated from it, so that it is destroyed last.
+  absl::optional<Arena> arena_;
   StreamDecoderFilters decoder_filters_;
   StreamEncoderFilters encoder_filters_;
-  std::vector<StreamFilterBase*> filters_;
+  std::vector<StreamFilterBase*, ArenaAllocator<StreamFilterBase*>> filters_;
   AccessLog::InstanceSharedPtrVector access_log_handlers_;
 
   // Stores metadata added in the decoding filter that is being processed. Will be cleared before
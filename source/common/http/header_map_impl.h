@@ -141,12 +141,22 @@ protected:
     const LowerCaseString* key_;
   };
 
+  /**
+   * Value stored in the static lookup table. This is trivially copyable so that a lookup is a trie
+   * walk followed by an index into the inline header array, without a type-erased call.
+   */
+  struct StaticLookupEntry {
+    // The registered key, or nullptr if the looked up key is not an O(1) header.
+    const LowerCaseString* key_{};
+    // Index of the header in inlineHeaders().
+    size_t index_{};
+  };
+
   /**
    * Base class for a static lookup table that converts a string key into an O(1) header.
    */
   template <class Interface>
-  struct StaticLookupTable
-      : public CompiledStringMap<std::function<StaticLookupResponse(HeaderMapImpl&)>> {
+  struct StaticLookupTable : public CompiledStringMap<StaticLookupEntry> {
     StaticLookupTable();
 
     std::vector<KV> finalizedTable() {
@@ -156,9 +166,7 @@ protected:
       std::vector<KV> input;
       input.reserve(size_);
       for (const auto& header : headers) {
-        input.emplace_back(header.first.get(), [&header](HeaderMapImpl& h) -> StaticLookupResponse {
-          return {&h.inlineHeaders()[header.second], &header.first};
-        });
+        input.emplace_back(header.first.get(), StaticLookupEntry{&header.first, header.second});
       }
       return input;
     }
@@ -176,12 +184,11 @@ protected:
 
     static absl::optional<StaticLookupResponse> lookup(HeaderMapImpl& header_map,
                                                        absl::string_view key) {
-      const auto& entry = ConstSingleton<StaticLookupTable>::get().find(key);
-      if (entry != nullptr) {
-        return entry(header_map);
-      } else {
+      const StaticLookupEntry entry = ConstSingleton<StaticLookupTable>::get().find(key);
+      if (entry.key_ == nullptr) {
         return absl::nullopt;
       }
+      return StaticLookupResponse{&header_map.inlineHeaders()[entry.index_], entry.key_};
     }
 
     // This is the size of the number of callbacks; in the case of Requests,
@@ -5,6 +5,7 @@
 #include <cstdint>
 
 #include "source/common/common/assert.h"
+#include "source/common/http/character_set_scan.h"
 #include "source/common/http/headers.h"
 #include "source/common/runtime/runtime_features.h"
 
@@ -25,22 +26,13 @@ constexpr absl::string_view kColonSlashSlash = "://";
 constexpr char kResponseFirstByte = 'H';
 constexpr absl::string_view kHttpVersionPrefix = "HTTP/";
 
-// Allowed characters for field names according to Section 5.1
-// and for methods according to Section 9.1 of RFC 9110:
-// https://www.rfc-editor.org/rfc/rfc9110.html
-constexpr absl::string_view kValidCharacters =
-    "!#$%&'*+-.0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ^_`abcdefghijklmnopqrstuvwxyz|~";
-constexpr absl::string_view::iterator kValidCharactersBegin = kValidCharacters.begin();
-constexpr absl::string_view::iterator kValidCharactersEnd = kValidCharacters.end();
-
 // TODO(#21245): Skip method validation altogether when UHV method validation is
 // enabled.
 bool isMethodValid(absl::string_view method, bool allow_custom_methods) {
   if (allow_custom_methods) {
-    return !method.empty() &&
-           std::all_of(method.begin(), method.end(), [](absl::string_view::value_type c) {
-             return std::binary_search(kValidCharactersBegin, kValidCharactersEnd, c);
-           });
+    // Methods are tokens like field names, see Section 9.1 of RFC 9110:
+    // https://www.rfc-editor.org/rfc/rfc9110.html
+    return !method.empty() && findInvalidHeaderNameChar(method) == absl::string_view::npos;
   }
 
   static constexpr absl::string_view kValidMethods[] = {
@@ -131,9 +123,7 @@ bool isVersionValid(absl::string_view version_input) {
 }
 
 bool isHeaderNameValid(absl::string_view name) {
-  return std::all_of(name.begin(), name.end(), [](absl::string_view::value_type c) {
-    return std::binary_search(kValidCharactersBegin, kValidCharactersEnd, c);
-  });
+  return findInvalidHeaderNameChar(name) == absl::string_view::npos;
 }
 
 } // anonymous namespace
@@ -411,15 +401,17 @@ void BalsaParser::validateAndProcessHeadersOrTrailersImpl(const quiche::BalsaHea
     }
 
     // Remove CR and LF characters to match http-parser behavior.
-    auto is_cr_or_lf = [](char c) { return c == '\r' || c == '\n'; };
-    if (std::any_of(value.begin(), value.end(), is_cr_or_lf)) {
+    size_t cr_or_lf = findCrOrLf(value);
+    if (cr_or_lf != absl::string_view::npos) {
       std::string value_without_cr_or_lf;
       value_without_cr_or_lf.reserve(value.size());
-      for (char c : value) {
-        if (!is_cr_or_lf(c)) {
-          value_without_cr_or_lf.push_back(c);
-        }
+      absl::string_view remaining = value;
+      while (cr_or_lf != absl::string_view::npos) {
+        value_without_cr_or_lf.append(remaining.data(), cr_or_lf);
+        remaining.remove_prefix(cr_or_lf + 1);
+        cr_or_lf = findCrOrLf(remaining);
       }
+      value_without_cr_or_lf.append(remaining.data(), remaining.size());
       status_ = convertResult(connection_->onHeaderValue(value_without_cr_or_lf.data(),
                                                          value_without_cr_or_lf.length()));
     } else {
@@ -21,6 +21,7 @@
 #include "source/common/common/assert.h"
 #include "source/common/common/linked_object.h"
 #include "source/common/common/logger.h"
+#include "source/common/event/deferred_delete_pool.h"
 #include "source/common/http/codec_helper.h"
 #include "source/common/http/header_map_impl.h"
 #include "source/common/http/http2/codec_stats.h"
@@ -510,13 +511,18 @@ protected:
   /**
    * Client side stream (request).
    */
-  struct ClientStreamImpl : public StreamImpl, public RequestEncoder {
+  struct ClientStreamImpl : public StreamImpl,
+                            public RequestEncoder,
+                            public Event::PooledDeferredDeletable<ClientStreamImpl> {
     ClientStreamImpl(ConnectionImpl& parent, uint32_t buffer_limit,
                      ResponseDecoder& response_decoder)
         : StreamImpl(parent, buffer_limit), response_decoder_(response_decoder),
           headers_or_trailers_(
               ResponseHeaderMapImpl::create(parent_.max_headers_kb_, parent_.max_headers_count_)) {}
 
+    // Event::PooledDeferredDeletable
+    static constexpr absl::string_view DeferredDeletePoolName = "http2_client_stream";
+
     // Http::MultiplexedStreamImplBase
     // Client streams do not need a flush timer because we currently assume that any failure
     // to flush would be covered by a request/stream/etc. timeout.
@@ -578,12 +584,17 @@ protected:
   /**
    * Server side stream (response).
    */
-  struct ServerStreamImpl : public StreamImpl, public ResponseEncoder {
+  struct ServerStreamImpl : public StreamImpl,
+                            public ResponseEncoder,
+                            public Event::PooledDeferredDeletable<ServerStreamImpl> {
     ServerStreamImpl(ConnectionImpl& parent, uint32_t buffer_limit)
         : StreamImpl(parent, buffer_limit),
           headers_or_trailers_(
               RequestHeaderMapImpl::create(parent_.max_headers_kb_, parent_.max_headers_count_)) {}
 
+    // Event::PooledDeferredDeletable
+    static constexpr absl::string_view DeferredDeletePoolName = "http2_server_stream";
+
     // StreamImpl
     void destroy() override;
     void submitHeaders(const HeaderMap& headers, bool end_stream) override;
@@ -30,7 +30,12 @@ IoUringImpl::IoUringImpl(uint32_t io_uring_size, bool use_submission_queue_polli
   RELEASE_ASSERT(ret == 0, fmt::format("unable to initialize io_uring: {}", errorDetails(-ret)));
 }
 
-IoUringImpl::~IoUringImpl() { io_uring_queue_exit(&ring_); }
+IoUringImpl::~IoUringImpl() {
+  for (auto& [group_id, buffer_ring] : buffer_rings_) {
+    io_uring_free_buf_ring(&ring_, buffer_ring.ring_, buffer_ring.num_buffers_, group_id);
+  }
+  io_uring_queue_exit(&ring_);
+}
 
 os_fd_t IoUringImpl::registerEventfd() {
   ASSERT(!isEventfdRegistered());
@@ -69,7 +74,9 @@ void IoUringImpl::forEveryCompletion(const CompletionCb& completion_cb) {
 
   for (unsigned i = 0; i < count; ++i) {
     struct io_uring_cqe* cqe = cqes_[i];
-    completion_cb(reinterpret_cast<Request*>(cqe->user_data), cqe->res, false);
+    Request* req = reinterpret_cast<Request*>(cqe->user_data);
+    req->setCompletionFlags(cqe->flags);
+    completion_cb(req, cqe->res, false);
   }
 
   io_uring_cq_advance(&ring_, count);
@@ -105,6 +112,22 @@ IoUringResult IoUringImpl::prepareAccept(os_fd_t fd, struct sockaddr* remote_add
   return IoUringResult::Ok;
 }
 
+IoUringResult IoUringImpl::prepareAcceptMultishot(os_fd_t fd, Request* user_data) {
+  ENVOY_LOG(trace, "prepare multishot accept for fd = {}", fd);
+  // TODO (soulxu): Handling the case of CQ ring is overflow.
+  ASSERT(!(*(ring_.sq.kflags) & IORING_SQ_CQ_OVERFLOW));
+  struct io_uring_sqe* sqe = io_uring_get_sqe(&ring_);
+  if (sqe == nullptr) {
+    return IoUringResult::Failed;
+  }
+
+  // The peer address is not reported, since the completions of a multishot request would all write
+  // it to the same place.
+  io_uring_prep_multishot_accept(sqe, fd, nullptr, nullptr, SOCK_NONBLOCK);
+  io_uring_sqe_set_data(sqe, user_data);
+  return IoUringResult::Ok;
+}
+
 IoUringResult IoUringImpl::prepareConnect(os_fd_t fd,
                                           const Network::Address::InstanceConstSharedPtr& address,
                                           Request* user_data) {
@@ -121,6 +144,52 @@ IoUringResult IoUringImpl::prepareConnect(os_fd_t fd,
   return IoUringResult::Ok;
 }
 
+IoUringResult IoUringImpl::registerBufferRing(uint16_t group_id, uint32_t num_buffers) {
+  ASSERT(!buffer_rings_.contains(group_id));
+  int ret = 0;
+  struct io_uring_buf_ring* ring = io_uring_setup_buf_ring(&ring_, num_buffers, group_id, 0, &ret);
+  if (ring == nullptr) {
+    ENVOY_LOG(debug, "unable to register buffer ring for group {}: {}", group_id,
+              errorDetails(-ret));
+    return IoUringResult::Failed;
+  }
+  buffer_rings_.emplace(group_id, BufferRing{ring, num_buffers});
+  return IoUringResult::Ok;
+}
+
+void IoUringImpl::unregisterBufferRing(uint16_t group_id) {
+  auto it = buffer_rings_.find(group_id);
+  ASSERT(it != buffer_rings_.end());
+  io_uring_free_buf_ring(&ring_, it->second.ring_, it->second.num_buffers_, group_id);
+  buffer_rings_.erase(it);
+}
+
+void IoUringImpl::provideBuffer(uint16_t group_id, uint16_t buffer_id, uint8_t* buf,
+                                uint32_t len) {
+  auto it = buffer_rings_.find(group_id);
+  ASSERT(it != buffer_rings_.end());
+  io_uring_buf_ring_add(it->second.ring_, buf, len, buffer_id,
+                        io_uring_buf_ring_mask(it->second.num_buffers_), 0);
+  io_uring_buf_ring_advance(it->second.ring_, 1);
+}
+
+IoUringResult IoUringImpl::prepareRecvMultishot(os_fd_t fd, uint16_t group_id,
+                                                Request* user_data) {
+  ENVOY_LOG(trace, "prepare multishot recv for fd = {}, buffer group = {}", fd, group_id);
+  // TODO (soulxu): Handling the case of CQ ring is overflow.
+  ASSERT(!(*(ring_.sq.kflags) & IORING_SQ_CQ_OVERFLOW));
+  struct io_uring_sqe* sqe = io_uring_get_sqe(&ring_);
+  if (sqe == nullptr) {
+    return IoUringResult::Failed;
+  }
+
+  io_uring_prep_recv_multishot(sqe, fd, nullptr, 0, 0);
+  sqe->flags |= IOSQE_BUFFER_SELECT;
+  sqe->buf_group = group_id;
+  io_uring_sqe_set_data(sqe, user_data);
+  return IoUringResult::Ok;
+}
+
 IoUringResult IoUringImpl::prepareReadv(os_fd_t fd, const struct iovec* iovecs, unsigned nr_vecs,
                                         off_t offset, Request* user_data) {
   ENVOY_LOG(trace, "prepare readv for fd = {}", fd);
@@ -5,6 +5,8 @@
 
 #include "source/common/common/logger.h"
 
+#include "absl/container/flat_hash_map.h"
+
 #include "liburing.h"
 
 namespace Envoy {
@@ -34,8 +36,13 @@ public:
   void forEveryCompletion(const CompletionCb& completion_cb) override;
   IoUringResult prepareAccept(os_fd_t fd, struct sockaddr* remote_addr, socklen_t* remote_addr_len,
                               Request* user_data) override;
+  IoUringResult prepareAcceptMultishot(os_fd_t fd, Request* user_data) override;
   IoUringResult prepareConnect(os_fd_t fd, const Network::Address::InstanceConstSharedPtr& address,
                                Request* user_data) override;
+  IoUringResult registerBufferRing(uint16_t group_id, uint32_t num_buffers) override;
+  void unregisterBufferRing(uint16_t group_id) override;
+  void provideBuffer(uint16_t group_id, uint16_t buffer_id, uint8_t* buf, uint32_t len) override;
+  IoUringResult prepareRecvMultishot(os_fd_t fd, uint16_t group_id, Request* user_data) override;
   IoUringResult prepareReadv(os_fd_t fd, const struct iovec* iovecs, unsigned nr_vecs, off_t offset,
                              Request* user_data) override;
   IoUringResult prepareWritev(os_fd_t fd, const struct iovec* iovecs, unsigned nr_vecs,
@@ -48,10 +55,16 @@ public:
   void removeInjectedCompletion(os_fd_t fd) override;
 
 private:
+  struct BufferRing {
+    struct io_uring_buf_ring* ring_;
+    uint32_t num_buffers_;
+  };
+
   struct io_uring ring_ {};
   std::vector<struct io_uring_cqe*> cqes_;
   os_fd_t event_fd_{INVALID_SOCKET};
   std::list<InjectedCompletion> injected_completions_;
+  absl::flat_hash_map<uint16_t, BufferRing> buffer_rings_;
 };
 
 } // namespace Io
@@ -9,9 +9,15 @@ IoUringWorkerFactoryImpl::IoUringWorkerFactoryImpl(uint32_t io_uring_size,
                                                    bool use_submission_queue_polling,
                                                    uint32_t read_buffer_size,
                                                    uint32_t write_timeout_ms,
+                                                   uint32_t provided_buffer_count,
+                                                   bool enable_batched_submission,
+                                                   bool enable_accept,
                                                    ThreadLocal::SlotAllocator& tls)
     : io_uring_size_(io_uring_size), use_submission_queue_polling_(use_submission_queue_polling),
-      read_buffer_size_(read_buffer_size), write_timeout_ms_(write_timeout_ms), tls_(tls) {}
+      read_buffer_size_(read_buffer_size), write_timeout_ms_(write_timeout_ms),
+      provided_buffer_count_(provided_buffer_count),
+      enable_batched_submission_(enable_batched_submission), enable_accept_(enable_accept),
+      tls_(tls) {}
 
 OptRef<IoUringWorker> IoUringWorkerFactoryImpl::getIoUringWorker() {
   auto ret = tls_.get();
@@ -25,9 +31,13 @@ void IoUringWorkerFactoryImpl::onWorkerThreadInitialized() {
   tls_.set([io_uring_size = io_uring_size_,
             use_submission_queue_polling = use_submission_queue_polling_,
             read_buffer_size = read_buffer_size_,
-            write_timeout_ms = write_timeout_ms_](Event::Dispatcher& dispatcher) {
-    return std::make_shared<IoUringWorkerImpl>(io_uring_size, use_submission_queue_polling,
-                                               read_buffer_size, write_timeout_ms, dispatcher);
+            write_timeout_ms = write_timeout_ms_,
+            provided_buffer_count = provided_buffer_count_,
+            enable_batched_submission =
+                enable_batched_submission_](Event::Dispatcher& dispatcher) {
+    return std::make_shared<IoUringWorkerImpl>(
+        io_uring_size, use_submission_queue_polling, read_buffer_size, write_timeout_ms,
+        provided_buffer_count, enable_batched_submission, dispatcher);
   });
 }
 
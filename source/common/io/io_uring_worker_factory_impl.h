@@ -10,18 +10,23 @@ class IoUringWorkerFactoryImpl : public IoUringWorkerFactory {
 public:
   IoUringWorkerFactoryImpl(uint32_t io_uring_size, bool use_submission_queue_polling,
                            uint32_t read_buffer_size, uint32_t write_timeout_ms,
-                           ThreadLocal::SlotAllocator& tls);
+                           uint32_t provided_buffer_count, bool enable_batched_submission,
+                           bool enable_accept, ThreadLocal::SlotAllocator& tls);
 
   OptRef<IoUringWorker> getIoUringWorker() override;
 
   void onWorkerThreadInitialized() override;
   bool currentThreadRegistered() override;
+  bool acceptEnabled() const override { return enable_accept_; }
 
 private:
   const uint32_t io_uring_size_;
   const bool use_submission_queue_polling_;
   const uint32_t read_buffer_size_;
   const uint32_t write_timeout_ms_;
+  const uint32_t provided_buffer_count_;
+  const bool enable_batched_submission_;
+  const bool enable_accept_;
   ThreadLocal::TypedSlot<IoUringWorker> tls_;
 };
 
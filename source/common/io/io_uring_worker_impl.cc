@@ -1,5 +1,7 @@
 #include "source/common/io/io_uring_worker_impl.h"
 
+#include "source/common/api/os_sys_calls_impl.h"
+
 namespace Envoy {
 namespace Io {
 
@@ -18,6 +20,110 @@ WriteRequest::WriteRequest(IoUringSocket& socket, const Buffer::RawSliceVector&
   }
 }
 
+class ProvidedBufferRing::Fragment : public Buffer::BufferFragment {
+public:
+  Fragment(ProvidedBufferRingSharedPtr ring, uint16_t buffer_id,
+           std::unique_ptr<uint8_t[]>&& buffer, size_t size)
+      : ring_(std::move(ring)), buffer_(std::move(buffer)), size_(size), buffer_id_(buffer_id) {}
+
+  // Buffer::BufferFragment
+  const void* data() const override { return buffer_.get(); }
+  size_t size() const override { return size_; }
+  void done() override {
+    ring_->release(buffer_id_, std::move(buffer_));
+    delete this;
+  }
+
+private:
+  const ProvidedBufferRingSharedPtr ring_;
+  std::unique_ptr<uint8_t[]> buffer_;
+  const size_t size_;
+  const uint16_t buffer_id_;
+};
+
+ProvidedBufferRingSharedPtr ProvidedBufferRing::create(IoUring& io_uring, uint32_t num_buffers,
+                                                       uint32_t buffer_size) {
+  ASSERT(num_buffers > 0 && num_buffers <= MaxBuffers);
+  // The kernel requires the size of the ring to be a power of 2.
+  while ((num_buffers & (num_buffers - 1)) != 0) {
+    num_buffers &= num_buffers - 1;
+  }
+  if (io_uring.registerBufferRing(GroupId, num_buffers) != IoUringResult::Ok) {
+    return nullptr;
+  }
+  return ProvidedBufferRingSharedPtr{new ProvidedBufferRing(io_uring, num_buffers, buffer_size)};
+}
+
+ProvidedBufferRing::ProvidedBufferRing(IoUring& io_uring, uint32_t num_buffers,
+                                       uint32_t buffer_size)
+    : io_uring_(&io_uring), buffer_size_(buffer_size), thread_id_(std::this_thread::get_id()),
+      buffers_(num_buffers) {
+  for (uint32_t buffer_id = 0; buffer_id < num_buffers; ++buffer_id) {
+    buffers_[buffer_id].reset(new uint8_t[buffer_size_]);
+    provide(buffer_id);
+  }
+}
+
+void ProvidedBufferRing::detach() {
+  ASSERT(std::this_thread::get_id() == thread_id_);
+  if (io_uring_ != nullptr) {
+    io_uring_->unregisterBufferRing(GroupId);
+    io_uring_ = nullptr;
+  }
+}
+
+Buffer::BufferFragment& ProvidedBufferRing::takeBuffer(uint32_t flags, uint32_t length) {
+  ASSERT(flags & IORING_CQE_F_BUFFER);
+  const uint16_t buffer_id = flags >> IORING_CQE_BUFFER_SHIFT;
+  ASSERT(buffer_id < buffers_.size() && buffers_[buffer_id] != nullptr);
+  ASSERT(length <= buffer_size_);
+  replaceLostBuffers();
+  return *new Fragment(shared_from_this(), buffer_id, std::move(buffers_[buffer_id]), length);
+}
+
+void ProvidedBufferRing::recycleBuffer(uint32_t flags) {
+  ASSERT(flags & IORING_CQE_F_BUFFER);
+  const uint16_t buffer_id = flags >> IORING_CQE_BUFFER_SHIFT;
+  ASSERT(buffer_id < buffers_.size() && buffers_[buffer_id] != nullptr);
+  provide(buffer_id);
+}
+
+void ProvidedBufferRing::release(uint16_t buffer_id, std::unique_ptr<uint8_t[]>&& buffer) {
+  if (std::this_thread::get_id() != thread_id_) {
+    // Only the worker's thread may touch the ring, so free the buffer and have the worker replace
+    // it.
+    buffer.reset();
+    absl::MutexLock lock(&lost_buffers_mutex_);
+    lost_buffers_.push_back(buffer_id);
+    has_lost_buffers_.store(true, std::memory_order_release);
+    return;
+  }
+  buffers_[buffer_id] = std::move(buffer);
+  provide(buffer_id);
+}
+
+void ProvidedBufferRing::provide(uint16_t buffer_id) {
+  if (io_uring_ != nullptr) {
+    io_uring_->provideBuffer(GroupId, buffer_id, buffers_[buffer_id].get(), buffer_size_);
+  }
+}
+
+void ProvidedBufferRing::replaceLostBuffers() {
+  if (!has_lost_buffers_.load(std::memory_order_acquire)) {
+    return;
+  }
+  std::vector<uint16_t> lost_buffers;
+  {
+    absl::MutexLock lock(&lost_buffers_mutex_);
+    lost_buffers.swap(lost_buffers_);
+    has_lost_buffers_.store(false, std::memory_order_relaxed);
+  }
+  for (const uint16_t buffer_id : lost_buffers) {
+    buffers_[buffer_id].reset(new uint8_t[buffer_size_]);
+    provide(buffer_id);
+  }
+}
+
 IoUringSocketEntry::IoUringSocketEntry(os_fd_t fd, IoUringWorkerImpl& parent, Event::FileReadyCb cb,
                                        bool enable_close_event)
     : fd_(fd), parent_(parent), enable_close_event_(enable_close_event), cb_(std::move(cb)) {}
@@ -60,14 +166,30 @@ void IoUringSocketEntry::onRemoteClose() {
 
 IoUringWorkerImpl::IoUringWorkerImpl(uint32_t io_uring_size, bool use_submission_queue_polling,
                                      uint32_t read_buffer_size, uint32_t write_timeout_ms,
+                                     uint32_t provided_buffer_count,
+                                     bool enable_batched_submission,
                                      Event::Dispatcher& dispatcher)
     : IoUringWorkerImpl(std::make_unique<IoUringImpl>(io_uring_size, use_submission_queue_polling),
-                        read_buffer_size, write_timeout_ms, dispatcher) {}
+                        read_buffer_size, write_timeout_ms, provided_buffer_count,
+                        enable_batched_submission, dispatcher) {}
 
 IoUringWorkerImpl::IoUringWorkerImpl(IoUringPtr&& io_uring, uint32_t read_buffer_size,
-                                     uint32_t write_timeout_ms, Event::Dispatcher& dispatcher)
+                                     uint32_t write_timeout_ms, uint32_t provided_buffer_count,
+                                     bool enable_batched_submission,
+                                     Event::Dispatcher& dispatcher)
     : io_uring_(std::move(io_uring)), read_buffer_size_(read_buffer_size),
       write_timeout_ms_(write_timeout_ms), dispatcher_(dispatcher) {
+  if (enable_batched_submission) {
+    submit_cb_ = dispatcher_.createSchedulableCallback([this]() { io_uring_->submit(); });
+  }
+  if (provided_buffer_count > 0) {
+    provided_buffers_ =
+        ProvidedBufferRing::create(*io_uring_, provided_buffer_count, read_buffer_size_);
+    if (provided_buffers_ == nullptr) {
+      ENVOY_LOG(info, "provided buffer rings are not supported, reads use their own buffers");
+    }
+  }
+
   const os_fd_t event_fd = io_uring_->registerEventfd();
   // We only care about the read event of Eventfd, since we only receive the
   // event here.
@@ -83,6 +205,15 @@ IoUringWorkerImpl::IoUringWorkerImpl(IoUringPtr&& io_uring, uint32_t read_buffer
 IoUringWorkerImpl::~IoUringWorkerImpl() {
   ENVOY_LOG(trace, "destruct io uring worker, existing sockets = {}", sockets_.size());
 
+  // The dispatcher no longer runs, so submit right away from here on.
+  if (submit_cb_ != nullptr) {
+    const bool submit_pending = submit_cb_->enabled();
+    submit_cb_.reset();
+    if (submit_pending) {
+      io_uring_->submit();
+    }
+  }
+
   for (auto& socket : sockets_) {
     if (socket->getStatus() != Closed) {
       socket->close(false);
@@ -97,6 +228,9 @@ IoUringWorkerImpl::~IoUringWorkerImpl() {
     onFileEvent();
   }
 
+  if (provided_buffers_ != nullptr) {
+    provided_buffers_->detach();
+  }
   dispatcher_.clearDeferredDeleteList();
 }
 
@@ -127,6 +261,15 @@ IoUringSocket& IoUringWorkerImpl::addClientSocket(os_fd_t fd, Event::FileReadyCb
   return addSocket(std::move(socket));
 }
 
+IoUringSocket& IoUringWorkerImpl::addAcceptSocket(os_fd_t fd, Event::FileReadyCb cb,
+                                                  bool enable_close_event) {
+  ENVOY_LOG(trace, "add accept socket, fd = {}", fd);
+  std::unique_ptr<IoUringAcceptSocket> socket =
+      std::make_unique<IoUringAcceptSocket>(fd, *this, std::move(cb), enable_close_event);
+  socket->enableRead();
+  return addSocket(std::move(socket));
+}
+
 Event::Dispatcher& IoUringWorkerImpl::dispatcher() { return dispatcher_; }
 
 IoUringSocketEntry& IoUringWorkerImpl::addSocket(IoUringSocketEntryPtr&& socket) {
@@ -134,6 +277,27 @@ IoUringSocketEntry& IoUringWorkerImpl::addSocket(IoUringSocketEntryPtr&& socket)
   return *sockets_.back();
 }
 
+Request* IoUringWorkerImpl::submitAcceptRequest(IoUringSocket& socket, bool multishot) {
+  Request* req = new Request(Request::RequestType::Accept, socket);
+
+  ENVOY_LOG(trace, "submit accept request, fd = {}, req = {}, multishot = {}", socket.fd(),
+            fmt::ptr(req), multishot);
+
+  auto prepare = [this, &socket, req, multishot]() {
+    return multishot ? io_uring_->prepareAcceptMultishot(socket.fd(), req)
+                     : io_uring_->prepareAccept(socket.fd(), nullptr, nullptr, req);
+  };
+  auto res = prepare();
+  if (res == IoUringResult::Failed) {
+    // TODO(rojkov): handle `EBUSY` in case the completion queue is never reaped.
+    io_uring_->submit();
+    res = prepare();
+    RELEASE_ASSERT(res == IoUringResult::Ok, "unable to prepare accept");
+  }
+  submit();
+  return req;
+}
+
 Request*
 IoUringWorkerImpl::submitConnectRequest(IoUringSocket& socket,
                                         const Network::Address::InstanceConstSharedPtr& address) {
@@ -144,7 +308,7 @@ IoUringWorkerImpl::submitConnectRequest(IoUringSocket& socket,
   auto res = io_uring_->prepareConnect(socket.fd(), address, req);
   if (res == IoUringResult::Failed) {
     // TODO(rojkov): handle `EBUSY` in case the completion queue is never reaped.
-    submit();
+    io_uring_->submit();
     res = io_uring_->prepareConnect(socket.fd(), address, req);
     RELEASE_ASSERT(res == IoUringResult::Ok, "unable to prepare connect");
   }
@@ -160,7 +324,7 @@ Request* IoUringWorkerImpl::submitReadRequest(IoUringSocket& socket) {
   auto res = io_uring_->prepareReadv(socket.fd(), req->iov_.get(), 1, 0, req);
   if (res == IoUringResult::Failed) {
     // TODO(rojkov): handle `EBUSY` in case the completion queue is never reaped.
-    submit();
+    io_uring_->submit();
     res = io_uring_->prepareReadv(socket.fd(), req->iov_.get(), 1, 0, req);
     RELEASE_ASSERT(res == IoUringResult::Ok, "unable to prepare readv");
   }
@@ -168,6 +332,24 @@ Request* IoUringWorkerImpl::submitReadRequest(IoUringSocket& socket) {
   return req;
 }
 
+Request* IoUringWorkerImpl::submitRecvMultishotRequest(IoUringSocket& socket) {
+  ASSERT(provided_buffers_ != nullptr);
+  Request* req = new Request(Request::RequestType::Read, socket);
+
+  ENVOY_LOG(trace, "submit multishot recv request, fd = {}, read req = {}", socket.fd(),
+            fmt::ptr(req));
+
+  auto res = io_uring_->prepareRecvMultishot(socket.fd(), ProvidedBufferRing::GroupId, req);
+  if (res == IoUringResult::Failed) {
+    // TODO(rojkov): handle `EBUSY` in case the completion queue is never reaped.
+    io_uring_->submit();
+    res = io_uring_->prepareRecvMultishot(socket.fd(), ProvidedBufferRing::GroupId, req);
+    RELEASE_ASSERT(res == IoUringResult::Ok, "unable to prepare multishot recv");
+  }
+  submit();
+  return req;
+}
+
 Request* IoUringWorkerImpl::submitWriteRequest(IoUringSocket& socket,
                                                const Buffer::RawSliceVector& slices) {
   WriteRequest* req = new WriteRequest(socket, slices);
@@ -177,7 +359,7 @@ Request* IoUringWorkerImpl::submitWriteRequest(IoUringSocket& socket,
   auto res = io_uring_->prepareWritev(socket.fd(), req->iov_.get(), slices.size(), 0, req);
   if (res == IoUringResult::Failed) {
     // TODO(rojkov): handle `EBUSY` in case the completion queue is never reaped.
-    submit();
+    io_uring_->submit();
     res = io_uring_->prepareWritev(socket.fd(), req->iov_.get(), slices.size(), 0, req);
     RELEASE_ASSERT(res == IoUringResult::Ok, "unable to prepare writev");
   }
@@ -193,7 +375,7 @@ Request* IoUringWorkerImpl::submitCloseRequest(IoUringSocket& socket) {
   auto res = io_uring_->prepareClose(socket.fd(), req);
   if (res == IoUringResult::Failed) {
     // TODO(rojkov): handle `EBUSY` in case the completion queue is never reaped.
-    submit();
+    io_uring_->submit();
     res = io_uring_->prepareClose(socket.fd(), req);
     RELEASE_ASSERT(res == IoUringResult::Ok, "unable to prepare close");
   }
@@ -210,7 +392,7 @@ Request* IoUringWorkerImpl::submitCancelRequest(IoUringSocket& socket, Request*
   auto res = io_uring_->prepareCancel(request_to_cancel, req);
   if (res == IoUringResult::Failed) {
     // TODO(rojkov): handle `EBUSY` in case the completion queue is never reaped.
-    submit();
+    io_uring_->submit();
     res = io_uring_->prepareCancel(request_to_cancel, req);
     RELEASE_ASSERT(res == IoUringResult::Ok, "unable to prepare cancel");
   }
@@ -227,7 +409,7 @@ Request* IoUringWorkerImpl::submitShutdownRequest(IoUringSocket& socket, int how
   auto res = io_uring_->prepareShutdown(socket.fd(), how, req);
   if (res == IoUringResult::Failed) {
     // TODO(rojkov): handle `EBUSY` in case the completion queue is never reaped.
-    submit();
+    io_uring_->submit();
     res = io_uring_->prepareShutdown(socket.fd(), how, req);
     RELEASE_ASSERT(res == IoUringResult::Ok, "unable to prepare cancel");
   }
@@ -294,16 +476,24 @@ void IoUringWorkerImpl::onFileEvent() {
       break;
     }
 
-    delete req;
+    // A multishot request stays in flight until its last completion.
+    if (!(req->completionFlags() & IORING_CQE_F_MORE)) {
+      delete req;
+    }
   });
   delay_submit_ = false;
   submit();
 }
 
 void IoUringWorkerImpl::submit() {
-  if (!delay_submit_) {
-    io_uring_->submit();
+  if (delay_submit_) {
+    return;
   }
+  if (submit_cb_ != nullptr) {
+    submit_cb_->scheduleCallbackCurrentIteration();
+    return;
+  }
+  io_uring_->submit();
 }
 
 IoUringServerSocket::IoUringServerSocket(os_fd_t fd, IoUringWorkerImpl& parent,
@@ -429,6 +619,11 @@ void IoUringServerSocket::onCancel(Request* req, int32_t result, bool injected)
 }
 
 void IoUringServerSocket::moveReadDataToBuffer(Request* req, size_t data_length) {
+  if (req->completionFlags() & IORING_CQE_F_BUFFER) {
+    read_buf_.addBufferFragment(
+        parent_.providedBuffers()->takeBuffer(req->completionFlags(), data_length));
+    return;
+  }
   ReadRequest* read_req = static_cast<ReadRequest*>(req);
   Buffer::BufferFragment* fragment = new Buffer::BufferFragmentImpl(
       read_req->buf_.release(), data_length,
@@ -439,6 +634,12 @@ void IoUringServerSocket::moveReadDataToBuffer(Request* req, size_t data_length)
   read_buf_.addBufferFragment(*fragment);
 }
 
+void IoUringServerSocket::discardReadData(Request* req) {
+  if (req->completionFlags() & IORING_CQE_F_BUFFER) {
+    parent_.providedBuffers()->recycleBuffer(req->completionFlags());
+  }
+}
+
 void IoUringServerSocket::onReadCompleted(int32_t result) {
   ENVOY_LOG(trace, "read from socket, fd = {}, result = {}", fd_, result);
   ReadParam param{read_buf_, result};
@@ -457,14 +658,21 @@ void IoUringServerSocket::onRead(Request* req, int32_t result, bool injected) {
             "onRead with result {}, fd = {}, injected = {}, status_ = {}, enable_close_event = {}",
             result, fd_, injected, static_cast<int>(status_), enable_close_event_);
   if (!injected) {
-    read_req_ = nullptr;
+    // A multishot receive keeps the read request until its last completion.
+    if (!(req->completionFlags() & IORING_CQE_F_MORE)) {
+      read_req_ = nullptr;
+    }
     // If the socket is going to close, discard all results.
     if (status_ == Closed && write_or_shutdown_req_ == nullptr && read_cancel_req_ == nullptr &&
         write_or_shutdown_cancel_req_ == nullptr) {
       if (result > 0 && keep_fd_open_) {
         moveReadDataToBuffer(req, result);
+      } else {
+        discardReadData(req);
+      }
+      if (read_req_ == nullptr) {
+        closeInternal();
       }
-      closeInternal();
       return;
     }
   }
@@ -473,7 +681,12 @@ void IoUringServerSocket::onRead(Request* req, int32_t result, bool injected) {
   if (result > 0) {
     moveReadDataToBuffer(req, result);
   } else {
-    if (result != -ECANCELED) {
+    discardReadData(req);
+    if (result == -ENOBUFS) {
+      // The provided buffer ring ran dry, all of its buffers are held by the upper layers. Read
+      // into a buffer of our own next time rather than failing the socket.
+      provided_buffers_exhausted_ = true;
+    } else if (result != -ECANCELED) {
       read_error_ = result;
     }
   }
@@ -539,6 +752,13 @@ void IoUringServerSocket::onRead(Request* req, int32_t result, bool injected) {
       submitReadRequest();
     }
   } else if (status_ == ReadDisabled) {
+    if (read_req_ != nullptr && read_cancel_req_ == nullptr) {
+      // A multishot receive would keep filling the read buffer of a disabled socket, stop it. Its
+      // last completion submits the single read below.
+      ENVOY_LOG(trace, "cancel the multishot read request of a disabled socket, fd = {}", fd_);
+      read_cancel_req_ = parent_.submitCancelRequest(*this, read_req_);
+      return;
+    }
     // Since error in a disabled socket will not be handled by the handler, stop submit read
     // request if there is any error.
     if (!read_error_.has_value()) {
@@ -622,7 +842,13 @@ void IoUringServerSocket::closeInternal() {
 
 void IoUringServerSocket::submitReadRequest() {
   if (!read_req_) {
-    read_req_ = parent_.submitReadRequest(*this);
+    if (parent_.providedBuffers() != nullptr && !provided_buffers_exhausted_ &&
+        status_ == ReadEnabled) {
+      read_req_ = parent_.submitRecvMultishotRequest(*this);
+    } else {
+      read_req_ = parent_.submitReadRequest(*this);
+    }
+    provided_buffers_exhausted_ = false;
   }
 }
 
@@ -678,5 +904,158 @@ void IoUringClientSocket::onConnect(Request* req, int32_t result, bool injected)
   parent_.injectCompletion(*this, Request::RequestType::Write, result);
 }
 
+IoUringAcceptSocket::IoUringAcceptSocket(os_fd_t fd, IoUringWorkerImpl& parent,
+                                         Event::FileReadyCb cb, bool enable_close_event)
+    : IoUringSocketEntry(fd, parent, std::move(cb), enable_close_event) {}
+
+IoUringAcceptSocket::~IoUringAcceptSocket() { closeAcceptedSockets(); }
+
+void IoUringAcceptSocket::close(bool keep_fd_open, IoUringSocketOnClosedCb cb) {
+  ENVOY_LOG(trace, "close the accept socket, fd = {}, status = {}", fd_,
+            static_cast<int>(status_));
+
+  IoUringSocketEntry::close(keep_fd_open, cb);
+  keep_fd_open_ = keep_fd_open;
+  // The connections which the listener has not taken yet can't be handed over, close them.
+  closeAcceptedSockets();
+
+  // Delay close until the accept request is drained.
+  if (accept_req_ == nullptr) {
+    closeInternal();
+    return;
+  }
+  if (accept_cancel_req_ == nullptr) {
+    ENVOY_LOG(trace, "cancel the accept request, fd = {}", fd_);
+    accept_cancel_req_ = parent_.submitCancelRequest(*this, accept_req_);
+  }
+}
+
+void IoUringAcceptSocket::enableRead() {
+  IoUringSocketEntry::enableRead();
+  ENVOY_LOG(trace, "enable accept, fd = {}", fd_);
+
+  // Deliver the connections accepted while the socket was disabled.
+  if (!accepted_sockets_.empty()) {
+    injectCompletion(Request::RequestType::Accept);
+  }
+  if (accept_req_ == nullptr) {
+    submitAcceptRequest();
+  }
+}
+
+void IoUringAcceptSocket::disableRead() {
+  IoUringSocketEntry::disableRead();
+  ENVOY_LOG(trace, "disable accept, fd = {}", fd_);
+
+  // A multishot accept would keep accepting connections for a disabled listener, stop it. A single
+  // accept is left in flight like the read request of a disabled server socket.
+  if (multishot_ && accept_req_ != nullptr && accept_cancel_req_ == nullptr) {
+    accept_cancel_req_ = parent_.submitCancelRequest(*this, accept_req_);
+  }
+}
+
+os_fd_t IoUringAcceptSocket::takeAcceptedSocket() {
+  if (accepted_sockets_.empty()) {
+    return INVALID_SOCKET;
+  }
+  const os_fd_t fd = accepted_sockets_.front();
+  accepted_sockets_.pop_front();
+  return fd;
+}
+
+void IoUringAcceptSocket::onAccept(Request* req, int32_t result, bool injected) {
+  IoUringSocketEntry::onAccept(req, result, injected);
+
+  ENVOY_LOG(trace, "onAccept with result {}, fd = {}, injected = {}, status_ = {}", result, fd_,
+            injected, static_cast<int>(status_));
+  bool accept_again = true;
+  if (!injected) {
+    if (!(req->completionFlags() & IORING_CQE_F_MORE)) {
+      accept_req_ = nullptr;
+    }
+    if (result >= 0) {
+      accepted_sockets_.push_back(result);
+    } else if (result == -EINVAL && multishot_) {
+      ENVOY_LOG(debug, "multishot accept is not supported, fd = {}", fd_);
+      multishot_ = false;
+    } else if (result == -EINVAL) {
+      // The socket is not listening, retrying would fail in the same way.
+      ENVOY_LOG(debug, "accept failed on a socket which is not listening, fd = {}", fd_);
+      accept_again = false;
+    } else if (result != -ECANCELED) {
+      ENVOY_LOG(debug, "accept failed, fd = {}, error = {}", fd_, errorDetails(-result));
+    }
+  }
+
+  if (status_ == Closed) {
+    closeAcceptedSockets();
+    if (accept_req_ == nullptr && accept_cancel_req_ == nullptr) {
+      closeInternal();
+    }
+    return;
+  }
+
+  // An injected completion notifies the listener even if nothing was accepted, like an activated
+  // file event.
+  if (status_ == ReadEnabled && (injected || !accepted_sockets_.empty())) {
+    THROW_IF_NOT_OK(cb_(Event::FileReadyType::Read));
+  }
+
+  // The listener may be disabled or closed by the callback.
+  if (status_ == ReadEnabled) {
+    // The listener takes a bounded number of connections per event, notify it again for the rest.
+    if (!accepted_sockets_.empty()) {
+      injectCompletion(Request::RequestType::Accept);
+    }
+    if (accept_again) {
+      submitAcceptRequest();
+    }
+  }
+}
+
+void IoUringAcceptSocket::onClose(Request* req, int32_t result, bool injected) {
+  IoUringSocketEntry::onClose(req, result, injected);
+  ASSERT(!injected);
+  cleanup();
+}
+
+void IoUringAcceptSocket::onCancel(Request* req, int32_t result, bool injected) {
+  IoUringSocketEntry::onCancel(req, result, injected);
+  ASSERT(!injected);
+  if (accept_cancel_req_ == req) {
+    accept_cancel_req_ = nullptr;
+  }
+  if (status_ == Closed && accept_req_ == nullptr) {
+    closeInternal();
+  }
+}
+
+void IoUringAcceptSocket::submitAcceptRequest() {
+  if (accept_req_ == nullptr) {
+    accept_req_ = parent_.submitAcceptRequest(*this, multishot_);
+  }
+}
+
+void IoUringAcceptSocket::closeAcceptedSockets() {
+  for (const os_fd_t fd : accepted_sockets_) {
+    Api::OsSysCallsSingleton::get().close(fd);
+  }
+  accepted_sockets_.clear();
+}
+
+void IoUringAcceptSocket::closeInternal() {
+  if (keep_fd_open_) {
+    if (on_closed_cb_) {
+      Buffer::OwnedImpl empty_buffer;
+      on_closed_cb_(empty_buffer);
+    }
+    cleanup();
+    return;
+  }
+  if (close_req_ == nullptr) {
+    close_req_ = parent_.submitCloseRequest(*this);
+  }
+}
+
 } // namespace Io
 } // namespace Envoy
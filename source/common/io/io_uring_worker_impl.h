@@ -1,12 +1,21 @@
 #pragma once
 
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <vector>
+
 #include "envoy/common/io/io_uring.h"
 
 #include "source/common/buffer/buffer_impl.h"
 #include "source/common/common/linked_object.h"
 #include "source/common/common/logger.h"
+#include "source/common/common/non_copyable.h"
 #include "source/common/io/io_uring_impl.h"
 
+#include "absl/synchronization/mutex.h"
+
 namespace Envoy {
 namespace Io {
 
@@ -25,6 +34,69 @@ public:
   std::unique_ptr<struct iovec[]> iov_;
 };
 
+/**
+ * A ring of equally sized buffers which the kernel fills for multishot receive requests. Received
+ * buffers are handed to Buffer::OwnedImpl as fragments without copying, and go back into the ring
+ * when the fragment is drained on the worker's thread. A fragment drained on another thread frees
+ * its buffer instead, and the worker puts a new buffer in its place on the next receive. Fragments
+ * keep the ring alive, so they may outlive the worker.
+ */
+class ProvidedBufferRing : public std::enable_shared_from_this<ProvidedBufferRing>, NonCopyable {
+public:
+  static constexpr uint16_t GroupId = 0;
+  static constexpr uint32_t MaxBuffers = 32768;
+
+  /**
+   * @param num_buffers the number of buffers, at most MaxBuffers. Rounded down to a power of 2.
+   * @return a ring registered with io_uring, or nullptr if the kernel does not support provided
+   *         buffer rings.
+   */
+  static std::shared_ptr<ProvidedBufferRing> create(IoUring& io_uring, uint32_t num_buffers,
+                                                    uint32_t buffer_size);
+
+  /**
+   * Unregister the ring from io_uring. Must be called on the worker's thread once no receive
+   * request is in flight, and before the io_uring is destroyed.
+   */
+  void detach();
+
+  /**
+   * Take the buffer reported by a completion out of the ring.
+   * @param flags the completion flags, which must have IORING_CQE_F_BUFFER set.
+   * @param length the number of bytes received into the buffer.
+   * @return a fragment referencing the received bytes, which puts the buffer back when done.
+   */
+  Buffer::BufferFragment& takeBuffer(uint32_t flags, uint32_t length);
+
+  /**
+   * Put the buffer reported by a completion back into the ring without using its data.
+   * @param flags the completion flags, which must have IORING_CQE_F_BUFFER set.
+   */
+  void recycleBuffer(uint32_t flags);
+
+private:
+  class Fragment;
+
+  ProvidedBufferRing(IoUring& io_uring, uint32_t num_buffers, uint32_t buffer_size);
+
+  void release(uint16_t buffer_id, std::unique_ptr<uint8_t[]>&& buffer);
+  void provide(uint16_t buffer_id);
+  void replaceLostBuffers();
+
+  // Null once detached.
+  IoUring* io_uring_;
+  const uint32_t buffer_size_;
+  const std::thread::id thread_id_;
+  // Indexed by buffer id. A buffer is null while it is lent out to a fragment.
+  std::vector<std::unique_ptr<uint8_t[]>> buffers_;
+  // Buffers which were freed by fragments drained on another thread.
+  std::atomic<bool> has_lost_buffers_{false};
+  absl::Mutex lost_buffers_mutex_;
+  std::vector<uint16_t> lost_buffers_ ABSL_GUARDED_BY(lost_buffers_mutex_);
+};
+
+using ProvidedBufferRingSharedPtr = std::shared_ptr<ProvidedBufferRing>;
+
 class IoUringSocketEntry;
 using IoUringSocketEntryPtr = std::unique_ptr<IoUringSocketEntry>;
 
@@ -32,8 +104,10 @@ class IoUringWorkerImpl : public IoUringWorker, private Logger::Loggable<Logger:
 public:
   IoUringWorkerImpl(uint32_t io_uring_size, bool use_submission_queue_polling,
                     uint32_t read_buffer_size, uint32_t write_timeout_ms,
+                    uint32_t provided_buffer_count, bool enable_batched_submission,
                     Event::Dispatcher& dispatcher);
   IoUringWorkerImpl(IoUringPtr&& io_uring, uint32_t read_buffer_size, uint32_t write_timeout_ms,
+                    uint32_t provided_buffer_count, bool enable_batched_submission,
                     Event::Dispatcher& dispatcher);
   ~IoUringWorkerImpl() override;
 
@@ -44,7 +118,10 @@ public:
                                  bool enable_close_event) override;
   IoUringSocket& addClientSocket(os_fd_t fd, Event::FileReadyCb cb,
                                  bool enable_close_event) override;
+  IoUringSocket& addAcceptSocket(os_fd_t fd, Event::FileReadyCb cb,
+                                 bool enable_close_event) override;
 
+  Request* submitAcceptRequest(IoUringSocket& socket, bool multishot) override;
   Request* submitConnectRequest(IoUringSocket& socket,
                                 const Network::Address::InstanceConstSharedPtr& address) override;
   Request* submitReadRequest(IoUringSocket& socket) override;
@@ -55,6 +132,13 @@ public:
 
   Event::Dispatcher& dispatcher() override;
 
+  // Submit a multishot receive into the provided buffer ring for a socket. Only valid if
+  // providedBuffers() is not null.
+  Request* submitRecvMultishotRequest(IoUringSocket& socket);
+
+  // Return the provided buffer ring of this worker, or nullptr if reads use their own buffer.
+  ProvidedBufferRing* providedBuffers() { return provided_buffers_.get(); }
+
   // Remove a socket from this worker.
   IoUringSocketEntryPtr removeSocket(IoUringSocketEntry& socket);
 
@@ -78,6 +162,11 @@ protected:
   Event::Dispatcher& dispatcher_;
   // The file event of iouring's eventfd.
   Event::FileEventPtr file_event_{nullptr};
+  // If set, the requests prepared in a dispatcher iteration are submitted together at the end of
+  // the iteration, with a single io_uring_enter.
+  Event::SchedulableCallbackPtr submit_cb_;
+  // The buffers multishot receives read into, shared with the fragments holding received data.
+  ProvidedBufferRingSharedPtr provided_buffers_;
   // All the sockets in this worker.
   std::list<IoUringSocketEntryPtr> sockets_;
   // This is used to mark whether delay submit is enabled.
@@ -106,6 +195,7 @@ public:
   void disableRead() override { status_ = ReadDisabled; }
   void enableCloseEvent(bool enable) override { enable_close_event_ = enable; }
   void connect(const Network::Address::InstanceConstSharedPtr&) override { PANIC("not implement"); }
+  os_fd_t takeAcceptedSocket() override { PANIC("not implement"); }
 
   void onAccept(Request*, int32_t, bool injected) override {
     if (injected && (injected_completions_ & static_cast<uint8_t>(Request::RequestType::Accept))) {
@@ -242,15 +332,57 @@ protected:
   Request* write_or_shutdown_cancel_req_{nullptr};
   // This is used for tracking the close request.
   Request* close_req_{nullptr};
+  // Set when a multishot receive ended because the provided buffer ring was empty, so that the
+  // next read uses its own buffer instead.
+  bool provided_buffers_exhausted_{false};
 
   void closeInternal();
   void submitReadRequest();
   void submitWriteOrShutdownRequest();
   void moveReadDataToBuffer(Request* req, size_t data_length);
+  void discardReadData(Request* req);
   void onReadCompleted(int32_t result);
   void onWriteCompleted(int32_t result);
 };
 
+class IoUringAcceptSocket : public IoUringSocketEntry {
+public:
+  IoUringAcceptSocket(os_fd_t fd, IoUringWorkerImpl& parent, Event::FileReadyCb cb,
+                      bool enable_close_event);
+  ~IoUringAcceptSocket() override;
+
+  // IoUringSocket
+  void close(bool keep_fd_open, IoUringSocketOnClosedCb cb = nullptr) override;
+  void enableRead() override;
+  void disableRead() override;
+  os_fd_t takeAcceptedSocket() override;
+  void write(Buffer::Instance&) override { PANIC("not implement"); }
+  uint64_t write(const Buffer::RawSlice*, uint64_t) override { PANIC("not implement"); }
+  void shutdown(int) override { PANIC("not implement"); }
+  void onAccept(Request* req, int32_t result, bool injected) override;
+  void onClose(Request* req, int32_t result, bool injected) override;
+  void onCancel(Request* req, int32_t result, bool injected) override;
+
+private:
+  void submitAcceptRequest();
+  void closeAcceptedSockets();
+  void closeInternal();
+
+  // The accept request in flight. A multishot request stays in flight until it is canceled.
+  Request* accept_req_{nullptr};
+  // Cleared when the kernel does not support multishot accept, then each request accepts a single
+  // connection.
+  bool multishot_{true};
+  // Connections accepted by the kernel which have not been taken by the listener yet.
+  std::deque<os_fd_t> accepted_sockets_;
+  // Whether keep the fd open when close the IoUringSocket.
+  bool keep_fd_open_{false};
+  // This is used for tracking the accept's cancel request.
+  Request* accept_cancel_req_{nullptr};
+  // This is used for tracking the close request.
+  Request* close_req_{nullptr};
+};
+
 class IoUringClientSocket : public IoUringServerSocket {
 public:
   IoUringClientSocket(os_fd_t fd, IoUringWorkerImpl& parent, Event::FileReadyCb cb,
@@ -118,7 +118,7 @@ void ActiveTcpListener::onAcceptWorker(Network::ConnectionSocketPtr&& socket,
 
   if (!rebalanced) {
     Network::BalancedConnectionHandler& target_handler =
-        connection_balancer_.pickTargetHandler(*this);
+        connection_balancer_.pickTargetHandler(*this, *socket);
     if (&target_handler != this) {
       target_handler.post(std::move(socket));
       return;
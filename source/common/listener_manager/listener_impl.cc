@@ -23,6 +23,7 @@
 #include "source/common/listener_manager/listener_manager_impl.h"
 #include "source/common/network/connection_balancer_impl.h"
 #include "source/common/network/resolver_impl.h"
+#include "source/common/network/reuse_port_steering.h"
 #include "source/common/network/socket_option_factory.h"
 #include "source/common/network/socket_option_impl.h"
 #include "source/common/network/udp_listener_impl.h"
@@ -429,6 +430,9 @@ ListenerImpl::ListenerImpl(const envoy::config::listener::v3::Listener& config,
   SET_AND_RETURN_IF_NOT_OK(buildUdpListenerFactory(config, parent_.server_.options().concurrency()),
                            creation_status);
   buildListenSocketOptions(config, address_opts_list);
+  SET_AND_RETURN_IF_NOT_OK(
+      buildReusePortSteeringOptions(config, parent_.server_.options().concurrency()),
+      creation_status);
   SET_AND_RETURN_IF_NOT_OK(createListenerFilterFactories(config), creation_status);
   SET_AND_RETURN_IF_NOT_OK(validateFilterChains(config), creation_status);
   SET_AND_RETURN_IF_NOT_OK(buildFilterChains(config), creation_status);
@@ -567,7 +571,8 @@ ListenerImpl::buildInternalListener(const envoy::config::listener::v3::Listener&
                       name_));
     }
     if ((config.has_connection_balance_config() &&
-         config.connection_balance_config().has_exact_balance()) ||
+         (config.connection_balance_config().has_exact_balance() ||
+          config.connection_balance_config().has_cpu_affinity_balance())) ||
         config.enable_mptcp() ||
         config.has_enable_reuse_port() // internal listener doesn't use physical l4 port.
         || (config.has_freebind() && config.freebind().value()) || config.has_tcp_backlog_size() ||
@@ -746,6 +751,39 @@ void ListenerImpl::buildListenSocketOptions(
   }
 }
 
+absl::Status
+ListenerImpl::buildReusePortSteeringOptions(const envoy::config::listener::v3::Listener& config,
+                                            uint32_t concurrency) {
+  if (!config.has_reuse_port_steering()) {
+    return absl::OkStatus();
+  }
+  if (socket_type_ != Network::Socket::Type::Stream || !reuse_port_) {
+    return absl::InvalidArgumentError(fmt::format(
+        "listener {}: reuse_port_steering can only be used with TCP listeners using reuse_port",
+        name_));
+  }
+  const Network::ReusePortSteering::Mode mode =
+      config.reuse_port_steering().mode() ==
+              envoy::config::listener::v3::Listener::ReusePortSteering::CPU
+          ? Network::ReusePortSteering::Mode::Cpu
+          : Network::ReusePortSteering::Mode::SourceAddressHash;
+  // The program is attached to the reuse_port group of each address, whose sockets are created
+  // and listen in worker order.
+  auto options = std::make_shared<Network::Socket::Options>();
+  options->push_back(Network::ReusePortSteering::createSocketOption(mode, concurrency));
+  if (options->back() == nullptr) {
+    return absl::InvalidArgumentError(fmt::format(
+        "listener {}: reuse_port_steering is not supported on this platform with {} workers", name_,
+        concurrency));
+  }
+  for (size_t i = 0; i < addresses_.size(); i++) {
+    if (addresses_[i]->type() == Network::Address::Type::Ip) {
+      addListenSocketOptions(listen_socket_options_list_[i], options);
+    }
+  }
+  return absl::OkStatus();
+}
+
 absl::Status
 ListenerImpl::createListenerFilterFactories(const envoy::config::listener::v3::Listener& config) {
   if (!config.listener_filters().empty()) {
@@ -849,6 +887,13 @@ ListenerImpl::buildConnectionBalancer(const envoy::config::listener::v3::Listene
         connection_balancers_.emplace(address.asString(),
                                       std::make_shared<Network::ExactConnectionBalancerImpl>());
         break;
+      case envoy::config::listener::v3::Listener_ConnectionBalanceConfig::kCpuAffinityBalance:
+        connection_balancers_.emplace(
+            address.asString(),
+            std::make_shared<Network::CpuAffinityConnectionBalancerImpl>(
+                Network::CpuAffinityConnectionBalancerImpl::readNumaTopology(
+                    listener_factory_context_->serverFactoryContext().api().fileSystem())));
+        break;
       case envoy::config::listener::v3::Listener_ConnectionBalanceConfig::kExtendBalance: {
         const std::string connection_balance_library_type{TypeUtil::typeUrlToDescriptorFullName(
             config.connection_balance_config().extend_balance().typed_config().type_url())};
@@ -1223,7 +1268,9 @@ bool ListenerMessageUtil::socketOptionsEqual(const envoy::config::listener::v3::
       (PROTOBUF_GET_WRAPPED_OR_DEFAULT(lhs, freebind, false) !=
        PROTOBUF_GET_WRAPPED_OR_DEFAULT(rhs, freebind, false)) ||
       (PROTOBUF_GET_WRAPPED_OR_DEFAULT(lhs, tcp_fast_open_queue_length, 0) !=
-       PROTOBUF_GET_WRAPPED_OR_DEFAULT(rhs, tcp_fast_open_queue_length, 0))) {
+       PROTOBUF_GET_WRAPPED_OR_DEFAULT(rhs, tcp_fast_open_queue_length, 0)) ||
+      (lhs.has_reuse_port_steering() != rhs.has_reuse_port_steering()) ||
+      (lhs.reuse_port_steering().mode() != rhs.reuse_port_steering().mode())) {
     return false;
   }
 
@@ -409,6 +409,8 @@ private:
                                        uint32_t concurrency);
   void buildListenSocketOptions(const envoy::config::listener::v3::Listener& config,
                                 std::vector<Network::Socket::OptionsSharedPtr>& address_opts_list);
+  absl::Status buildReusePortSteeringOptions(const envoy::config::listener::v3::Listener& config,
+                                             uint32_t concurrency);
   absl::Status createListenerFilterFactories(const envoy::config::listener::v3::Listener& config);
   absl::Status validateFilterChains(const envoy::config::listener::v3::Listener& config);
   absl::Status buildFilterChains(const envoy::config::listener::v3::Listener& config);
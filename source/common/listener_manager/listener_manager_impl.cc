@@ -1060,12 +1060,23 @@ absl::Status ListenerManagerImpl::startWorkers(OptRef<GuardDog> guard_dog,
                           });
     }
   }
+  absl::optional<Event::BusyPollConfig> busy_poll_config;
+  if (server_.bootstrap().has_worker_busy_poll()) {
+    const auto& busy_poll = server_.bootstrap().worker_busy_poll();
+    busy_poll_config = Event::BusyPollConfig{
+        std::chrono::microseconds(
+            Protobuf::util::TimeUtil::DurationToMicroseconds(busy_poll.spin_duration())),
+        PROTOBUF_PERCENT_TO_DOUBLE_OR_DEFAULT(busy_poll, max_idle_spin_cpu, 50.0) / 100.0};
+  }
   for (const auto& worker : workers_) {
     ENVOY_LOG(debug, "starting worker {}", i);
     worker->start(guard_dog, worker_started_running);
     if (enable_dispatcher_stats_) {
       worker->initializeStats(*scope_);
     }
+    if (busy_poll_config.has_value()) {
+      worker->enableBusyPoll(*busy_poll_config, *scope_);
+    }
     i++;
   }
 
@@ -0,0 +1,114 @@
+#include "source/common/memory/huge_page_allocator.h"
+
+#include <cstdint>
+#include <new>
+
+#include "source/common/common/assert.h"
+#include "source/common/common/lock_guard.h"
+#include "source/common/common/thread.h"
+
+#include "absl/container/flat_hash_set.h"
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+namespace Envoy {
+namespace Memory {
+
+std::atomic<bool> HugePageRegions::enabled_{false};
+std::atomic<uint64_t> HugePageRegions::mapped_bytes_{0};
+
+#if defined(__linux__)
+namespace {
+
+size_t roundUpToHugePage(size_t bytes) {
+  return (bytes + HugePageRegions::HugePageSize - 1) & ~(HugePageRegions::HugePageSize - 1);
+}
+
+// The regions which deallocate() has to unmap, as the enabled flag may have changed since they were
+// allocated.
+struct MappedRegions {
+  Thread::MutexBasicLockable mutex_;
+  absl::flat_hash_set<void*> regions_ ABSL_GUARDED_BY(mutex_);
+};
+
+MappedRegions& mappedRegions() { MUTABLE_CONSTRUCT_ON_FIRST_USE(MappedRegions); }
+
+// Maps bytes at huge page alignment, by mapping an extra huge page and unmapping the misaligned
+// head and the tail.
+void* mapAligned(size_t bytes) {
+  const size_t map_size = bytes + HugePageRegions::HugePageSize;
+  void* mapping =
+      ::mmap(nullptr, map_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (mapping == MAP_FAILED) {
+    return nullptr;
+  }
+  const uintptr_t start = reinterpret_cast<uintptr_t>(mapping);
+  const uintptr_t aligned = (start + HugePageRegions::HugePageSize - 1) &
+                            ~static_cast<uintptr_t>(HugePageRegions::HugePageSize - 1);
+  if (aligned > start) {
+    ::munmap(mapping, aligned - start);
+  }
+  const uintptr_t end = start + map_size;
+  if (end > aligned + bytes) {
+    ::munmap(reinterpret_cast<void*>(aligned + bytes), end - aligned - bytes);
+  }
+  // Without transparent huge pages in madvise or always mode this fails, and the region is backed
+  // by regular pages.
+  ::madvise(reinterpret_cast<void*>(aligned), bytes, MADV_HUGEPAGE);
+  return reinterpret_cast<void*>(aligned);
+}
+
+} // namespace
+#endif
+
+void HugePageRegions::setEnabled(bool enabled) {
+  enabled_.store(enabled, std::memory_order_relaxed);
+}
+
+void* HugePageRegions::allocate(size_t bytes) {
+#if defined(__linux__)
+  if (enabled() && bytes >= MinRegionAllocation) {
+    const size_t region_size = roundUpToHugePage(bytes);
+    void* region = mapAligned(region_size);
+    if (region != nullptr) {
+      MappedRegions& mapped = mappedRegions();
+      {
+        Thread::LockGuard lock(mapped.mutex_);
+        mapped.regions_.insert(region);
+      }
+      mapped_bytes_.fetch_add(region_size, std::memory_order_relaxed);
+      return region;
+    }
+    // Fall back to the heap when the mapping fails.
+  }
+#endif
+  return ::operator new(bytes);
+}
+
+void HugePageRegions::deallocate(void* ptr, size_t bytes) {
+  if (ptr == nullptr) {
+    return;
+  }
+#if defined(__linux__)
+  if (bytes >= MinRegionAllocation) {
+    MappedRegions& mapped = mappedRegions();
+    bool was_mapped;
+    {
+      Thread::LockGuard lock(mapped.mutex_);
+      was_mapped = mapped.regions_.erase(ptr) > 0;
+    }
+    if (was_mapped) {
+      const size_t region_size = roundUpToHugePage(bytes);
+      RELEASE_ASSERT(::munmap(ptr, region_size) == 0, "failed to unmap huge page region");
+      mapped_bytes_.fetch_sub(region_size, std::memory_order_relaxed);
+      return;
+    }
+  }
+#endif
+  ::operator delete(ptr);
+}
+
+} // namespace Memory
+} // namespace Envoy
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace Envoy {
+namespace Memory {
+
+/**
+ * Backs large, long-lived tables with huge pages. Once enabled, allocations of at least half a huge
+ * page are rounded up to whole huge pages, mapped at huge page alignment and the kernel is asked to
+ * back them with transparent huge pages, which saves the TLB misses of tables looked up at random,
+ * such as Maglev tables. The threshold admits the Maglev table of the default table size (65537
+ * entries, about 1 MiB) while bounding the rounding overhead to the size of the table itself.
+ * Smaller allocations, and all allocations while disabled or on platforms other than Linux, use
+ * operator new.
+ */
+class HugePageRegions {
+public:
+  static constexpr size_t HugePageSize = 2 * 1024 * 1024;
+  // The smallest allocation which is backed by a huge page region.
+  static constexpr size_t MinRegionAllocation = HugePageSize / 2;
+
+  /**
+   * Enables or disables huge page regions for subsequent allocations. Existing allocations are
+   * released the way they were made.
+   */
+  static void setEnabled(bool enabled);
+
+  /**
+   * @return whether huge page regions are enabled.
+   */
+  static bool enabled() { return enabled_.load(std::memory_order_relaxed); }
+
+  /**
+   * @param bytes the size of the allocation.
+   * @return memory for bytes, which is never nullptr.
+   */
+  static void* allocate(size_t bytes);
+
+  /**
+   * @param ptr memory returned by allocate().
+   * @param bytes the size ptr was allocated with.
+   */
+  static void deallocate(void* ptr, size_t bytes);
+
+  /**
+   * @return the bytes currently mapped for huge page regions.
+   */
+  static uint64_t mappedBytes() { return mapped_bytes_.load(std::memory_order_relaxed); }
+
+private:
+  static std::atomic<bool> enabled_;
+  static std::atomic<uint64_t> mapped_bytes_;
+};
+
+/**
+ * Standard allocator for containers which allocate from HugePageRegions.
+ */
+template <typename T> class HugePageAllocator {
+public:
+  using value_type = T;
+
+  HugePageAllocator() noexcept = default;
+  template <typename U> HugePageAllocator(const HugePageAllocator<U>&) noexcept {}
+
+  T* allocate(size_t n) { return static_cast<T*>(HugePageRegions::allocate(n * sizeof(T))); }
+  void deallocate(T* p, size_t n) noexcept { HugePageRegions::deallocate(p, n * sizeof(T)); }
+
+  template <typename U> bool operator==(const HugePageAllocator<U>&) const noexcept {
+    return true;
+  }
+  template <typename U> bool operator!=(const HugePageAllocator<U>&) const noexcept {
+    return false;
+  }
+};
+
+} // namespace Memory
+} // namespace Envoy
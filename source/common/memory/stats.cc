@@ -2,9 +2,16 @@
 
 #include <atomic>
 #include <cstdint>
+#include <fstream>
+#include <string>
 
 #include "source/common/common/assert.h"
 #include "source/common/common/logger.h"
+#include "source/common/memory/huge_page_allocator.h"
+
+#include "absl/strings/ascii.h"
+#include "absl/strings/numbers.h"
+#include "absl/strings/strip.h"
 
 #if defined(TCMALLOC)
 #include "tcmalloc/malloc_extension.h"
@@ -107,6 +114,32 @@ uint64_t Stats::totalPhysicalBytes() {
 #endif
 }
 
+uint64_t Stats::totalHugePageBytes() {
+#if defined(__linux__)
+  std::ifstream smaps("/proc/self/smaps_rollup");
+  if (smaps.fail()) {
+    return 0;
+  }
+  std::string line;
+  while (std::getline(smaps, line)) {
+    absl::string_view value = line;
+    if (!absl::ConsumePrefix(&value, "AnonHugePages:")) {
+      continue;
+    }
+    // The value is in kB, e.g. "AnonHugePages:      4096 kB".
+    uint64_t kilobytes = 0;
+    if (!absl::SimpleAtoi(absl::StripSuffix(absl::StripAsciiWhitespace(value), " kB"),
+                          &kilobytes)) {
+      return 0;
+    }
+    return kilobytes * 1024;
+  }
+#endif
+  return 0;
+}
+
+uint64_t Stats::totalHugePageRegionBytes() { return HugePageRegions::mappedBytes(); }
+
 void Stats::dumpStatsToLog() {
 #if defined(TCMALLOC)
   ENVOY_LOG_MISC(debug, "TCMalloc stats:\n{}", tcmalloc::MallocExtension::GetStats());
@@ -185,6 +218,14 @@ void AllocatorManager::configureTcmallocOptions(
     ENVOY_LOG_MISC(info, "Set max unfreed memory threshold to {} bytes.",
                    config.max_unfreed_memory_bytes());
   }
+  if (config.huge_page_regions()) {
+#if defined(__linux__)
+    HugePageRegions::setEnabled(true);
+    ENVOY_LOG_MISC(info, "Enabled huge page regions for large tables.");
+#else
+    ENVOY_LOG_MISC(warn, "Huge page regions are only supported on Linux, ignoring.");
+#endif
+  }
 #if defined(TCMALLOC)
   if (config.has_soft_memory_limit_bytes()) {
     tcmalloc::MallocExtension::SetMemoryLimit(config.soft_memory_limit_bytes().value(),
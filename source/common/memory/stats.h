@@ -60,6 +60,19 @@ public:
    */
   static uint64_t totalPhysicalBytes();
 
+  /**
+   * @return uint64_t the bytes of anonymous memory of the process which the kernel currently backs
+   *                  with transparent huge pages, or 0 if not supported. This reads
+   *                  /proc/self/smaps_rollup, whose cost grows with the number of mappings, so
+   *                  it should not be called on hot paths.
+   */
+  static uint64_t totalHugePageBytes();
+
+  /**
+   * @return uint64_t the bytes mapped for huge page regions. @see HugePageRegions.
+   */
+  static uint64_t totalHugePageRegionBytes();
+
   /**
    * Log detailed stats about current memory allocation. Intended for debugging purposes.
    */
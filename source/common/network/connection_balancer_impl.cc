@@ -2,6 +2,19 @@
 
 #include <limits>
 
+#include "source/common/common/assert.h"
+
+#include "absl/strings/ascii.h"
+#include "absl/strings/numbers.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_split.h"
+
+#if defined(__linux__)
+#include <sched.h>
+
+#include "source/common/api/os_sys_calls_impl_linux.h"
+#endif
+
 namespace Envoy {
 namespace Network {
 
@@ -19,7 +32,7 @@ void ExactConnectionBalancerImpl::unregisterHandler(BalancedConnectionHandler& h
 }
 
 BalancedConnectionHandler&
-ExactConnectionBalancerImpl::pickTargetHandler(BalancedConnectionHandler&) {
+ExactConnectionBalancerImpl::pickTargetHandler(BalancedConnectionHandler&, ConnectionSocket&) {
   BalancedConnectionHandler* min_connection_handler = nullptr;
   {
     absl::MutexLock lock(lock_);
@@ -38,5 +51,161 @@ ExactConnectionBalancerImpl::pickTargetHandler(BalancedConnectionHandler&) {
   return *min_connection_handler;
 }
 
+std::vector<uint32_t> CpuAffinityConnectionBalancerImpl::parseCpuList(absl::string_view list) {
+  std::vector<uint32_t> ids;
+  for (absl::string_view range : absl::StrSplit(list, ',', absl::SkipWhitespace())) {
+    range = absl::StripAsciiWhitespace(range);
+    std::pair<absl::string_view, absl::string_view> bounds = absl::StrSplit(range, '-');
+    uint32_t first;
+    uint32_t last;
+    if (!absl::SimpleAtoi(bounds.first, &first)) {
+      return {};
+    }
+    if (bounds.second.empty()) {
+      last = first;
+    } else if (!absl::SimpleAtoi(bounds.second, &last) || last < first) {
+      return {};
+    }
+    for (uint32_t id = first; id <= last; ++id) {
+      ids.push_back(id);
+    }
+  }
+  return ids;
+}
+
+CpuAffinityConnectionBalancerImpl::CpuToNodeMap
+CpuAffinityConnectionBalancerImpl::readNumaTopology(Filesystem::Instance& file_system) {
+  CpuToNodeMap cpu_to_node;
+  constexpr absl::string_view node_root = "/sys/devices/system/node";
+  const absl::StatusOr<std::string> online =
+      file_system.fileReadToEnd(absl::StrCat(node_root, "/online"));
+  if (!online.ok()) {
+    return cpu_to_node;
+  }
+  for (const uint32_t node : parseCpuList(online.value())) {
+    const absl::StatusOr<std::string> cpus =
+        file_system.fileReadToEnd(absl::StrCat(node_root, "/node", node, "/cpulist"));
+    if (!cpus.ok()) {
+      continue;
+    }
+    for (const uint32_t cpu : parseCpuList(cpus.value())) {
+      cpu_to_node[cpu] = node;
+    }
+  }
+  return cpu_to_node;
+}
+
+CpuAffinityConnectionBalancerImpl::Placement
+CpuAffinityConnectionBalancerImpl::currentThreadPlacement() const {
+  Placement placement;
+#if defined(__linux__)
+  cpu_set_t mask;
+  CPU_ZERO(&mask);
+  const Api::SysCallIntResult result =
+      Api::LinuxOsSysCallsSingleton::get().sched_getaffinity(0, sizeof(cpu_set_t), &mask);
+  if (result.return_value_ == -1) {
+    return placement;
+  }
+  // A worker allowed to run on several CPUs is still placed on a node if all of them are on it.
+  bool single_node = true;
+  for (uint32_t cpu = 0; cpu < CPU_SETSIZE && single_node; ++cpu) {
+    if (!CPU_ISSET(cpu, &mask)) {
+      continue;
+    }
+    if (CPU_COUNT(&mask) == 1) {
+      placement.cpu_ = cpu;
+    }
+    const auto node = cpu_to_node_.find(cpu);
+    single_node = node != cpu_to_node_.end() &&
+                  (!placement.node_.has_value() || placement.node_.value() == node->second);
+    placement.node_ = single_node ? absl::make_optional(node->second) : absl::nullopt;
+  }
+#endif
+  return placement;
+}
+
+void CpuAffinityConnectionBalancerImpl::registerHandler(BalancedConnectionHandler& handler) {
+  // Handlers are registered on their own worker thread, so the affinity of the calling thread is
+  // the affinity of the handler's worker.
+  const Placement placement = currentThreadPlacement();
+  absl::MutexLock lock(lock_);
+  placements_[&handler] = placement;
+  if (placement.cpu_.has_value()) {
+    handlers_by_cpu_[placement.cpu_.value()].push_back(&handler);
+  }
+  if (placement.node_.has_value()) {
+    handlers_by_node_[placement.node_.value()].push_back(&handler);
+  }
+}
+
+void CpuAffinityConnectionBalancerImpl::unregisterHandler(BalancedConnectionHandler& handler) {
+  absl::MutexLock lock(lock_);
+  const auto placement = placements_.find(&handler);
+  ASSERT(placement != placements_.end());
+  const auto remove = [&handler](absl::flat_hash_map<uint32_t, HandlerList>& handlers,
+                                 uint32_t key) {
+    HandlerList& list = handlers[key];
+    list.erase(std::find(list.begin(), list.end(), &handler));
+    if (list.empty()) {
+      handlers.erase(key);
+    }
+  };
+  if (placement->second.cpu_.has_value()) {
+    remove(handlers_by_cpu_, placement->second.cpu_.value());
+  }
+  if (placement->second.node_.has_value()) {
+    remove(handlers_by_node_, placement->second.node_.value());
+  }
+  placements_.erase(placement);
+}
+
+BalancedConnectionHandler*
+CpuAffinityConnectionBalancerImpl::pickFrom(const HandlerList& handlers,
+                                            BalancedConnectionHandler& current_handler) {
+  // Prefer not to move the connection at all, then the least loaded of the candidates.
+  BalancedConnectionHandler* min_connection_handler = nullptr;
+  uint64_t min_connections = std::numeric_limits<uint64_t>::max();
+  for (BalancedConnectionHandler* handler : handlers) {
+    if (handler == &current_handler) {
+      return handler;
+    }
+    const uint64_t connections = handler->numConnections();
+    if (connections < min_connections) {
+      min_connections = connections;
+      min_connection_handler = handler;
+    }
+  }
+  return min_connection_handler;
+}
+
+BalancedConnectionHandler&
+CpuAffinityConnectionBalancerImpl::pickTargetHandler(BalancedConnectionHandler& current_handler,
+                                                     ConnectionSocket& socket) {
+  BalancedConnectionHandler* target = &current_handler;
+#ifdef SO_INCOMING_CPU
+  int incoming_cpu = -1;
+  socklen_t len = sizeof(incoming_cpu);
+  const Api::SysCallIntResult result =
+      socket.getSocketOption(SOL_SOCKET, SO_INCOMING_CPU, &incoming_cpu, &len);
+  if (result.return_value_ == 0 && incoming_cpu >= 0) {
+    const uint32_t cpu = incoming_cpu;
+    absl::ReaderMutexLock lock(lock_);
+    const auto by_cpu = handlers_by_cpu_.find(cpu);
+    if (by_cpu != handlers_by_cpu_.end()) {
+      target = pickFrom(by_cpu->second, current_handler);
+    } else if (const auto node = cpu_to_node_.find(cpu); node != cpu_to_node_.end()) {
+      const auto by_node = handlers_by_node_.find(node->second);
+      if (by_node != handlers_by_node_.end()) {
+        target = pickFrom(by_node->second, current_handler);
+      }
+    }
+  }
+#else
+  UNREFERENCED_PARAMETER(socket);
+#endif
+  target->incNumConnections();
+  return *target;
+}
+
 } // namespace Network
 } // namespace Envoy
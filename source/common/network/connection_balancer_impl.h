@@ -1,13 +1,17 @@
 #pragma once
 
 #include "envoy/config/listener/v3/listener.pb.h"
+#include "envoy/filesystem/filesystem.h"
 #include "envoy/network/connection_balancer.h"
 #include "envoy/registry/registry.h"
 #include "envoy/server/filter_config.h"
 
 #include "source/common/protobuf/protobuf.h"
 
+#include "absl/container/flat_hash_map.h"
+#include "absl/strings/string_view.h"
 #include "absl/synchronization/mutex.h"
+#include "absl/types/optional.h"
 
 namespace Envoy {
 namespace Network {
@@ -37,13 +41,66 @@ public:
   // ConnectionBalancer
   void registerHandler(BalancedConnectionHandler& handler) override;
   void unregisterHandler(BalancedConnectionHandler& handler) override;
-  BalancedConnectionHandler& pickTargetHandler(BalancedConnectionHandler& current_handler) override;
+  BalancedConnectionHandler& pickTargetHandler(BalancedConnectionHandler& current_handler,
+                                               ConnectionSocket& socket) override;
 
 private:
   absl::Mutex lock_;
   std::vector<BalancedConnectionHandler*> handlers_ ABSL_GUARDED_BY(lock_);
 };
 
+/**
+ * Implementation of connection balancer that keeps a connection on a handler whose worker runs on
+ * the CPU, or failing that the NUMA node, on which the kernel processed the connection's packets,
+ * as reported by SO_INCOMING_CPU. Each handler's placement is taken from the CPU affinity of its
+ * worker thread when the handler registers, so this is only effective when the workers are pinned
+ * (see the pin_worker_threads bootstrap option). Connections whose CPU is
+ * unknown, or which no handler is placed near, stay on the accepting handler.
+ */
+class CpuAffinityConnectionBalancerImpl : public ConnectionBalancer {
+public:
+  // Maps each online CPU to its NUMA node.
+  using CpuToNodeMap = absl::flat_hash_map<uint32_t, uint32_t>;
+
+  explicit CpuAffinityConnectionBalancerImpl(CpuToNodeMap cpu_to_node)
+      : cpu_to_node_(std::move(cpu_to_node)) {}
+
+  /**
+   * Read the NUMA topology of the host from sysfs. Hosts without NUMA support yield an empty map,
+   * in which case only connections received on a handler's own CPU are steered.
+   */
+  static CpuToNodeMap readNumaTopology(Filesystem::Instance& file_system);
+
+  /**
+   * Parse a list of CPUs or nodes in the kernel's list format, e.g. "0-3,8,10-11".
+   * @return the listed ids, or an empty vector if the list is malformed.
+   */
+  static std::vector<uint32_t> parseCpuList(absl::string_view list);
+
+  // ConnectionBalancer
+  void registerHandler(BalancedConnectionHandler& handler) override;
+  void unregisterHandler(BalancedConnectionHandler& handler) override;
+  BalancedConnectionHandler& pickTargetHandler(BalancedConnectionHandler& current_handler,
+                                               ConnectionSocket& socket) override;
+
+private:
+  struct Placement {
+    absl::optional<uint32_t> cpu_;
+    absl::optional<uint32_t> node_;
+  };
+  using HandlerList = std::vector<BalancedConnectionHandler*>;
+
+  Placement currentThreadPlacement() const;
+  static BalancedConnectionHandler* pickFrom(const HandlerList& handlers,
+                                             BalancedConnectionHandler& current_handler);
+
+  const CpuToNodeMap cpu_to_node_;
+  absl::Mutex lock_;
+  absl::flat_hash_map<BalancedConnectionHandler*, Placement> placements_ ABSL_GUARDED_BY(lock_);
+  absl::flat_hash_map<uint32_t, HandlerList> handlers_by_cpu_ ABSL_GUARDED_BY(lock_);
+  absl::flat_hash_map<uint32_t, HandlerList> handlers_by_node_ ABSL_GUARDED_BY(lock_);
+};
+
 /**
  * A NOP connection balancer implementation that always continues execution after incrementing
  * the handler's connection count.
@@ -53,8 +110,8 @@ public:
   // ConnectionBalancer
   void registerHandler(BalancedConnectionHandler&) override {}
   void unregisterHandler(BalancedConnectionHandler&) override {}
-  BalancedConnectionHandler&
-  pickTargetHandler(BalancedConnectionHandler& current_handler) override {
+  BalancedConnectionHandler& pickTargetHandler(BalancedConnectionHandler& current_handler,
+                                               ConnectionSocket&) override {
     // In the NOP case just increment the connection count and return the current handler.
     current_handler.incNumConnections();
     return current_handler;
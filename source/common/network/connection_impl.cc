@@ -976,6 +976,15 @@ absl::optional<uint64_t> ConnectionImpl::congestionWindowInBytes() const {
   return socket_->congestionWindowInBytes();
 }
 
+bool ConnectionImpl::canBypassBuffers() const {
+  // Wrapping transport sockets (e.g. proxy protocol or tap) derive from PassthroughSocket rather
+  // than RawBufferSocket, so only the plain raw_buffer socket passes this check. Any other filter
+  // on the connection would be skipped once bytes stop passing through the filter chain.
+  return dynamic_cast<const RawBufferSocket*>(transport_socket_.get()) != nullptr &&
+         filter_manager_.hasSingleReadFilterOnly() && read_buffer_->length() == 0 &&
+         write_buffer_->length() == 0;
+}
+
 void ConnectionImpl::flushWriteBuffer() {
   if (state() == State::Open && write_buffer_->length() > 0) {
     onWriteReady();
@@ -38,6 +38,19 @@ void FilterManagerImpl::removeReadFilter(ReadFilterSharedPtr filter_to_remove) {
   }
 }
 
+bool FilterManagerImpl::hasSingleReadFilterOnly() const {
+  if (!downstream_filters_.empty()) {
+    return false;
+  }
+  uint32_t read_filters = 0;
+  for (const auto& entry : upstream_filters_) {
+    if (entry->filter_ != nullptr && ++read_filters > 1) {
+      return false;
+    }
+  }
+  return true;
+}
+
 bool FilterManagerImpl::initializeReadFilters() {
   if (upstream_filters_.empty()) {
     return false;
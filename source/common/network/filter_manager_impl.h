@@ -122,6 +122,9 @@ public:
   void maybeClose();
   void onConnectionClose(ConnectionCloseAction close_action);
   bool pendingClose() { return state_.local_close_pending_ || state_.remote_close_pending_; }
+  // True if no write filter and at most one (not removed) read filter are installed, i.e. a single
+  // terminal read filter sees every byte of the connection.
+  bool hasSingleReadFilterOnly() const;
 
   void addAccessLogHandler(AccessLog::InstanceSharedPtr handler);
   void log(AccessLog::AccessLogType type);
@@ -40,7 +40,6 @@ IoUringSocketHandleImpl::~IoUringSocketHandleImpl() {
   // TODO(zhxie): for current usage of server socket and client socket, the check may be
   // redundant.
   if (io_uring_socket_type_ != IoUringSocketType::Unknown &&
-      io_uring_socket_type_ != IoUringSocketType::Accept &&
       io_uring_worker_factory_.currentThreadRegistered() && io_uring_socket_.has_value()) {
     if (io_uring_socket_->getStatus() != Io::IoUringSocketStatus::Closed) {
       io_uring_socket_.ref().close(false);
@@ -57,8 +56,7 @@ Api::IoCallUint64Result IoUringSocketHandleImpl::close() {
 
   ASSERT(SOCKET_VALID(fd_));
 
-  if (io_uring_socket_type_ == IoUringSocketType::Unknown ||
-      io_uring_socket_type_ == IoUringSocketType::Accept || !io_uring_socket_.has_value()) {
+  if (io_uring_socket_type_ == IoUringSocketType::Unknown || !io_uring_socket_.has_value()) {
     if (file_event_) {
       file_event_.reset();
     }
@@ -186,13 +184,30 @@ IoHandlePtr IoUringSocketHandleImpl::accept(struct sockaddr* addr, socklen_t* ad
 
   ASSERT(io_uring_socket_type_ == IoUringSocketType::Accept);
 
-  Envoy::Api::SysCallSocketResult result =
-      Api::OsSysCallsSingleton::get().accept(fd_, addr, addrlen);
-  if (SOCKET_INVALID(result.return_value_)) {
+  if (!io_uring_socket_.has_value()) {
+    Envoy::Api::SysCallSocketResult result =
+        Api::OsSysCallsSingleton::get().accept(fd_, addr, addrlen);
+    if (SOCKET_INVALID(result.return_value_)) {
+      return nullptr;
+    }
+    return std::make_unique<IoUringSocketHandleImpl>(io_uring_worker_factory_,
+                                                     result.return_value_, socket_v6only_, domain_,
+                                                     true);
+  }
+
+  os_fd_t fd = io_uring_socket_->takeAcceptedSocket();
+  if (SOCKET_INVALID(fd)) {
+    errno = SOCKET_ERROR_AGAIN;
     return nullptr;
   }
-  return std::make_unique<IoUringSocketHandleImpl>(io_uring_worker_factory_, result.return_value_,
-                                                   socket_v6only_, domain_, true);
+  // The connection was accepted by io_uring without the peer address.
+  if (addr != nullptr &&
+      Api::OsSysCallsSingleton::get().getpeername(fd, addr, addrlen).return_value_ != 0) {
+    Api::OsSysCallsSingleton::get().close(fd);
+    return nullptr;
+  }
+  return std::make_unique<IoUringSocketHandleImpl>(io_uring_worker_factory_, fd, socket_v6only_,
+                                                   domain_, true);
 }
 
 Api::SysCallIntResult IoUringSocketHandleImpl::connect(Address::InstanceConstSharedPtr address) {
@@ -268,6 +283,11 @@ void IoUringSocketHandleImpl::initializeFileEvent(Event::Dispatcher& dispatcher,
         wait_cv.wait(mutex);
       }
 
+      if (io_uring_socket_type_ == IoUringSocketType::Accept) {
+        io_uring_socket_ = io_uring_worker_factory_.getIoUringWorker()->addAcceptSocket(
+            fd, std::move(cb), events & Event::FileReadyType::Closed);
+        return;
+      }
       // Move the temporary buf to the newly created one.
       io_uring_socket_ = io_uring_worker_factory_.getIoUringWorker()->addServerSocket(
           fd, buf, std::move(cb), events & Event::FileReadyType::Closed);
@@ -276,9 +296,18 @@ void IoUringSocketHandleImpl::initializeFileEvent(Event::Dispatcher& dispatcher,
   }
 
   switch (io_uring_socket_type_) {
-  case IoUringSocketType::Accept:
-    file_event_ = dispatcher.createFileEvent(fd_, cb, trigger, events);
+  case IoUringSocketType::Accept: {
+    // A listener owned by a thread without io_uring, like the main thread, accepts through the
+    // file event, as does every listener unless io_uring accept is enabled.
+    OptRef<Io::IoUringWorker> io_uring_worker = io_uring_worker_factory_.getIoUringWorker();
+    if (!io_uring_worker_factory_.acceptEnabled() || !io_uring_worker.has_value()) {
+      file_event_ = dispatcher.createFileEvent(fd_, cb, trigger, events);
+      break;
+    }
+    io_uring_socket_ = io_uring_worker->addAcceptSocket(fd_, std::move(cb),
+                                                        events & Event::FileReadyType::Closed);
     break;
+  }
   case IoUringSocketType::Server:
     io_uring_socket_ = io_uring_worker_factory_.getIoUringWorker()->addServerSocket(
         fd_, std::move(cb), events & Event::FileReadyType::Closed);
@@ -297,6 +326,12 @@ void IoUringSocketHandleImpl::activateFileEvents(uint32_t events) {
             ioUringSocketTypeStr());
 
   if (io_uring_socket_type_ == IoUringSocketType::Accept) {
+    if (io_uring_socket_.has_value()) {
+      if (events & Event::FileReadyType::Read) {
+        io_uring_socket_->injectCompletion(Io::Request::RequestType::Accept);
+      }
+      return;
+    }
     ASSERT(file_event_ != nullptr);
     file_event_->activate(events);
     return;
@@ -314,7 +349,7 @@ void IoUringSocketHandleImpl::enableFileEvents(uint32_t events) {
   ENVOY_LOG(trace, "enable file events {}, fd = {}, type = {}", events, fd_,
             ioUringSocketTypeStr());
 
-  if (io_uring_socket_type_ == IoUringSocketType::Accept) {
+  if (io_uring_socket_type_ == IoUringSocketType::Accept && !io_uring_socket_.has_value()) {
     ASSERT(file_event_ != nullptr);
     file_event_->setEnabled(events);
     return;
@@ -331,7 +366,7 @@ void IoUringSocketHandleImpl::enableFileEvents(uint32_t events) {
 void IoUringSocketHandleImpl::resetFileEvents() {
   ENVOY_LOG(trace, "reset file events, fd = {}, type = {}", fd_, ioUringSocketTypeStr());
 
-  if (io_uring_socket_type_ == IoUringSocketType::Accept) {
+  if (io_uring_socket_type_ == IoUringSocketType::Accept && !io_uring_socket_.has_value()) {
     file_event_.reset();
     return;
   }
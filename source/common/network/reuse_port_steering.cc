@@ -0,0 +1,232 @@
+#include "source/common/network/reuse_port_steering.h"
+
+#include <array>
+
+#include "envoy/common/platform.h"
+
+#include "source/common/common/assert.h"
+#include "source/common/common/safe_memcpy.h"
+#include "source/common/network/socket_option_impl.h"
+
+#if defined(__linux__)
+#include <sched.h>
+
+#include "source/common/api/os_sys_calls_impl_linux.h"
+#endif
+
+namespace Envoy {
+namespace Network {
+namespace {
+
+// Multipliers of the MurmurHash3 finalizer, which the programs use to mix 32 bit values.
+constexpr uint32_t MixMultiplier1 = 0x85ebca6b;
+constexpr uint32_t MixMultiplier2 = 0xc2b2ae35;
+
+constexpr uint32_t mix(uint32_t value) {
+  value ^= value >> 16;
+  value *= MixMultiplier1;
+  value ^= value >> 13;
+  value *= MixMultiplier2;
+  value ^= value >> 16;
+  return value;
+}
+
+// The rendezvous hashing weight of a socket for a hash. The seed of a socket only depends on its
+// index, so the weights of the remaining sockets are unchanged when sockets are added or removed.
+uint32_t weight(uint32_t hash, uint32_t index) {
+  uint32_t value = (hash ^ mix(index + 1)) * MixMultiplier1;
+  value ^= value >> 13;
+  value *= MixMultiplier2;
+  return value ^ (value >> 16);
+}
+
+#if defined(__linux__) && defined(SO_ATTACH_REUSEPORT_CBPF)
+// Keeps the program alive for as long as the option, since the sock_fprog passed to setsockopt()
+// only points to it.
+class ReusePortProgramOption : public Socket::Option {
+public:
+  explicit ReusePortProgramOption(std::vector<sock_filter>&& filter)
+      : filter_(std::move(filter)), program_{static_cast<unsigned short>(filter_.size()),
+                                             filter_.data()},
+        option_(envoy::config::core::v3::SocketOption::STATE_LISTENING,
+                ENVOY_ATTACH_REUSEPORT_CBPF,
+                absl::string_view(reinterpret_cast<const char*>(&program_), sizeof(program_))) {}
+
+  // Socket::Option
+  bool setOption(Socket& socket,
+                 envoy::config::core::v3::SocketOption::SocketState state) const override {
+    return option_.setOption(socket, state);
+  }
+  void hashKey(std::vector<uint8_t>& hash_key) const override {
+    const uint8_t* begin = reinterpret_cast<const uint8_t*>(filter_.data());
+    hash_key.insert(hash_key.end(), begin, begin + filter_.size() * sizeof(sock_filter));
+  }
+  absl::optional<Details>
+  getOptionDetails(const Socket& socket,
+                   envoy::config::core::v3::SocketOption::SocketState state) const override {
+    return option_.getOptionDetails(socket, state);
+  }
+  bool isSupported() const override { return option_.isSupported(); }
+
+private:
+  const std::vector<sock_filter> filter_;
+  const sock_fprog program_;
+  const SocketOptionImpl option_;
+};
+#endif
+
+} // namespace
+
+Socket::OptionConstSharedPtr ReusePortSteering::createSocketOption(Mode mode,
+                                                                   uint32_t num_sockets) {
+  ASSERT(num_sockets > 0);
+#if defined(__linux__) && defined(SO_ATTACH_REUSEPORT_CBPF)
+  switch (mode) {
+  case Mode::Cpu:
+    return std::make_shared<ReusePortProgramOption>(cpuProgram(num_sockets));
+  case Mode::SourceAddressHash:
+    if (num_sockets > MaxSourceAddressHashSockets) {
+      ENVOY_LOG(warn, "source address reuse_port steering supports at most {} workers, not {}",
+                MaxSourceAddressHashSockets, num_sockets);
+      return nullptr;
+    }
+    return std::make_shared<ReusePortProgramOption>(sourceAddressHashProgram(num_sockets));
+  }
+  PANIC_DUE_TO_CORRUPT_ENUM;
+#else
+  UNREFERENCED_PARAMETER(mode);
+  UNREFERENCED_PARAMETER(num_sockets);
+  return nullptr;
+#endif
+}
+
+uint32_t ReusePortSteering::sourceAddressHash(const Address::Ip& address) {
+  if (address.ipv4() != nullptr) {
+    return ntohl(address.ipv4()->address());
+  }
+  const Address::InstanceConstSharedPtr v4 = address.ipv6()->v4CompatibleAddress();
+  if (v4 != nullptr) {
+    return ntohl(v4->ip()->ipv4()->address());
+  }
+  const absl::uint128 address_bytes = address.ipv6()->address();
+  std::array<uint32_t, 4> words;
+  safeMemcpy(&words, &address_bytes);
+  uint32_t hash = ntohl(words[0]);
+  for (size_t i = 1; i < words.size(); ++i) {
+    hash = (hash * MixMultiplier1) ^ ntohl(words[i]);
+  }
+  return hash;
+}
+
+uint32_t ReusePortSteering::pickBySourceAddressHash(uint32_t hash, uint32_t num_sockets) {
+  uint32_t picked = 0;
+  uint32_t max_weight = 0;
+  for (uint32_t index = 0; index < num_sockets; ++index) {
+    const uint32_t index_weight = weight(hash, index);
+    if (index_weight > max_weight) {
+      max_weight = index_weight;
+      picked = index;
+    }
+  }
+  return picked;
+}
+
+#if defined(__linux__) && defined(SO_ATTACH_REUSEPORT_CBPF)
+std::vector<sock_filter> ReusePortSteering::cpuProgram(uint32_t num_sockets) {
+  std::vector<sock_filter> filter{
+      BPF_STMT(BPF_LD | BPF_W | BPF_ABS, static_cast<uint32_t>(SKF_AD_OFF + SKF_AD_CPU)),
+  };
+  // The i-th CPU of the process' affinity maps to worker i, which is the CPU the worker is pinned
+  // to by the pin_worker_threads bootstrap option.
+  cpu_set_t mask;
+  CPU_ZERO(&mask);
+  const Api::SysCallIntResult result =
+      Api::LinuxOsSysCallsSingleton::get().sched_getaffinity(0, sizeof(cpu_set_t), &mask);
+  if (result.return_value_ == 0) {
+    uint32_t rank = 0;
+    for (uint32_t cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+      if (CPU_ISSET(cpu, &mask)) {
+        // if (A == cpu) return rank % num_sockets;
+        filter.push_back(BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, cpu, 0, 1));
+        filter.push_back(BPF_STMT(BPF_RET | BPF_K, rank++ % num_sockets));
+      }
+    }
+  }
+  // Any other CPU falls back to the CPU number itself.
+  filter.push_back(BPF_STMT(BPF_ALU | BPF_MOD | BPF_K, num_sockets));
+  filter.push_back(BPF_STMT(BPF_RET | BPF_A, 0));
+  return filter;
+}
+
+std::vector<sock_filter> ReusePortSteering::sourceAddressHashProgram(uint32_t num_sockets) {
+  // The program runs with the packet data at the TCP payload, so the IP header is read at the
+  // negative SKF_NET_OFF offsets. M[0] holds the hash of the source address, M[1] the largest
+  // weight so far and M[2] the index of its socket.
+  const auto load_net_word = [](uint32_t offset) {
+    return BPF_STMT(BPF_LD | BPF_W | BPF_ABS, static_cast<uint32_t>(SKF_NET_OFF) + offset);
+  };
+  const std::vector<sock_filter> ipv6_hash{
+      load_net_word(8),
+      BPF_STMT(BPF_ALU | BPF_MUL | BPF_K, MixMultiplier1),
+      BPF_STMT(BPF_MISC | BPF_TAX, 0),
+      load_net_word(12),
+      BPF_STMT(BPF_ALU | BPF_XOR | BPF_X, 0),
+      BPF_STMT(BPF_ALU | BPF_MUL | BPF_K, MixMultiplier1),
+      BPF_STMT(BPF_MISC | BPF_TAX, 0),
+      load_net_word(16),
+      BPF_STMT(BPF_ALU | BPF_XOR | BPF_X, 0),
+      BPF_STMT(BPF_ALU | BPF_MUL | BPF_K, MixMultiplier1),
+      BPF_STMT(BPF_MISC | BPF_TAX, 0),
+      load_net_word(20),
+      BPF_STMT(BPF_ALU | BPF_XOR | BPF_X, 0),
+      BPF_STMT(BPF_ST, 0),
+  };
+  const std::vector<sock_filter> ipv4_hash{
+      load_net_word(12),
+      BPF_STMT(BPF_ST, 0),
+  };
+
+  std::vector<sock_filter> filter{
+      // if ((ip[0] >> 4) != 6) goto ipv4_hash;
+      BPF_STMT(BPF_LD | BPF_B | BPF_ABS, static_cast<uint32_t>(SKF_NET_OFF)),
+      BPF_STMT(BPF_ALU | BPF_RSH | BPF_K, 4),
+      BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, 6, 0, static_cast<uint8_t>(ipv6_hash.size() + 1)),
+  };
+  filter.insert(filter.end(), ipv6_hash.begin(), ipv6_hash.end());
+  filter.push_back(BPF_STMT(BPF_JMP | BPF_JA, static_cast<uint32_t>(ipv4_hash.size())));
+  filter.insert(filter.end(), ipv4_hash.begin(), ipv4_hash.end());
+  filter.push_back(BPF_STMT(BPF_LD | BPF_IMM, 0));
+  filter.push_back(BPF_STMT(BPF_ST, 1));
+  filter.push_back(BPF_STMT(BPF_ST, 2));
+
+  // The same computation as weight() and pickBySourceAddressHash(), unrolled over the sockets.
+  for (uint32_t index = 0; index < num_sockets; ++index) {
+    const std::vector<sock_filter> pick{
+        BPF_STMT(BPF_LD | BPF_MEM, 0),
+        BPF_STMT(BPF_ALU | BPF_XOR | BPF_K, mix(index + 1)),
+        BPF_STMT(BPF_ALU | BPF_MUL | BPF_K, MixMultiplier1),
+        BPF_STMT(BPF_MISC | BPF_TAX, 0),
+        BPF_STMT(BPF_ALU | BPF_RSH | BPF_K, 13),
+        BPF_STMT(BPF_ALU | BPF_XOR | BPF_X, 0),
+        BPF_STMT(BPF_ALU | BPF_MUL | BPF_K, MixMultiplier2),
+        BPF_STMT(BPF_MISC | BPF_TAX, 0),
+        BPF_STMT(BPF_ALU | BPF_RSH | BPF_K, 16),
+        BPF_STMT(BPF_ALU | BPF_XOR | BPF_X, 0),
+        // if (A > M[1]) { M[1] = A; M[2] = index; }
+        BPF_STMT(BPF_LDX | BPF_MEM, 1),
+        BPF_JUMP(BPF_JMP | BPF_JGT | BPF_X, 0, 0, 3),
+        BPF_STMT(BPF_ST, 1),
+        BPF_STMT(BPF_LD | BPF_IMM, index),
+        BPF_STMT(BPF_ST, 2),
+    };
+    filter.insert(filter.end(), pick.begin(), pick.end());
+  }
+  filter.push_back(BPF_STMT(BPF_LD | BPF_MEM, 2));
+  filter.push_back(BPF_STMT(BPF_RET | BPF_A, 0));
+  ASSERT(filter.size() <= BPF_MAXINSNS);
+  return filter;
+}
+#endif
+
+} // namespace Network
+} // namespace Envoy
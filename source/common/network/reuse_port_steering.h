@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "envoy/network/address.h"
+#include "envoy/network/socket.h"
+
+#include "source/common/common/logger.h"
+
+#if defined(__linux__)
+#include <linux/filter.h>
+#endif
+
+namespace Envoy {
+namespace Network {
+
+/**
+ * Builds the classic BPF programs which steer the connections of a TCP listener using reuse_port
+ * to one of its per-worker sockets, instead of leaving the choice to the kernel's hash of the
+ * 4-tuple. The program is attached to the reuse_port group with SO_ATTACH_REUSEPORT_CBPF and
+ * returns the index of a socket in the group, which is the index of its worker as long as the
+ * sockets listen in worker order.
+ *
+ * Attaching a program replaces the program of the whole group, so the sockets a hot restarted
+ * child inherits from its parent are steered by the child's program as soon as it listens on them.
+ */
+class ReusePortSteering : Logger::Loggable<Logger::Id::config> {
+public:
+  enum class Mode {
+    // Steer by the CPU which processed the connection's SYN, mapping the i-th CPU the process may
+    // run on to worker i (modulo the number of workers). Together with receive side scaling and
+    // pinned workers, this keeps a connection on the core its packets arrive on.
+    Cpu,
+    // Steer by rendezvous hashing of the source address, so that connections from one address
+    // always land on the same worker, and changing the number of workers only moves the addresses
+    // of the workers which were added or removed.
+    SourceAddressHash,
+  };
+
+  // The largest number of workers the source address program supports, which bounds its length.
+  static constexpr uint32_t MaxSourceAddressHashSockets = 256;
+
+  /**
+   * @param mode supplies the steering mode.
+   * @param num_sockets supplies the number of sockets in the reuse_port group.
+   * @return the option attaching the program on listening sockets, or nullptr if the platform does
+   *         not support SO_ATTACH_REUSEPORT_CBPF or the mode does not support num_sockets.
+   */
+  static Socket::OptionConstSharedPtr createSocketOption(Mode mode, uint32_t num_sockets);
+
+  /**
+   * @return the hash the source address program computes for a source address. IPv4-mapped IPv6
+   *         addresses hash like the IPv4 address, as their packets carry an IPv4 header.
+   */
+  static uint32_t sourceAddressHash(const Address::Ip& address);
+
+  /**
+   * @return the index of the socket the source address program picks for a hash.
+   */
+  static uint32_t pickBySourceAddressHash(uint32_t hash, uint32_t num_sockets);
+
+private:
+#if defined(__linux__) && defined(SO_ATTACH_REUSEPORT_CBPF)
+  static std::vector<sock_filter> cpuProgram(uint32_t num_sockets);
+  static std::vector<sock_filter> sourceAddressHashProgram(uint32_t num_sockets);
+#endif
+};
+
+} // namespace Network
+} // namespace Envoy
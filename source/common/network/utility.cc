@@ -19,6 +19,7 @@
 #include "source/common/buffer/buffer_impl.h"
 #include "source/common/common/assert.h"
 #include "source/common/common/fmt.h"
+#include "source/common/common/safe_memcpy.h"
 #include "source/common/common/utility.h"
 #include "source/common/network/address_impl.h"
 #include "source/common/network/io_socket_error_impl.h"
@@ -524,6 +525,125 @@ Api::IoCallUint64Result Utility::writeToSocket(IoHandle& handle, Buffer::RawSlic
 
 namespace {
 
+#if ENVOY_MMSG_MORE
+Api::IoCallUint64Result writeBatchWithSendmmsg(IoHandle& handle,
+                                               absl::Span<const Buffer::InstancePtr> packets,
+                                               const Address::Instance& peer_address,
+                                               bool allow_gso) {
+  // The kernel limits a GSO message to 64 segments and to the payload of a single UDP datagram.
+  constexpr size_t MaxGsoSegments = 64;
+  constexpr uint64_t MaxGsoPayload = 65507;
+  // The kernel handles at most UIO_MAXIOV messages per sendmmsg() call.
+  constexpr size_t MaxMessagesPerCall = 1024;
+  struct GsoControl {
+    alignas(cmsghdr) char buffer_[CMSG_SPACE(sizeof(uint16_t))];
+  };
+
+  Api::OsSysCalls& os_sys_calls = Api::OsSysCallsSingleton::get();
+  const bool use_gso = allow_gso && os_sys_calls.supportsUdpGso();
+
+  // The iovecs of all packets, where the iovecs of packet i start at iov_offsets[i].
+  std::vector<iovec> iovs;
+  iovs.reserve(packets.size());
+  absl::FixedArray<size_t> iov_offsets(packets.size() + 1);
+  for (size_t i = 0; i < packets.size(); ++i) {
+    iov_offsets[i] = iovs.size();
+    for (const Buffer::RawSlice& slice : packets[i]->getRawSlices()) {
+      iovs.push_back({slice.mem_, slice.len_});
+    }
+  }
+  iov_offsets[packets.size()] = iovs.size();
+
+  absl::FixedArray<mmsghdr> messages(packets.size());
+  absl::FixedArray<GsoControl> controls(use_gso ? packets.size() : 0);
+  absl::FixedArray<size_t> packets_per_message(packets.size());
+  size_t num_messages = 0;
+  for (size_t first = 0; first < packets.size();) {
+    // A GSO message carries packets of one segment size, of which only the last may be shorter.
+    const uint64_t segment_size = packets[first]->length();
+    uint64_t payload = segment_size;
+    size_t last = first + 1;
+    while (use_gso && segment_size > 0 && last < packets.size() &&
+           last - first < MaxGsoSegments && packets[last - 1]->length() == segment_size &&
+           packets[last]->length() <= segment_size &&
+           payload + packets[last]->length() <= MaxGsoPayload) {
+      payload += packets[last]->length();
+      ++last;
+    }
+
+    mmsghdr& message = messages[num_messages];
+    memset(&message, 0, sizeof(message));
+    message.msg_hdr.msg_iov = iovs.data() + iov_offsets[first];
+    message.msg_hdr.msg_iovlen = iov_offsets[last] - iov_offsets[first];
+    if (last - first > 1) {
+      message.msg_hdr.msg_control = controls[num_messages].buffer_;
+      message.msg_hdr.msg_controllen = sizeof(controls[num_messages].buffer_);
+      cmsghdr* cmsg = CMSG_FIRSTHDR(&message.msg_hdr);
+      cmsg->cmsg_level = IPPROTO_UDP;
+      cmsg->cmsg_type = UDP_SEGMENT;
+      cmsg->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+      const uint16_t gso_size = segment_size;
+      safeMemcpyUnsafeDst(CMSG_DATA(cmsg), &gso_size);
+    }
+    packets_per_message[num_messages++] = last - first;
+    first = last;
+  }
+
+  uint64_t packets_sent = 0;
+  for (size_t next = 0; next < num_messages;) {
+    const Api::SysCallIntResult result = os_sys_calls.sendmmsg(
+        handle.fdDoNotUse(), &messages[next],
+        static_cast<unsigned int>(std::min(num_messages - next, MaxMessagesPerCall)), 0);
+    if (result.return_value_ < 0) {
+      if (result.errno_ == SOCKET_ERROR_INTR) {
+        continue;
+      }
+      if (packets_per_message[next] > 1 &&
+          (result.errno_ == SOCKET_ERROR_INVAL || result.errno_ == EIO)) {
+        // The segment size exceeds the path MTU or the device does not support GSO checksums, so
+        // send the remaining packets one by one.
+        ENVOY_LOG_MISC(debug, "sendmmsg with UDP GSO failed with error {}, retrying without GSO",
+                       result.errno_);
+        Api::IoCallUint64Result rest = Utility::writeBatchToConnectedSocket(
+            handle, packets.subspan(packets_sent), peer_address, false);
+        return {packets_sent + rest.return_value_, std::move(rest.err_)};
+      }
+      ENVOY_LOG_MISC(debug, "sendmmsg failed with error {}", result.errno_);
+      return {packets_sent, IoSocketError::create(result.errno_)};
+    }
+    for (int i = 0; i < result.return_value_; ++i) {
+      packets_sent += packets_per_message[next++];
+    }
+  }
+  ENVOY_LOG_MISC(trace, "sendmmsg sent {} packets in {} messages", packets_sent, num_messages);
+  return {packets_sent, Api::IoError::none()};
+}
+#endif
+
+} // namespace
+
+Api::IoCallUint64Result Utility::writeBatchToConnectedSocket(
+    IoHandle& handle, absl::Span<const Buffer::InstancePtr> packets,
+    const Address::Instance& peer_address, bool allow_gso) {
+  ASSERT(handle.wasConnected());
+#if ENVOY_MMSG_MORE
+  if (handle.supportsMmsg()) {
+    return writeBatchWithSendmmsg(handle, packets, peer_address, allow_gso);
+  }
+#else
+  UNREFERENCED_PARAMETER(allow_gso);
+#endif
+  for (size_t i = 0; i < packets.size(); ++i) {
+    Api::IoCallUint64Result result = writeToSocket(handle, *packets[i], nullptr, peer_address);
+    if (!result.ok()) {
+      return {i, std::move(result.err_)};
+    }
+  }
+  return {packets.size(), Api::IoError::none()};
+}
+
+namespace {
+
 void passPayloadToProcessor(uint64_t bytes_read, Buffer::InstancePtr buffer,
                             Address::InstanceConstSharedPtr peer_addess,
                             Address::InstanceConstSharedPtr local_address,
@@ -18,6 +18,7 @@
 #endif
 
 #include "absl/strings/string_view.h"
+#include "absl/types/span.h"
 
 namespace Envoy {
 namespace Network {
@@ -314,6 +315,21 @@ public:
                                                const Address::Ip* local_ip,
                                                const Address::Instance& peer_address);
 
+  /**
+   * Send a batch of packets via given connected UDP socket with as few system calls as possible.
+   * The packets are sent with sendmmsg() if the platform supports it, and consecutive packets of
+   * the same size are sent as one UDP GSO message if the platform supports it and allow_gso is set.
+   * @param handle is the connected UDP socket used to send.
+   * @param packets supplies the packets to send, in order.
+   * @param peer_address is the address the socket is connected to.
+   * @param allow_gso supplies whether packets may be coalesced with UDP GSO.
+   * @return the number of packets sent. The error is set if it stopped the remaining packets from
+   *         being sent.
+   */
+  static Api::IoCallUint64Result
+  writeBatchToConnectedSocket(IoHandle& handle, absl::Span<const Buffer::InstancePtr> packets,
+                              const Address::Instance& peer_address, bool allow_gso);
+
   /**
    * Read a packet from a given UDP socket and pass the packet to given UdpPacketProcessor.
    * @param handle is the UDP socket to read from.
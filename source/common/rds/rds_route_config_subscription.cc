@@ -43,7 +43,8 @@ RdsRouteConfigSubscription::RdsRouteConfigSubscription(
                          [this]() { subscription_->start({route_config_name_}); }),
       local_init_manager_(fmt::format("{} local-init-manager {}", rds_type, route_config_name_)),
       stat_prefix_(stat_prefix), rds_type_(rds_type),
-      stats_({ALL_RDS_STATS(POOL_COUNTER(*scope_), POOL_GAUGE(*scope_))}),
+      stats_({ALL_RDS_STATS(POOL_COUNTER(*scope_), POOL_GAUGE(*scope_),
+                            POOL_HISTOGRAM(*scope_))}),
       route_config_provider_manager_(route_config_provider_manager),
       manager_identifier_(manager_identifier), config_update_info_(std::move(config_update)),
       resource_decoder_(std::move(resource_decoder)) {
@@ -105,7 +106,9 @@ absl::Status RdsRouteConfigSubscription::onConfigUpdate(
   }
   std::unique_ptr<Init::ManagerImpl> noop_init_manager;
   std::unique_ptr<Cleanup> resume_rds;
+  const ConfigLoadMeasurement load_measurement(factory_context_.timeSource());
   if (config_update_info_->onRdsUpdate(route_config, version_info)) {
+    load_measurement.record(stats_.config_load_time_, stats_.config_load_memory_growth_);
     stats_.config_reload_.inc();
     stats_.config_reload_time_ms_.set(DateUtil::nowToMilliseconds(factory_context_.timeSource()));
 
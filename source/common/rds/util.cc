@@ -1,5 +1,9 @@
 #include "source/common/rds/util.h"
 
+#include <chrono>
+
+#include "source/common/memory/stats.h"
+
 namespace Envoy {
 namespace Rds {
 
@@ -20,5 +24,22 @@ std::string resourceName(ProtoTraits& proto_traits, const Protobuf::Message& rc)
   return reflection->GetString(*reflectable_message, field);
 }
 
+ConfigLoadMeasurement::ConfigLoadMeasurement(TimeSource& time_source)
+    : time_source_(time_source), start_(time_source.monotonicTime()),
+      start_allocated_bytes_(Memory::Stats::totalCurrentlyAllocated()) {}
+
+void ConfigLoadMeasurement::record(Stats::Histogram& load_time,
+                                   Stats::Histogram& load_memory_growth) const {
+  load_time.recordValue(std::chrono::duration_cast<std::chrono::milliseconds>(
+                            time_source_.monotonicTime() - start_)
+                            .count());
+  if (start_allocated_bytes_ == 0) {
+    return;
+  }
+  const uint64_t allocated_bytes = Memory::Stats::totalCurrentlyAllocated();
+  load_memory_growth.recordValue(
+      allocated_bytes > start_allocated_bytes_ ? allocated_bytes - start_allocated_bytes_ : 0);
+}
+
 } // namespace Rds
 } // namespace Envoy
@@ -1,6 +1,8 @@
 #pragma once
 
+#include "envoy/common/time.h"
 #include "envoy/rds/config_traits.h"
+#include "envoy/stats/histogram.h"
 
 namespace Envoy {
 namespace Rds {
@@ -8,5 +10,27 @@ namespace Rds {
 ProtobufTypes::MessagePtr cloneProto(ProtoTraits& proto_traits, const Protobuf::Message& rc);
 std::string resourceName(ProtoTraits& proto_traits, const Protobuf::Message& rc);
 
+/**
+ * Measures the load of a route configuration update, from construction until record().
+ */
+class ConfigLoadMeasurement {
+public:
+  explicit ConfigLoadMeasurement(TimeSource& time_source);
+
+  /**
+   * Records how long the load took and by how much it grew the allocated memory. The growth is the
+   * bytes allocated minus the bytes freed during the load, so memory which was only used while
+   * loading is not included. It is only recorded when the allocator reports the allocated memory,
+   * which is when Envoy is built with tcmalloc.
+   */
+  void record(Stats::Histogram& load_time, Stats::Histogram& load_memory_growth) const;
+
+private:
+  TimeSource& time_source_;
+  const MonotonicTime start_;
+  // 0 if the allocator does not report the allocated memory.
+  const uint64_t start_allocated_bytes_;
+};
+
 } // namespace Rds
 } // namespace Envoy
@@ -44,6 +44,7 @@
 #include "source/common/protobuf/utility.h"
 #include "source/common/router/context_impl.h"
 #include "source/common/router/header_cluster_specifier.h"
+#include "source/common/router/header_parser_pool.h"
 #include "source/common/router/matcher_visitor.h"
 #include "source/common/router/weighted_cluster_specifier.h"
 #include "source/common/runtime/runtime_features.h"
@@ -583,14 +584,14 @@ RouteEntryImplBase::RouteEntryImplBase(const CommonVirtualHostSharedPtr& vhost,
   }
 
   if (!route.request_headers_to_add().empty() || !route.request_headers_to_remove().empty()) {
-    auto parser_or_error =
-        HeaderParser::configure(route.request_headers_to_add(), route.request_headers_to_remove());
+    auto parser_or_error = HeaderParserPool::configure(
+        route.request_headers_to_add(), route.request_headers_to_remove(), factory_context);
     SET_AND_RETURN_IF_NOT_OK(parser_or_error.status(), creation_status);
     request_headers_parser_ = std::move(parser_or_error.value());
   }
   if (!route.response_headers_to_add().empty() || !route.response_headers_to_remove().empty()) {
-    auto parser_or_error = HeaderParser::configure(route.response_headers_to_add(),
-                                                   route.response_headers_to_remove());
+    auto parser_or_error = HeaderParserPool::configure(
+        route.response_headers_to_add(), route.response_headers_to_remove(), factory_context);
     SET_AND_RETURN_IF_NOT_OK(parser_or_error.status(), creation_status);
     response_headers_parser_ = std::move(parser_or_error.value());
   }
@@ -1609,17 +1610,17 @@ CommonVirtualHostImpl::CommonVirtualHostImpl(
 
   if (!virtual_host.request_headers_to_add().empty() ||
       !virtual_host.request_headers_to_remove().empty()) {
-    request_headers_parser_ =
-        THROW_OR_RETURN_VALUE(HeaderParser::configure(virtual_host.request_headers_to_add(),
-                                                      virtual_host.request_headers_to_remove()),
-                              Router::HeaderParserPtr);
+    request_headers_parser_ = THROW_OR_RETURN_VALUE(
+        HeaderParserPool::configure(virtual_host.request_headers_to_add(),
+                                    virtual_host.request_headers_to_remove(), factory_context),
+        Router::HeaderParserConstSharedPtr);
   }
   if (!virtual_host.response_headers_to_add().empty() ||
       !virtual_host.response_headers_to_remove().empty()) {
-    response_headers_parser_ =
-        THROW_OR_RETURN_VALUE(HeaderParser::configure(virtual_host.response_headers_to_add(),
-                                                      virtual_host.response_headers_to_remove()),
-                              Router::HeaderParserPtr);
+    response_headers_parser_ = THROW_OR_RETURN_VALUE(
+        HeaderParserPool::configure(virtual_host.response_headers_to_add(),
+                                    virtual_host.response_headers_to_remove(), factory_context),
+        Router::HeaderParserConstSharedPtr);
   }
 
   // Retry and Hedge policies must be set before routes, since they may use them.
@@ -1796,17 +1797,40 @@ VirtualHostImpl::VirtualHostImpl(const envoy::config::route::v3::VirtualHost& vi
       SET_AND_RETURN_IF_NOT_OK(route_or_error.status(), creation_status);
       routes_.emplace_back(route_or_error.value());
     }
+    if (Runtime::runtimeFeatureEnabled("envoy.reloadable_features.route_index")) {
+      auto route_index = std::make_unique<RouteIndex>();
+      for (const auto& route : routes_) {
+        route_index->addRoute(route->matchType(), route->matcher(),
+                              route->pathMatchIsCaseSensitive());
+      }
+      if (route_index->indexedRoutes() > 0) {
+        route_index_ = std::move(route_index);
+      }
+    }
+    if (Runtime::runtimeFeatureEnabled("envoy.reloadable_features.regex_route_sets")) {
+      regex_route_sets_ =
+          RegexRouteSets::create(virtual_host.routes(), factory_context.regexEngine());
+    }
   }
 }
 
 RouteConstSharedPtr VirtualHostImpl::getRouteFromRoutes(
     const RouteCallback& cb, const Http::RequestHeaderMap& headers,
     const StreamInfo::StreamInfo& stream_info, uint64_t random_value,
-    absl::Span<const RouteEntryImplBaseConstSharedPtr> routes) const {
+    absl::Span<const RouteEntryImplBaseConstSharedPtr> routes,
+    const RegexRouteSets* regex_route_sets) const {
+  absl::optional<RegexRouteSets::Lookup> regex_lookup;
+  if (regex_route_sets != nullptr && headers.Path()) {
+    regex_lookup.emplace(*regex_route_sets, pathForMatching(headers));
+  }
+
   for (auto route = routes.begin(); route != routes.end(); ++route) {
     if (!headers.Path() && !(*route)->supportsPathlessHeaders()) {
       continue;
     }
+    if (regex_lookup.has_value() && !regex_lookup->mayMatch(route - routes.begin())) {
+      continue;
+    }
 
     RouteConstSharedPtr route_entry = (*route)->matches(headers, stream_info, random_value);
     if (route_entry == nullptr) {
@@ -1885,8 +1909,46 @@ RouteConstSharedPtr VirtualHostImpl::getRouteFromEntries(const RouteCallback& cb
     return nullptr;
   }
 
-  // Check for a route that matches the request.
-  return getRouteFromRoutes(cb, headers, stream_info, random_value, routes_);
+  // Check for a route that matches the request. The index does not tell the callback whether
+  // more routes follow a match, so callbacks walk all routes.
+  if (route_index_ != nullptr && cb == nullptr && headers.Path()) {
+    return getRouteFromIndex(headers, stream_info, random_value);
+  }
+  return getRouteFromRoutes(cb, headers, stream_info, random_value, routes_,
+                            regex_route_sets_.get());
+}
+
+absl::string_view VirtualHostImpl::pathForMatching(const Http::RequestHeaderMap& headers) const {
+  absl::string_view path = Http::PathUtil::removeQueryAndFragment(headers.getPathValue());
+  if (shared_virtual_host_->globalRouteConfig().ignorePathParametersInPathMatching()) {
+    path = path.substr(0, path.find(';'));
+  }
+  return path;
+}
+
+RouteConstSharedPtr VirtualHostImpl::getRouteFromIndex(const Http::RequestHeaderMap& headers,
+                                                       const StreamInfo::StreamInfo& stream_info,
+                                                       uint64_t random_value) const {
+  const absl::string_view path = pathForMatching(headers);
+  absl::optional<RegexRouteSets::Lookup> regex_lookup;
+  if (regex_route_sets_ != nullptr) {
+    regex_lookup.emplace(*regex_route_sets_, path);
+  }
+
+  RouteIndex::Candidates candidates = route_index_->candidates(path);
+  uint32_t index;
+  while (candidates.next(index)) {
+    if (regex_lookup.has_value() && !regex_lookup->mayMatch(index)) {
+      continue;
+    }
+    RouteConstSharedPtr route_entry = routes_[index]->matches(headers, stream_info, random_value);
+    if (route_entry != nullptr) {
+      return route_entry;
+    }
+  }
+
+  ENVOY_LOG(debug, "route was resolved but final route list did not match incoming request");
+  return nullptr;
 }
 
 const VirtualHostImpl* RouteMatcher::findWildcardVirtualHost(
@@ -1914,11 +1976,12 @@ absl::StatusOr<std::unique_ptr<RouteMatcher>>
 RouteMatcher::create(const envoy::config::route::v3::RouteConfiguration& route_config,
                      const CommonConfigSharedPtr& global_route_config,
                      Server::Configuration::ServerFactoryContext& factory_context,
-                     ProtobufMessage::ValidationVisitor& validator, bool validate_clusters) {
+                     ProtobufMessage::ValidationVisitor& validator, bool validate_clusters,
+                     const RouteMatcher* previous_matcher, bool hash_virtual_hosts) {
   absl::Status creation_status = absl::OkStatus();
-  auto ret = std::unique_ptr<RouteMatcher>{new RouteMatcher(route_config, global_route_config,
-                                                            factory_context, validator,
-                                                            validate_clusters, creation_status)};
+  auto ret = std::unique_ptr<RouteMatcher>{
+      new RouteMatcher(route_config, global_route_config, factory_context, validator,
+                       validate_clusters, previous_matcher, hash_virtual_hosts, creation_status)};
   RETURN_IF_NOT_OK(creation_status);
   return ret;
 }
@@ -1926,16 +1989,35 @@ RouteMatcher::RouteMatcher(const envoy::config::route::v3::RouteConfiguration& r
                            const CommonConfigSharedPtr& global_route_config,
                            Server::Configuration::ServerFactoryContext& factory_context,
                            ProtobufMessage::ValidationVisitor& validator, bool validate_clusters,
+                           const RouteMatcher* previous_matcher, bool hash_virtual_hosts,
                            absl::Status& creation_status)
     : vhost_scope_(factory_context.scope().scopeFromStatName(
           factory_context.routerContext().virtualClusterStatNames().vhost_)),
       ignore_port_in_host_matching_(route_config.ignore_port_in_host_matching()),
       vhost_header_(route_config.vhost_header()) {
+  uint32_t reused_virtual_hosts = 0;
   for (const auto& virtual_host_config : route_config.virtual_hosts()) {
-    VirtualHostImplSharedPtr virtual_host = std::make_shared<VirtualHostImpl>(
-        virtual_host_config, global_route_config, factory_context, *vhost_scope_, validator,
-        validate_clusters, creation_status);
-    SET_AND_RETURN_IF_NOT_OK(creation_status, creation_status);
+    VirtualHostImplSharedPtr virtual_host;
+    uint64_t hash = 0;
+    if (hash_virtual_hosts) {
+      hash = MessageUtil::hash(virtual_host_config);
+      if (previous_matcher != nullptr) {
+        if (auto it = previous_matcher->virtual_hosts_by_hash_.find(hash);
+            it != previous_matcher->virtual_hosts_by_hash_.end()) {
+          virtual_host = it->second;
+          ++reused_virtual_hosts;
+        }
+      }
+    }
+    if (virtual_host == nullptr) {
+      virtual_host = std::make_shared<VirtualHostImpl>(virtual_host_config, global_route_config,
+                                                       factory_context, *vhost_scope_, validator,
+                                                       validate_clusters, creation_status);
+      SET_AND_RETURN_IF_NOT_OK(creation_status, creation_status);
+    }
+    if (hash_virtual_hosts) {
+      virtual_hosts_by_hash_.emplace(hash, virtual_host);
+    }
     for (const std::string& domain_name : virtual_host_config.domains()) {
       const Http::LowerCaseString lower_case_domain_name(domain_name);
       absl::string_view domain = lower_case_domain_name;
@@ -1967,6 +2049,10 @@ RouteMatcher::RouteMatcher(const envoy::config::route::v3::RouteConfiguration& r
       }
     }
   }
+  if (previous_matcher != nullptr) {
+    ENVOY_LOG_MISC(debug, "route config {}: reused {} of {} virtual hosts", route_config.name(),
+                   reused_virtual_hosts, route_config.virtual_hosts_size());
+  }
 }
 
 const VirtualHostImpl* RouteMatcher::findVirtualHost(const Http::RequestHeaderMap& headers) const {
@@ -2108,16 +2194,16 @@ CommonConfigImpl::CommonConfigImpl(const envoy::config::route::v3::RouteConfigur
   }
 
   if (!config.request_headers_to_add().empty() || !config.request_headers_to_remove().empty()) {
-    request_headers_parser_ =
-        THROW_OR_RETURN_VALUE(HeaderParser::configure(config.request_headers_to_add(),
-                                                      config.request_headers_to_remove()),
-                              Router::HeaderParserPtr);
+    request_headers_parser_ = THROW_OR_RETURN_VALUE(
+        HeaderParserPool::configure(config.request_headers_to_add(),
+                                    config.request_headers_to_remove(), factory_context),
+        Router::HeaderParserConstSharedPtr);
   }
   if (!config.response_headers_to_add().empty() || !config.response_headers_to_remove().empty()) {
-    response_headers_parser_ =
-        THROW_OR_RETURN_VALUE(HeaderParser::configure(config.response_headers_to_add(),
-                                                      config.response_headers_to_remove()),
-                              Router::HeaderParserPtr);
+    response_headers_parser_ = THROW_OR_RETURN_VALUE(
+        HeaderParserPool::configure(config.response_headers_to_add(),
+                                    config.response_headers_to_remove(), factory_context),
+        Router::HeaderParserConstSharedPtr);
   }
 
   if (config.has_metadata()) {
@@ -2153,13 +2239,79 @@ create(const envoy::config::route::v3::RouteConfiguration& config,
   return config_or_error.value();
 }
 
+namespace {
+
+#if defined(ENVOY_ENABLE_FULL_PROTOS)
+// All fields of the route configuration but its virtual hosts.
+const Protobuf::FieldMask& commonConfigFields() {
+  CONSTRUCT_ON_FIRST_USE(Protobuf::FieldMask, []() {
+    Protobuf::FieldMask mask;
+    const Protobuf::Descriptor* descriptor =
+        envoy::config::route::v3::RouteConfiguration::descriptor();
+    for (int i = 0; i < descriptor->field_count(); ++i) {
+      if (descriptor->field(i)->number() !=
+          envoy::config::route::v3::RouteConfiguration::kVirtualHostsFieldNumber) {
+        mask.add_paths(std::string(descriptor->field(i)->name()));
+      }
+    }
+    return mask;
+  }());
+}
+
+// The runtime features read while virtual hosts and their routes are built. A virtual host built
+// with different values of any of them would behave differently, so it can't be shared. Features
+// read while matching requests are not listed, as they apply to shared virtual hosts alike.
+constexpr absl::string_view RouteConstructionFeatures[] = {
+    "envoy.reloadable_features.route_index",
+    "envoy.reloadable_features.regex_route_sets",
+    "envoy.reloadable_features.remove_legacy_route_formatter",
+    "envoy.reloadable_features.intern_header_parsers",
+    "envoy.reloadable_features.enable_formatter_for_ratelimit_action_descriptor_value",
+};
+#endif
+
+// The hash of everything but the virtual hosts that virtual hosts are built from: the other fields
+// of the route configuration, and the runtime features which change how routes are built.
+// Virtual hosts whose routes check that their clusters exist are not shared, as the clusters may
+// have been removed since they were built.
+absl::optional<uint64_t>
+commonConfigHash(const envoy::config::route::v3::RouteConfiguration& config,
+                 bool validate_clusters) {
+#if defined(ENVOY_ENABLE_FULL_PROTOS)
+  if (validate_clusters ||
+      !Runtime::runtimeFeatureEnabled("envoy.reloadable_features.incremental_route_config")) {
+    return absl::nullopt;
+  }
+  // Copies all fields but the virtual hosts, which are most of the configuration.
+  envoy::config::route::v3::RouteConfiguration common_config;
+  ProtobufUtil::FieldMaskUtil::MergeMessageTo(config, commonConfigFields(),
+                                              ProtobufUtil::FieldMaskUtil::MergeOptions(),
+                                              &common_config);
+  uint64_t features = 0;
+  for (size_t i = 0; i < std::size(RouteConstructionFeatures); ++i) {
+    if (Runtime::runtimeFeatureEnabled(RouteConstructionFeatures[i])) {
+      features |= uint64_t(1) << i;
+    }
+  }
+  return HashUtil::xxHash64Value(features, MessageUtil::hash(common_config));
+#else
+  UNREFERENCED_PARAMETER(config);
+  UNREFERENCED_PARAMETER(validate_clusters);
+  return absl::nullopt;
+#endif
+}
+
+} // namespace
+
 absl::StatusOr<std::shared_ptr<ConfigImpl>>
 ConfigImpl::create(const envoy::config::route::v3::RouteConfiguration& config,
                    Server::Configuration::ServerFactoryContext& factory_context,
-                   ProtobufMessage::ValidationVisitor& validator, bool validate_clusters_default) {
+                   ProtobufMessage::ValidationVisitor& validator, bool validate_clusters_default,
+                   const ConfigImpl* previous_config) {
   absl::Status creation_status = absl::OkStatus();
-  auto ret = std::shared_ptr<ConfigImpl>(new ConfigImpl(
-      config, factory_context, validator, validate_clusters_default, creation_status));
+  auto ret = std::shared_ptr<ConfigImpl>(new ConfigImpl(config, factory_context, validator,
+                                                        validate_clusters_default,
+                                                        creation_status, previous_config));
   RETURN_IF_NOT_OK(creation_status);
   return ret;
 }
@@ -2167,14 +2319,27 @@ ConfigImpl::create(const envoy::config::route::v3::RouteConfiguration& config,
 ConfigImpl::ConfigImpl(const envoy::config::route::v3::RouteConfiguration& config,
                        Server::Configuration::ServerFactoryContext& factory_context,
                        ProtobufMessage::ValidationVisitor& validator,
-                       bool validate_clusters_default, absl::Status& creation_status) {
-  auto config_or_error = CommonConfigImpl::create(config, factory_context, validator);
-  SET_AND_RETURN_IF_NOT_OK(config_or_error.status(), creation_status);
-  shared_config_ = std::move(config_or_error.value());
+                       bool validate_clusters_default, absl::Status& creation_status,
+                       const ConfigImpl* previous_config) {
+  const bool validate_clusters =
+      PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, validate_clusters, validate_clusters_default);
+  common_config_hash_ = commonConfigHash(config, validate_clusters);
+
+  // Virtual hosts refer to the shared configuration, so they can only be reused along with it.
+  const RouteMatcher* previous_matcher = nullptr;
+  if (common_config_hash_.has_value() && previous_config != nullptr &&
+      previous_config->common_config_hash_ == common_config_hash_) {
+    shared_config_ = previous_config->shared_config_;
+    previous_matcher = previous_config->route_matcher_.get();
+  } else {
+    auto config_or_error = CommonConfigImpl::create(config, factory_context, validator);
+    SET_AND_RETURN_IF_NOT_OK(config_or_error.status(), creation_status);
+    shared_config_ = std::move(config_or_error.value());
+  }
 
-  auto matcher_or_error = RouteMatcher::create(
-      config, shared_config_, factory_context, validator,
-      PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, validate_clusters, validate_clusters_default));
+  auto matcher_or_error =
+      RouteMatcher::create(config, shared_config_, factory_context, validator, validate_clusters,
+                           previous_matcher, common_config_hash_.has_value());
   SET_AND_RETURN_IF_NOT_OK(matcher_or_error.status(), creation_status);
   route_matcher_ = std::move(matcher_or_error.value());
 }
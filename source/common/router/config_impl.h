@@ -33,11 +33,14 @@
 #include "source/common/router/header_parser.h"
 #include "source/common/router/metadatamatchcriteria_impl.h"
 #include "source/common/router/per_filter_config.h"
+#include "source/common/router/regex_route_sets.h"
 #include "source/common/router/retry_policy_impl.h"
+#include "source/common/router/route_index.h"
 #include "source/common/router/router_ratelimit.h"
 #include "source/common/router/tls_context_match_criteria_impl.h"
 #include "source/common/stats/symbol_table.h"
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/container/flat_hash_set.h"
 #include "absl/container/inlined_vector.h"
 #include "absl/container/node_hash_map.h"
@@ -346,8 +349,8 @@ private:
   // Keep an copy of the shared pointer to the shared part of the route config. This is needed
   // to keep the shared part alive while the virtual host is alive.
   const CommonConfigSharedPtr global_route_config_;
-  HeaderParserPtr request_headers_parser_;
-  HeaderParserPtr response_headers_parser_;
+  HeaderParserConstSharedPtr request_headers_parser_;
+  HeaderParserConstSharedPtr response_headers_parser_;
   std::unique_ptr<PerFilterConfigs> per_filter_configs_;
   RetryPolicyConstSharedPtr retry_policy_;
   std::unique_ptr<envoy::config::route::v3::HedgePolicy> hedge_policy_;
@@ -380,19 +383,34 @@ public:
   RouteConstSharedPtr
   getRouteFromRoutes(const RouteCallback& cb, const Http::RequestHeaderMap& headers,
                      const StreamInfo::StreamInfo& stream_info, uint64_t random_value,
-                     absl::Span<const RouteEntryImplBaseConstSharedPtr> routes) const;
+                     absl::Span<const RouteEntryImplBaseConstSharedPtr> routes,
+                     const RegexRouteSets* regex_route_sets = nullptr) const;
 
   VirtualHostConstSharedPtr virtualHost() const { return shared_virtual_host_; }
 
 private:
   enum class SslRequirements : uint8_t { None, ExternalOnly, All };
 
+  // The path which path match criteria match, as computed by
+  // RouteEntryImplBase::sanitizePathBeforePathMatching() and Matchers::PathMatcher::match().
+  absl::string_view pathForMatching(const Http::RequestHeaderMap& headers) const;
+  // Finds the first of routes_ which matches a request with a path through route_index_.
+  RouteConstSharedPtr getRouteFromIndex(const Http::RequestHeaderMap& headers,
+                                        const StreamInfo::StreamInfo& stream_info,
+                                        uint64_t random_value) const;
+
   CommonVirtualHostSharedPtr shared_virtual_host_;
 
   std::shared_ptr<const SslRedirectRoute> ssl_redirect_route_;
   SslRequirements ssl_requirements_;
 
   absl::InlinedVector<RouteEntryImplBaseConstSharedPtr, 2> routes_;
+  // Only built when the envoy.reloadable_features.route_index runtime feature is enabled and some
+  // of routes_ can be indexed.
+  RouteIndexConstPtr route_index_;
+  // Only built when the envoy.reloadable_features.regex_route_sets runtime feature is enabled and
+  // routes_ has consecutive safe_regex routes.
+  RegexRouteSetsConstPtr regex_route_sets_;
   Matcher::MatchTreeSharedPtr<Http::HttpMatchingData> matcher_;
 };
 
@@ -585,6 +603,7 @@ public:
 
   bool matchRoute(const Http::RequestHeaderMap& headers, const StreamInfo::StreamInfo& stream_info,
                   uint64_t random_value) const;
+  bool pathMatchIsCaseSensitive() const { return case_sensitive_; }
   absl::Status validateClusters(const Upstream::ClusterManager& cluster_manager) const;
 
   // Router::RouteEntry
@@ -902,8 +921,8 @@ private:
   std::unique_ptr<const Http::HashPolicyImpl> hash_policy_;
   MetadataMatchCriteriaConstPtr metadata_match_criteria_;
   TlsContextMatchCriteriaConstPtr tls_context_match_criteria_;
-  HeaderParserPtr request_headers_parser_;
-  HeaderParserPtr response_headers_parser_;
+  HeaderParserConstSharedPtr request_headers_parser_;
+  HeaderParserConstSharedPtr response_headers_parser_;
   RouteMetadataPackPtr metadata_;
   const std::vector<Envoy::Matchers::MetadataMatcher> dynamic_metadata_;
   const std::vector<Envoy::Matchers::FilterStateMatcher> filter_state_;
@@ -1199,11 +1218,19 @@ DECLARE_FACTORY(RouteListMatchActionFactory);
  */
 class RouteMatcher {
 public:
+  /**
+   * @param previous_matcher supplies the matcher of a previous generation of the route
+   *        configuration, built with the same global_route_config, whose virtual hosts are reused
+   *        for virtual hosts with the same content, or nullptr.
+   * @param hash_virtual_hosts supplies whether to record the content hashes of the virtual hosts,
+   *        so that the next generation can reuse them.
+   */
   static absl::StatusOr<std::unique_ptr<RouteMatcher>>
   create(const envoy::config::route::v3::RouteConfiguration& config,
          const CommonConfigSharedPtr& global_route_config,
          Server::Configuration::ServerFactoryContext& factory_context,
-         ProtobufMessage::ValidationVisitor& validator, bool validate_clusters);
+         ProtobufMessage::ValidationVisitor& validator, bool validate_clusters,
+         const RouteMatcher* previous_matcher = nullptr, bool hash_virtual_hosts = false);
 
   VirtualHostRoute route(const RouteCallback& cb, const Http::RequestHeaderMap& headers,
                          const StreamInfo::StreamInfo& stream_info, uint64_t random_value) const;
@@ -1215,6 +1242,7 @@ private:
                const CommonConfigSharedPtr& global_route_config,
                Server::Configuration::ServerFactoryContext& factory_context,
                ProtobufMessage::ValidationVisitor& validator, bool validate_clusters,
+               const RouteMatcher* previous_matcher, bool hash_virtual_hosts,
                absl::Status& creation_status);
 
   using WildcardVirtualHosts =
@@ -1242,6 +1270,8 @@ private:
   VirtualHostImplSharedPtr default_virtual_host_;
   const bool ignore_port_in_host_matching_{false};
   const Http::LowerCaseString vhost_header_;
+  // The virtual hosts by the hash of their configuration, for the next generation to reuse.
+  absl::flat_hash_map<uint64_t, VirtualHostImplSharedPtr> virtual_hosts_by_hash_;
 };
 
 /**
@@ -1300,8 +1330,8 @@ private:
                    Server::Configuration::ServerFactoryContext& factory_context,
                    ProtobufMessage::ValidationVisitor& validator, absl::Status& creation_status);
   std::vector<Http::LowerCaseString> internal_only_headers_;
-  HeaderParserPtr request_headers_parser_;
-  HeaderParserPtr response_headers_parser_;
+  HeaderParserConstSharedPtr request_headers_parser_;
+  HeaderParserConstSharedPtr response_headers_parser_;
   const std::string name_;
   Stats::SymbolTable& symbol_table_;
   std::vector<ShadowPolicyPtr> shadow_policies_;
@@ -1321,10 +1351,17 @@ private:
  */
 class ConfigImpl : public Config {
 public:
+  /**
+   * @param previous_config supplies a previous generation of the route configuration, or nullptr.
+   *        When the envoy.reloadable_features.incremental_route_config runtime feature is enabled
+   *        and only virtual hosts changed since previous_config, the new generation shares the
+   *        unchanged virtual hosts with it rather than building them again.
+   */
   static absl::StatusOr<std::shared_ptr<ConfigImpl>>
   create(const envoy::config::route::v3::RouteConfiguration& config,
          Server::Configuration::ServerFactoryContext& factory_context,
-         ProtobufMessage::ValidationVisitor& validator, bool validate_clusters_default);
+         ProtobufMessage::ValidationVisitor& validator, bool validate_clusters_default,
+         const ConfigImpl* previous_config = nullptr);
 
   bool virtualHostExists(const Http::RequestHeaderMap& headers) const {
     return route_matcher_->findVirtualHost(headers) != nullptr;
@@ -1367,11 +1404,14 @@ protected:
   ConfigImpl(const envoy::config::route::v3::RouteConfiguration& config,
              Server::Configuration::ServerFactoryContext& factory_context,
              ProtobufMessage::ValidationVisitor& validator, bool validate_clusters_default,
-             absl::Status& creation_status);
+             absl::Status& creation_status, const ConfigImpl* previous_config = nullptr);
 
 private:
   CommonConfigSharedPtr shared_config_;
   std::unique_ptr<RouteMatcher> route_matcher_;
+  // The hash of everything but the virtual hosts that the virtual hosts are built from. Only set
+  // when the virtual hosts can be shared with the next generation.
+  absl::optional<uint64_t> common_config_hash_;
 };
 
 /**
@@ -17,6 +17,7 @@ namespace Router {
 
 class HeaderParser;
 using HeaderParserPtr = std::unique_ptr<HeaderParser>;
+using HeaderParserConstSharedPtr = std::shared_ptr<const HeaderParser>;
 
 using HeaderAppendAction = envoy::config::core::v3::HeaderValueOption::HeaderAppendAction;
 using HeaderValueOption = envoy::config::core::v3::HeaderValueOption;
@@ -0,0 +1,52 @@
+#include "source/common/router/header_parser_pool.h"
+
+#include "source/common/runtime/runtime_features.h"
+
+#include "absl/strings/str_cat.h"
+
+namespace Envoy {
+namespace Router {
+
+SINGLETON_MANAGER_REGISTRATION(header_parser_shared_pool);
+
+HeaderParserSharedPoolSharedPtr HeaderParserPool::getSharedPool(Singleton::Manager& manager,
+                                                                Event::Dispatcher& dispatcher) {
+  return manager.getTyped<HeaderParserSharedPool>(
+      SINGLETON_MANAGER_REGISTERED_NAME(header_parser_shared_pool),
+      [&dispatcher] { return std::make_shared<HeaderParserSharedPool>(dispatcher); }, true);
+}
+
+absl::StatusOr<HeaderParserConstSharedPtr>
+HeaderParserPool::configure(const Protobuf::RepeatedPtrField<HeaderValueOption>& headers_to_add,
+                            const Protobuf::RepeatedPtrField<std::string>& headers_to_remove,
+                            Server::Configuration::ServerFactoryContext& context) {
+  if (!Runtime::runtimeFeatureEnabled("envoy.reloadable_features.intern_header_parsers")) {
+    return HeaderParser::configure(headers_to_add, headers_to_remove);
+  }
+
+  // The formatters depend on the runtime feature. Length prefixes keep the key unambiguous.
+  const bool remove_legacy_route_formatter =
+      Runtime::runtimeFeatureEnabled("envoy.reloadable_features.remove_legacy_route_formatter");
+  InternedHeaderParser key{remove_legacy_route_formatter ? "1" : "0", nullptr};
+  for (const HeaderValueOption& header_value_option : headers_to_add) {
+    const std::string serialized = header_value_option.SerializeAsString();
+    absl::StrAppend(&key.config_, serialized.size(), ":", serialized);
+  }
+  key.config_.push_back('|');
+  for (const std::string& header : headers_to_remove) {
+    absl::StrAppend(&key.config_, header.size(), ":", header);
+  }
+
+  std::shared_ptr<InternedHeaderParser> interned =
+      getSharedPool(context.singletonManager(), context.mainThreadDispatcher())->getObject(key);
+  if (interned->parser_ == nullptr) {
+    auto parser_or_error = HeaderParser::configure(headers_to_add, headers_to_remove);
+    RETURN_IF_NOT_OK_REF(parser_or_error.status());
+    interned->parser_ = std::move(parser_or_error.value());
+  }
+  // The parser keeps the pool entry alive.
+  return HeaderParserConstSharedPtr(interned, interned->parser_.get());
+}
+
+} // namespace Router
+} // namespace Envoy
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "envoy/config/core/v3/base.pb.h"
+#include "envoy/event/dispatcher.h"
+#include "envoy/server/factory_context.h"
+#include "envoy/singleton/manager.h"
+
+#include "source/common/protobuf/protobuf.h"
+#include "source/common/router/header_parser.h"
+#include "source/common/shared_pool/shared_pool.h"
+
+#include "absl/hash/hash.h"
+
+namespace Envoy {
+namespace Router {
+
+/**
+ * A HeaderParser together with the configuration it was built from.
+ */
+struct InternedHeaderParser {
+  // The serialized headers to add and remove, and the runtime features the parser depends on.
+  std::string config_;
+  // Built by the first user of the entry.
+  std::shared_ptr<const HeaderParser> parser_;
+};
+
+struct InternedHeaderParserHash {
+  size_t operator()(const InternedHeaderParser& interned) const {
+    return absl::Hash<std::string>()(interned.config_);
+  }
+};
+
+struct InternedHeaderParserEqualTo {
+  bool operator()(const InternedHeaderParser& lhs, const InternedHeaderParser& rhs) const {
+    return lhs.config_ == rhs.config_;
+  }
+};
+
+using HeaderParserSharedPool =
+    SharedPool::ObjectSharedPool<InternedHeaderParser, InternedHeaderParserHash,
+                                 InternedHeaderParserEqualTo>;
+using HeaderParserSharedPoolSharedPtr = std::shared_ptr<HeaderParserSharedPool>;
+
+class HeaderParserPool {
+public:
+  /**
+   * Returns an ObjectSharedPool to store the header parsers of route configurations.
+   * @param manager used to create singleton
+   * @param dispatcher the dispatcher object reference to the thread that created the
+   * ObjectSharedPool
+   */
+  static HeaderParserSharedPoolSharedPtr getSharedPool(Singleton::Manager& manager,
+                                                      Event::Dispatcher& dispatcher);
+
+  /**
+   * Same as HeaderParser::configure(). When the envoy.reloadable_features.intern_header_parsers
+   * runtime feature is enabled, the route configurations of the server share one parser, and
+   * the formatters it owns, for each distinct configuration. Must be called on the main thread.
+   * @param headers_to_add defines the headers to add during calls to evaluateHeaders.
+   * @param headers_to_remove defines the headers to remove during calls to evaluateHeaders.
+   * @param context supplies the server factory context which owns the pool.
+   * @return HeaderParserConstSharedPtr a configured, possibly shared, parser.
+   */
+  static absl::StatusOr<HeaderParserConstSharedPtr>
+  configure(const Protobuf::RepeatedPtrField<HeaderValueOption>& headers_to_add,
+            const Protobuf::RepeatedPtrField<std::string>& headers_to_remove,
+            Server::Configuration::ServerFactoryContext& context);
+};
+
+} // namespace Router
+} // namespace Envoy
@@ -0,0 +1,81 @@
+#include "source/common/router/regex_route_sets.h"
+
+#include <algorithm>
+#include <string>
+
+#include "source/common/common/logger.h"
+
+namespace Envoy {
+namespace Router {
+
+RegexRouteSetsConstPtr
+RegexRouteSets::create(const Protobuf::RepeatedPtrField<envoy::config::route::v3::Route>& routes,
+                       const Regex::Engine& engine) {
+  auto sets = std::make_unique<RegexRouteSets>();
+  std::vector<std::string> patterns;
+  uint32_t first_route = 0;
+
+  auto end_run = [&]() {
+    if (patterns.size() >= 2) {
+      auto matcher_or_error = engine.setMatcher(patterns);
+      if (matcher_or_error.ok()) {
+        sets->runs_.push_back({first_route, std::move(matcher_or_error.value())});
+      } else {
+        ENVOY_LOG_MISC(debug, "matching {} regex routes one by one: {}", patterns.size(),
+                       matcher_or_error.status().message());
+      }
+    }
+    patterns.clear();
+  };
+
+  for (int i = 0; i < routes.size(); ++i) {
+    const auto& match = routes[i].match();
+    if (match.path_specifier_case() !=
+            envoy::config::route::v3::RouteMatch::PathSpecifierCase::kSafeRegex ||
+        match.safe_regex().has_google_re2()) {
+      end_run();
+      continue;
+    }
+    if (patterns.empty()) {
+      first_route = i;
+    }
+    patterns.push_back(match.safe_regex().regex());
+  }
+  end_run();
+
+  if (sets->runs_.empty()) {
+    return nullptr;
+  }
+  return sets;
+}
+
+uint32_t RegexRouteSets::routes() const {
+  uint32_t routes = 0;
+  for (const Run& run : runs_) {
+    routes += run.matcher_->size();
+  }
+  return routes;
+}
+
+bool RegexRouteSets::Lookup::mayMatch(uint32_t route) {
+  const std::vector<Run>& runs = sets_.runs_;
+  while (run_ < runs.size() && route >= runs[run_].first_route_ + runs[run_].matcher_->size()) {
+    ++run_;
+  }
+  if (run_ == runs.size() || route < runs[run_].first_route_) {
+    return true;
+  }
+
+  const Run& run = runs[run_];
+  if (matched_run_ != run_) {
+    matched_run_ = run_;
+    complete_ = run.matcher_->match(path_, matches_);
+  }
+  // An incomplete match leaves each route to its own matcher.
+  return !complete_ ||
+         std::binary_search(matches_.begin(), matches_.end(),
+                            static_cast<int>(route - run.first_route_));
+}
+
+} // namespace Router
+} // namespace Envoy
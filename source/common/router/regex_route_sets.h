@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "envoy/common/regex.h"
+#include "envoy/config/route/v3/route_components.pb.h"
+
+#include "source/common/protobuf/protobuf.h"
+
+#include "absl/strings/string_view.h"
+
+namespace Envoy {
+namespace Router {
+
+class RegexRouteSets;
+using RegexRouteSetsConstPtr = std::unique_ptr<const RegexRouteSets>;
+
+/**
+ * The safe_regex path patterns of runs of consecutive routes in a route list, each run compiled
+ * into a single Regex::CompiledSetMatcher. A lookup matches the path against all patterns of a run
+ * at once, and then only needs to match the rest of the request against the routes whose pattern
+ * matched.
+ */
+class RegexRouteSets {
+public:
+  /**
+   * Compiles the runs of at least two consecutive safe_regex routes with the regex engine. Routes
+   * which set the deprecated google_re2 field break runs, as they always use RE2 whatever the
+   * engine. Runs which the engine fails to compile as a set are matched route by route.
+   * @param routes supplies the route list.
+   * @param engine supplies the regex engine which compiled the safe_regex routes.
+   * @return the runs, or nullptr if there are none.
+   */
+  static RegexRouteSetsConstPtr
+  create(const Protobuf::RepeatedPtrField<envoy::config::route::v3::Route>& routes,
+         const Regex::Engine& engine);
+
+  /**
+   * The state of one lookup, which visits routes in increasing order. Each run is matched against
+   * the path at most once, when the lookup visits the first of its routes.
+   */
+  class Lookup {
+  public:
+    /**
+     * @param sets supplies the runs, which must outlive the lookup.
+     * @param path supplies the path the routes match, without query and fragment.
+     */
+    Lookup(const RegexRouteSets& sets, absl::string_view path) : sets_(sets), path_(path) {}
+
+    /**
+     * @param route supplies the position of the next route the lookup visits.
+     * @return false if the route is in a run and its pattern does not match the path.
+     */
+    bool mayMatch(uint32_t route);
+
+  private:
+    const RegexRouteSets& sets_;
+    const absl::string_view path_;
+    size_t run_{};
+    size_t matched_run_{SIZE_MAX};
+    bool complete_{};
+    std::vector<int> matches_;
+  };
+
+  /**
+   * @return the number of routes which are in a run.
+   */
+  uint32_t routes() const;
+
+private:
+  struct Run {
+    uint32_t first_route_;
+    Regex::CompiledSetMatcherPtr matcher_;
+  };
+
+  std::vector<Run> runs_;
+};
+
+} // namespace Router
+} // namespace Envoy
@@ -44,10 +44,14 @@ ConfigTraitsImpl::createConfig(const Protobuf::Message& rc,
                                Server::Configuration::ServerFactoryContext& factory_context,
                                bool validate_clusters_default) const {
   ASSERT(dynamic_cast<const envoy::config::route::v3::RouteConfiguration*>(&rc));
-  return THROW_OR_RETURN_VALUE(
+  const std::shared_ptr<const ConfigImpl> previous_config = previous_config_.lock();
+  std::shared_ptr<ConfigImpl> config = THROW_OR_RETURN_VALUE(
       ConfigImpl::create(static_cast<const envoy::config::route::v3::RouteConfiguration&>(rc),
-                         factory_context, validator_, validate_clusters_default),
+                         factory_context, validator_, validate_clusters_default,
+                         previous_config.get()),
       std::shared_ptr<ConfigImpl>);
+  previous_config_ = config;
+  return config;
 }
 
 bool RouteConfigUpdateReceiverImpl::onRdsUpdate(const Protobuf::Message& rc,
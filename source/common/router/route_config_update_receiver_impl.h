@@ -1,5 +1,6 @@
 #pragma once
 
+#include <memory>
 #include <string>
 
 #include "envoy/config/route/v3/route.pb.h"
@@ -29,6 +30,8 @@ public:
 
 private:
   ProtobufMessage::ValidationVisitor& validator_;
+  // The last config created, which the next one may share virtual hosts with while it is alive.
+  mutable std::weak_ptr<const ConfigImpl> previous_config_;
 };
 
 class RouteConfigUpdateReceiverImpl : public RouteConfigUpdateReceiver {
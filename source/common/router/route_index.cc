@@ -0,0 +1,77 @@
+#include "source/common/router/route_index.h"
+
+namespace Envoy {
+namespace Router {
+
+RouteIndex::Entry& RouteIndex::entry(absl::string_view key) {
+  Entry* existing = tree_.find(key);
+  if (existing != nullptr) {
+    return *existing;
+  }
+  entries_.push_back(std::make_unique<Entry>(key.size()));
+  tree_.add(key, entries_.back().get());
+  return *entries_.back();
+}
+
+void RouteIndex::addRoute(PathMatchType type, absl::string_view matcher, bool case_sensitive) {
+  const uint32_t index = routes_++;
+  if (case_sensitive) {
+    switch (type) {
+    case PathMatchType::Prefix:
+      entry(matcher).prefix_routes_.push_back(index);
+      ++indexed_routes_;
+      return;
+    case PathMatchType::Exact:
+      entry(matcher).exact_routes_.push_back(index);
+      ++indexed_routes_;
+      return;
+    case PathMatchType::PathSeparatedPrefix:
+      entry(matcher).path_separated_prefix_routes_.push_back(index);
+      ++indexed_routes_;
+      return;
+    default:
+      break;
+    }
+  }
+  unindexed_routes_.push_back(index);
+}
+
+RouteIndex::Candidates RouteIndex::candidates(absl::string_view path) const {
+  Candidates candidates;
+  if (!unindexed_routes_.empty()) {
+    candidates.lists_.push_back(unindexed_routes_);
+  }
+  for (const Entry* entry : tree_.findMatchingPrefixes(path)) {
+    if (!entry->prefix_routes_.empty()) {
+      candidates.lists_.push_back(entry->prefix_routes_);
+    }
+    if (!entry->exact_routes_.empty() && entry->key_length_ == path.size()) {
+      candidates.lists_.push_back(entry->exact_routes_);
+    }
+    if (!entry->path_separated_prefix_routes_.empty() &&
+        (entry->key_length_ == path.size() || path[entry->key_length_] == '/')) {
+      candidates.lists_.push_back(entry->path_separated_prefix_routes_);
+    }
+  }
+  return candidates;
+}
+
+bool RouteIndex::Candidates::next(uint32_t& index) {
+  // There are only a few lists, one per matching key, so a linear scan for the smallest head is
+  // cheaper than a heap.
+  absl::Span<const uint32_t>* smallest = nullptr;
+  for (absl::Span<const uint32_t>& list : lists_) {
+    if (!list.empty() && (smallest == nullptr || list.front() < smallest->front())) {
+      smallest = &list;
+    }
+  }
+  if (smallest == nullptr) {
+    return false;
+  }
+  index = smallest->front();
+  smallest->remove_prefix(1);
+  return true;
+}
+
+} // namespace Router
+} // namespace Envoy
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "envoy/router/router.h"
+
+#include "source/common/common/radix_tree.h"
+
+#include "absl/container/inlined_vector.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+
+namespace Envoy {
+namespace Router {
+
+/**
+ * An index of the path match criteria of an ordered list of routes, which narrows the routes that
+ * can match a path down to candidates while preserving first-match semantics. Case sensitive
+ * prefix, exact path and path separated prefix routes are indexed by their matcher in a radix
+ * tree. All other routes, such as regex, URI template and CONNECT routes, are candidates for every
+ * path, interleaved with the indexed candidates by their position in the list.
+ *
+ * The index only considers the path. Candidates still need to be matched against the request.
+ */
+class RouteIndex {
+public:
+  /**
+   * Adds the next route of the list.
+   * @param type supplies the path match type of the route.
+   * @param matcher supplies the path or prefix which the route matches.
+   * @param case_sensitive supplies whether the route matches the path case sensitively. Case
+   *        insensitive routes are not indexed.
+   */
+  void addRoute(PathMatchType type, absl::string_view matcher, bool case_sensitive);
+
+  /**
+   * The positions of the routes which may match a path, in increasing order.
+   */
+  class Candidates {
+  public:
+    /**
+     * @param index supplies the position of the next candidate.
+     * @return false if there are no more candidates.
+     */
+    bool next(uint32_t& index);
+
+  private:
+    friend class RouteIndex;
+
+    absl::InlinedVector<absl::Span<const uint32_t>, 8> lists_;
+  };
+
+  /**
+   * @param path supplies the path without query and fragment.
+   * @return the candidates for path.
+   */
+  Candidates candidates(absl::string_view path) const;
+
+  /**
+   * @return the number of routes which are indexed rather than candidates for every path.
+   */
+  uint32_t indexedRoutes() const { return indexed_routes_; }
+
+private:
+  // The routes of one key of the tree, each in increasing order.
+  struct Entry {
+    explicit Entry(size_t key_length) : key_length_(key_length) {}
+
+    const size_t key_length_;
+    std::vector<uint32_t> prefix_routes_;
+    std::vector<uint32_t> exact_routes_;
+    std::vector<uint32_t> path_separated_prefix_routes_;
+  };
+
+  Entry& entry(absl::string_view key);
+
+  RadixTree<Entry*> tree_;
+  std::vector<std::unique_ptr<Entry>> entries_;
+  std::vector<uint32_t> unindexed_routes_;
+  uint32_t routes_{};
+  uint32_t indexed_routes_{};
+};
+
+using RouteIndexConstPtr = std::unique_ptr<const RouteIndex>;
+
+} // namespace Router
+} // namespace Envoy
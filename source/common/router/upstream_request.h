@@ -22,6 +22,7 @@
 #include "source/common/common/linked_object.h"
 #include "source/common/common/logger.h"
 #include "source/common/config/well_known_names.h"
+#include "source/common/event/deferred_delete_pool.h"
 #include "source/common/http/filter_manager.h"
 #include "source/common/router/upstream_to_downstream_impl_base.h"
 #include "source/common/stream_info/stream_info_impl.h"
@@ -68,10 +69,14 @@ class UpstreamRequest : public Logger::Loggable<Logger::Id::router>,
                         public UpstreamToDownstreamImplBase,
                         public LinkedObject<UpstreamRequest>,
                         public GenericConnectionPoolCallbacks,
-                        public Event::DeferredDeletable {
+                        public Event::DeferredDeletable,
+                        public Event::PooledDeferredDeletable<UpstreamRequest> {
 public:
   UpstreamRequest(RouterFilterInterface& parent, std::unique_ptr<GenericConnPool>&& conn_pool,
                   bool can_send_early_data, bool can_use_http3, bool enable_half_close);
+
+  // Event::PooledDeferredDeletable
+  static constexpr absl::string_view DeferredDeletePoolName = "router_upstream_request";
   ~UpstreamRequest() override;
   void deleteIsPending() override { cleanUp(); }
 
@@ -15,6 +15,7 @@
 #include "source/common/config/utility.h"
 #include "source/common/grpc/common.h"
 #include "source/common/protobuf/utility.h"
+#include "source/common/rds/util.h"
 #include "source/common/router/config_impl.h"
 
 namespace Envoy {
@@ -71,14 +72,14 @@ VhdsSubscription::VhdsSubscription(RouteConfigUpdatePtr& config_update_info,
       config_update_info_(config_update_info),
       scope_(factory_context.scope().createScope(
           stat_prefix + "vhds." + config_update_info_->protobufConfigurationCast().name() + ".")),
-      stats_({ALL_VHDS_STATS(POOL_COUNTER(*scope_))}),
+      stats_({ALL_VHDS_STATS(POOL_COUNTER(*scope_), POOL_HISTOGRAM(*scope_))}),
       init_target_(fmt::format("VhdsConfigSubscription {}",
                                config_update_info_->protobufConfigurationCast().name()),
                    [this]() {
                      subscription_->start(
                          {config_update_info_->protobufConfigurationCast().name()});
                    }),
-      route_config_provider_(route_config_provider) {
+      route_config_provider_(route_config_provider), time_source_(factory_context.timeSource()) {
   const auto resource_name = getResourceName();
   Envoy::Config::SubscriptionOptions options;
   options.use_namespace_matching_ = true;
@@ -120,8 +121,10 @@ absl::Status VhdsSubscription::onConfigUpdate(
     added_vhosts.emplace_back(
         dynamic_cast<const envoy::config::route::v3::VirtualHost&>(resource.get().resource()));
   }
+  const Rds::ConfigLoadMeasurement load_measurement(time_source_);
   if (config_update_info_->onVhdsUpdate(added_vhosts, std::move(added_resource_ids),
                                         removed_resources, version_info)) {
+    load_measurement.record(stats_.config_load_time_, stats_.config_load_memory_growth_);
     stats_.config_reload_.inc();
     ENVOY_LOG(debug, "vhds: loading new configuration: config_name={} hash={}",
               config_update_info_->protobufConfigurationCast().name(),
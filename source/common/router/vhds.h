@@ -28,12 +28,14 @@
 namespace Envoy {
 namespace Router {
 
-#define ALL_VHDS_STATS(COUNTER)                                                                    \
+#define ALL_VHDS_STATS(COUNTER, HISTOGRAM)                                                         \
   COUNTER(config_reload)                                                                           \
-  COUNTER(update_empty)
+  COUNTER(update_empty)                                                                            \
+  HISTOGRAM(config_load_time, Milliseconds)                                                        \
+  HISTOGRAM(config_load_memory_growth, Bytes)
 
 struct VhdsStats {
-  ALL_VHDS_STATS(GENERATE_COUNTER_STRUCT)
+  ALL_VHDS_STATS(GENERATE_COUNTER_STRUCT, GENERATE_HISTOGRAM_STRUCT)
 };
 
 class VhdsSubscription : Envoy::Config::SubscriptionBase<envoy::config::route::v3::VirtualHost>,
@@ -81,6 +83,7 @@ private:
   Envoy::Config::SubscriptionPtr subscription_;
   Init::TargetImpl init_target_;
   Rds::RouteConfigProvider* route_config_provider_;
+  TimeSource& time_source_;
 };
 
 using VhdsSubscriptionPtr = std::unique_ptr<VhdsSubscription>;
@@ -2,6 +2,7 @@
 
 #include "source/common/config/well_known_names.h"
 #include "source/common/router/config_utility.h"
+#include "source/common/router/header_parser_pool.h"
 
 namespace Envoy {
 namespace Router {
@@ -39,16 +40,16 @@ WeightedClustersConfigEntry::WeightedClustersConfigEntry(
       host_rewrite_(cluster.host_rewrite_literal()), cluster_name_(cluster.name()),
       cluster_header_name_(cluster.cluster_header()) {
   if (!cluster.request_headers_to_add().empty() || !cluster.request_headers_to_remove().empty()) {
-    request_headers_parser_ =
-        THROW_OR_RETURN_VALUE(HeaderParser::configure(cluster.request_headers_to_add(),
-                                                      cluster.request_headers_to_remove()),
-                              Router::HeaderParserPtr);
+    request_headers_parser_ = THROW_OR_RETURN_VALUE(
+        HeaderParserPool::configure(cluster.request_headers_to_add(),
+                                    cluster.request_headers_to_remove(), context),
+        Router::HeaderParserConstSharedPtr);
   }
   if (!cluster.response_headers_to_add().empty() || !cluster.response_headers_to_remove().empty()) {
-    response_headers_parser_ =
-        THROW_OR_RETURN_VALUE(HeaderParser::configure(cluster.response_headers_to_add(),
-                                                      cluster.response_headers_to_remove()),
-                              Router::HeaderParserPtr);
+    response_headers_parser_ = THROW_OR_RETURN_VALUE(
+        HeaderParserPool::configure(cluster.response_headers_to_add(),
+                                    cluster.response_headers_to_remove(), context),
+        Router::HeaderParserConstSharedPtr);
   }
 
   if (cluster.has_metadata_match()) {
@@ -38,8 +38,8 @@ private:
   const std::string runtime_key_;
   const uint64_t cluster_weight_;
   MetadataMatchCriteriaConstPtr cluster_metadata_match_criteria_;
-  HeaderParserPtr request_headers_parser_;
-  HeaderParserPtr response_headers_parser_;
+  HeaderParserConstSharedPtr request_headers_parser_;
+  HeaderParserConstSharedPtr response_headers_parser_;
   std::unique_ptr<PerFilterConfigs> per_filter_configs_;
   const std::string host_rewrite_;
   const std::string cluster_name_;
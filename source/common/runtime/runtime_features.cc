@@ -192,6 +192,21 @@ FALSE_RUNTIME_GUARD(envoy_reloadable_features_getaddrinfo_no_ai_flags);
 // Flip to true after two release periods.
 FALSE_RUNTIME_GUARD(envoy_reloadable_features_remove_legacy_route_formatter);
 
+// TODO(nbaws): flip true after prod testing shows buffer_slice_pool_misses below 10% of
+// allocations with no memory_physical_size regression on proxies with large buffers.
+// Recycles Buffer::Slice backing storage through a per-worker pool.
+FALSE_RUNTIME_GUARD(envoy_restart_features_buffer_slice_storage_pool);
+
+// TODO(nbaws): flip true after the stats benchmarks show no read/flush regression with 64
+// workers and prod testing shows lower CPU on hot per-cluster counters.
+// Spreads increments of counters written by several workers over per-thread cache lines.
+FALSE_RUNTIME_GUARD(envoy_restart_features_sharded_counters);
+
+// TODO(nbaws): flip true after prod testing shows most stream allocations reused from the pools
+// with no memory_physical_size regression on proxies with many idle connections.
+// Recycles the storage of deferred-deleted streams and upstream requests through per-worker pools.
+FALSE_RUNTIME_GUARD(envoy_restart_features_deferred_delete_pool);
+
 // TODO(grnmeira):
 // Enables the new DNS implementation, a merged implementation of
 // strict and logical DNS clusters. This new implementation will
@@ -220,6 +235,26 @@ FALSE_RUNTIME_GUARD(envoy_reloadable_features_http2_use_oghttp2);
 FALSE_RUNTIME_GUARD(envoy_reloadable_features_dynamic_modules_strip_custom_stat_prefix);
 // TODO(haoyuewang): Flip true after prod testing.
 FALSE_RUNTIME_GUARD(envoy_reloadable_features_quic_disable_data_read_immediately);
+// TODO(nbaws): flip true after shadow matching in prod testing picks the same route as the linear
+// scan on every request and the route benchmarks show no regression for small virtual hosts.
+// Indexes the path match criteria of virtual host routes in a radix tree.
+FALSE_RUNTIME_GUARD(envoy_reloadable_features_route_index);
+// TODO(nbaws): flip true after prod testing shows the same route selected as the per-route regex
+// matches, and no memory or config load time regression on route tables with thousands of regexes.
+// Matches runs of consecutive safe_regex routes with a single multi-pattern regex matcher.
+FALSE_RUNTIME_GUARD(envoy_reloadable_features_regex_route_sets);
+// TODO(nbaws): flip true after prod testing with frequent RDS and VHDS updates shows lower
+// config_load_time and config_load_memory_growth, and no routing difference from full rebuilds.
+// Shares unchanged virtual hosts between generations of a route configuration.
+FALSE_RUNTIME_GUARD(envoy_reloadable_features_incremental_route_config);
+// TODO(nbaws): flip true after prod testing with many similar route configurations shows lower
+// memory, and no header mutation difference from per-route parsers in the header mutation tests.
+// Shares header parsers with the same configuration between route configurations.
+FALSE_RUNTIME_GUARD(envoy_reloadable_features_intern_header_parsers);
+// TODO(nbaws): flip true after filter_manager_speed_test shows no bytes_per_request regression for
+// short filter chains and prod testing shows no memory_allocated regression with many streams.
+// Allocates the filter wrappers and filter lists of HTTP streams from a per-stream arena.
+FALSE_RUNTIME_GUARD(envoy_reloadable_features_http_stream_arena);
 
 // Block of non-boolean flags. Use of int flags is deprecated. Do not add more.
 ABSL_FLAG(uint64_t, re2_max_program_size_error_level, 100, ""); // NOLINT
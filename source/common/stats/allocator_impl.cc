@@ -2,6 +2,7 @@
 
 #include <algorithm>
 #include <cstdint>
+#include <memory>
 
 #include "envoy/stats/sink.h"
 #include "envoy/stats/stats.h"
@@ -88,6 +89,19 @@ public:
   void markUnused() override { flags_ &= ~Metric::Flags::Used; }
   bool hidden() const override { return flags_ & Metric::Flags::Hidden; }
 
+  // Records that the stat changed if changes are tracked. Only the first change after the changed
+  // stats were last visited takes the allocator's lock, later ones only pay for two relaxed loads.
+  void markChanged() {
+    if (!alloc_.track_changes_.load(std::memory_order_relaxed) ||
+        (flags_.load(std::memory_order_relaxed) & Metric::Flags::Changed) != 0) {
+      return;
+    }
+    if ((flags_.fetch_or(Metric::Flags::Changed) & Metric::Flags::Changed) == 0) {
+      alloc_.addChangedStat(static_cast<BaseClass*>(this));
+    }
+  }
+  void clearChanged() { flags_ &= ~Metric::Flags::Changed; }
+
   // RefcountInterface
   void incRefCount() override { ++ref_count_; }
   bool decRefCount() override {
@@ -107,6 +121,9 @@ public:
     if (--ref_count_ == 0) {
       alloc_.sync().syncPoint(AllocatorImpl::DecrementToZeroSyncPoint);
       removeFromSetLockHeld();
+      if ((flags_ & Metric::Flags::Changed) != 0) {
+        alloc_.removeChangedStat(static_cast<BaseClass*>(this));
+      }
       return true;
     }
     return false;
@@ -156,6 +173,7 @@ public:
     value_ += amount;
     pending_increment_ += amount;
     flags_ |= Flags::Used;
+    markChanged();
   }
   void inc() override { add(1); }
   uint64_t latch() override { return pending_increment_.exchange(0); }
@@ -167,6 +185,137 @@ private:
   std::atomic<uint64_t> pending_increment_{0};
 };
 
+// Returns a small per-thread index, assigned in the order in which threads first increment a
+// sharded counter. The main thread and the workers therefore map to distinct slots as long as
+// there are at least as many slots as threads.
+uint32_t counterShardIndex() {
+  static std::atomic<uint32_t> next_index{0};
+  thread_local const uint32_t index = next_index.fetch_add(1, std::memory_order_relaxed);
+  return index;
+}
+
+// Per-thread slots of a contended counter. Each slot sits on its own cache line, so threads mapped
+// to different slots never write to the same line.
+class CounterShards {
+public:
+  explicit CounterShards(uint32_t num_shards)
+      : mask_(num_shards - 1), slots_(new Slot[num_shards]) {
+    ASSERT(num_shards > 0 && (num_shards & mask_) == 0);
+  }
+
+  void add(uint64_t amount) {
+    slots_[counterShardIndex() & mask_].value_.fetch_add(amount, std::memory_order_relaxed);
+  }
+
+  // Slots only ever grow, so the sum is monotonic.
+  uint64_t sum() const {
+    uint64_t sum = 0;
+    for (uint32_t i = 0; i <= mask_; ++i) {
+      sum += slots_[i].value_.load(std::memory_order_relaxed);
+    }
+    return sum;
+  }
+
+  // The sum at the last latch(), and at the last reset(). Both are only written from the thread
+  // which flushes or resets stats.
+  std::atomic<uint64_t> latched_sum_{0};
+  std::atomic<uint64_t> reset_sum_{0};
+
+private:
+  struct alignas(64) Slot {
+    std::atomic<uint64_t> value_{0};
+  };
+
+  const uint32_t mask_;
+  const std::unique_ptr<Slot[]> slots_;
+};
+
+// A counter which switches to per-thread slots once a second thread increments it. Counters
+// which are only ever incremented by a single thread, which is the common case for main thread
+// stats, only pay for the owner thread id and an unset slots pointer.
+class ShardedCounterImpl : public CounterImpl {
+public:
+  ShardedCounterImpl(StatName name, AllocatorImpl& alloc, StatName tag_extracted_name,
+                     const StatNameTagVector& stat_name_tags, uint32_t num_shards)
+      : CounterImpl(name, alloc, tag_extracted_name, stat_name_tags), num_shards_(num_shards) {}
+
+  ~ShardedCounterImpl() override { delete shards_.load(std::memory_order_acquire); }
+
+  // Stats::Counter
+  void add(uint64_t amount) override {
+    CounterShards* shards = shards_.load(std::memory_order_acquire);
+    if (shards == nullptr) {
+      if (isOwnerThread()) {
+        CounterImpl::add(amount);
+        return;
+      }
+      shards = createShards();
+    }
+    shards->add(amount);
+    // Only write the shared flags when they change, as an unconditional read-modify-write would
+    // bring back the cache line contention that the slots avoid.
+    if ((flags_.load(std::memory_order_relaxed) & Flags::Used) == 0) {
+      flags_ |= Flags::Used;
+    }
+    markChanged();
+  }
+  void inc() override { add(1); }
+  uint64_t latch() override {
+    uint64_t pending = CounterImpl::latch();
+    CounterShards* shards = shards_.load(std::memory_order_acquire);
+    if (shards != nullptr) {
+      const uint64_t sum = shards->sum();
+      pending += sum - shards->latched_sum_.exchange(sum, std::memory_order_relaxed);
+    }
+    return pending;
+  }
+  void reset() override {
+    CounterImpl::reset();
+    CounterShards* shards = shards_.load(std::memory_order_acquire);
+    if (shards != nullptr) {
+      shards->reset_sum_.store(shards->sum(), std::memory_order_release);
+    }
+  }
+  uint64_t value() const override {
+    uint64_t value = CounterImpl::value();
+    const CounterShards* shards = shards_.load(std::memory_order_acquire);
+    if (shards != nullptr) {
+      // Load the reset point before the slots, so that the sum is never behind it.
+      const uint64_t reset_sum = shards->reset_sum_.load(std::memory_order_acquire);
+      value += shards->sum() - reset_sum;
+    }
+    return value;
+  }
+
+private:
+  // Returns true if the calling thread is the first, and so far only, thread to increment the
+  // counter.
+  bool isOwnerThread() {
+    const uint32_t thread_id = counterShardIndex() + 1;
+    uint32_t owner = owner_thread_.load(std::memory_order_relaxed);
+    if (owner == thread_id) {
+      return true;
+    }
+    return owner == 0 &&
+           owner_thread_.compare_exchange_strong(owner, thread_id, std::memory_order_relaxed);
+  }
+
+  CounterShards* createShards() {
+    auto shards = std::make_unique<CounterShards>(num_shards_);
+    CounterShards* expected = nullptr;
+    if (shards_.compare_exchange_strong(expected, shards.get(), std::memory_order_acq_rel)) {
+      return shards.release();
+    }
+    // Another thread won the race.
+    return expected;
+  }
+
+  const uint32_t num_shards_;
+  // counterShardIndex() + 1 of the first thread to increment the counter, or 0.
+  std::atomic<uint32_t> owner_thread_{0};
+  std::atomic<CounterShards*> shards_{nullptr};
+};
+
 class GaugeImpl : public StatsSharedImpl<Gauge> {
 public:
   GaugeImpl(StatName name, AllocatorImpl& alloc, StatName tag_extracted_name,
@@ -202,17 +351,20 @@ public:
   void add(uint64_t amount) override {
     child_value_ += amount;
     flags_ |= Flags::Used;
+    markChanged();
   }
   void dec() override { sub(1); }
   void inc() override { add(1); }
   void set(uint64_t value) override {
     child_value_ = value;
     flags_ |= Flags::Used;
+    markChanged();
   }
   void sub(uint64_t amount) override {
     ASSERT(child_value_ >= amount);
     ASSERT(used() || amount == 0);
     child_value_ -= amount;
+    markChanged();
   }
   uint64_t value() const override { return child_value_ + parent_value_; }
 
@@ -261,7 +413,10 @@ public:
     }
   }
 
-  void setParentValue(uint64_t value) override { parent_value_ = value; }
+  void setParentValue(uint64_t value) override {
+    parent_value_ = value;
+    markChanged();
+  }
 
 private:
   std::atomic<uint64_t> parent_value_{0};
@@ -286,6 +441,7 @@ public:
     absl::MutexLock lock(mutex_);
     value_ = std::move(value_copy);
     flags_ |= Flags::Used;
+    markChanged();
   }
   std::string value() const override {
     absl::MutexLock lock(mutex_);
@@ -326,9 +482,11 @@ GaugeSharedPtr AllocatorImpl::makeGauge(StatName name, StatName tag_extracted_na
   if (iter != gauges_.end()) {
     return {*iter};
   }
-  auto gauge =
-      GaugeSharedPtr(new GaugeImpl(name, *this, tag_extracted_name, stat_name_tags, import_mode));
+  auto* gauge_impl = new GaugeImpl(name, *this, tag_extracted_name, stat_name_tags, import_mode);
+  auto gauge = GaugeSharedPtr(gauge_impl);
   gauges_.insert(gauge.get());
+  // New gauges are included in the next incremental flush.
+  gauge_impl->markChanged();
   // Add gauge to sinked_gauges_ if it matches the sink predicate.
   if (sink_predicates_ != nullptr && sink_predicates_->includeGauge(*gauge)) {
     auto val = sinked_gauges_.insert(gauge.get());
@@ -346,9 +504,11 @@ TextReadoutSharedPtr AllocatorImpl::makeTextReadout(StatName name, StatName tag_
   if (iter != text_readouts_.end()) {
     return {*iter};
   }
-  auto text_readout =
-      TextReadoutSharedPtr(new TextReadoutImpl(name, *this, tag_extracted_name, stat_name_tags));
+  auto* text_readout_impl = new TextReadoutImpl(name, *this, tag_extracted_name, stat_name_tags);
+  auto text_readout = TextReadoutSharedPtr(text_readout_impl);
   text_readouts_.insert(text_readout.get());
+  // New text readouts are included in the next incremental flush.
+  text_readout_impl->markChanged();
   // Add text_readout to sinked_text_readouts_ if it matches the sink predicate.
   if (sink_predicates_ != nullptr && sink_predicates_->includeTextReadout(*text_readout)) {
     auto val = sinked_text_readouts_.insert(text_readout.get());
@@ -367,9 +527,18 @@ bool AllocatorImpl::isMutexLockedForTest() {
 
 Counter* AllocatorImpl::makeCounterInternal(StatName name, StatName tag_extracted_name,
                                             const StatNameTagVector& stat_name_tags) {
+  const uint32_t num_shards = counter_shards_.load(std::memory_order_relaxed);
+  if (num_shards > 0) {
+    return new ShardedCounterImpl(name, *this, tag_extracted_name, stat_name_tags, num_shards);
+  }
   return new CounterImpl(name, *this, tag_extracted_name, stat_name_tags);
 }
 
+void AllocatorImpl::setCounterShards(uint32_t num_shards) {
+  ASSERT((num_shards & (num_shards - 1)) == 0);
+  counter_shards_.store(num_shards, std::memory_order_relaxed);
+}
+
 void AllocatorImpl::forEachCounter(SizeFn f_size, StatFn<Counter> f_stat) const {
   Thread::LockGuard lock(mutex_);
   if (f_size != nullptr) {
@@ -440,6 +609,59 @@ void AllocatorImpl::forEachSinkedTextReadout(SizeFn f_size, StatFn<TextReadout>
   }
 }
 
+template <class StatType> void AllocatorImpl::addChangedStat(StatType* stat) {
+  Thread::LockGuard lock(changed_mutex_);
+  changedStats(stat).insert(stat);
+}
+
+template <class StatType> void AllocatorImpl::removeChangedStat(StatType* stat) {
+  Thread::LockGuard lock(changed_mutex_);
+  changedStats(stat).erase(stat);
+}
+
+void AllocatorImpl::forEachChangedSinkedStat(StatFn<Counter> f_counter, StatFn<Gauge> f_gauge,
+                                             StatFn<TextReadout> f_text_readout) {
+  // Holding mutex_ keeps the changed stats from being destroyed while they are visited.
+  Thread::LockGuard lock(mutex_);
+  StatPointerSet<Counter> counters;
+  StatPointerSet<Gauge> gauges;
+  StatPointerSet<TextReadout> text_readouts;
+  {
+    Thread::LockGuard changed_lock(changed_mutex_);
+    counters.swap(changed_counters_);
+    gauges.swap(changed_gauges_);
+    text_readouts.swap(changed_text_readouts_);
+  }
+
+  // Only the stat implementations in this file add themselves, so the down casts are safe. The
+  // flag is cleared before the stat is read, so that a concurrent change is either seen now or
+  // records the stat again for the next call. As for forEachSinked*(), stats which were marked for
+  // deletion are skipped.
+  for (Counter* counter : counters) {
+    static_cast<CounterImpl*>(counter)->clearChanged();
+    if (sink_predicates_ != nullptr ? sinked_counters_.contains(counter)
+                                    : counters_.find(counter->statName()) != counters_.end()) {
+      f_counter(*counter);
+    }
+  }
+  for (Gauge* gauge : gauges) {
+    static_cast<GaugeImpl*>(gauge)->clearChanged();
+    if (sink_predicates_ != nullptr
+            ? sinked_gauges_.contains(gauge)
+            : !gauge->hidden() && gauges_.find(gauge->statName()) != gauges_.end()) {
+      f_gauge(*gauge);
+    }
+  }
+  for (TextReadout* text_readout : text_readouts) {
+    static_cast<TextReadoutImpl*>(text_readout)->clearChanged();
+    if (sink_predicates_ != nullptr
+            ? sinked_text_readouts_.contains(text_readout)
+            : text_readouts_.find(text_readout->statName()) != text_readouts_.end()) {
+      f_text_readout(*text_readout);
+    }
+  }
+}
+
 void AllocatorImpl::setSinkPredicates(std::unique_ptr<SinkPredicates>&& sink_predicates) {
   Thread::LockGuard lock(mutex_);
   ASSERT(sink_predicates_ == nullptr);
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <vector>
 
 #include "envoy/common/optref.h"
@@ -43,8 +44,12 @@ public:
   void forEachSinkedCounter(SizeFn f_size, StatFn<Counter> f_stat) const override;
   void forEachSinkedGauge(SizeFn f_size, StatFn<Gauge> f_stat) const override;
   void forEachSinkedTextReadout(SizeFn f_size, StatFn<TextReadout> f_stat) const override;
+  void trackChanges() override { track_changes_.store(true, std::memory_order_relaxed); }
+  void forEachChangedSinkedStat(StatFn<Counter> f_counter, StatFn<Gauge> f_gauge,
+                                StatFn<TextReadout> f_text_readout) override;
 
   void setSinkPredicates(std::unique_ptr<SinkPredicates>&& sink_predicates) override;
+  void setCounterShards(uint32_t num_shards) override;
 #ifndef ENVOY_CONFIG_COVERAGE
   void debugPrint();
 #endif
@@ -93,6 +98,33 @@ private:
   // Predicates used to filter stats to be flushed.
   std::unique_ptr<SinkPredicates> sink_predicates_;
   SymbolTable& symbol_table_;
+  // Number of slots for sharded counters, or 0 if new counters are not sharded.
+  std::atomic<uint32_t> counter_shards_{0};
+  // Whether stats record when they change, so that incremental flushes can skip idle stats.
+  std::atomic<bool> track_changes_{false};
+
+  // Stats which changed since forEachChangedSinkedStat() was last called. They are added by the
+  // threads which change them, so they are guarded by their own lock rather than mutex_. A stat
+  // removes itself when it is destroyed. When both are held, mutex_ is acquired first.
+  Thread::MutexBasicLockable changed_mutex_;
+  StatPointerSet<Counter> changed_counters_ ABSL_GUARDED_BY(changed_mutex_);
+  StatPointerSet<Gauge> changed_gauges_ ABSL_GUARDED_BY(changed_mutex_);
+  StatPointerSet<TextReadout> changed_text_readouts_ ABSL_GUARDED_BY(changed_mutex_);
+
+  // Records a stat which changed for the first time since the changed stats were last visited, or
+  // forgets it when it is destroyed.
+  template <class StatType> void addChangedStat(StatType* stat);
+  template <class StatType> void removeChangedStat(StatType* stat);
+  StatPointerSet<Counter>& changedStats(Counter*) ABSL_EXCLUSIVE_LOCKS_REQUIRED(changed_mutex_) {
+    return changed_counters_;
+  }
+  StatPointerSet<Gauge>& changedStats(Gauge*) ABSL_EXCLUSIVE_LOCKS_REQUIRED(changed_mutex_) {
+    return changed_gauges_;
+  }
+  StatPointerSet<TextReadout>& changedStats(TextReadout*)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(changed_mutex_) {
+    return changed_text_readouts_;
+  }
 
   Thread::ThreadSynchronizer sync_;
 
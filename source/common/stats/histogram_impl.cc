@@ -111,7 +111,8 @@ HistogramSettingsImpl::HistogramSettingsImpl(const envoy::config::metrics::v3::S
                                buckets.empty()
                                    ? absl::nullopt
                                    : absl::make_optional<ConstSupportedBuckets>(std::move(buckets)),
-                               PROTOBUF_GET_OPTIONAL_WRAPPED(matcher, bins));
+                               PROTOBUF_GET_OPTIONAL_WRAPPED(matcher, bins),
+                               matcher.bucketed_recording());
         }
 
         return configs;
@@ -135,6 +136,17 @@ absl::optional<uint32_t> HistogramSettingsImpl::bins(absl::string_view stat_name
   return {};
 }
 
+bool HistogramSettingsImpl::bucketedRecording(absl::string_view stat_name) const {
+  // As for the buckets, the first matching rule wins, so that a histogram is always recorded
+  // according to a single rule.
+  for (const auto& config : configs_) {
+    if (config.matcher_.match(stat_name)) {
+      return config.bucketed_recording_;
+    }
+  }
+  return false;
+}
+
 const ConstSupportedBuckets& HistogramSettingsImpl::defaultBuckets() {
   CONSTRUCT_ON_FIRST_USE(ConstSupportedBuckets,
                          {0.5, 1, 5, 10, 25, 50, 100, 250, 500, 1000, 2500, 5000, 10000, 30000,
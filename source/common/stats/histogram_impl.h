@@ -26,6 +26,7 @@ public:
   // HistogramSettings
   const ConstSupportedBuckets& buckets(absl::string_view stat_name) const override;
   absl::optional<uint32_t> bins(absl::string_view stat_name) const override;
+  bool bucketedRecording(absl::string_view stat_name) const override;
 
   static ConstSupportedBuckets& defaultBuckets();
 
@@ -34,6 +35,7 @@ private:
     Matchers::StringMatcherImpl matcher_;
     absl::optional<ConstSupportedBuckets> buckets_;
     absl::optional<uint32_t> bins_;
+    bool bucketed_recording_;
   };
   const std::vector<Config> configs_{};
 };
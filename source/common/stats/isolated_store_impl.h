@@ -104,6 +104,16 @@ public:
     UNREFERENCED_PARAMETER(f_stat);
   }
 
+  void trackChanges() override {}
+
+  void forEachChangedSinkedStat(StatFn<Counter> f_counter, StatFn<Gauge> f_gauge,
+                                StatFn<TextReadout> f_text_readout) override {
+    // Changes are not tracked, so all stats are visited.
+    forEachCounter(nullptr, f_counter);
+    forEachGauge(nullptr, f_gauge);
+    forEachTextReadout(nullptr, f_text_readout);
+  }
+
   NullCounterImpl& nullCounter() override { return null_counter_; }
   NullGaugeImpl& nullGauge() override { return null_gauge_; }
 
@@ -31,6 +31,44 @@ static constexpr uint32_t Low7Bits = 0x7f;
 static constexpr Symbol FirstValidSymbol = 1;
 static constexpr uint8_t LiteralStringIndicator = 0;
 
+namespace {
+
+// Scoped exclusive lock which counts the acquisitions that had to wait.
+class ABSL_SCOPED_LOCKABLE CountingMutexLock {
+public:
+  CountingMutexLock(absl::Mutex& mutex, std::atomic<uint64_t>& contentions)
+      ABSL_EXCLUSIVE_LOCK_FUNCTION(mutex)
+      : mutex_(mutex) {
+    if (!mutex_.TryLock()) {
+      contentions.fetch_add(1, std::memory_order_relaxed);
+      mutex_.Lock();
+    }
+  }
+  ~CountingMutexLock() ABSL_UNLOCK_FUNCTION() { mutex_.Unlock(); }
+
+private:
+  absl::Mutex& mutex_;
+};
+
+// Scoped shared lock which counts the acquisitions that had to wait.
+class ABSL_SCOPED_LOCKABLE CountingReaderMutexLock {
+public:
+  CountingReaderMutexLock(absl::Mutex& mutex, std::atomic<uint64_t>& contentions)
+      ABSL_SHARED_LOCK_FUNCTION(mutex)
+      : mutex_(mutex) {
+    if (!mutex_.ReaderTryLock()) {
+      contentions.fetch_add(1, std::memory_order_relaxed);
+      mutex_.ReaderLock();
+    }
+  }
+  ~CountingReaderMutexLock() ABSL_UNLOCK_FUNCTION() { mutex_.ReaderUnlock(); }
+
+private:
+  absl::Mutex& mutex_;
+};
+
+} // namespace
+
 size_t StatName::dataSize() const {
   if (size_and_data_ == nullptr) {
     return 0;
@@ -261,7 +299,7 @@ bool StatName::startsWith(StatName prefix) const {
 
 std::vector<absl::string_view> SymbolTable::decodeStrings(StatName stat_name) const {
   std::vector<absl::string_view> strings;
-  Thread::LockGuard lock(lock_);
+  CountingReaderMutexLock lock(lock_, lock_contentions_);
   Encoding::decodeTokens(
       stat_name,
       [this, &strings](Symbol symbol)
@@ -312,10 +350,19 @@ void SymbolTable::addTokensToEncoding(const absl::string_view name, Encoding& en
   std::vector<Symbol> symbols;
   symbols.reserve(tokens.size());
 
+  // Most names are made up of tokens which are already in the table, for example dynamic stat
+  // names created on every request. Those only need a shared lock. Recent lookups can only be
+  // recorded with an exclusive lock, so this is skipped while they are being tracked.
+  if (!track_recent_lookups_.load(std::memory_order_relaxed) &&
+      addExistingSymbols(tokens, symbols)) {
+    encoding.addSymbols(symbols);
+    return;
+  }
+
   // Now take the lock and populate the Symbol objects, which involves bumping
   // ref-counts in this.
   {
-    Thread::LockGuard lock(lock_);
+    CountingMutexLock lock(lock_, lock_contentions_);
     recent_lookups_.lookup(name);
     for (auto& token : tokens) {
       // TODO(jmarantz): consider using StatNameDynamicStorage for tokens with
@@ -330,8 +377,45 @@ void SymbolTable::addTokensToEncoding(const absl::string_view name, Encoding& en
   encoding.addSymbols(symbols);
 }
 
+bool SymbolTable::addExistingSymbols(const std::vector<absl::string_view>& tokens,
+                                     std::vector<Symbol>& symbols) {
+  absl::InlinedVector<SharedSymbol*, 8> shared_symbols;
+  shared_symbols.reserve(tokens.size());
+
+  CountingReaderMutexLock lock(lock_, lock_contentions_);
+  for (absl::string_view token : tokens) {
+    auto encode_find = encode_map_.find(token);
+    if (encode_find == encode_map_.end()) {
+      return false;
+    }
+    shared_symbols.push_back(&encode_find->second);
+  }
+  // Symbols cannot be erased while the lock is held shared, so every reference count is at least
+  // one and can be bumped without the exclusive lock.
+  for (SharedSymbol* shared_symbol : shared_symbols) {
+    shared_symbol->ref_count_.fetch_add(1, std::memory_order_relaxed);
+    symbols.push_back(shared_symbol->symbol_);
+  }
+  shared_encodes_.fetch_add(1, std::memory_order_relaxed);
+  return true;
+}
+
+SymbolTable::SharedSymbol& SymbolTable::sharedSymbol(Symbol symbol) {
+  auto decode_search = decode_map_.find(symbol);
+  ASSERT(decode_search != decode_map_.end(),
+         "Please see "
+         "https://github.com/envoyproxy/envoy/blob/main/source/docs/stats.md#"
+         "debugging-symbol-table-assertions");
+  auto encode_search = encode_map_.find(decode_search->second->toStringView());
+  ASSERT(encode_search != encode_map_.end(),
+         "Please see "
+         "https://github.com/envoyproxy/envoy/blob/main/source/docs/stats.md#"
+         "debugging-symbol-table-assertions");
+  return encode_search->second;
+}
+
 uint64_t SymbolTable::numSymbols() const {
-  Thread::LockGuard lock(lock_);
+  absl::MutexLock lock(lock_);
   ASSERT(encode_map_.size() == decode_map_.size());
   return encode_map_.size();
 }
@@ -344,21 +428,11 @@ void SymbolTable::incRefCount(const StatName& stat_name) {
   // Before taking the lock, decode the array of symbols from the SymbolTable::Storage.
   const SymbolVec symbols = Encoding::decodeSymbols(stat_name);
 
-  Thread::LockGuard lock(lock_);
+  // The caller holds a reference to every symbol, so none of them can be erased, and adding
+  // references only needs the lock held shared.
+  CountingReaderMutexLock lock(lock_, lock_contentions_);
   for (Symbol symbol : symbols) {
-    auto decode_search = decode_map_.find(symbol);
-
-    ASSERT(decode_search != decode_map_.end(),
-           "Please see "
-           "https://github.com/envoyproxy/envoy/blob/main/source/docs/stats.md#"
-           "debugging-symbol-table-assertions");
-    auto encode_search = encode_map_.find(decode_search->second->toStringView());
-    ASSERT(encode_search != encode_map_.end(),
-           "Please see "
-           "https://github.com/envoyproxy/envoy/blob/main/source/docs/stats.md#"
-           "debugging-symbol-table-assertions");
-
-    ++encode_search->second.ref_count_;
+    sharedSymbol(symbol).ref_count_.fetch_add(1, std::memory_order_relaxed);
   }
 }
 
@@ -366,8 +440,28 @@ void SymbolTable::free(const StatName& stat_name) {
   // Before taking the lock, decode the array of symbols from the SymbolTable::Storage.
   const SymbolVec symbols = Encoding::decodeSymbols(stat_name);
 
-  Thread::LockGuard lock(lock_);
-  for (Symbol symbol : symbols) {
+  // References which are not the last one for their symbol are dropped with the lock held shared.
+  // The remaining ones may erase their symbol, which needs the lock held exclusively.
+  SymbolVec last_references;
+  {
+    CountingReaderMutexLock lock(lock_, lock_contentions_);
+    for (Symbol symbol : symbols) {
+      std::atomic<uint32_t>& ref_count = sharedSymbol(symbol).ref_count_;
+      uint32_t count = ref_count.load(std::memory_order_relaxed);
+      while (count > 1 &&
+             !ref_count.compare_exchange_weak(count, count - 1, std::memory_order_relaxed)) {
+      }
+      if (count <= 1) {
+        last_references.push_back(symbol);
+      }
+    }
+  }
+  if (last_references.empty()) {
+    return;
+  }
+
+  CountingMutexLock lock(lock_, lock_contentions_);
+  for (Symbol symbol : last_references) {
     auto decode_search = decode_map_.find(symbol);
     ASSERT(decode_search != decode_map_.end());
 
@@ -395,11 +489,12 @@ uint64_t SymbolTable::getRecentLookups(const RecentLookupsFn& iter) const {
   // We don't want to hold lock_ while calling the iterator, but we need it to
   // access recent_lookups_, so we buffer in name_count_map.
   {
-    Thread::LockGuard lock(lock_);
+    absl::MutexLock lock(lock_);
     recent_lookups_.forEach(
         [&name_count_map](absl::string_view str, uint64_t count)
             ABSL_NO_THREAD_SAFETY_ANALYSIS { name_count_map[std::string(str)] += count; });
-    total += recent_lookups_.total();
+    total += recent_lookups_.total() + shared_encodes_.load(std::memory_order_relaxed) -
+             cleared_shared_encodes_;
   }
 
   // Now we have the collated name-count map data: we need to vectorize and
@@ -444,20 +539,29 @@ DynamicSpans SymbolTable::getDynamicSpans(StatName stat_name) const {
 }
 
 void SymbolTable::setRecentLookupCapacity(uint64_t capacity) {
-  Thread::LockGuard lock(lock_);
+  absl::MutexLock lock(lock_);
   recent_lookups_.setCapacity(capacity);
+  track_recent_lookups_.store(capacity > 0, std::memory_order_relaxed);
 }
 
 void SymbolTable::clearRecentLookups() {
-  Thread::LockGuard lock(lock_);
+  absl::MutexLock lock(lock_);
   recent_lookups_.clear();
+  cleared_shared_encodes_ = shared_encodes_.load(std::memory_order_relaxed);
 }
 
 uint64_t SymbolTable::recentLookupCapacity() const {
-  Thread::LockGuard lock(lock_);
+  absl::MutexLock lock(lock_);
   return recent_lookups_.capacity();
 }
 
+SymbolTable::LockStats SymbolTable::lockStats() const {
+  LockStats stats;
+  stats.shared_encodes_ = shared_encodes_.load(std::memory_order_relaxed);
+  stats.contentions_ = lock_contentions_.load(std::memory_order_relaxed);
+  return stats;
+}
+
 StatNameSetPtr SymbolTable::makeSet(absl::string_view name) {
   // make_unique does not work with private ctor, even though SymbolTable is a friend.
   StatNameSetPtr stat_name_set(new StatNameSet(*this, name));
@@ -491,7 +595,7 @@ Symbol SymbolTable::toSymbol(absl::string_view sv) {
 }
 
 absl::string_view SymbolTable::fromSymbol(const Symbol symbol) const
-    ABSL_EXCLUSIVE_LOCKS_REQUIRED(lock_) {
+    ABSL_SHARED_LOCKS_REQUIRED(lock_) {
   auto search = decode_map_.find(symbol);
   RELEASE_ASSERT(search != decode_map_.end(), "no such symbol");
   return search->second->toStringView();
@@ -512,12 +616,12 @@ bool SymbolTable::lessThan(const StatName& a, const StatName& b) const {
   // Proactively take the table lock in anticipation that we'll need to
   // convert at least one symbol to a string_view, and it's easier not to
   // bother to lazily take the lock.
-  Thread::LockGuard lock(lock_);
+  CountingReaderMutexLock lock(lock_, lock_contentions_);
   return lessThanLockHeld(a, b);
 }
 
 bool SymbolTable::lessThanLockHeld(const StatName& a, const StatName& b) const
-    ABSL_EXCLUSIVE_LOCKS_REQUIRED(lock_) {
+    ABSL_SHARED_LOCKS_REQUIRED(lock_) {
   Encoding::TokenIter a_iter(a), b_iter(b);
   while (true) {
     Encoding::TokenIter::TokenType a_type = a_iter.next();
@@ -547,7 +651,7 @@ bool SymbolTable::lessThanLockHeld(const StatName& a, const StatName& b) const
 
 #ifndef ENVOY_CONFIG_COVERAGE
 void SymbolTable::debugPrint() const {
-  Thread::LockGuard lock(lock_);
+  absl::MutexLock lock(lock_);
   std::vector<Symbol> symbols;
   for (const auto& p : decode_map_) {
     symbols.push_back(p.first);
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <algorithm>
+#include <atomic>
 #include <memory>
 #include <stack>
 #include <string>
@@ -19,6 +20,7 @@
 #include "absl/container/inlined_vector.h"
 #include "absl/strings/str_join.h"
 #include "absl/strings/str_split.h"
+#include "absl/synchronization/mutex.h"
 
 namespace Envoy {
 namespace Stats {
@@ -311,6 +313,19 @@ public:
    */
   uint64_t recentLookupCapacity() const;
 
+  struct LockStats {
+    // Number of names encoded with only a shared lock, because all of their tokens were already
+    // in the table.
+    uint64_t shared_encodes_{};
+    // Number of times a thread had to wait to acquire the table lock.
+    uint64_t contentions_{};
+  };
+
+  /**
+   * @return counters describing how the table lock is being used.
+   */
+  LockStats lockStats() const;
+
   /**
    * Identifies the dynamic components of a stat_name into an array of integer
    * pairs, indicating the begin/end of spans of tokens in the stat-name that
@@ -349,7 +364,7 @@ public:
   void sortByStatNames(Iter begin, Iter end, GetStatName get_stat_name) const {
     // Grab the lock once before sorting begins, so we don't have to re-take
     // it on every comparison.
-    Thread::LockGuard lock(lock_);
+    absl::ReaderMutexLock lock(lock_);
     StatNameCompare<GetStatName, Obj> compare(*this, get_stat_name);
     std::sort(begin, end, compare);
   }
@@ -397,13 +412,20 @@ private:
 
   struct SharedSymbol {
     SharedSymbol(Symbol symbol) : symbol_(symbol) {}
+    // Only called while rehashing the encode map, with lock_ held exclusively.
+    SharedSymbol(SharedSymbol&& src) noexcept
+        : symbol_(src.symbol_), ref_count_(src.ref_count_.load(std::memory_order_relaxed)) {}
 
     Symbol symbol_;
-    uint32_t ref_count_{1};
+    // References may be added, and dropped while others remain, with lock_ held shared. Dropping
+    // the last reference, which erases the symbol, requires lock_ held exclusively.
+    std::atomic<uint32_t> ref_count_{1};
   };
 
-  // This must be held during both encode() and free().
-  mutable Thread::MutexBasicLockable lock_;
+  // This must be held during both encode() and free(). Names made up of symbols which are already
+  // in the table are encoded and freed with the lock held shared, so that workers creating the
+  // same dynamic stat names do not serialize on it.
+  mutable absl::Mutex lock_;
 
   /**
    * Decodes a uint8_t array into an array of period-delimited strings. Note
@@ -434,7 +456,22 @@ private:
    * @param symbol the individual symbol to be decoded.
    * @return absl::string_view the decoded string.
    */
-  absl::string_view fromSymbol(Symbol symbol) const ABSL_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  absl::string_view fromSymbol(Symbol symbol) const ABSL_SHARED_LOCKS_REQUIRED(lock_);
+
+  /**
+   * Adds a reference to the symbols for all tokens, if they are all in the table already.
+   *
+   * @param tokens the tokens to look up.
+   * @param symbols receives the symbols for the tokens.
+   * @return true if all tokens were found, false if none were referenced.
+   */
+  bool addExistingSymbols(const std::vector<absl::string_view>& tokens,
+                          std::vector<Symbol>& symbols);
+
+  /**
+   * @return the encode map entry for a symbol which is in the table.
+   */
+  SharedSymbol& sharedSymbol(Symbol symbol) ABSL_SHARED_LOCKS_REQUIRED(lock_);
 
   /**
    * Stages a new symbol for use. To be called after a successful insertion.
@@ -451,7 +488,7 @@ private:
   void addTokensToEncoding(absl::string_view name, Encoding& encoding);
 
   Symbol monotonicCounter() {
-    Thread::LockGuard lock(lock_);
+    absl::MutexLock lock(lock_);
     return monotonic_counter_;
   }
 
@@ -475,6 +512,12 @@ private:
   // using an Envoy::IntervalSet.
   std::stack<Symbol> pool_ ABSL_GUARDED_BY(lock_);
   RecentLookups recent_lookups_ ABSL_GUARDED_BY(lock_);
+  // Encodes which skip recent_lookups_ are only allowed while lookups are not being recorded.
+  std::atomic<bool> track_recent_lookups_{false};
+  // Included in the total of recent lookups, relative to the value at the last clear.
+  std::atomic<uint64_t> shared_encodes_{0};
+  uint64_t cleared_shared_encodes_ ABSL_GUARDED_BY(lock_){0};
+  mutable std::atomic<uint64_t> lock_contentions_{0};
 };
 
 // Base class for holding the backing-storing for a StatName. The two derived
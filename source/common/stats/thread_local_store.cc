@@ -1,5 +1,6 @@
 #include "source/common/stats/thread_local_store.h"
 
+#include <algorithm>
 #include <chrono>
 #include <cstdint>
 #include <list>
@@ -713,6 +714,8 @@ Histogram& ThreadLocalStoreImpl::ScopeImpl::histogramFromStatNameWithTags(
     const auto string_stat_name = symbolTable().toString(final_stat_name);
     buckets = &parent_.histogram_settings_->buckets(string_stat_name);
     const auto bins = parent_.histogram_settings_->bins(string_stat_name);
+    const bool bucketed_recording =
+        parent_.histogram_settings_->bucketedRecording(string_stat_name);
 
     RefcountPtr<ParentHistogramImpl> stat;
     {
@@ -728,7 +731,8 @@ Histogram& ThreadLocalStoreImpl::ScopeImpl::histogramFromStatNameWithTags(
         }
         stat = new ParentHistogramImpl(final_stat_name, unit, parent_,
                                        tag_helper.tagExtractedName(), tag_helper.statNameTags(),
-                                       *buckets, bins, parent_.next_histogram_id_++);
+                                       *buckets, bins, bucketed_recording,
+                                       parent_.next_histogram_id_++);
         if (!parent_.shutting_down_) {
           parent_.histogram_set_.insert(stat.get());
           if (parent_.sink_predicates_.has_value() &&
@@ -835,7 +839,8 @@ Histogram& ThreadLocalStoreImpl::tlsHistogram(ParentHistogramImpl& parent, uint6
 
   TlsHistogramSharedPtr hist_tls_ptr(
       new ThreadLocalHistogramImpl(parent.statName(), parent.unit(), tag_helper.tagExtractedName(),
-                                   tag_helper.statNameTags(), symbolTable(), parent.bins()));
+                                   tag_helper.statNameTags(), symbolTable(), parent.bins(),
+                                   parent.recordingBuckets()));
 
   parent.addTlsHistogram(hist_tls_ptr);
 
@@ -850,11 +855,17 @@ ThreadLocalHistogramImpl::ThreadLocalHistogramImpl(StatName name, Histogram::Uni
                                                    StatName tag_extracted_name,
                                                    const StatNameTagVector& stat_name_tags,
                                                    SymbolTable& symbol_table,
-                                                   absl::optional<uint32_t> bins)
+                                                   absl::optional<uint32_t> bins,
+                                                   const ConstSupportedBuckets* recording_buckets)
     : HistogramImplHelper(name, tag_extracted_name, stat_name_tags, symbol_table), unit_(unit),
-      used_(false), created_thread_id_(std::this_thread::get_id()), symbol_table_(symbol_table) {
+      recording_buckets_(recording_buckets), used_(false),
+      created_thread_id_(std::this_thread::get_id()), symbol_table_(symbol_table) {
   histograms_[0] = bins ? hist_alloc_nbins(bins.value()) : hist_alloc();
   histograms_[1] = bins ? hist_alloc_nbins(bins.value()) : hist_alloc();
+  if (recording_buckets_ != nullptr) {
+    bucket_counts_[0] = std::make_unique<uint64_t[]>(recording_buckets_->size());
+    bucket_counts_[1] = std::make_unique<uint64_t[]>(recording_buckets_->size());
+  }
 }
 
 ThreadLocalHistogramImpl::~ThreadLocalHistogramImpl() {
@@ -865,8 +876,18 @@ ThreadLocalHistogramImpl::~ThreadLocalHistogramImpl() {
 
 void ThreadLocalHistogramImpl::recordValue(uint64_t value) {
   ASSERT(std::this_thread::get_id() == created_thread_id_);
-  hist_insert_intscale(histograms_[current_active_], value, 0, 1);
   used_ = true;
+  if (recording_buckets_ != nullptr) {
+    // Buckets are sorted upper bounds, so the first bound which is not below the value is the
+    // bucket the value belongs to.
+    const auto bucket = std::lower_bound(recording_buckets_->begin(), recording_buckets_->end(),
+                                         static_cast<double>(value));
+    if (bucket != recording_buckets_->end()) {
+      ++bucket_counts_[current_active_][bucket - recording_buckets_->begin()];
+      return;
+    }
+  }
+  hist_insert_intscale(histograms_[current_active_], value, 0, 1);
 }
 
 void ThreadLocalHistogramImpl::merge(histogram_t* target) {
@@ -875,17 +896,38 @@ void ThreadLocalHistogramImpl::merge(histogram_t* target) {
   hist_clear(*other_histogram);
 }
 
+void ThreadLocalHistogramImpl::mergeBucketCounts(std::vector<uint64_t>& target) {
+  ASSERT(recording_buckets_ != nullptr && target.size() == recording_buckets_->size());
+  uint64_t* other_counts = bucket_counts_[otherHistogramIndex()].get();
+  // Plain loops over contiguous arrays, which the compiler vectorizes.
+  for (size_t i = 0; i < target.size(); ++i) {
+    target[i] += other_counts[i];
+  }
+  std::fill_n(other_counts, target.size(), 0);
+}
+
 ParentHistogramImpl::ParentHistogramImpl(StatName name, Histogram::Unit unit,
                                          ThreadLocalStoreImpl& thread_local_store,
                                          StatName tag_extracted_name,
                                          const StatNameTagVector& stat_name_tags,
                                          ConstSupportedBuckets& supported_buckets,
-                                         absl::optional<uint32_t> bins, uint64_t id)
+                                         absl::optional<uint32_t> bins, bool bucketed_recording,
+                                         uint64_t id)
     : MetricImpl(name, tag_extracted_name, stat_name_tags, thread_local_store.symbolTable()),
-      unit_(unit), bins_(bins), thread_local_store_(thread_local_store),
-      interval_histogram_(hist_alloc()), cumulative_histogram_(hist_alloc()),
+      unit_(unit), bins_(bins),
+      // Percent values are scaled before they are recorded, so they cannot be compared with the
+      // configured buckets.
+      recording_buckets_(bucketed_recording && unit != Histogram::Unit::Percent
+                             ? &supported_buckets
+                             : nullptr),
+      thread_local_store_(thread_local_store), interval_histogram_(hist_alloc()),
+      cumulative_histogram_(hist_alloc()),
       interval_statistics_(interval_histogram_, unit, supported_buckets),
-      cumulative_statistics_(cumulative_histogram_, unit, supported_buckets), id_(id) {}
+      cumulative_statistics_(cumulative_histogram_, unit, supported_buckets), id_(id) {
+  if (recording_buckets_ != nullptr) {
+    bucket_counts_.resize(recording_buckets_->size());
+  }
+}
 
 ParentHistogramImpl::~ParentHistogramImpl() {
   thread_local_store_.releaseHistogramCrossThread(id_);
@@ -976,6 +1018,12 @@ void ParentHistogramImpl::merge() {
     // merge and adding TLS histograms is rare.
     for (const TlsHistogramSharedPtr& tls_histogram : tls_histograms_) {
       tls_histogram->merge(interval_histogram_);
+      if (recording_buckets_ != nullptr) {
+        tls_histogram->mergeBucketCounts(bucket_counts_);
+      }
+    }
+    if (recording_buckets_ != nullptr) {
+      insertBucketCountsLockHeld();
     }
     // Since TLS merge is done, we can release the lock here.
     lock.release();
@@ -1051,6 +1099,20 @@ void ParentHistogramImpl::addTlsHistogram(const TlsHistogramSharedPtr& hist_ptr)
   tls_histograms_.emplace_back(hist_ptr);
 }
 
+void ParentHistogramImpl::insertBucketCountsLockHeld() {
+  // Place the values of each bucket at its midpoint, which lies within the same bucket when the
+  // histogram statistics count the values below each bound.
+  double lower_bound = 0;
+  for (size_t i = 0; i < bucket_counts_.size(); ++i) {
+    const double upper_bound = (*recording_buckets_)[i];
+    if (bucket_counts_[i] > 0) {
+      hist_insert(interval_histogram_, (lower_bound + upper_bound) / 2, bucket_counts_[i]);
+      bucket_counts_[i] = 0;
+    }
+    lower_bound = upper_bound;
+  }
+}
+
 bool ParentHistogramImpl::usedLockHeld() const {
   for (const TlsHistogramSharedPtr& tls_histogram : tls_histograms_) {
     if (tls_histogram->used()) {
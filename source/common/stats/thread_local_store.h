@@ -6,6 +6,7 @@
 #include <list>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "envoy/stats/stats_matcher.h"
 #include "envoy/stats/tag.h"
@@ -31,16 +32,28 @@ namespace Stats {
  * A histogram that is stored in TLS and used to record values per thread. This holds two
  * histograms, one to collect the values and other as backup that is used for merge process. The
  * swap happens during the merge process.
+ *
+ * In bucketed recording mode, values which fall within the recording buckets only increment a
+ * per-bucket count, and are converted to a histogram by the parent at merge time. Values above
+ * the largest bucket are still inserted into the histograms.
  */
 class ThreadLocalHistogramImpl : public HistogramImplHelper {
 public:
   ThreadLocalHistogramImpl(StatName name, Histogram::Unit unit, StatName tag_extracted_name,
                            const StatNameTagVector& stat_name_tags, SymbolTable& symbol_table,
-                           absl::optional<uint32_t> bins);
+                           absl::optional<uint32_t> bins,
+                           const ConstSupportedBuckets* recording_buckets = nullptr);
   ~ThreadLocalHistogramImpl() override;
 
   void merge(histogram_t* target);
 
+  /**
+   * Adds the bucket counts collected before the last beginMerge() to `target`, and clears them.
+   * Only valid in bucketed recording mode.
+   * @param target the merged counts, with one entry per recording bucket.
+   */
+  void mergeBucketCounts(std::vector<uint64_t>& target);
+
   /**
    * Called in the beginning of merge process. Swaps the histogram used for collection so that we do
    * not have to lock the histogram in high throughput TLS writes.
@@ -70,6 +83,10 @@ private:
   uint64_t otherHistogramIndex() const { return 1 - current_active_; }
   uint64_t current_active_{0};
   histogram_t* histograms_[2];
+  // Upper bounds of the buckets for bucketed recording, or nullptr if all values are inserted into
+  // histograms_.
+  const ConstSupportedBuckets* const recording_buckets_;
+  std::unique_ptr<uint64_t[]> bucket_counts_[2];
   std::atomic<bool> used_;
   const std::thread::id created_thread_id_;
   SymbolTable& symbol_table_;
@@ -87,7 +104,7 @@ public:
   ParentHistogramImpl(StatName name, Histogram::Unit unit, ThreadLocalStoreImpl& parent,
                       StatName tag_extracted_name, const StatNameTagVector& stat_name_tags,
                       ConstSupportedBuckets& supported_buckets, absl::optional<uint32_t> bins,
-                      uint64_t id);
+                      bool bucketed_recording, uint64_t id);
   ~ParentHistogramImpl() override;
 
   void addTlsHistogram(const TlsHistogramSharedPtr& hist_ptr);
@@ -133,14 +150,18 @@ public:
   void setShuttingDown(bool shutting_down) { shutting_down_ = shutting_down; }
   bool shuttingDown() const { return shutting_down_; }
   absl::optional<uint32_t> bins() const { return bins_; }
+  // Upper bounds of the buckets thread local histograms record into, or nullptr.
+  const ConstSupportedBuckets* recordingBuckets() const { return recording_buckets_; }
 
 private:
   bool usedLockHeld() const ABSL_EXCLUSIVE_LOCKS_REQUIRED(merge_lock_);
   std::vector<Stats::ParentHistogram::Bucket>
   detailedlBucketsHelper(const histogram_t& histogram) const;
+  void insertBucketCountsLockHeld() ABSL_EXCLUSIVE_LOCKS_REQUIRED(merge_lock_);
 
   const Histogram::Unit unit_;
   const absl::optional<uint32_t> bins_;
+  const ConstSupportedBuckets* const recording_buckets_;
   ThreadLocalStoreImpl& thread_local_store_;
   histogram_t* interval_histogram_;
   histogram_t* cumulative_histogram_;
@@ -148,6 +169,8 @@ private:
   HistogramStatisticsImpl cumulative_statistics_;
   mutable Thread::MutexBasicLockable merge_lock_;
   std::list<TlsHistogramSharedPtr> tls_histograms_ ABSL_GUARDED_BY(merge_lock_);
+  // Bucket counts merged from the TLS histograms in bucketed recording mode.
+  std::vector<uint64_t> bucket_counts_ ABSL_GUARDED_BY(merge_lock_);
   bool merged_{false};
   std::atomic<bool> shutting_down_{false};
   std::atomic<uint32_t> ref_count_{0};
@@ -213,8 +236,14 @@ public:
   void forEachSinkedGauge(SizeFn f_size, StatFn<Gauge> f_stat) const override;
   void forEachSinkedTextReadout(SizeFn f_size, StatFn<TextReadout> f_stat) const override;
   void forEachSinkedHistogram(SizeFn f_size, StatFn<ParentHistogram> f_stat) const override;
+  void trackChanges() override { alloc_.trackChanges(); }
+  void forEachChangedSinkedStat(StatFn<Counter> f_counter, StatFn<Gauge> f_gauge,
+                                StatFn<TextReadout> f_text_readout) override {
+    alloc_.forEachChangedSinkedStat(f_counter, f_gauge, f_text_readout);
+  }
 
   void setSinkPredicates(std::unique_ptr<SinkPredicates>&& sink_predicates) override;
+  void setCounterShards(uint32_t num_shards) override { alloc_.setCounterShards(num_shards); }
   OptRef<SinkPredicates> sinkPredicates() override { return sink_predicates_; }
 
   /**
@@ -0,0 +1,196 @@
+#include "source/common/tcp_proxy/splice_forwarder.h"
+
+#include "source/common/api/os_sys_calls_impl.h"
+#include "source/common/common/assert.h"
+#include "source/common/common/utility.h"
+
+#if defined(__linux__)
+#include <fcntl.h>
+
+#include "source/common/api/os_sys_calls_impl_linux.h"
+#endif
+
+namespace Envoy {
+namespace TcpProxy {
+
+#if defined(__linux__)
+namespace {
+
+// Matches the default capacity of a Linux pipe.
+constexpr uint64_t MaxSpliceChunk = 64 * 1024;
+constexpr unsigned int SpliceFlags = SPLICE_F_MOVE | SPLICE_F_NONBLOCK;
+
+bool wouldBlock(int error) { return error == SOCKET_ERROR_AGAIN || error == SOCKET_ERROR_INTR; }
+
+} // namespace
+
+SplicePipePtr SplicePipe::create() {
+  os_fd_t fds[2];
+  const Api::SysCallIntResult result =
+      Api::LinuxOsSysCallsSingleton::get().pipe2(fds, O_NONBLOCK | O_CLOEXEC);
+  if (result.return_value_ != 0) {
+    ENVOY_LOG_MISC(debug, "failed to create splice pipe: {}", errorDetails(result.errno_));
+    return nullptr;
+  }
+  return SplicePipePtr{new SplicePipe(fds[0], fds[1])};
+}
+
+SplicePipe::~SplicePipe() {
+  auto& os_sys_calls = Api::OsSysCallsSingleton::get();
+  os_sys_calls.close(read_end_);
+  os_sys_calls.close(write_end_);
+}
+
+SplicePipe::Result SplicePipe::transfer(os_fd_t from, os_fd_t to, uint64_t max_bytes) {
+  auto& os_sys_calls = Api::LinuxOsSysCallsSingleton::get();
+  Result result;
+  bool progress = true;
+  while (progress) {
+    progress = false;
+    if (!end_stream_) {
+      if (result.bytes_read_ >= max_bytes) {
+        result.more_ = true;
+      } else {
+        // EAGAIN here means either the socket has no data, or the pipe is full. In the latter case
+        // the write below will either make room or block, and a write event resumes reading.
+        const Api::SysCallSizeResult rc =
+            os_sys_calls.splice(from, write_end_, MaxSpliceChunk, SpliceFlags);
+        if (rc.return_value_ > 0) {
+          buffered_ += rc.return_value_;
+          result.bytes_read_ += rc.return_value_;
+          progress = true;
+        } else if (rc.return_value_ == 0) {
+          end_stream_ = true;
+        } else if (!wouldBlock(rc.errno_)) {
+          result.error_ = rc.errno_;
+          return result;
+        }
+      }
+    }
+    if (buffered_ > 0) {
+      const Api::SysCallSizeResult rc = os_sys_calls.splice(read_end_, to, buffered_, SpliceFlags);
+      if (rc.return_value_ > 0) {
+        ASSERT(static_cast<uint64_t>(rc.return_value_) <= buffered_);
+        buffered_ -= rc.return_value_;
+        result.bytes_written_ += rc.return_value_;
+        progress = true;
+      } else if (rc.return_value_ < 0 && !wouldBlock(rc.errno_)) {
+        result.error_ = rc.errno_;
+        return result;
+      }
+    }
+  }
+  return result;
+}
+
+std::unique_ptr<SpliceForwarder> SpliceForwarder::create(Event::Dispatcher& dispatcher,
+                                                         Network::Connection& downstream,
+                                                         Network::Connection& upstream,
+                                                         SpliceForwarderCallbacks& callbacks) {
+  SplicePipePtr downstream_pipe = SplicePipe::create();
+  SplicePipePtr upstream_pipe = SplicePipe::create();
+  if (downstream_pipe == nullptr || upstream_pipe == nullptr) {
+    return nullptr;
+  }
+
+  std::unique_ptr<SpliceForwarder> forwarder{new SpliceForwarder(
+      downstream.getSocket()->ioHandle().fdDoNotUse(), upstream.getSocket()->ioHandle().fdDoNotUse(),
+      std::move(downstream_pipe), std::move(upstream_pipe), callbacks)};
+
+  // The connections keep their own events on the same sockets for write and close handling. Both
+  // must use the same trigger type, which libevent requires for events sharing a file descriptor.
+  auto cb = [forwarder = forwarder.get()](uint32_t) {
+    forwarder->onFileEvent();
+    return absl::OkStatus();
+  };
+  forwarder->downstream_event_ = dispatcher.createFileEvent(
+      forwarder->downstream_fd_, cb, Event::PlatformDefaultTriggerType,
+      Event::FileReadyType::Read | Event::FileReadyType::Write);
+  forwarder->upstream_event_ = dispatcher.createFileEvent(
+      forwarder->upstream_fd_, cb, Event::PlatformDefaultTriggerType,
+      Event::FileReadyType::Read | Event::FileReadyType::Write);
+  return forwarder;
+}
+#else
+SplicePipePtr SplicePipe::create() { return nullptr; }
+
+SplicePipe::~SplicePipe() = default;
+
+SplicePipe::Result SplicePipe::transfer(os_fd_t, os_fd_t, uint64_t) {
+  PANIC("splice is not supported on this platform");
+}
+
+std::unique_ptr<SpliceForwarder> SpliceForwarder::create(Event::Dispatcher&, Network::Connection&,
+                                                         Network::Connection&,
+                                                         SpliceForwarderCallbacks&) {
+  return nullptr;
+}
+#endif
+
+void SpliceForwarder::start() {
+  // Defer the first transfer to the event loop, so that callbacks are never invoked from within
+  // the caller's stack.
+  downstream_event_->activate(Event::FileReadyType::Read);
+}
+
+void SpliceForwarder::onFileEvent() {
+  // Any readiness change on either socket may unblock either direction, so always pump both.
+  if (!pump(*downstream_pipe_, downstream_fd_, upstream_fd_, upstream_write_shutdown_, true) ||
+      !pump(*upstream_pipe_, upstream_fd_, downstream_fd_, downstream_write_shutdown_, false)) {
+    return;
+  }
+  if (upstream_write_shutdown_ && downstream_write_shutdown_) {
+    ENVOY_LOG(trace, "splice: both directions complete");
+    disableEvents();
+    callbacks_.onSpliceComplete();
+  }
+}
+
+bool SpliceForwarder::pump(SplicePipe& pipe, os_fd_t from, os_fd_t to, bool& write_shutdown,
+                           bool downstream) {
+  if (write_shutdown) {
+    return true;
+  }
+
+  const SplicePipe::Result result = pipe.transfer(from, to, MaxBytesPerEvent);
+  ENVOY_LOG(trace, "splice: {} read {} bytes, wrote {} bytes, {} bytes in flight",
+            downstream ? "downstream" : "upstream", result.bytes_read_, result.bytes_written_,
+            pipe.buffered());
+  if (result.bytes_read_ > 0 || result.bytes_written_ > 0) {
+    if (downstream) {
+      callbacks_.onSpliceDownstreamData(result.bytes_read_, result.bytes_written_);
+    } else {
+      callbacks_.onSpliceUpstreamData(result.bytes_read_, result.bytes_written_);
+    }
+  }
+
+  if (result.error_ != 0) {
+    ENVOY_LOG(debug, "splice: {} transfer failed: {}", downstream ? "downstream" : "upstream",
+              errorDetails(result.error_));
+    disableEvents();
+    callbacks_.onSpliceError(result.error_);
+    return false;
+  }
+
+  if (result.more_) {
+    // Edge triggered events do not fire again for data which is already readable.
+    (downstream ? downstream_event_ : upstream_event_)->activate(Event::FileReadyType::Read);
+  }
+
+  if (pipe.endStream() && pipe.buffered() == 0) {
+    // Propagate the half close to the peer.
+    Api::OsSysCallsSingleton::get().shutdown(to, ENVOY_SHUT_WR);
+    write_shutdown = true;
+  }
+  return true;
+}
+
+void SpliceForwarder::disableEvents() {
+  // The events are dropped before the owner is told to close the connections, so that they can
+  // never fire for a file descriptor number which has been closed and reused.
+  downstream_event_.reset();
+  upstream_event_.reset();
+}
+
+} // namespace TcpProxy
+} // namespace Envoy
@@ -0,0 +1,162 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+
+#include "envoy/common/platform.h"
+#include "envoy/common/pure.h"
+#include "envoy/event/deferred_deletable.h"
+#include "envoy/event/dispatcher.h"
+#include "envoy/event/file_event.h"
+#include "envoy/network/connection.h"
+
+#include "source/common/common/logger.h"
+#include "source/common/common/non_copyable.h"
+
+namespace Envoy {
+namespace TcpProxy {
+
+/**
+ * Callbacks used by SpliceForwarder to report progress to the TCP proxy filter.
+ */
+class SpliceForwarderCallbacks {
+public:
+  virtual ~SpliceForwarderCallbacks() = default;
+
+  /**
+   * Called when bytes were moved from the downstream socket towards the upstream socket.
+   * @param bytes_read number of bytes read from the downstream socket.
+   * @param bytes_written number of bytes written to the upstream socket.
+   */
+  virtual void onSpliceDownstreamData(uint64_t bytes_read, uint64_t bytes_written) PURE;
+
+  /**
+   * Called when bytes were moved from the upstream socket towards the downstream socket.
+   * @param bytes_read number of bytes read from the upstream socket.
+   * @param bytes_written number of bytes written to the downstream socket.
+   */
+  virtual void onSpliceUpstreamData(uint64_t bytes_read, uint64_t bytes_written) PURE;
+
+  /**
+   * Called once both directions have reached end of stream and all in-flight bytes have been
+   * written. The forwarder's events are disabled before this is called.
+   */
+  virtual void onSpliceComplete() PURE;
+
+  /**
+   * Called when splicing failed with a socket error. The forwarder's events are disabled before
+   * this is called.
+   * @param error the errno reported by splice(2).
+   */
+  virtual void onSpliceError(int error) PURE;
+};
+
+/**
+ * A kernel pipe used as the intermediate buffer for one direction of a spliced connection.
+ */
+class SplicePipe : NonCopyable {
+public:
+  struct Result {
+    uint64_t bytes_read_{};
+    uint64_t bytes_written_{};
+    // Set when the per call transfer limit was reached while more data may be readable.
+    bool more_{};
+    // Non-zero errno if the transfer failed.
+    int error_{};
+  };
+
+  /**
+   * @return a pipe, or nullptr if it could not be created or splice(2) is not supported.
+   */
+  static std::unique_ptr<SplicePipe> create();
+  ~SplicePipe();
+
+  /**
+   * Move as many bytes as possible from `from` into the pipe and from the pipe into `to`, until
+   * both sides would block, the source reaches end of stream or `max_bytes` have been read.
+   */
+  Result transfer(os_fd_t from, os_fd_t to, uint64_t max_bytes);
+
+  /**
+   * @return number of bytes read into the pipe but not yet written out.
+   */
+  uint64_t buffered() const { return buffered_; }
+
+  /**
+   * @return true if the source has reached end of stream.
+   */
+  bool endStream() const { return end_stream_; }
+
+private:
+  SplicePipe(os_fd_t read_end, os_fd_t write_end) : read_end_(read_end), write_end_(write_end) {}
+
+  const os_fd_t read_end_;
+  const os_fd_t write_end_;
+  uint64_t buffered_{};
+  bool end_stream_{};
+};
+
+using SplicePipePtr = std::unique_ptr<SplicePipe>;
+
+/**
+ * Moves bytes between two connected, plain TCP sockets without copying them into user space by
+ * splicing through a pair of kernel pipes. The owning connections must be read-disabled for the
+ * lifetime of the forwarder, and must not have any buffered data when forwarding starts. The
+ * forwarder registers its own edge-triggered file events alongside the connections' events, so
+ * the connections keep their close and write handling.
+ */
+class SpliceForwarder : public Event::DeferredDeletable,
+                        NonCopyable,
+                        Logger::Loggable<Logger::Id::filter> {
+public:
+  // Upper bound on the bytes read from one socket per event, so that a busy connection does not
+  // starve the rest of the event loop.
+  static constexpr uint64_t MaxBytesPerEvent = 1024 * 1024;
+
+  /**
+   * @return a forwarder between the two connections, or nullptr if kernel splicing is not
+   *         available.
+   */
+  static std::unique_ptr<SpliceForwarder> create(Event::Dispatcher& dispatcher,
+                                                 Network::Connection& downstream,
+                                                 Network::Connection& upstream,
+                                                 SpliceForwarderCallbacks& callbacks);
+
+  /**
+   * Start moving data. Any data already readable on either socket is moved right away.
+   */
+  void start();
+
+  /**
+   * Stop watching the sockets. This must be called before either connection closes its socket.
+   */
+  void disableEvents();
+
+private:
+  SpliceForwarder(os_fd_t downstream_fd, os_fd_t upstream_fd, SplicePipePtr&& downstream_pipe,
+                  SplicePipePtr&& upstream_pipe, SpliceForwarderCallbacks& callbacks)
+      : downstream_fd_(downstream_fd), upstream_fd_(upstream_fd),
+        downstream_pipe_(std::move(downstream_pipe)), upstream_pipe_(std::move(upstream_pipe)),
+        callbacks_(callbacks) {}
+
+  void onFileEvent();
+  // Returns false if the forwarder must not be touched anymore.
+  bool pump(SplicePipe& pipe, os_fd_t from, os_fd_t to, bool& write_shutdown, bool downstream);
+
+  const os_fd_t downstream_fd_;
+  const os_fd_t upstream_fd_;
+  // Downstream to upstream direction.
+  const SplicePipePtr downstream_pipe_;
+  // Upstream to downstream direction.
+  const SplicePipePtr upstream_pipe_;
+  SpliceForwarderCallbacks& callbacks_;
+  Event::FileEventPtr downstream_event_;
+  Event::FileEventPtr upstream_event_;
+  bool upstream_write_shutdown_{};
+  bool downstream_write_shutdown_{};
+};
+
+using SpliceForwarderPtr = std::unique_ptr<SpliceForwarder>;
+
+} // namespace TcpProxy
+} // namespace Envoy
@@ -267,6 +267,8 @@ Config::Config(const envoy::extensions::filters::network::tcp_proxy::v3::TcpProx
     max_early_data_bytes_ = config.max_early_data_bytes().value();
   }
 
+  kernel_splice_ = config.kernel_splice();
+
   // Validate: Non-IMMEDIATE modes require max_early_data_bytes to be set.
   // Setting it to zero is allowed and will disable early data buffering.
   if (upstream_connect_mode_ != UpstreamConnectMode::IMMEDIATE &&
@@ -1189,6 +1191,7 @@ void Filter::onDownstreamEvent(Network::ConnectionEvent event) {
 
   if (event == Network::ConnectionEvent::LocalClose ||
       event == Network::ConnectionEvent::RemoteClose) {
+    stopKernelSplice();
     downstream_closed_ = true;
     // Cancel the potential odcds callback.
     cluster_discovery_handle_ = nullptr;
@@ -1244,6 +1247,7 @@ void Filter::onUpstreamEvent(Network::ConnectionEvent event) {
 
   if (event == Network::ConnectionEvent::RemoteClose ||
       event == Network::ConnectionEvent::LocalClose) {
+    stopKernelSplice();
     // Propagate the upstream local close reason to the downstream stream info's upstreamInfo.
     if (upstream_) {
       getStreamInfo().upstreamInfo()->setUpstreamLocalCloseReason(upstream_->localCloseReason());
@@ -1313,6 +1317,9 @@ void Filter::onUpstreamConnection() {
     ASSERT(0 == early_data_buffer_.length());
   }
 
+  // Reading stays disabled on both connections while the kernel moves the bytes.
+  const bool spliced = maybeStartKernelSplice();
+
   // Re-enable downstream reads if we disabled reading.
   // Reading can be disabled in two cases:
   // 1. Buffer overflow when receive_before_connect is enabled (tracked by
@@ -1321,7 +1328,7 @@ void Filter::onUpstreamConnection() {
   if (read_disabled_due_to_buffer_) {
     read_callbacks_->connection().readDisable(false);
     read_disabled_due_to_buffer_ = false;
-  } else if (!receive_before_connect_) {
+  } else if (!receive_before_connect_ && !spliced) {
     // Re-enable downstream reads that were disabled in establishUpstreamConnection()
     // when early data reception was NOT enabled.
     read_callbacks_->connection().readDisable(false);
@@ -1353,6 +1360,73 @@ void Filter::onUpstreamConnection() {
   }
 }
 
+bool Filter::maybeStartKernelSplice() {
+  // With receive_before_connect the downstream connection may already hold data which must be
+  // forwarded through the regular path.
+  if (!config_->kernelSplice() || receive_before_connect_ || upstream_ == nullptr) {
+    return false;
+  }
+  Network::Connection& downstream_connection = read_callbacks_->connection();
+  Network::Connection* upstream_connection = upstream_->rawConnection();
+  // Bytes may only bypass the connections if no transport socket transforms them, no filter other
+  // than this one (or the upstream pool's) would miss them and nothing is left in the connection
+  // buffers which would otherwise be overtaken by the spliced data. Otherwise stay buffered.
+  if (upstream_connection == nullptr || !downstream_connection.canBypassBuffers() ||
+      !upstream_connection->canBypassBuffers()) {
+    return false;
+  }
+
+  splice_forwarder_ = SpliceForwarder::create(downstream_connection.dispatcher(),
+                                              downstream_connection, *upstream_connection, *this);
+  if (splice_forwarder_ == nullptr) {
+    return false;
+  }
+  ENVOY_CONN_LOG(debug, "switching to kernel splice", downstream_connection);
+  config_->stats().kernel_splice_total_.inc();
+  upstream_->readDisable(true);
+  splice_forwarder_->start();
+  return true;
+}
+
+void Filter::stopKernelSplice() {
+  if (splice_forwarder_ != nullptr) {
+    splice_forwarder_->disableEvents();
+    read_callbacks_->connection().dispatcher().deferredDelete(std::move(splice_forwarder_));
+  }
+}
+
+void Filter::onSpliceDownstreamData(uint64_t bytes_read, uint64_t bytes_written) {
+  getStreamInfo().getDownstreamBytesMeter()->addWireBytesReceived(bytes_read);
+  getStreamInfo().getUpstreamBytesMeter()->addWireBytesSent(bytes_written);
+  config_->stats().downstream_cx_rx_bytes_total_.add(bytes_read);
+  read_callbacks_->upstreamHost()->cluster().trafficStats()->upstream_cx_tx_bytes_total_.add(
+      bytes_written);
+  resetIdleTimer();
+}
+
+void Filter::onSpliceUpstreamData(uint64_t bytes_read, uint64_t bytes_written) {
+  getStreamInfo().getUpstreamBytesMeter()->addWireBytesReceived(bytes_read);
+  getStreamInfo().getDownstreamBytesMeter()->addWireBytesSent(bytes_written);
+  config_->stats().downstream_cx_tx_bytes_total_.add(bytes_written);
+  read_callbacks_->upstreamHost()->cluster().trafficStats()->upstream_cx_rx_bytes_total_.add(
+      bytes_read);
+  resetIdleTimer();
+}
+
+void Filter::onSpliceComplete() {
+  ENVOY_CONN_LOG(debug, "kernel splice complete", read_callbacks_->connection());
+  stopKernelSplice();
+  // Both directions have been half closed and flushed, so there is nothing left to write.
+  read_callbacks_->connection().close(Network::ConnectionCloseType::NoFlush);
+}
+
+void Filter::onSpliceError(int error) {
+  ENVOY_CONN_LOG(debug, "kernel splice failed: {}", read_callbacks_->connection(),
+                 errorDetails(error));
+  stopKernelSplice();
+  read_callbacks_->connection().close(Network::ConnectionCloseType::NoFlush);
+}
+
 void Filter::onIdleTimeout() {
   ENVOY_CONN_LOG(debug, "Session timed out", read_callbacks_->connection());
   config_->stats().idle_timeout_.inc();
@@ -34,6 +34,7 @@
 #include "source/common/network/hash_policy.h"
 #include "source/common/network/utility.h"
 #include "source/common/stream_info/stream_info_impl.h"
+#include "source/common/tcp_proxy/splice_forwarder.h"
 #include "source/common/tcp_proxy/upstream.h"
 #include "source/common/upstream/load_balancer_context_base.h"
 #include "source/common/upstream/od_cds_api_impl.h"
@@ -67,6 +68,7 @@ constexpr absl::string_view ReceiveBeforeConnectKey = "envoy.tcp_proxy.receive_b
   COUNTER(downstream_flow_control_resumed_reading_total)                                           \
   COUNTER(early_data_received_count_total)                                                         \
   COUNTER(idle_timeout)                                                                            \
+  COUNTER(kernel_splice_total)                                                                     \
   COUNTER(max_downstream_connection_duration)                                                      \
   COUNTER(upstream_flush_total)                                                                    \
   GAUGE(downstream_cx_rx_bytes_buffered, Accumulate)                                               \
@@ -377,6 +379,7 @@ public:
   }
 
   const absl::optional<uint32_t>& maxEarlyDataBytes() const { return max_early_data_bytes_; }
+  bool kernelSplice() const { return kernel_splice_; }
 
 private:
   struct SimpleRouteImpl : public Route {
@@ -433,6 +436,7 @@ private:
   envoy::extensions::filters::network::tcp_proxy::v3::UpstreamConnectMode upstream_connect_mode_{
       envoy::extensions::filters::network::tcp_proxy::v3::IMMEDIATE};
   absl::optional<uint32_t> max_early_data_bytes_;
+  bool kernel_splice_{false};
 };
 
 using ConfigSharedPtr = std::shared_ptr<Config>;
@@ -459,7 +463,8 @@ private:
 class Filter : public Network::ReadFilter,
                public Upstream::LoadBalancerContextBase,
                protected Logger::Loggable<Logger::Id::filter>,
-               public GenericConnectionPoolCallbacks {
+               public GenericConnectionPoolCallbacks,
+               public SpliceForwarderCallbacks {
 public:
   Filter(ConfigSharedPtr config, Upstream::ClusterManager& cluster_manager);
   ~Filter() override;
@@ -479,6 +484,12 @@ public:
                             absl::string_view failure_reason,
                             Upstream::HostDescriptionConstSharedPtr host) override;
 
+  // SpliceForwarderCallbacks
+  void onSpliceDownstreamData(uint64_t bytes_read, uint64_t bytes_written) override;
+  void onSpliceUpstreamData(uint64_t bytes_read, uint64_t bytes_written) override;
+  void onSpliceComplete() override;
+  void onSpliceError(int error) override;
+
   // Upstream::LoadBalancerContext
   const Router::MetadataMatchCriteria* metadataMatchCriteria() override;
   absl::optional<uint64_t> computeHashKey() override {
@@ -685,6 +696,9 @@ protected:
   void onUpstreamData(Buffer::Instance& data, bool end_stream);
   void onUpstreamEvent(Network::ConnectionEvent event);
   void onUpstreamConnection();
+  // Switch to kernel splicing if it is configured and both connections allow it.
+  bool maybeStartKernelSplice();
+  void stopKernelSplice();
   void onIdleTimeout();
   void resetIdleTimer();
   void disableIdleTimer();
@@ -754,6 +768,9 @@ protected:
   bool initial_data_received_{false};
   bool read_disabled_due_to_buffer_{false}; // Track if we disabled reading due to buffer overflow.
   uint32_t max_buffered_bytes_{65536};      // Default 64KB.
+  // Set while bytes are moved between the sockets in the kernel. Both connections stay
+  // read-disabled for as long as this is set.
+  SpliceForwarderPtr splice_forwarder_;
 };
 
 // This class deals with an upstream connection that needs to finish flushing, when the downstream
@@ -72,6 +72,14 @@ TcpUpstream::TcpUpstream(Tcp::ConnectionPool::ConnectionDataPtr&& data,
   upstream_conn_data_->addUpstreamCallbacks(upstream_callbacks);
 }
 
+Network::Connection* TcpUpstream::rawConnection() {
+  if (upstream_conn_data_ == nullptr ||
+      upstream_conn_data_->connection().state() != Network::Connection::State::Open) {
+    return nullptr;
+  }
+  return &upstream_conn_data_->connection();
+}
+
 bool TcpUpstream::readDisable(bool disable) {
   if (upstream_conn_data_ == nullptr ||
       upstream_conn_data_->connection().state() != Network::Connection::State::Open) {
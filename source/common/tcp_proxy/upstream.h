@@ -181,6 +181,7 @@ public:
   Ssl::ConnectionInfoConstSharedPtr getUpstreamConnectionSslInfo() override;
   StreamInfo::DetectedCloseType detectedCloseType() const override;
   absl::string_view localCloseReason() const override;
+  Network::Connection* rawConnection() override;
 
 private:
   Tcp::ConnectionPool::ConnectionDataPtr upstream_conn_data_;
@@ -135,6 +135,7 @@ public:
   std::chrono::milliseconds sessionTimeout() const override { return session_timeout_; }
   bool usingOriginalSrcIp() const override { return use_original_src_ip_; }
   bool usingPerPacketLoadBalancing() const override { return use_per_packet_load_balancing_; }
+  bool batchingUpstreamWrites() const override { return batch_upstream_writes_; }
   const Udp::HashPolicy* hashPolicy() const override { return hash_policy_.get(); }
   UdpProxyDownstreamStats& stats() const override { return stats_; }
   TimeSource& timeSource() const override { return time_source_; }
@@ -191,6 +192,7 @@ private:
   const std::chrono::milliseconds session_timeout_;
   const bool use_original_src_ip_;
   const bool use_per_packet_load_balancing_;
+  const bool batch_upstream_writes_;
   bool flush_access_log_on_tunnel_connected_;
   absl::optional<std::chrono::milliseconds> access_log_flush_interval_;
   std::unique_ptr<const HashPolicyImpl> hash_policy_;
@@ -555,6 +555,17 @@ void UdpProxyFilter::UdpActiveSession::writeUpstream(Network::UdpRecvData& data)
   ASSERT((connected_ || use_original_src_ip_) && udp_socket_ && host_);
 
   const uint64_t tx_buffer_length = data.buffer_->length();
+  if (flush_upstream_callback_ != nullptr) {
+    ENVOY_LOG(trace, "queueing {} byte datagram upstream: downstream={} local={} upstream={}",
+              tx_buffer_length, addresses_.peer_->asStringView(),
+              addresses_.local_->asStringView(), host_->address()->asStringView());
+    pending_upstream_datagrams_.push_back(std::move(data.buffer_));
+    if (!flush_upstream_callback_->enabled()) {
+      flush_upstream_callback_->scheduleCallbackCurrentIteration();
+    }
+    return;
+  }
+
   ENVOY_LOG(trace, "writing {} byte datagram upstream: downstream={} local={} upstream={}",
             tx_buffer_length, addresses_.peer_->asStringView(), addresses_.local_->asStringView(),
             host_->address()->asStringView());
@@ -571,6 +582,35 @@ void UdpProxyFilter::UdpActiveSession::writeUpstream(Network::UdpRecvData& data)
   }
 }
 
+void UdpProxyFilter::UdpActiveSession::flushUpstream() {
+  ASSERT(connected_ && udp_socket_ && host_ && cluster_);
+  const Api::IoCallUint64Result rc = Network::Utility::writeBatchToConnectedSocket(
+      udp_socket_->ioHandle(), pending_upstream_datagrams_, *host_->address(),
+      /*allow_gso=*/true);
+  ENVOY_LOG(trace, "wrote {} of {} datagrams upstream: downstream={} local={} upstream={}",
+            rc.return_value_, pending_upstream_datagrams_.size(), addresses_.peer_->asStringView(),
+            addresses_.local_->asStringView(), host_->address()->asStringView());
+
+  uint64_t tx_bytes = 0;
+  for (uint64_t i = 0; i < rc.return_value_; ++i) {
+    tx_bytes += pending_upstream_datagrams_[i]->length();
+  }
+  cluster_->cluster_stats_.sess_tx_datagrams_.add(rc.return_value_);
+  cluster_->cluster_stats_.sess_tx_errors_.add(pending_upstream_datagrams_.size() -
+                                               rc.return_value_);
+  cluster_->cluster_info_->trafficStats()->upstream_cx_tx_bytes_total_.add(tx_bytes);
+  pending_upstream_datagrams_.clear();
+}
+
+void UdpProxyFilter::UdpActiveSession::onSessionComplete() {
+  // The flush callback goes away with the session, so send the datagrams still queued from this
+  // iteration now rather than dropping them, and before the session end is logged.
+  if (!pending_upstream_datagrams_.empty()) {
+    flushUpstream();
+  }
+  ActiveSession::onSessionComplete();
+}
+
 bool UdpProxyFilter::ActiveSession::onContinueFilterChain(ActiveReadFilter* filter) {
   ASSERT(filter != nullptr);
 
@@ -646,6 +686,11 @@ void UdpProxyFilter::UdpActiveSession::createUdpSocket(const Upstream::HostConst
         return absl::OkStatus();
       },
       Event::PlatformDefaultTriggerType, Event::FileReadyType::Read);
+  if (filter_.config_->batchingUpstreamWrites()) {
+    flush_upstream_callback_ =
+        filter_.read_callbacks_->udpListener().dispatcher().createSchedulableCallback(
+            [this]() { flushUpstream(); });
+  }
 
   ENVOY_LOG(debug, "creating new session: downstream={} local={} upstream={}",
             addresses_.peer_->asStringView(), addresses_.local_->asStringView(),
@@ -128,6 +128,7 @@ public:
   virtual std::chrono::milliseconds sessionTimeout() const PURE;
   virtual bool usingOriginalSrcIp() const PURE;
   virtual bool usingPerPacketLoadBalancing() const PURE;
+  virtual bool batchingUpstreamWrites() const PURE;
   virtual const Udp::HashPolicy* hashPolicy() const PURE;
   virtual UdpProxyDownstreamStats& stats() const PURE;
   virtual TimeSource& timeSource() const PURE;
@@ -696,6 +697,7 @@ protected:
     bool createUpstream() override;
     void writeUpstream(Network::UdpRecvData& data) override;
     void onIdleTimer() override;
+    void onSessionComplete() override;
 
     // Network::UdpPacketProcessor
     void processPacket(Network::Address::InstanceConstSharedPtr local_address,
@@ -726,6 +728,7 @@ protected:
   private:
     void onReadReady();
     void createUdpSocket(const Upstream::HostConstSharedPtr& host);
+    void flushUpstream();
 
     // The socket is used for writing packets to the selected upstream host as well as receiving
     // packets from the upstream host. Note that a a local ephemeral port is bound on the first
@@ -734,6 +737,10 @@ protected:
     // The socket has been connected to avoid port exhaustion.
     bool connected_{};
     const bool use_original_src_ip_;
+    // When batching upstream writes, the datagrams written during the current event loop iteration,
+    // which are sent together by flush_upstream_callback_ at the end of the iteration.
+    std::vector<Buffer::InstancePtr> pending_upstream_datagrams_;
+    Event::SchedulableCallbackPtr flush_upstream_callback_;
   };
 
   /**
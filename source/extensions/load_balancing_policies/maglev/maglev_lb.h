@@ -10,6 +10,7 @@
 #include "envoy/upstream/load_balancer.h"
 
 #include "source/common/common/bit_array.h"
+#include "source/common/memory/huge_page_allocator.h"
 #include "source/extensions/load_balancing_policies/common/thread_aware_lb_impl.h"
 
 namespace Envoy {
@@ -130,7 +131,7 @@ private:
   void constructImplementationInternals(std::vector<TableBuildEntry>& table_build_entries,
                                         double max_normalized_weight) override;
 
-  std::vector<HostConstSharedPtr> table_;
+  std::vector<HostConstSharedPtr, Memory::HugePageAllocator<HostConstSharedPtr>> table_;
 };
 
 /**
@@ -37,6 +37,13 @@ Http::FilterTrailersStatus AdminFilter::decodeTrailers(Http::RequestTrailerMap&)
 }
 
 void AdminFilter::onDestroy() {
+  if (handler_ != nullptr) {
+    decoder_callbacks_->removeDownstreamWatermarkCallbacks(*this);
+    if (next_chunk_cb_ != nullptr) {
+      next_chunk_cb_->cancel();
+    }
+    handler_.reset();
+  }
   for (const auto& callback : on_destroy_callbacks_) {
     callback();
   }
@@ -86,24 +93,58 @@ void AdminFilter::onComplete() {
 
   auto header_map = Http::ResponseHeaderMapImpl::create();
   RELEASE_ASSERT(request_headers_, "");
-  Admin::RequestPtr handler = admin_.makeRequest(*this);
-  Http::Code code = handler->start(*header_map);
+  handler_ = admin_.makeRequest(*this);
+  Http::Code code = handler_->start(*header_map);
   Utility::populateFallbackResponseHeaders(code, *header_map);
   decoder_callbacks_->encodeHeaders(std::move(header_map), false,
                                     StreamInfo::ResponseCodeDetails::get().AdminFilterResponse);
 
-  // TODO(#31087): use high/lower watermarks to apply flow-control to the admin http port.
-  bool more_data;
-  do {
-    Buffer::OwnedImpl response;
-    more_data = handler->nextChunk(response);
-    bool end_stream = end_stream_on_complete_ && !more_data;
-    ENVOY_LOG_MISC(debug, "nextChunk: response.length={} more_data={} end_stream={}",
-                   response.length(), more_data, end_stream);
+  decoder_callbacks_->addDownstreamWatermarkCallbacks(*this);
+  nextChunk();
+}
+
+void AdminFilter::nextChunk() {
+  Buffer::OwnedImpl response;
+  const bool more_data = handler_->nextChunk(response);
+  const bool end_stream = end_stream_on_complete_ && !more_data;
+  ENVOY_LOG_MISC(debug, "nextChunk: response.length={} more_data={} end_stream={}",
+                 response.length(), more_data, end_stream);
+  if (!more_data) {
+    // Mark the response as complete before encoding the final chunk, as the stream may be
+    // destroyed while encoding it.
+    decoder_callbacks_->removeDownstreamWatermarkCallbacks(*this);
+    Admin::RequestPtr handler = std::move(handler_);
     if (response.length() > 0 || end_stream) {
       decoder_callbacks_->encodeData(response, end_stream);
     }
-  } while (more_data);
+    return;
+  }
+
+  if (response.length() > 0) {
+    decoder_callbacks_->encodeData(response, false);
+  }
+  // Encoding may have reset the stream, or pushed the downstream above its high watermark, in
+  // which case the next chunk is scheduled once it drains.
+  if (handler_ != nullptr && high_watermark_count_ == 0) {
+    scheduleNextChunk();
+  }
+}
+
+void AdminFilter::scheduleNextChunk() {
+  if (next_chunk_cb_ == nullptr) {
+    next_chunk_cb_ =
+        decoder_callbacks_->dispatcher().createSchedulableCallback([this]() { nextChunk(); });
+  }
+  next_chunk_cb_->scheduleCallbackNextIteration();
+}
+
+void AdminFilter::onAboveWriteBufferHighWatermark() { ++high_watermark_count_; }
+
+void AdminFilter::onBelowWriteBufferLowWatermark() {
+  ASSERT(high_watermark_count_ > 0);
+  if (--high_watermark_count_ == 0 && handler_ != nullptr) {
+    scheduleNextChunk();
+  }
 }
 
 } // namespace Server
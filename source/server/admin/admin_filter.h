@@ -3,6 +3,7 @@
 #include <functional>
 #include <list>
 
+#include "envoy/event/schedulable_cb.h"
 #include "envoy/http/filter.h"
 #include "envoy/server/admin.h"
 
@@ -22,6 +23,7 @@ namespace Server {
  */
 class AdminFilter : public Http::PassThroughFilter,
                     public AdminStream,
+                    public Http::DownstreamWatermarkCallbacks,
                     Logger::Loggable<Logger::Id::admin> {
 public:
   using AdminServerCallbackFunction = std::function<Http::Code(
@@ -59,13 +61,30 @@ public:
   }
   Http::Utility::QueryParamsMulti queryParams() const override;
 
+  // Http::DownstreamWatermarkCallbacks
+  void onAboveWriteBufferHighWatermark() override;
+  void onBelowWriteBufferLowWatermark() override;
+
 private:
   /**
    * Called when an admin request has been completely received.
    */
   void onComplete();
+
+  /**
+   * Sends the next chunk of the response, and schedules the one after it for
+   * the next dispatcher iteration unless the downstream is above its high
+   * watermark. Large responses are thus streamed without blocking the
+   * dispatcher or buffering the whole response.
+   */
+  void nextChunk();
+  void scheduleNextChunk();
+
   const Admin& admin_;
   Http::RequestHeaderMap* request_headers_{};
+  Admin::RequestPtr handler_;
+  Event::SchedulableCallbackPtr next_chunk_cb_;
+  uint32_t high_watermark_count_{0};
   std::list<std::function<void()>> on_destroy_callbacks_;
   bool end_stream_on_complete_ = true;
 };
@@ -1,7 +1,9 @@
 #include "source/server/admin/prometheus_stats.h"
 
 #include <cmath>
+#include <limits>
 #include <map>
+#include <memory>
 #include <set>
 
 #include "source/common/common/empty_string.h"
@@ -9,6 +11,7 @@
 #include "source/common/common/regex.h"
 #include "source/common/protobuf/protobuf.h"
 #include "source/common/stats/histogram_impl.h"
+#include "source/common/stats/symbol_table.h"
 #include "source/common/upstream/host_utility.h"
 
 #include "absl/strings/str_cat.h"
@@ -20,6 +23,9 @@ namespace Server {
 
 namespace {
 
+constexpr absl::string_view ProtobufContentType =
+    "application/vnd.google.protobuf; proto=io.prometheus.client.MetricFamily; encoding=delimited";
+
 const Regex::CompiledGoogleReMatcher& promRegex() {
   CONSTRUCT_ON_FIRST_USE(Regex::CompiledGoogleReMatcherNoSafetyChecks, "[^a-zA-Z0-9_]");
 }
@@ -635,24 +641,92 @@ private:
 };
 
 /**
- * Processes a stat type (counter, gauge, histogram) by generating all output lines, sorting
- * them by tag-extracted metric name, and then outputting them in the correct sorted order into
- * response.
- *
- * @param response The buffer to put the output into.
- * @param used_only Whether to only output stats that are used.
- * @param regex A filter on which stats to output.
- * @param metrics The metrics to output stats for. This must contain all stats of the given type
- *        to be included in the same output.
- * @param generate_output A function which returns the output text for this metric.
- * @param type The name of the prometheus metric type for used in TYPE annotations.
+ * Renders the metrics of one stat type (counter, gauge, text readout, histogram), grouped and
+ * sorted by tag-extracted metric name. Groups are rendered in order, and each group is released
+ * once it has been rendered.
  */
-template <class StatType>
-uint64_t outputStatType(Buffer::Instance& response, const StatsParams& params,
-                        const std::vector<Stats::RefcountPtr<StatType>>& metrics,
-                        const PrometheusStatsFormatter::OutputFormat& output_format,
-                        const Stats::CustomStatNamespaces& custom_namespaces) {
+class MetricGroups {
+public:
+  virtual ~MetricGroups() = default;
+
+  /**
+   * Renders groups until all of them have been rendered or the response holds at least
+   * `max_length` bytes.
+   * @return true if all groups have been rendered.
+   */
+  virtual bool render(Buffer::Instance& response, uint64_t max_length) PURE;
+};
+using MetricGroupsPtr = std::unique_ptr<MetricGroups>;
+
+template <class StatType> class MetricGroupsImpl : public MetricGroups {
+public:
+  /**
+   * Visits `source` once, collecting the metrics grouped by family.
+   * @param source visits all stats of the given type to be included in the same output.
+   * @param metric_name_count incremented for each metric name rendered.
+   */
+  MetricGroupsImpl(const PrometheusStatsFormatter::MetricSource<StatType>& source,
+                   const StatsParams& params,
+                   const PrometheusStatsFormatter::OutputFormat& output_format,
+                   const Stats::CustomStatNamespaces& custom_namespaces,
+                   uint64_t& metric_name_count)
+      : output_format_(output_format), custom_namespaces_(custom_namespaces),
+        metric_name_count_(metric_name_count) {
+    Stats::StatNameHashMap<uint64_t> family_indexes;
+    source([this, &params, &family_indexes](StatType& metric) {
+      if (!params.shouldShowMetric(metric)) {
+        return;
+      }
+      auto [iter, inserted] =
+          family_indexes.try_emplace(metric.tagExtractedStatName(), families_.size());
+      if (inserted) {
+        families_.emplace_back();
+      }
+      families_[iter->second].metrics_.emplace_back(&metric);
+    });
+    if (families_.empty()) {
+      return;
+    }
+
+    // There should only be one symbol table for all of the stats in the admin interface. If this
+    // assumption changes, the name comparisons in this class will have to change to compare to
+    // convert all StatNames to strings before comparison.
+    const Stats::StatNameLessThan less_than(families_.front().metrics_.front()->constSymbolTable());
+    std::sort(families_.begin(), families_.end(),
+              [&less_than](const MetricFamily& a, const MetricFamily& b) {
+                return less_than(a.metrics_.front()->tagExtractedStatName(),
+                                 b.metrics_.front()->tagExtractedStatName());
+              });
+  }
+
+  bool render(Buffer::Instance& response, uint64_t max_length) override {
+    while (next_family_ < families_.size() && response.length() < max_length) {
+      MetricFamily& family = families_[next_family_++];
+      const StatType& name_metric = *family.metrics_.front();
+      const absl::optional<std::string> prefixed_tag_extracted_name =
+          PrometheusStatsFormatter::metricName(
+              name_metric.constSymbolTable().toString(name_metric.tagExtractedStatName()),
+              custom_namespaces_);
+      if (prefixed_tag_extracted_name.has_value()) {
+        StatTypeUnsortedCollection group;
+        group.reserve(family.metrics_.size());
+        for (const StatTypeSharedPtr& metric : family.metrics_) {
+          group.push_back(metric.get());
+        }
+        // Sort before producing the final output to satisfy the "preferred" ordering from the
+        // prometheus spec: metrics will be sorted by their tags' textual representation, which
+        // will be consistent across calls.
+        std::sort(group.begin(), group.end(), MetricLessThan());
 
+        output_format_.generateOutput(response, group, prefixed_tag_extracted_name.value());
+        ++metric_name_count_;
+      }
+      family = MetricFamily();
+    }
+    return next_family_ == families_.size();
+  }
+
+private:
   /*
    * From
    * https://github.com/prometheus/docs/blob/master/content/docs/instrumenting/exposition_formats.md#grouping-and-sorting:
@@ -663,56 +737,30 @@ uint64_t outputStatType(Buffer::Instance& response, const StatsParams& params,
    * prohibitive.
    */
 
+  using StatTypeSharedPtr = Stats::RefcountPtr<StatType>;
+
   // This is an unsorted collection of dumb-pointers (no need to increment then decrement every
-  // refcount; ownership is held throughout by `metrics`). It is unsorted for efficiency, but will
+  // refcount; ownership is held throughout by the family). It is unsorted for efficiency, but will
   // be sorted before producing the final output to satisfy the "preferred" ordering from the
   // prometheus spec: metrics will be sorted by their tags' textual representation, which will be
   // consistent across calls.
   using StatTypeUnsortedCollection = std::vector<const StatType*>;
 
-  // Return early to avoid crashing when getting the symbol table from the first metric.
-  if (metrics.empty()) {
-    return 0;
-  }
-
-  // There should only be one symbol table for all of the stats in the admin
-  // interface. If this assumption changes, the name comparisons in this function
-  // will have to change to compare to convert all StatNames to strings before
-  // comparison.
-  const Stats::SymbolTable& global_symbol_table = metrics.front()->constSymbolTable();
-
-  // Sorted collection of metrics sorted by their tagExtractedName, to satisfy the requirements
-  // of the exposition format.
-  std::map<Stats::StatName, StatTypeUnsortedCollection, Stats::StatNameLessThan> groups(
-      global_symbol_table);
-
-  for (const auto& metric : metrics) {
-    ASSERT(&global_symbol_table == &metric->constSymbolTable());
-    if (!params.shouldShowMetric(*metric)) {
-      continue;
-    }
-    groups[metric->tagExtractedStatName()].push_back(metric.get());
-  }
-
-  auto result = groups.size();
-  for (auto& group : groups) {
-    const absl::optional<std::string> prefixed_tag_extracted_name =
-        PrometheusStatsFormatter::metricName(global_symbol_table.toString(group.first),
-                                             custom_namespaces);
-    if (!prefixed_tag_extracted_name.has_value()) {
-      --result;
-      continue;
-    }
+  struct MetricFamily {
+    // The metrics of the family, which share its tag-extracted name. Never empty.
+    std::vector<StatTypeSharedPtr> metrics_;
+  };
 
-    // Sort before producing the final output to satisfy the "preferred" ordering from the
-    // prometheus spec: metrics will be sorted by their tags' textual representation, which will
-    // be consistent across calls.
-    std::sort(group.second.begin(), group.second.end(), MetricLessThan());
+  const PrometheusStatsFormatter::OutputFormat& output_format_;
+  const Stats::CustomStatNamespaces& custom_namespaces_;
+  uint64_t& metric_name_count_;
 
-    output_format.generateOutput(response, group.second, prefixed_tag_extracted_name.value());
-  }
-  return result;
-}
+  // All families sorted by their tag-extracted name, to satisfy the requirements of the exposition
+  // format.
+  std::vector<MetricFamily> families_;
+  // The next family to render.
+  size_t next_family_{0};
+};
 
 template <class StatType, class OutputFormat>
 uint64_t outputPrimitiveStatType(Buffer::Instance& response, const StatsParams& params,
@@ -817,6 +865,196 @@ bool useProtobufFormat(const StatsParams& params, const Http::RequestHeaderMap&
   return use_protobuf;
 }
 
+void setHistogramType(const StatsParams& params,
+                      PrometheusStatsFormatter::OutputFormat& output_format) {
+  using HistogramType = PrometheusStatsFormatter::OutputFormat::HistogramType;
+  HistogramType hist_type;
+
+  // Validation of bucket modes is handled separately.
+  switch (params.histogram_buckets_mode_) {
+  case Utility::HistogramBucketsMode::Summary:
+    hist_type = HistogramType::Summary;
+    break;
+  case Utility::HistogramBucketsMode::Unset:
+  case Utility::HistogramBucketsMode::Cumulative:
+    hist_type = HistogramType::ClassicHistogram;
+    break;
+  case Utility::HistogramBucketsMode::PrometheusNative:
+    hist_type = HistogramType::NativeHistogram;
+    break;
+  // "Detailed" and "Disjoint" don't make sense for prometheus histogram semantics. These types were
+  // have been filtered out in validateParams().
+  case Utility::HistogramBucketsMode::Detailed:
+  case Utility::HistogramBucketsMode::Disjoint:
+    hist_type = HistogramType::ClassicHistogram;
+    IS_ENVOY_BUG("unsupported prometheus histogram bucket mode");
+    break;
+  }
+
+  output_format.setHistogramType(hist_type);
+}
+
+/**
+ * Renders counters, gauges, text readouts, histograms and then per-host metrics, in that order,
+ * stopping whenever the response reaches the requested length. The metrics of each type are only
+ * visited once rendering reaches that type, and are released once that type has been rendered.
+ */
+class ChunkedRenderer {
+public:
+  ChunkedRenderer(PrometheusStatsFormatter::MetricSources&& sources,
+                  const Upstream::ClusterManager& cluster_manager, const StatsParams& params,
+                  const Stats::CustomStatNamespaces& custom_namespaces,
+                  const PrometheusStatsFormatter::OutputFormat& output_format)
+      : sources_(std::move(sources)), cluster_manager_(cluster_manager), params_(params),
+        custom_namespaces_(custom_namespaces), output_format_(output_format) {}
+
+  /**
+   * Renders metrics until everything has been rendered or the response holds at least
+   * `max_length` bytes. A metric family is never split across calls.
+   * @return whether there is more to render.
+   */
+  bool render(Buffer::Instance& response, uint64_t max_length) {
+    while (response.length() < max_length) {
+      switch (phase_) {
+      case Phase::Counters:
+        if (renderMetrics(sources_.counters_, response, max_length)) {
+          phase_ = Phase::Gauges;
+        }
+        break;
+      case Phase::Gauges:
+        if (renderMetrics(sources_.gauges_, response, max_length)) {
+          phase_ = Phase::TextReadouts;
+        }
+        break;
+      case Phase::TextReadouts:
+        if (renderMetrics(sources_.text_readouts_, response, max_length)) {
+          phase_ = Phase::Histograms;
+        }
+        break;
+      case Phase::Histograms:
+        if (renderMetrics(sources_.histograms_, response, max_length)) {
+          phase_ = Phase::HostMetrics;
+        }
+        break;
+      case Phase::HostMetrics:
+        renderHostMetrics(response);
+        phase_ = Phase::Done;
+        return false;
+      case Phase::Done:
+        return false;
+      }
+    }
+    return true;
+  }
+
+  uint64_t metricNameCount() const { return metric_name_count_; }
+
+private:
+  enum class Phase { Counters, Gauges, TextReadouts, Histograms, HostMetrics, Done };
+
+  // Returns true once all metrics from `source` have been rendered.
+  template <class StatType>
+  bool renderMetrics(const PrometheusStatsFormatter::MetricSource<StatType>& source,
+                     Buffer::Instance& response, uint64_t max_length) {
+    if (groups_ == nullptr) {
+      if (source == nullptr) {
+        return true;
+      }
+      groups_ = std::make_unique<MetricGroupsImpl<StatType>>(
+          source, params_, output_format_, custom_namespaces_, metric_name_count_);
+    }
+    if (!groups_->render(response, max_length)) {
+      return false;
+    }
+    groups_.reset();
+    return true;
+  }
+
+  void renderHostMetrics(Buffer::Instance& response) {
+    // Note: This assumes that there is no overlap in stat name between per-endpoint stats and all
+    // other stats. If this is not true, then the counters/gauges for per-endpoint need to be
+    // combined with the above counter/gauge calls so that stats can be properly grouped.
+    std::vector<Stats::PrimitiveCounterSnapshot> host_counters;
+    std::vector<Stats::PrimitiveGaugeSnapshot> host_gauges;
+    Upstream::HostUtility::forEachHostMetric(
+        cluster_manager_,
+        [&](Stats::PrimitiveCounterSnapshot&& metric) {
+          host_counters.emplace_back(std::move(metric));
+        },
+        [&](Stats::PrimitiveGaugeSnapshot&& metric) {
+          host_gauges.emplace_back(std::move(metric));
+        });
+
+    metric_name_count_ += outputPrimitiveStatType(response, params_, host_counters,
+                                                  output_format_, custom_namespaces_);
+    metric_name_count_ += outputPrimitiveStatType(response, params_, host_gauges, output_format_,
+                                                  custom_namespaces_);
+  }
+
+  const PrometheusStatsFormatter::MetricSources sources_;
+  const Upstream::ClusterManager& cluster_manager_;
+  const StatsParams& params_;
+  const Stats::CustomStatNamespaces& custom_namespaces_;
+  const PrometheusStatsFormatter::OutputFormat& output_format_;
+  Phase phase_{Phase::Counters};
+  MetricGroupsPtr groups_;
+  uint64_t metric_name_count_{0};
+};
+
+// Returns a source which visits the metrics in `metrics`, which must outlive the source.
+template <class StatType>
+PrometheusStatsFormatter::MetricSource<StatType>
+vectorSource(const std::vector<Stats::RefcountPtr<StatType>>& metrics) {
+  return [&metrics](const Stats::StatFn<StatType>& fn) {
+    for (const Stats::RefcountPtr<StatType>& metric : metrics) {
+      fn(*metric);
+    }
+  };
+}
+
+// Implements a chunked request for Prometheus stats.
+class PrometheusStatsRequest : public Admin::Request {
+public:
+  PrometheusStatsRequest(PrometheusStatsFormatter::MetricSources&& sources,
+                         const Upstream::ClusterManager& cluster_manager, bool use_protobuf,
+                         const StatsParams& params,
+                         const Stats::CustomStatNamespaces& custom_namespaces, uint64_t chunk_size)
+      : params_(params), use_protobuf_(use_protobuf),
+        output_format_(makeOutputFormat(use_protobuf, params_)),
+        renderer_(std::move(sources), cluster_manager, params_, custom_namespaces, *output_format_),
+        chunk_size_(chunk_size) {}
+
+  Http::Code start(Http::ResponseHeaderMap& response_headers) override {
+    if (use_protobuf_) {
+      response_headers.setReferenceContentType(ProtobufContentType);
+    }
+    return Http::Code::OK;
+  }
+
+  bool nextChunk(Buffer::Instance& response) override {
+    return renderer_.render(response, response.length() + chunk_size_);
+  }
+
+private:
+  static std::unique_ptr<PrometheusStatsFormatter::OutputFormat>
+  makeOutputFormat(bool use_protobuf, const StatsParams& params) {
+    std::unique_ptr<PrometheusStatsFormatter::OutputFormat> output_format;
+    if (use_protobuf) {
+      output_format = std::make_unique<ProtobufFormat>(params.native_histogram_max_buckets_);
+    } else {
+      output_format = std::make_unique<TextFormat>();
+    }
+    setHistogramType(params, *output_format);
+    return output_format;
+  }
+
+  const StatsParams params_;
+  const bool use_protobuf_;
+  const std::unique_ptr<PrometheusStatsFormatter::OutputFormat> output_format_;
+  ChunkedRenderer renderer_;
+  const uint64_t chunk_size_;
+};
+
 } // namespace
 
 std::string PrometheusStatsFormatter::formattedTags(const std::vector<Stats::Tag>& tags) {
@@ -879,6 +1117,15 @@ PrometheusStatsFormatter::metricName(const std::string& extracted_name,
   return absl::StrCat("envoy_", sanitizeName(extracted_name));
 }
 
+Admin::RequestPtr PrometheusStatsFormatter::makeRequest(
+    MetricSources sources, const Upstream::ClusterManager& cluster_manager,
+    const Http::RequestHeaderMap& request_headers, const StatsParams& params,
+    const Stats::CustomStatNamespaces& custom_namespaces, uint64_t chunk_size) {
+  return std::make_unique<PrometheusStatsRequest>(std::move(sources), cluster_manager,
+                                                  useProtobufFormat(params, request_headers),
+                                                  params, custom_namespaces, chunk_size);
+}
+
 uint64_t PrometheusStatsFormatter::generateWithOutputFormat(
     const std::vector<Stats::CounterSharedPtr>& counters,
     const std::vector<Stats::GaugeSharedPtr>& gauges,
@@ -888,62 +1135,18 @@ uint64_t PrometheusStatsFormatter::generateWithOutputFormat(
     const StatsParams& params, const Stats::CustomStatNamespaces& custom_namespaces,
     OutputFormat& output_format) {
 
-  OutputFormat::HistogramType hist_type;
-
-  // Validation of bucket modes is handled separately.
-  switch (params.histogram_buckets_mode_) {
-  case Utility::HistogramBucketsMode::Summary:
-    hist_type = OutputFormat::HistogramType::Summary;
-    break;
-  case Utility::HistogramBucketsMode::Unset:
-  case Utility::HistogramBucketsMode::Cumulative:
-    hist_type = OutputFormat::HistogramType::ClassicHistogram;
-    break;
-  case Utility::HistogramBucketsMode::PrometheusNative:
-    hist_type = OutputFormat::HistogramType::NativeHistogram;
-    break;
-  // "Detailed" and "Disjoint" don't make sense for prometheus histogram semantics. These types were
-  // have been filtered out in validateParams().
-  case Utility::HistogramBucketsMode::Detailed:
-  case Utility::HistogramBucketsMode::Disjoint:
-    hist_type = OutputFormat::HistogramType::ClassicHistogram;
-    IS_ENVOY_BUG("unsupported prometheus histogram bucket mode");
-    break;
-  }
-
-  output_format.setHistogramType(hist_type);
-
-  uint64_t metric_name_count = 0;
-  metric_name_count +=
-      outputStatType<Stats::Counter>(response, params, counters, output_format, custom_namespaces);
-
-  metric_name_count +=
-      outputStatType<Stats::Gauge>(response, params, gauges, output_format, custom_namespaces);
-
-  metric_name_count += outputStatType<Stats::TextReadout>(response, params, text_readouts,
-                                                          output_format, custom_namespaces);
-
-  metric_name_count += outputStatType<Stats::ParentHistogram>(response, params, histograms,
-                                                              output_format, custom_namespaces);
-
-  // Note: This assumes that there is no overlap in stat name between per-endpoint stats and all
-  // other stats. If this is not true, then the counters/gauges for per-endpoint need to be combined
-  // with the above counter/gauge calls so that stats can be properly grouped.
-  std::vector<Stats::PrimitiveCounterSnapshot> host_counters;
-  std::vector<Stats::PrimitiveGaugeSnapshot> host_gauges;
-  Upstream::HostUtility::forEachHostMetric(
-      cluster_manager,
-      [&](Stats::PrimitiveCounterSnapshot&& metric) {
-        host_counters.emplace_back(std::move(metric));
-      },
-      [&](Stats::PrimitiveGaugeSnapshot&& metric) { host_gauges.emplace_back(std::move(metric)); });
-
-  metric_name_count +=
-      outputPrimitiveStatType(response, params, host_counters, output_format, custom_namespaces);
-  metric_name_count +=
-      outputPrimitiveStatType(response, params, host_gauges, output_format, custom_namespaces);
-
-  return metric_name_count;
+  setHistogramType(params, output_format);
+
+  MetricSources sources;
+  sources.counters_ = vectorSource(counters);
+  sources.gauges_ = vectorSource(gauges);
+  sources.text_readouts_ = vectorSource(text_readouts);
+  sources.histograms_ = vectorSource(histograms);
+  // The metrics are already referenced by the caller, so render them in a single page.
+  ChunkedRenderer renderer(std::move(sources), cluster_manager, params, custom_namespaces,
+                           output_format, std::numeric_limits<uint64_t>::max());
+  renderer.render(response, std::numeric_limits<uint64_t>::max());
+  return renderer.metricNameCount();
 }
 
 uint64_t PrometheusStatsFormatter::statsAsPrometheusText(
@@ -968,9 +1171,7 @@ uint64_t PrometheusStatsFormatter::statsAsPrometheusProtobuf(
     Buffer::Instance& response, const StatsParams& params,
     const Stats::CustomStatNamespaces& custom_namespaces) {
 
-  response_headers.setReferenceContentType(
-      "application/vnd.google.protobuf; "
-      "proto=io.prometheus.client.MetricFamily; encoding=delimited");
+  response_headers.setReferenceContentType(ProtobufContentType);
 
   ProtobufFormat output_format(params.native_histogram_max_buckets_);
   return generateWithOutputFormat(counters, gauges, histograms, text_readouts, cluster_manager,
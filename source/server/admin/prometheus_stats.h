@@ -1,8 +1,10 @@
 #pragma once
 
+#include <functional>
 #include <string>
 
 #include "envoy/buffer/buffer.h"
+#include "envoy/server/admin.h"
 #include "envoy/stats/custom_stat_namespaces.h"
 #include "envoy/stats/histogram.h"
 #include "envoy/stats/stats.h"
@@ -68,6 +70,42 @@ public:
     HistogramType histogram_type_;
   };
 
+  // Visits all metrics of one type, calling the supplied function for each of them.
+  template <class StatType>
+  using MetricSource = std::function<void(const Stats::StatFn<StatType>&)>;
+
+  // Supplies the metrics of each type to render. Each source is visited exactly once, when
+  // rendering reaches that type, and its metrics are referenced until that type has been
+  // rendered. A null source renders no metrics of that type.
+  struct MetricSources {
+    MetricSource<Stats::Counter> counters_;
+    MetricSource<Stats::Gauge> gauges_;
+    MetricSource<Stats::TextReadout> text_readouts_;
+    MetricSource<Stats::ParentHistogram> histograms_;
+  };
+
+  // Approximate size of each chunk produced by a request from makeRequest().
+  static constexpr uint64_t DefaultChunkSize = 2 * 1000 * 1000;
+
+  /**
+   * Creates an admin request which renders metrics in the Prometheus exposition format
+   * incrementally. Each call to nextChunk() renders whole metric families until at least
+   * `chunk_size` bytes have been added, so the response does not need to be buffered in full.
+   * The params must have been validated with validateParams(). The cluster manager and custom
+   * namespaces must outlive the request.
+   *
+   * @param sources supplies the metrics to render.
+   * @param request_headers used to select between the text and protobuf formats.
+   * @param chunk_size the approximate number of bytes to render per chunk.
+   * @return the request.
+   */
+  static Admin::RequestPtr makeRequest(MetricSources sources,
+                                       const Upstream::ClusterManager& cluster_manager,
+                                       const Http::RequestHeaderMap& request_headers,
+                                       const StatsParams& params,
+                                       const Stats::CustomStatNamespaces& custom_namespaces,
+                                       uint64_t chunk_size = DefaultChunkSize);
+
   /**
    * Extracts counters and gauges and relevant tags, appending them to
    * the response buffer after sanitizing the metric / label names.
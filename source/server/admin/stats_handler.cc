@@ -20,33 +20,6 @@ namespace Server {
 
 const uint64_t RecentLookupsCapacity = 100;
 
-namespace {
-// Implements a chunked request for Prometheus stats.
-class PrometheusRequest : public Admin::Request {
-public:
-  PrometheusRequest(StatsHandler& handler, const StatsParams& params, AdminStream& admin_stream)
-      : handler_(handler), params_(params), admin_stream_(admin_stream) {}
-
-  Http::Code start(Http::ResponseHeaderMap& response_headers) override {
-    code_ = handler_.prometheusFlushAndRender(params_, admin_stream_.getRequestHeaders(),
-                                              response_headers, response_);
-    return code_;
-  }
-
-  bool nextChunk(Buffer::Instance& response) override {
-    response.move(response_);
-    return false;
-  }
-
-private:
-  StatsHandler& handler_;
-  const StatsParams params_;
-  AdminStream& admin_stream_;
-  Buffer::OwnedImpl response_;
-  Http::Code code_{Http::Code::OK};
-};
-} // namespace
-
 StatsHandler::StatsHandler(Server::Instance& server) : HandlerContextBase(server) {}
 
 Http::Code StatsHandler::handlerResetCounters(Http::ResponseHeaderMap&, Buffer::Instance& response,
@@ -107,14 +80,16 @@ Admin::RequestPtr StatsHandler::makeRequest(AdminStream& admin_stream) {
   }
 
   if (params.format_ == StatsFormat::Prometheus) {
-    // TODO(#16139): modify streaming algorithm to cover Prometheus.
-    //
-    // This may be easiest to accomplish by populating the set
-    // with tagExtractedName(), and allowing for vectors of
-    // stats as multiples will have the same tag-extracted names.
-    // Ideally we'd find a way to do this without slowing down
-    // the non-Prometheus implementations.
-    return std::make_unique<PrometheusRequest>(*this, params, admin_stream);
+    const Http::RequestHeaderMap& request_headers = admin_stream.getRequestHeaders();
+    absl::Status params_status = PrometheusStatsFormatter::validateParams(params, request_headers);
+    if (!params_status.ok()) {
+      return Admin::makeStaticTextRequest(params_status.message(), Http::Code::BadRequest);
+    }
+    if (server_.statsConfig().flushOnAdmin()) {
+      server_.flushStats();
+    }
+    return makePrometheusRequest(server_.stats(), server_.api().customStatNamespaces(),
+                                 server_.clusterManager(), params, request_headers);
   }
 
   if (params.histogram_buckets_mode_ == Utility::HistogramBucketsMode::PrometheusNative) {
@@ -143,6 +118,31 @@ Admin::RequestPtr StatsHandler::makeRequest(Stats::Store& stats, const StatsPara
   return std::make_unique<StatsRequest>(stats, params, cluster_manager, url_handler_fn);
 }
 
+Admin::RequestPtr
+StatsHandler::makePrometheusRequest(Stats::Store& stats,
+                                    const Stats::CustomStatNamespaces& custom_namespaces,
+                                    const Upstream::ClusterManager& cluster_manager,
+                                    const StatsParams& params,
+                                    const Http::RequestHeaderMap& request_headers) {
+  PrometheusStatsFormatter::MetricSources sources;
+  sources.counters_ = [&stats](const Stats::StatFn<Stats::Counter>& fn) {
+    stats.forEachCounter(nullptr, fn);
+  };
+  sources.gauges_ = [&stats](const Stats::StatFn<Stats::Gauge>& fn) {
+    stats.forEachGauge(nullptr, fn);
+  };
+  if (params.prometheus_text_readouts_) {
+    sources.text_readouts_ = [&stats](const Stats::StatFn<Stats::TextReadout>& fn) {
+      stats.forEachTextReadout(nullptr, fn);
+    };
+  }
+  sources.histograms_ = [&stats](const Stats::StatFn<Stats::ParentHistogram>& fn) {
+    stats.forEachHistogram(nullptr, fn);
+  };
+  return PrometheusStatsFormatter::makeRequest(std::move(sources), cluster_manager,
+                                               request_headers, params, custom_namespaces);
+}
+
 Http::Code StatsHandler::handlerPrometheusStats(Http::ResponseHeaderMap& response_headers,
                                                 Buffer::Instance& response,
                                                 AdminStream& admin_stream) {
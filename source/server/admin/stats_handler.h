@@ -75,6 +75,21 @@ public:
                    const Http::RequestHeaderMap& request_headers,
                    Http::ResponseHeaderMap& response_headers, Buffer::Instance& response);
 
+  /**
+   * Creates a request which streams the stats as prometheus, a chunk at a time. The
+   * metrics of each type are only fetched from the store once the request reaches them.
+   *
+   * @params stats the stats store to read; this must outlive the request.
+   * @param custom_namespaces namespace mappings used for prometheus
+   * @params params the already-validated parameters.
+   * @param request_headers used to select the exposition format.
+   * @return the request.
+   */
+  static Admin::RequestPtr
+  makePrometheusRequest(Stats::Store& stats, const Stats::CustomStatNamespaces& custom_namespaces,
+                        const Upstream::ClusterManager& cluster_manager, const StatsParams& params,
+                        const Http::RequestHeaderMap& request_headers);
+
   Http::Code handlerContention(Http::ResponseHeaderMap& response_headers,
                                Buffer::Instance& response, AdminStream&);
 
@@ -57,6 +57,7 @@ public:
   std::chrono::milliseconds flushInterval() const override { return flush_interval_; }
   bool flushOnAdmin() const override { return flush_on_admin_; }
   uint32_t evictOnFlush() const override { return evict_on_flush_; }
+  uint32_t fullFlushOnFlush() const override { return full_flush_on_flush_; }
 
   void addSink(Stats::SinkPtr sink) { sinks_.emplace_back(std::move(sink)); }
   bool enableDeferredCreationStats() const override {
@@ -69,6 +70,7 @@ private:
   bool flush_on_admin_{false};
   const envoy::config::bootstrap::v3::Bootstrap::DeferredStatOptions deferred_stat_options_;
   uint32_t evict_on_flush_{0};
+  uint32_t full_flush_on_flush_{0};
 };
 
 /**
@@ -34,9 +34,12 @@
 #include "source/common/config/well_known_names.h"
 #include "source/common/config/xds_manager_impl.h"
 #include "source/common/config/xds_resource.h"
+#include "source/common/event/deferred_delete_pool.h"
+#include "source/common/event/timer_wheel.h"
 #include "source/common/http/codes.h"
 #include "source/common/http/headers.h"
 #include "source/common/local_info/local_info_impl.h"
+#include "source/common/memory/huge_page_allocator.h"
 #include "source/common/network/address_impl.h"
 #include "source/common/network/dns_resolver/dns_factory_util.h"
 #include "source/common/network/socket_interface.h"
@@ -49,6 +52,7 @@
 #include "source/common/stats/tag_producer_impl.h"
 #include "source/common/stats/thread_local_store.h"
 #include "source/common/stats/timespan_impl.h"
+#include "source/common/stats/utility.h"
 #include "source/common/tls/context_manager_impl.h"
 #include "source/common/upstream/cluster_manager_impl.h"
 #include "source/common/version/version.h"
@@ -58,10 +62,21 @@
 #include "source/server/regex_engine.h"
 #include "source/server/utils.h"
 
+#include "absl/numeric/bits.h"
+
 namespace Envoy {
 namespace Server {
 
 namespace {
+
+// Upper bound on the number of slots of a sharded counter, which bounds a contended counter to
+// 4 KiB of slots.
+constexpr uint32_t MaxCounterShards = 64;
+
+// Reading the huge page usage walks every mapping of the process, so it is sampled less often than
+// the stats are flushed.
+constexpr std::chrono::seconds HugePageSampleInterval{60};
+
 std::unique_ptr<ConnectionHandler> getHandler(Event::Dispatcher& dispatcher) {
 
   auto* factory = Config::Utility::getFactoryByName<ConnectionHandlerFactory>(
@@ -170,47 +185,77 @@ void InstanceBase::failHealthcheck(bool fail) {
 
 MetricSnapshotImpl::MetricSnapshotImpl(Stats::Store& store,
                                        Upstream::ClusterManager& cluster_manager,
-                                       TimeSource& time_source) {
-  store.forEachSinkedCounter(
-      [this](std::size_t size) {
-        snapped_counters_.reserve(size);
-        counters_.reserve(size);
-      },
-      [this](Stats::Counter& counter) {
-        snapped_counters_.push_back(Stats::CounterSharedPtr(&counter));
-        counters_.push_back({counter.latch(), counter});
-      });
+                                       TimeSource& time_source, StatsFlushMode mode) {
+  const bool incremental = mode == StatsFlushMode::Incremental;
+  const auto add_counter = [this](Stats::Counter& counter, uint64_t delta) {
+    snapped_counters_.push_back(Stats::CounterSharedPtr(&counter));
+    counters_.push_back({delta, counter});
+  };
+  const auto add_gauge = [this](Stats::Gauge& gauge) {
+    snapped_gauges_.push_back(Stats::GaugeSharedPtr(&gauge));
+    gauges_.push_back(gauge);
+  };
+  const auto add_text_readout = [this](Stats::TextReadout& text_readout) {
+    snapped_text_readouts_.push_back(Stats::TextReadoutSharedPtr(&text_readout));
+    text_readouts_.push_back(text_readout);
+  };
 
-  store.forEachSinkedGauge(
-      [this](std::size_t size) {
-        snapped_gauges_.reserve(size);
-        gauges_.reserve(size);
-      },
-      [this](Stats::Gauge& gauge) {
-        snapped_gauges_.push_back(Stats::GaugeSharedPtr(&gauge));
-        gauges_.push_back(gauge);
-      });
+  if (incremental) {
+    // Only the stats which changed since the previous flush are visited. Every counter with a
+    // pending increment was changed, so all non-zero deltas are still latched, which the hot
+    // restart code relies on.
+    store.forEachChangedSinkedStat(
+        [&add_counter](Stats::Counter& counter) {
+          // The delta may already have been latched, e.g. when exporting stats to a hot restart
+          // child.
+          if (const uint64_t delta = counter.latch(); delta > 0) {
+            add_counter(counter, delta);
+          }
+        },
+        add_gauge, add_text_readout);
+  } else {
+    if (mode == StatsFlushMode::FullWithChangeTracking) {
+      // Forget the changes made so far, so that the next incremental flush only includes the
+      // stats which change after this full flush.
+      store.trackChanges();
+      store.forEachChangedSinkedStat([](Stats::Counter&) {}, [](Stats::Gauge&) {},
+                                     [](Stats::TextReadout&) {});
+    }
+    store.forEachSinkedCounter(
+        [this](std::size_t size) {
+          snapped_counters_.reserve(size);
+          counters_.reserve(size);
+        },
+        [&add_counter](Stats::Counter& counter) { add_counter(counter, counter.latch()); });
+    store.forEachSinkedGauge(
+        [this](std::size_t size) {
+          snapped_gauges_.reserve(size);
+          gauges_.reserve(size);
+        },
+        add_gauge);
+    store.forEachSinkedTextReadout(
+        [this](std::size_t size) {
+          snapped_text_readouts_.reserve(size);
+          text_readouts_.reserve(size);
+        },
+        add_text_readout);
+  }
 
   store.forEachSinkedHistogram(
-      [this](std::size_t size) {
-        snapped_histograms_.reserve(size);
-        histograms_.reserve(size);
+      [this, incremental](std::size_t size) {
+        if (!incremental) {
+          snapped_histograms_.reserve(size);
+          histograms_.reserve(size);
+        }
       },
-      [this](Stats::ParentHistogram& histogram) {
+      [this, incremental](Stats::ParentHistogram& histogram) {
+        if (incremental && histogram.intervalStatistics().sampleCount() == 0) {
+          return;
+        }
         snapped_histograms_.push_back(Stats::ParentHistogramSharedPtr(&histogram));
         histograms_.push_back(histogram);
       });
 
-  store.forEachSinkedTextReadout(
-      [this](std::size_t size) {
-        snapped_text_readouts_.reserve(size);
-        text_readouts_.reserve(size);
-      },
-      [this](Stats::TextReadout& text_readout) {
-        snapped_text_readouts_.push_back(Stats::TextReadoutSharedPtr(&text_readout));
-        text_readouts_.push_back(text_readout);
-      });
-
   Upstream::HostUtility::forEachHostMetric(
       cluster_manager,
       [this](Stats::PrimitiveCounterSnapshot&& metric) {
@@ -224,12 +269,13 @@ MetricSnapshotImpl::MetricSnapshotImpl(Stats::Store& store,
 }
 
 void InstanceUtil::flushMetricsToSinks(const std::list<Stats::SinkPtr>& sinks, Stats::Store& store,
-                                       Upstream::ClusterManager& cm, TimeSource& time_source) {
+                                       Upstream::ClusterManager& cm, TimeSource& time_source,
+                                       StatsFlushMode mode) {
   // Create a snapshot and flush to all sinks.
   // NOTE: Even if there are no sinks, creating the snapshot has the important property that it
   //       latches all counters on a periodic basis. The hot restart code assumes this is being
   //       done so this should not be removed.
-  MetricSnapshotImpl snapshot(store, cm, time_source);
+  MetricSnapshotImpl snapshot(store, cm, time_source, mode);
   for (const auto& sink : sinks) {
     sink->flush(snapshot);
   }
@@ -267,6 +313,52 @@ void InstanceBase::updateServerStats() {
                                        parent_stats.parent_memory_allocated_);
   server_stats_->memory_heap_size_.set(Memory::Stats::totalCurrentlyReserved());
   server_stats_->memory_physical_size_.set(Memory::Stats::totalPhysicalBytes());
+  if (Memory::HugePageRegions::enabled()) {
+    const MonotonicTime now = time_source_.monotonicTime();
+    if (!last_huge_page_sample_time_.has_value() ||
+        now - *last_huge_page_sample_time_ >= HugePageSampleInterval) {
+      server_stats_->memory_huge_page_size_.set(Memory::Stats::totalHugePageBytes());
+      last_huge_page_sample_time_ = now;
+    }
+    server_stats_->memory_huge_page_region_size_.set(Memory::Stats::totalHugePageRegionBytes());
+  }
+  if (Buffer::SliceStoragePool::enabled()) {
+    const Buffer::SliceStoragePool::Stats slice_pool_stats = Buffer::SliceStoragePool::stats();
+    // The pool keeps running totals; only the growth since the previous flush is added.
+    server_stats_->buffer_slice_pool_hits_.add(slice_pool_stats.hits_ -
+                                               last_slice_pool_stats_.hits_);
+    server_stats_->buffer_slice_pool_misses_.add(slice_pool_stats.misses_ -
+                                                 last_slice_pool_stats_.misses_);
+    server_stats_->buffer_slice_pool_retained_bytes_.set(slice_pool_stats.retained_bytes_);
+    last_slice_pool_stats_ = slice_pool_stats;
+  }
+  if (Event::DeferredDeletePool::enabled()) {
+    const std::vector<Event::DeferredDeletePool::TypeStats> pool_stats =
+        Event::DeferredDeletePool::stats();
+    // Types register when they are first allocated, so create the stats of the types which
+    // registered since the previous update.
+    Stats::Scope& scope = *stats_store_.rootScope();
+    for (size_t i = deferred_delete_pool_stats_.size(); i < pool_stats.size(); ++i) {
+      const auto elements = [&](absl::string_view stat) -> Stats::ElementVec {
+        return {Stats::DynamicName("server.deferred_delete_pool"),
+                Stats::DynamicName(pool_stats[i].name_), Stats::DynamicName(stat)};
+      };
+      deferred_delete_pool_stats_.push_back(
+          {Stats::Utility::counterFromElements(scope, elements("reused")),
+           Stats::Utility::counterFromElements(scope, elements("allocated")),
+           Stats::Utility::gaugeFromElements(scope, elements("retained"),
+                                             Stats::Gauge::ImportMode::NeverImport)});
+    }
+    // The pools keep running totals; only the growth since the previous update is added.
+    for (size_t i = 0; i < pool_stats.size(); ++i) {
+      DeferredDeletePoolStats& stats = deferred_delete_pool_stats_[i];
+      stats.reused_.add(pool_stats[i].reused_ - stats.last_reused_);
+      stats.allocated_.add(pool_stats[i].allocated_ - stats.last_allocated_);
+      stats.retained_.set(pool_stats[i].retained_);
+      stats.last_reused_ = pool_stats[i].reused_;
+      stats.last_allocated_ = pool_stats[i].allocated_;
+    }
+  }
   if (!options().hotRestartDisabled()) {
     server_stats_->parent_connections_.set(parent_stats.parent_connections_);
   }
@@ -285,13 +377,27 @@ void InstanceBase::updateServerStats() {
       enumToInt(Utility::serverState(initManager().state(), healthCheckFailed())));
   server_stats_->stats_recent_lookups_.set(
       stats_store_.symbolTable().getRecentLookups([](absl::string_view, uint64_t) {}));
+  const Stats::SymbolTable::LockStats symbol_table_lock_stats =
+      stats_store_.symbolTable().lockStats();
+  server_stats_->stats_symbol_table_lock_contentions_.add(
+      symbol_table_lock_stats.contentions_ - last_symbol_table_lock_stats_.contentions_);
+  server_stats_->stats_symbol_table_shared_encodes_.add(
+      symbol_table_lock_stats.shared_encodes_ - last_symbol_table_lock_stats_.shared_encodes_);
+  last_symbol_table_lock_stats_ = symbol_table_lock_stats;
 }
 
 void InstanceBase::flushStatsInternal() {
   updateServerStats();
   auto& stats_config = config_.statsConfig();
+  StatsFlushMode flush_mode = StatsFlushMode::Full;
+  if (const auto full_flush_on_flush = stats_config.fullFlushOnFlush(); full_flush_on_flush > 0) {
+    // The first flush is always a full one.
+    flush_mode = stats_full_flush_counter_ == 0 ? StatsFlushMode::FullWithChangeTracking
+                                                : StatsFlushMode::Incremental;
+    stats_full_flush_counter_ = (stats_full_flush_counter_ + 1) % full_flush_on_flush;
+  }
   InstanceUtil::flushMetricsToSinks(stats_config.sinks(), stats_store_, clusterManager(),
-                                    timeSource());
+                                    timeSource(), flush_mode);
   if (const auto evict_on_flush = stats_config.evictOnFlush(); evict_on_flush > 0) {
     stats_eviction_counter_ = (stats_eviction_counter_ + 1) % evict_on_flush;
     if (stats_eviction_counter_ == 0) {
@@ -721,6 +827,11 @@ absl::Status InstanceBase::initializeOrThrow(Network::Address::InstanceConstShar
         Config::ServerExtensionValues::get().DEFAULT_LISTENER);
   }
 
+  // The workers are created with the listener manager, so their scheduler and pinning have to be
+  // chosen first.
+  Event::TimerWheelScheduler::configure(bootstrap_.enable_worker_timer_wheel());
+  worker_factory_.setPinWorkerThreads(bootstrap_.pin_worker_threads());
+
   // Workers get created first so they register for thread local updates.
   listener_manager_ = listener_manager_factory->createListenerManager(
       *this, nullptr, worker_factory_, bootstrap_.enable_dispatcher_stats(), quic_stat_names_);
@@ -760,6 +871,21 @@ absl::Status InstanceBase::initializeOrThrow(Network::Address::InstanceConstShar
   InstanceUtil::raiseFileLimits();
 #endif
 
+  if (Runtime::runtimeFeatureEnabled("envoy.restart_features.buffer_slice_storage_pool")) {
+    Buffer::SliceStoragePool::configure(Buffer::SliceStoragePool::DefaultMaxSlicesPerSizeClass);
+  }
+
+  if (Runtime::runtimeFeatureEnabled("envoy.restart_features.sharded_counters")) {
+    // One slot per worker plus the main thread, so that they never share a cache line. Counters
+    // created before this point, such as the server stats, are not sharded.
+    stats_store_.setCounterShards(
+        std::min<uint32_t>(absl::bit_ceil(options_.concurrency() + 1), MaxCounterShards));
+  }
+
+  if (Runtime::runtimeFeatureEnabled("envoy.restart_features.deferred_delete_pool")) {
+    Event::DeferredDeletePool::configure(Event::DeferredDeletePool::DefaultMaxObjectsPerType);
+  }
+
   if (!runtime().snapshot().getBoolean("envoy.disallow_global_stats", false)) {
     assert_action_registration_ = Assert::addDebugAssertionFailureRecordAction(
         [this](const char*) { server_stats_->debug_assertion_failures_.inc(); });
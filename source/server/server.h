@@ -25,6 +25,7 @@
 #include "envoy/tracing/tracer.h"
 
 #include "source/common/access_log/access_log_manager_impl.h"
+#include "source/common/buffer/slice_storage_pool.h"
 #include "source/common/common/assert.h"
 #include "source/common/common/cleanup.h"
 #include "source/common/common/logger_delegates.h"
@@ -40,6 +41,7 @@
 #include "source/common/runtime/runtime_impl.h"
 #include "source/common/secret/secret_manager_impl.h"
 #include "source/common/singleton/manager_impl.h"
+#include "source/common/stats/symbol_table.h"
 
 #ifdef ENVOY_ADMIN_FUNCTIONALITY
 #include "source/server/admin/admin.h"
@@ -77,6 +79,11 @@ struct ServerCompilationSettingsStats {
   COUNTER(static_unknown_fields)                                                                   \
   COUNTER(wip_protos)                                                                              \
   COUNTER(dropped_stat_flushes)                                                                    \
+  COUNTER(buffer_slice_pool_hits)                                                                  \
+  COUNTER(buffer_slice_pool_misses)                                                                \
+  COUNTER(stats_symbol_table_lock_contentions)                                                     \
+  COUNTER(stats_symbol_table_shared_encodes)                                                       \
+  GAUGE(buffer_slice_pool_retained_bytes, NeverImport)                                             \
   GAUGE(concurrency, NeverImport)                                                                  \
   GAUGE(days_until_first_cert_expiring, NeverImport)                                               \
   GAUGE(seconds_until_first_ocsp_response_expiring, NeverImport)                                   \
@@ -85,6 +92,8 @@ struct ServerCompilationSettingsStats {
   GAUGE(live, NeverImport)                                                                         \
   GAUGE(memory_allocated, Accumulate)                                                              \
   GAUGE(memory_heap_size, Accumulate)                                                              \
+  GAUGE(memory_huge_page_region_size, NeverImport)                                                 \
+  GAUGE(memory_huge_page_size, NeverImport)                                                        \
   GAUGE(memory_physical_size, Accumulate)                                                          \
   GAUGE(parent_connections, Accumulate)                                                            \
   GAUGE(state, NeverImport)                                                                        \
@@ -116,6 +125,20 @@ public:
   virtual Runtime::LoaderPtr createRuntime(Instance& server, Configuration::Initial& config) PURE;
 };
 
+/**
+ * Selects which stats are included in a flush to sinks.
+ */
+enum class StatsFlushMode {
+  // All stats are flushed, and changes are not tracked.
+  Full,
+  // All stats are flushed, and the store starts or keeps tracking changes, so that the next
+  // incremental flush only includes the stats which change after this flush.
+  FullWithChangeTracking,
+  // Only the counters which were incremented, the gauges and text readouts which were set, and the
+  // histograms which recorded values since the previous flush are flushed.
+  Incremental,
+};
+
 /**
  * Helpers used during server creation.
  */
@@ -132,9 +155,11 @@ public:
    * flush() on each sink.
    * @param sinks supplies the list of sinks.
    * @param store provides the store being flushed.
+   * @param mode selects which stats are included in the flush.
    */
   static void flushMetricsToSinks(const std::list<Stats::SinkPtr>& sinks, Stats::Store& store,
-                                  Upstream::ClusterManager& cm, TimeSource& time_source);
+                                  Upstream::ClusterManager& cm, TimeSource& time_source,
+                                  StatsFlushMode mode = StatsFlushMode::Full);
 
   /**
    * Load a bootstrap config and perform validation.
@@ -442,6 +467,22 @@ private:
   bool enable_reuse_port_default_{false};
   Regex::EnginePtr regex_engine_;
   bool stats_flush_in_progress_ : 1;
+  // Slice storage pool totals already added to the server counters.
+  Buffer::SliceStoragePool::Stats last_slice_pool_stats_{};
+  // Symbol table lock totals already added to the server counters.
+  Stats::SymbolTable::LockStats last_symbol_table_lock_stats_{};
+  // When memory_huge_page_size was last sampled.
+  absl::optional<MonotonicTime> last_huge_page_sample_time_;
+  // Stats of each deferred delete pool type, indexed by type, with the totals already added to the
+  // counters.
+  struct DeferredDeletePoolStats {
+    Stats::Counter& reused_;
+    Stats::Counter& allocated_;
+    Stats::Gauge& retained_;
+    uint64_t last_reused_{};
+    uint64_t last_allocated_{};
+  };
+  std::vector<DeferredDeletePoolStats> deferred_delete_pool_stats_;
   std::unique_ptr<Memory::AllocatorManager> memory_allocator_manager_;
 
   template <class T>
@@ -452,6 +493,7 @@ private:
   };
 
   uint32_t stats_eviction_counter_{0};
+  uint32_t stats_full_flush_counter_{0};
 
 #ifdef ENVOY_PERFETTO
   std::unique_ptr<perfetto::TracingSession> tracing_session_{};
@@ -471,7 +513,8 @@ public:
   // MetricSnapshotImpl captures a snapshot of metrics by latching the delta usage, and optionally
   // marking the stats as used.
   explicit MetricSnapshotImpl(Stats::Store& store, Upstream::ClusterManager& cluster_manager,
-                              TimeSource& time_source);
+                              TimeSource& time_source,
+                              StatsFlushMode mode = StatsFlushMode::Full);
 
   // Stats::MetricSnapshot
   const std::vector<CounterSnapshot>& counters() override { return counters_; }
@@ -9,9 +9,16 @@
 #include "envoy/server/configuration.h"
 #include "envoy/thread_local/thread_local.h"
 
+#include "source/common/common/utility.h"
 #include "source/common/config/utility.h"
 #include "source/server/listener_manager_factory.h"
 
+#if defined(__linux__)
+#include <sched.h>
+
+#include "source/common/api/os_sys_calls_impl_linux.h"
+#endif
+
 namespace Envoy {
 namespace Server {
 namespace {
@@ -39,16 +46,18 @@ WorkerPtr ProdWorkerFactory::createWorker(uint32_t index, OverloadManager& overl
       api_.allocateDispatcher(worker_name, overload_manager.scaledTimerFactory()));
   auto conn_handler = getHandler(*dispatcher, index, overload_manager, null_overload_manager);
   return std::make_unique<WorkerImpl>(tls_, hooks_, std::move(dispatcher), std::move(conn_handler),
-                                      overload_manager, api_, stat_names_);
+                                      overload_manager, api_, stat_names_, index,
+                                      pin_worker_threads_);
 }
 
 WorkerImpl::WorkerImpl(ThreadLocal::Instance& tls, ListenerHooks& hooks,
                        Event::DispatcherPtr&& dispatcher, Network::ConnectionHandlerPtr handler,
                        OverloadManager& overload_manager, Api::Api& api,
-                       WorkerStatNames& stat_names)
+                       WorkerStatNames& stat_names, uint32_t index, bool pin_thread)
     : tls_(tls), hooks_(hooks), dispatcher_(std::move(dispatcher)), handler_(std::move(handler)),
       api_(api), reset_streams_counter_(
-                     api_.rootScope().counterFromStatName(stat_names.reset_high_memory_stream_)) {
+                     api_.rootScope().counterFromStatName(stat_names.reset_high_memory_stream_)),
+      index_(index), pin_thread_(pin_thread) {
   tls_.registerThread(*dispatcher_, false);
   overload_manager.registerForAction(
       OverloadActionNames::get().StopAcceptingConnections, *dispatcher_,
@@ -121,6 +130,10 @@ void WorkerImpl::start(OptRef<GuardDog> guard_dog, const std::function<void()>&
 
 void WorkerImpl::initializeStats(Stats::Scope& scope) { dispatcher_->initializeStats(scope); }
 
+void WorkerImpl::enableBusyPoll(const Event::BusyPollConfig& config, Stats::Scope& scope) {
+  dispatcher_->enableBusyPoll(config, scope);
+}
+
 void WorkerImpl::stop() {
   // It's possible for the server to cleanly shut down while cluster initialization during startup
   // is happening, so we might not yet have a thread.
@@ -143,6 +156,7 @@ void WorkerImpl::stopListener(Network::ListenerConfig& listener,
 }
 
 void WorkerImpl::threadRoutine(OptRef<GuardDog> guard_dog, const std::function<void()>& cb) {
+  pinThread();
   ENVOY_LOG(debug, "worker entering dispatch loop");
   // The watch dog must be created after the dispatcher starts running and has post events flushed,
   // as this is when TLS stat scopes start working.
@@ -168,6 +182,42 @@ void WorkerImpl::threadRoutine(OptRef<GuardDog> guard_dog, const std::function<v
   watch_dog_.reset();
 }
 
+void WorkerImpl::pinThread() {
+  if (!pin_thread_) {
+    return;
+  }
+#if defined(__linux__)
+  // Workers are spread over the CPUs the thread inherited from the main thread, so that pinning
+  // honours any cpuset or taskset the process was started in. This runs before the dispatcher, so
+  // listeners added to the worker register with their connection balancer from the pinned thread.
+  auto& linux_os_syscalls = Api::LinuxOsSysCallsSingleton::get();
+  cpu_set_t mask;
+  CPU_ZERO(&mask);
+  Api::SysCallIntResult result = linux_os_syscalls.sched_getaffinity(0, sizeof(cpu_set_t), &mask);
+  if (result.return_value_ == -1 || CPU_COUNT(&mask) == 0) {
+    ENVOY_LOG(warn, "unable to read the CPU affinity of worker {}: {}", dispatcher_->name(),
+              errorDetails(result.errno_));
+    return;
+  }
+  uint32_t skip = index_ % CPU_COUNT(&mask);
+  uint32_t cpu = 0;
+  while (!CPU_ISSET(cpu, &mask) || skip-- > 0) {
+    ++cpu;
+  }
+  CPU_ZERO(&mask);
+  CPU_SET(cpu, &mask);
+  result = linux_os_syscalls.sched_setaffinity(0, sizeof(cpu_set_t), &mask);
+  if (result.return_value_ == -1) {
+    ENVOY_LOG(warn, "unable to pin worker {} to CPU {}: {}", dispatcher_->name(), cpu,
+              errorDetails(result.errno_));
+    return;
+  }
+  ENVOY_LOG(debug, "worker {} pinned to CPU {}", dispatcher_->name(), cpu);
+#else
+  ENVOY_LOG(warn, "pinning worker threads is only supported on Linux");
+#endif
+}
+
 void WorkerImpl::stopAcceptingConnectionsCb(OverloadActionState state) {
   if (state.isSaturated()) {
     handler_->disableListeners();
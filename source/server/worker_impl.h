@@ -31,6 +31,12 @@ public:
   ProdWorkerFactory(ThreadLocal::Instance& tls, Api::Api& api, ListenerHooks& hooks)
       : tls_(tls), api_(api), stat_names_(api.rootScope().symbolTable()), hooks_(hooks) {}
 
+  /**
+   * Set whether the workers created from now on pin their threads to CPUs. This is set from the
+   * bootstrap, which is loaded after the factory is constructed.
+   */
+  void setPinWorkerThreads(bool pin_worker_threads) { pin_worker_threads_ = pin_worker_threads; }
+
   // Server::WorkerFactory
   WorkerPtr createWorker(uint32_t index, OverloadManager& overload_manager,
                          OverloadManager& null_overload_manager,
@@ -41,6 +47,7 @@ private:
   Api::Api& api_;
   WorkerStatNames stat_names_;
   ListenerHooks& hooks_;
+  bool pin_worker_threads_{};
 };
 
 /**
@@ -50,7 +57,7 @@ class WorkerImpl : public Worker, Logger::Loggable<Logger::Id::main> {
 public:
   WorkerImpl(ThreadLocal::Instance& tls, ListenerHooks& hooks, Event::DispatcherPtr&& dispatcher,
              Network::ConnectionHandlerPtr handler, OverloadManager& overload_manager,
-             Api::Api& api, WorkerStatNames& stat_names);
+             Api::Api& api, WorkerStatNames& stat_names, uint32_t index, bool pin_thread);
 
   // Server::Worker
   void addListener(absl::optional<uint64_t> overridden_listener, Network::ListenerConfig& listener,
@@ -64,6 +71,7 @@ public:
                           std::function<void()> completion) override;
   void start(OptRef<GuardDog> guard_dog, const std::function<void()>& cb) override;
   void initializeStats(Stats::Scope& scope) override;
+  void enableBusyPoll(const Event::BusyPollConfig& config, Stats::Scope& scope) override;
   void stop() override;
   void stopListener(Network::ListenerConfig& listener,
                     const Network::ExtraShutdownListenerOptions& options,
@@ -71,6 +79,7 @@ public:
 
 private:
   void threadRoutine(OptRef<GuardDog> guard_dog, const std::function<void()>& cb);
+  void pinThread();
   void stopAcceptingConnectionsCb(OverloadActionState state);
   void rejectIncomingConnectionsCb(OverloadActionState state);
   void resetStreamsUsingExcessiveMemory(OverloadActionState state);
@@ -81,6 +90,8 @@ private:
   Network::ConnectionHandlerPtr handler_;
   Api::Api& api_;
   Stats::Counter& reset_streams_counter_;
+  const uint32_t index_;
+  const bool pin_thread_;
   Thread::ThreadPtr thread_;
   WatchDogSharedPtr watch_dog_;
 };
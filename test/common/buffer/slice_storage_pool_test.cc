@@ -0,0 +1,129 @@
+#include <thread>
+
+#include "source/common/buffer/buffer_impl.h"
+#include "source/common/buffer/slice_storage_pool.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Buffer {
+namespace {
+
+class SliceStoragePoolTest : public testing::Test {
+protected:
+  SliceStoragePoolTest() { SliceStoragePool::configure(4); }
+  ~SliceStoragePoolTest() override { SliceStoragePool::configure(0); }
+};
+
+TEST(SliceStoragePoolSizeClassTest, SizeClasses) {
+  EXPECT_EQ(-1, SliceStoragePool::sizeClass(0));
+  EXPECT_EQ(-1, SliceStoragePool::sizeClass(100));
+  EXPECT_EQ(0, SliceStoragePool::sizeClass(4096));
+  EXPECT_EQ(1, SliceStoragePool::sizeClass(8192));
+  EXPECT_EQ(-1, SliceStoragePool::sizeClass(3 * 4096));
+  EXPECT_EQ(2, SliceStoragePool::sizeClass(16384));
+  EXPECT_EQ(4, SliceStoragePool::sizeClass(65536));
+  EXPECT_EQ(-1, SliceStoragePool::sizeClass(131072));
+}
+
+TEST(SliceStoragePoolDisabledTest, Passthrough) {
+  EXPECT_FALSE(SliceStoragePool::enabled());
+  const SliceStoragePool::Stats before = SliceStoragePool::stats();
+  SliceStoragePool::StoragePtr storage = SliceStoragePool::allocate(16384);
+  EXPECT_NE(nullptr, storage);
+  SliceStoragePool::release(std::move(storage), 16384);
+  EXPECT_EQ(nullptr, storage);
+  const SliceStoragePool::Stats after = SliceStoragePool::stats();
+  EXPECT_EQ(before.hits_, after.hits_);
+  EXPECT_EQ(before.misses_, after.misses_);
+  EXPECT_EQ(0, after.retained_bytes_);
+}
+
+TEST_F(SliceStoragePoolTest, RecyclesStorage) {
+  const SliceStoragePool::Stats before = SliceStoragePool::stats();
+
+  SliceStoragePool::StoragePtr storage = SliceStoragePool::allocate(16384);
+  uint8_t* address = storage.get();
+  SliceStoragePool::release(std::move(storage), 16384);
+  EXPECT_EQ(16384, SliceStoragePool::stats().retained_bytes_);
+
+  // A different size class does not reuse the cached storage.
+  SliceStoragePool::StoragePtr other = SliceStoragePool::allocate(4096);
+  EXPECT_NE(address, other.get());
+
+  SliceStoragePool::StoragePtr reused = SliceStoragePool::allocate(16384);
+  EXPECT_EQ(address, reused.get());
+
+  const SliceStoragePool::Stats after = SliceStoragePool::stats();
+  EXPECT_EQ(before.hits_ + 1, after.hits_);
+  EXPECT_EQ(before.misses_ + 2, after.misses_);
+  EXPECT_EQ(0, after.retained_bytes_);
+}
+
+TEST_F(SliceStoragePoolTest, FreeListIsBounded) {
+  std::vector<SliceStoragePool::StoragePtr> storages;
+  for (int i = 0; i < 6; i++) {
+    storages.push_back(SliceStoragePool::allocate(8192));
+  }
+  for (auto& storage : storages) {
+    SliceStoragePool::release(std::move(storage), 8192);
+  }
+  EXPECT_EQ(4 * 8192, SliceStoragePool::stats().retained_bytes_);
+
+  SliceStoragePool::clearThreadCache();
+  EXPECT_EQ(0, SliceStoragePool::stats().retained_bytes_);
+}
+
+TEST_F(SliceStoragePoolTest, UnpoolableSizesAreFreed) {
+  SliceStoragePool::release(SliceStoragePool::allocate(3 * 4096), 3 * 4096);
+  SliceStoragePool::release(SliceStoragePool::allocate(32 * 4096), 32 * 4096);
+  EXPECT_EQ(0, SliceStoragePool::stats().retained_bytes_);
+}
+
+TEST_F(SliceStoragePoolTest, PerThreadCaches) {
+  const SliceStoragePool::Stats before = SliceStoragePool::stats();
+  std::thread thread([]() {
+    SliceStoragePool::release(SliceStoragePool::allocate(16384), 16384);
+    EXPECT_EQ(16384, SliceStoragePool::stats().retained_bytes_);
+    SliceStoragePool::release(SliceStoragePool::allocate(16384), 16384);
+  });
+  thread.join();
+
+  // The exited thread's storage was freed, but its hits and misses are still accounted for.
+  const SliceStoragePool::Stats after = SliceStoragePool::stats();
+  EXPECT_EQ(before.hits_ + 1, after.hits_);
+  EXPECT_EQ(before.misses_ + 1, after.misses_);
+  EXPECT_EQ(0, after.retained_bytes_);
+}
+
+TEST_F(SliceStoragePoolTest, OwnedImplUsesPool) {
+  {
+    OwnedImpl buffer;
+    buffer.appendSliceForTest(std::string(10000, 'a'));
+    buffer.appendSliceForTest(std::string(100, 'b'));
+  }
+  // Slices of 12 KiB are not pooled; the 4 KiB slice is.
+  EXPECT_EQ(4096, SliceStoragePool::stats().retained_bytes_);
+
+  const SliceStoragePool::Stats before = SliceStoragePool::stats();
+  {
+    OwnedImpl buffer;
+    buffer.add(std::string(100, 'c'));
+    EXPECT_EQ(0, SliceStoragePool::stats().retained_bytes_);
+  }
+  EXPECT_EQ(before.hits_ + 1, SliceStoragePool::stats().hits_);
+}
+
+TEST_F(SliceStoragePoolTest, ReadReservationUsesPool) {
+  {
+    OwnedImpl buffer;
+    auto reservation = buffer.reserveForRead();
+    EXPECT_GT(reservation.numSlices(), 0);
+    reservation.commit(100);
+  }
+  EXPECT_EQ(Slice::default_slice_size_, SliceStoragePool::stats().retained_bytes_);
+}
+
+} // namespace
+} // namespace Buffer
+} // namespace Envoy
@@ -0,0 +1,77 @@
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "source/common/common/arena.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace {
+
+class Counted {
+public:
+  Counted(int& live, std::string value) : live_(live), value_(std::move(value)) { ++live_; }
+  ~Counted() { --live_; }
+
+  const std::string& value() const { return value_; }
+
+private:
+  int& live_;
+  const std::string value_;
+};
+
+TEST(ArenaTest, Allocate) {
+  Arena arena(256);
+  EXPECT_EQ(0, arena.blocks());
+
+  char* first = static_cast<char*>(arena.allocate(1, 1));
+  void* second = arena.allocate(8, 8);
+  EXPECT_EQ(0, reinterpret_cast<uintptr_t>(second) % 8);
+  EXPECT_EQ(first + 8, second);
+  EXPECT_EQ(1, arena.blocks());
+
+  // Large allocations which do not fit in the current block get a block of their own.
+  arena.allocate(250, 8);
+  EXPECT_EQ(2, arena.blocks());
+  EXPECT_EQ(static_cast<char*>(second) + 8, arena.allocate(8, 8));
+
+  // The next block is taken when the current one is full.
+  for (int i = 0; i < 29; ++i) {
+    arena.allocate(8, 8);
+  }
+  EXPECT_EQ(2, arena.blocks());
+  arena.allocate(8, 8);
+  EXPECT_EQ(3, arena.blocks());
+  EXPECT_EQ(34, arena.allocations());
+}
+
+TEST(ArenaTest, ArenaPtr) {
+  Arena arena;
+  int live = 0;
+  {
+    ArenaPtr<Counted> in_arena = makeArenaPtr<Counted>(&arena, live, "a value beyond the SSO size");
+    ArenaPtr<Counted> on_heap = makeArenaPtr<Counted>(nullptr, live, "b");
+    EXPECT_EQ(2, live);
+    EXPECT_EQ("a value beyond the SSO size", in_arena->value());
+    EXPECT_EQ("b", on_heap->value());
+    EXPECT_EQ(1, arena.allocations());
+  }
+  EXPECT_EQ(0, live);
+}
+
+TEST(ArenaTest, ArenaAllocator) {
+  Arena arena;
+  std::vector<uint64_t, ArenaAllocator<uint64_t>> in_arena{ArenaAllocator<uint64_t>(&arena)};
+  std::vector<uint64_t, ArenaAllocator<uint64_t>> on_heap;
+  for (uint64_t i = 0; i < 100; ++i) {
+    in_arena.push_back(i);
+    on_heap.push_back(i);
+  }
+  EXPECT_EQ(in_arena, on_heap);
+  EXPECT_LT(0, arena.allocations());
+  EXPECT_EQ(1, arena.blocks());
+}
+
+} // namespace
+} // namespace Envoy
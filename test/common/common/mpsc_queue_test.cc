@@ -0,0 +1,78 @@
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "source/common/common/mpsc_queue.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace {
+
+TEST(MpscQueueTest, Fifo) {
+  MpscQueue<int> queue;
+  EXPECT_FALSE(queue.pop().has_value());
+  EXPECT_EQ(0, queue.push(1));
+  EXPECT_EQ(1, queue.push(2));
+  EXPECT_EQ(2, queue.size());
+  EXPECT_EQ(1, queue.pop());
+  EXPECT_EQ(1, queue.size());
+  EXPECT_EQ(1, queue.push(3));
+  EXPECT_EQ(2, queue.pop());
+  EXPECT_EQ(3, queue.pop());
+  EXPECT_FALSE(queue.pop().has_value());
+  EXPECT_EQ(0, queue.size());
+
+  // The queue is reusable once drained.
+  EXPECT_EQ(0, queue.push(4));
+  EXPECT_EQ(4, queue.pop());
+  EXPECT_FALSE(queue.pop().has_value());
+}
+
+TEST(MpscQueueTest, MoveOnlyValuesDestroyedWithQueue) {
+  auto value = std::make_shared<int>(1);
+  {
+    MpscQueue<std::unique_ptr<std::shared_ptr<int>>> queue;
+    queue.push(std::make_unique<std::shared_ptr<int>>(value));
+    queue.push(std::make_unique<std::shared_ptr<int>>(value));
+    EXPECT_EQ(3, value.use_count());
+    EXPECT_EQ(value, **queue.pop());
+    EXPECT_EQ(2, value.use_count());
+  }
+  EXPECT_EQ(1, value.use_count());
+}
+
+// Each producer's values are popped in the order it pushed them, and none are lost.
+TEST(MpscQueueTest, ConcurrentProducers) {
+  constexpr uint32_t num_producers = 4;
+  constexpr uint32_t values_per_producer = 100000;
+  MpscQueue<std::pair<uint32_t, uint32_t>> queue;
+  std::vector<std::thread> producers;
+  for (uint32_t producer = 0; producer < num_producers; ++producer) {
+    producers.emplace_back([&queue, producer]() {
+      for (uint32_t i = 0; i < values_per_producer; ++i) {
+        queue.push({producer, i});
+      }
+    });
+  }
+
+  std::vector<uint32_t> next_expected(num_producers);
+  uint32_t num_popped = 0;
+  while (num_popped < num_producers * values_per_producer) {
+    absl::optional<std::pair<uint32_t, uint32_t>> value = queue.pop();
+    if (!value.has_value()) {
+      std::this_thread::yield();
+      continue;
+    }
+    ASSERT_EQ(next_expected[value->first]++, value->second);
+    ++num_popped;
+  }
+  for (std::thread& producer : producers) {
+    producer.join();
+  }
+  EXPECT_FALSE(queue.pop().has_value());
+  EXPECT_EQ(0, queue.size());
+}
+
+} // namespace
+} // namespace Envoy
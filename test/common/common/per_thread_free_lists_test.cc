@@ -0,0 +1,77 @@
+#include <memory>
+
+#include "source/common/common/per_thread_free_lists.h"
+
+#include "test/test_common/thread_factory_for_test.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace {
+
+using StoragePtr = std::unique_ptr<uint64_t>;
+
+// Each test uses its own lists, as the stats of the lists are process wide.
+template <int N> struct Tag {};
+template <int N> using FreeLists = PerThreadFreeLists<Tag<N>, StoragePtr, 2>;
+
+TEST(PerThreadFreeListsTest, PopReturnsPushedStorage) {
+  using Lists = FreeLists<0>;
+  EXPECT_EQ(nullptr, Lists::pop(0, 8));
+
+  auto storage = std::make_unique<uint64_t>(1);
+  uint64_t* raw = storage.get();
+  Lists::push(0, std::move(storage), 8, 4);
+  EXPECT_EQ(nullptr, Lists::pop(1, 8));
+  EXPECT_EQ(8, Lists::stats()[0].retained_);
+
+  StoragePtr popped = Lists::pop(0, 8);
+  EXPECT_EQ(raw, popped.get());
+
+  const auto stats = Lists::stats();
+  EXPECT_EQ(1, stats[0].reused_);
+  EXPECT_EQ(1, stats[0].allocated_);
+  EXPECT_EQ(0, stats[0].retained_);
+  EXPECT_EQ(0, stats[1].reused_);
+  EXPECT_EQ(1, stats[1].allocated_);
+}
+
+TEST(PerThreadFreeListsTest, PushIsBounded) {
+  using Lists = FreeLists<1>;
+  for (int i = 0; i < 3; ++i) {
+    Lists::push(0, std::make_unique<uint64_t>(i), 1, 2);
+  }
+  EXPECT_EQ(2, Lists::stats()[0].retained_);
+
+  Lists::clearThreadCache();
+  EXPECT_EQ(0, Lists::stats()[0].retained_);
+  EXPECT_EQ(nullptr, Lists::pop(0, 1));
+}
+
+// Each thread has its own lists, and the stats of exited threads are kept.
+TEST(PerThreadFreeListsTest, ListsArePerThread) {
+  using Lists = FreeLists<2>;
+  Lists::push(0, std::make_unique<uint64_t>(0), 1, 2);
+
+  Thread::ThreadPtr thread = Thread::threadFactoryForTest().createThread([]() {
+    EXPECT_EQ(nullptr, Lists::pop(0, 1));
+    Lists::push(0, std::make_unique<uint64_t>(1), 1, 2);
+    EXPECT_NE(nullptr, Lists::pop(0, 1));
+    Lists::push(0, std::make_unique<uint64_t>(2), 1, 2);
+  });
+  thread->join();
+
+  // The storage of the exited thread was freed.
+  auto stats = Lists::stats();
+  EXPECT_EQ(1, stats[0].reused_);
+  EXPECT_EQ(1, stats[0].allocated_);
+  EXPECT_EQ(1, stats[0].retained_);
+
+  EXPECT_NE(nullptr, Lists::pop(0, 1));
+  stats = Lists::stats();
+  EXPECT_EQ(2, stats[0].reused_);
+  EXPECT_EQ(0, stats[0].retained_);
+}
+
+} // namespace
+} // namespace Envoy
@@ -7,6 +7,7 @@
 #include "test/test_common/test_runtime.h"
 #include "test/test_common/utility.h"
 
+#include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
 using testing::ContainsRegex;
@@ -140,6 +141,32 @@ TEST(Utility, ParseRegex) {
   }
 }
 
+TEST(GoogleReEngine, SetMatcher) {
+  GoogleReEngine engine;
+  const auto set = *engine.setMatcher({"/users/[0-9]+", "/users/.*", "/status/200(/.*)?$", ".*"});
+  EXPECT_EQ(4, set->size());
+
+  std::vector<int> matches;
+  EXPECT_TRUE(set->match("/users/123", matches));
+  EXPECT_THAT(matches, testing::ElementsAre(0, 1, 3));
+  EXPECT_TRUE(set->match("/users/abc", matches));
+  EXPECT_THAT(matches, testing::ElementsAre(1, 3));
+  EXPECT_TRUE(set->match("/status/200/foo", matches));
+  EXPECT_THAT(matches, testing::ElementsAre(2, 3));
+  // Expressions match whole values, like CompiledMatcher::match().
+  EXPECT_TRUE(set->match("/status/200foo", matches));
+  EXPECT_THAT(matches, testing::ElementsAre(3));
+  EXPECT_TRUE(set->match("prefix/users/123", matches));
+  EXPECT_THAT(matches, testing::ElementsAre(3));
+
+  const auto specific = *engine.setMatcher({"/users/[0-9]+", "/status/.*"});
+  EXPECT_TRUE(specific->match("/other", matches));
+  EXPECT_TRUE(matches.empty());
+
+  EXPECT_EQ(engine.setMatcher({"/ok", "(+invalid)"}).status().message(),
+            "no argument for repetition operator: +");
+}
+
 } // namespace
 } // namespace Regex
 } // namespace Envoy
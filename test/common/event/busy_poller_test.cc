@@ -0,0 +1,98 @@
+#include <chrono>
+
+#include "source/common/event/busy_poller.h"
+#include "source/common/stats/isolated_store_impl.h"
+
+#include "test/mocks/event/mocks.h"
+#include "test/test_common/simulated_time_system.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Event {
+namespace {
+
+using testing::NiceMock;
+
+class BusyPollerTest : public testing::Test {
+protected:
+  // Spins for 1ms after events, within an idle spin budget of 10ms per second.
+  BusyPollerTest()
+      : spin_cb_(new NiceMock<MockSchedulableCallback>(&dispatcher_)),
+        stats_{ALL_BUSY_POLL_STATS(POOL_COUNTER(*store_.rootScope()))},
+        poller_({std::chrono::milliseconds(1), 0.01}, stats_, dispatcher_) {}
+
+  void poll(bool found_events) { poller_.onPoll(time_system_.monotonicTime(), found_events); }
+  void advance(std::chrono::microseconds duration) { time_system_.advanceTimeWait(duration); }
+
+  SimulatedTimeSystem time_system_;
+  NiceMock<MockDispatcher> dispatcher_;
+  Stats::IsolatedStoreImpl store_;
+  MockSchedulableCallback* spin_cb_;
+  BusyPollStats stats_;
+  BusyPoller poller_;
+};
+
+TEST_F(BusyPollerTest, SpinsUntilDurationPassesWithoutEvents) {
+  // Blocking polls which find no events do not start spinning.
+  poll(false);
+  EXPECT_FALSE(spin_cb_->enabled_);
+
+  poll(true);
+  EXPECT_TRUE(spin_cb_->enabled_);
+  spin_cb_->invokeCallback();
+  EXPECT_TRUE(spin_cb_->enabled_);
+
+  advance(std::chrono::microseconds(40));
+  poll(false);
+  spin_cb_->invokeCallback();
+  EXPECT_TRUE(spin_cb_->enabled_);
+
+  // Events extend the spin.
+  advance(std::chrono::microseconds(40));
+  poll(true);
+  spin_cb_->invokeCallback();
+  EXPECT_TRUE(spin_cb_->enabled_);
+
+  advance(std::chrono::microseconds(999));
+  poll(false);
+  spin_cb_->invokeCallback();
+  EXPECT_TRUE(spin_cb_->enabled_);
+
+  advance(std::chrono::microseconds(1));
+  poll(false);
+  spin_cb_->invokeCallback();
+  EXPECT_FALSE(spin_cb_->enabled_);
+
+  EXPECT_EQ(4, stats_.busy_poll_spins_.value());
+  EXPECT_EQ(1, stats_.busy_poll_spins_with_events_.value());
+  EXPECT_EQ(0, stats_.busy_poll_budget_exhausted_.value());
+}
+
+TEST_F(BusyPollerTest, StopsAtIdleSpinBudget) {
+  // Each burst of events is followed by almost 1ms of spins which find no events.
+  for (int i = 0; i < 11; ++i) {
+    poll(true);
+    spin_cb_->invokeCallback();
+    advance(std::chrono::microseconds(999));
+    poll(false);
+    spin_cb_->invokeCallback();
+    EXPECT_EQ(i < 10, spin_cb_->enabled_);
+  }
+  EXPECT_EQ(1, stats_.busy_poll_budget_exhausted_.value());
+
+  // Events do not restart spinning until the budget is renewed the next second.
+  poll(true);
+  EXPECT_FALSE(spin_cb_->enabled_);
+  EXPECT_EQ(2, stats_.busy_poll_budget_exhausted_.value());
+
+  advance(std::chrono::seconds(1));
+  poll(true);
+  EXPECT_TRUE(spin_cb_->enabled_);
+  EXPECT_EQ(2, stats_.busy_poll_budget_exhausted_.value());
+}
+
+} // namespace
+} // namespace Event
+} // namespace Envoy
@@ -0,0 +1,128 @@
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "envoy/event/deferred_deletable.h"
+
+#include "source/common/api/api_impl.h"
+#include "source/common/event/deferred_delete_pool.h"
+#include "source/common/event/dispatcher_impl.h"
+
+#include "test/test_common/utility.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Event {
+namespace {
+
+class PooledObject : public DeferredDeletable, public PooledDeferredDeletable<PooledObject> {
+public:
+  static constexpr absl::string_view DeferredDeletePoolName = "test_pooled_object";
+
+  char payload_[200];
+};
+
+class LargerPooledObject : public PooledObject {
+public:
+  char more_payload_[100];
+};
+
+DeferredDeletePool::TypeStats pooledObjectStats() {
+  for (const DeferredDeletePool::TypeStats& stats : DeferredDeletePool::stats()) {
+    if (stats.name_ == PooledObject::DeferredDeletePoolName) {
+      return stats;
+    }
+  }
+  return {};
+}
+
+class DeferredDeletePoolTest : public testing::Test {
+protected:
+  DeferredDeletePoolTest() { DeferredDeletePool::configure(2); }
+  ~DeferredDeletePoolTest() override { DeferredDeletePool::configure(0); }
+};
+
+TEST(DeferredDeletePoolDisabledTest, Passthrough) {
+  EXPECT_FALSE(DeferredDeletePool::enabled());
+  const DeferredDeletePool::TypeStats before = pooledObjectStats();
+  auto object = std::make_unique<PooledObject>();
+  object.reset();
+  const DeferredDeletePool::TypeStats after = pooledObjectStats();
+  EXPECT_EQ(before.reused_, after.reused_);
+  EXPECT_EQ(before.allocated_, after.allocated_);
+  EXPECT_EQ(0, after.retained_);
+}
+
+TEST_F(DeferredDeletePoolTest, RecyclesStorage) {
+  const DeferredDeletePool::TypeStats before = pooledObjectStats();
+
+  auto object = std::make_unique<PooledObject>();
+  const void* address = object.get();
+  object.reset();
+  EXPECT_EQ(1, pooledObjectStats().retained_);
+
+  auto reused = std::make_unique<PooledObject>();
+  EXPECT_EQ(address, reused.get());
+
+  const DeferredDeletePool::TypeStats after = pooledObjectStats();
+  EXPECT_EQ(before.reused_ + 1, after.reused_);
+  EXPECT_EQ(before.allocated_ + 1, after.allocated_);
+  EXPECT_EQ(0, after.retained_);
+}
+
+TEST_F(DeferredDeletePoolTest, BoundedFreeList) {
+  std::vector<std::unique_ptr<PooledObject>> objects;
+  for (int i = 0; i < 4; ++i) {
+    objects.push_back(std::make_unique<PooledObject>());
+  }
+  objects.clear();
+  EXPECT_EQ(2, pooledObjectStats().retained_);
+
+  DeferredDeletePool::clearThreadCache();
+  EXPECT_EQ(0, pooledObjectStats().retained_);
+}
+
+// Subclasses have a different size and are not pooled, including when deleted through a pointer
+// to the base.
+TEST_F(DeferredDeletePoolTest, SubclassesBypassPool) {
+  const DeferredDeletePool::TypeStats before = pooledObjectStats();
+  std::unique_ptr<PooledObject> object = std::make_unique<LargerPooledObject>();
+  object.reset();
+  const DeferredDeletePool::TypeStats after = pooledObjectStats();
+  EXPECT_EQ(before.allocated_, after.allocated_);
+  EXPECT_EQ(0, after.retained_);
+}
+
+TEST_F(DeferredDeletePoolTest, ReusedAfterDeferredDelete) {
+  Api::ApiPtr api = Api::createApiForTest();
+  DispatcherPtr dispatcher = api->allocateDispatcher("test_thread");
+
+  auto object = std::make_unique<PooledObject>();
+  const void* address = object.get();
+  dispatcher->deferredDelete(std::move(object));
+  EXPECT_EQ(0, pooledObjectStats().retained_);
+  dispatcher->run(Dispatcher::RunType::NonBlock);
+  EXPECT_EQ(1, pooledObjectStats().retained_);
+
+  auto reused = std::make_unique<PooledObject>();
+  EXPECT_EQ(address, reused.get());
+}
+
+// Storage allocated on one thread may be released on another, and the totals of exited threads
+// are kept.
+TEST_F(DeferredDeletePoolTest, CrossThreadRelease) {
+  const DeferredDeletePool::TypeStats before = pooledObjectStats();
+  std::unique_ptr<PooledObject> object;
+  std::thread allocator([&object]() { object = std::make_unique<PooledObject>(); });
+  allocator.join();
+  object.reset();
+
+  const DeferredDeletePool::TypeStats after = pooledObjectStats();
+  EXPECT_EQ(before.allocated_ + 1, after.allocated_);
+  EXPECT_EQ(1, after.retained_);
+}
+
+} // namespace
+} // namespace Event
+} // namespace Envoy
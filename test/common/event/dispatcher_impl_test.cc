@@ -27,10 +27,13 @@
 #include "gtest/gtest.h"
 
 using testing::_;
+using testing::AnyNumber;
+using testing::AtLeast;
 using testing::ByMove;
 using testing::InSequence;
 using testing::MockFunction;
 using testing::NiceMock;
+using testing::Property;
 using testing::Return;
 
 namespace Envoy {
@@ -369,7 +372,57 @@ TEST_F(DispatcherImplTest, InitializeStats) {
               histogram("test.dispatcher.loop_duration_us", Stats::Histogram::Unit::Microseconds));
   EXPECT_CALL(store_,
               histogram("test.dispatcher.poll_delay_us", Stats::Histogram::Unit::Microseconds));
+  EXPECT_CALL(store_,
+              histogram("test.dispatcher.post_queue_depth", Stats::Histogram::Unit::Unspecified));
+  EXPECT_CALL(store_,
+              histogram("test.dispatcher.post_delay_us", Stats::Histogram::Unit::Microseconds));
+  EXPECT_CALL(store_,
+              histogram("test.dispatcher.events_per_loop", Stats::Histogram::Unit::Unspecified));
+  EXPECT_CALL(store_,
+              histogram("test.dispatcher.file_event_us", Stats::Histogram::Unit::Microseconds));
+  EXPECT_CALL(store_, histogram("test.dispatcher.timer_us", Stats::Histogram::Unit::Microseconds));
+  EXPECT_CALL(store_,
+              histogram("test.dispatcher.post_callback_us", Stats::Histogram::Unit::Microseconds));
+  EXPECT_CALL(store_, histogram("test.dispatcher.deferred_delete_us",
+                                Stats::Histogram::Unit::Microseconds));
+  dispatcher_->initializeStats(scope_, "test.");
+}
+
+// Once stats are initialized, the time spent in each category of callbacks is recorded when the
+// event loop iteration which ran them ends, and the delay of posted callbacks when they run.
+TEST_F(DispatcherImplTest, LoopCallbackStats) {
+  EXPECT_CALL(store_, deliverHistogramToSinks(_, _)).Times(AnyNumber());
+  for (const std::string name :
+       {"test.dispatcher.post_delay_us", "test.dispatcher.events_per_loop",
+        "test.dispatcher.timer_us", "test.dispatcher.post_callback_us"}) {
+    EXPECT_CALL(store_, deliverHistogramToSinks(Property(&Stats::Metric::name, name), _))
+        .Times(AtLeast(1));
+  }
   dispatcher_->initializeStats(scope_, "test.");
+
+  // The first timer and the callback it posts run in an iteration which ends before the second
+  // timer runs.
+  TimerPtr first_timer;
+  TimerPtr second_timer;
+  dispatcher_->post([&]() {
+    second_timer = dispatcher_->createTimer([&]() {
+      first_timer.reset();
+      {
+        Thread::LockGuard lock(mu_);
+        work_finished_ = true;
+      }
+      cv_.notifyOne();
+    });
+    first_timer = dispatcher_->createTimer([&]() {
+      dispatcher_->post([&]() { second_timer->enableTimer(std::chrono::milliseconds(0)); });
+    });
+    first_timer->enableTimer(std::chrono::milliseconds(0));
+  });
+
+  Thread::LockGuard lock(mu_);
+  while (!work_finished_) {
+    cv_.wait(mu_);
+  }
 }
 
 TEST_F(DispatcherImplTest, Post) {
@@ -388,6 +441,39 @@ TEST_F(DispatcherImplTest, Post) {
   }
 }
 
+// Callbacks posted concurrently from several threads all run, in the order each thread posted them.
+TEST_F(DispatcherImplTest, PostFromManyThreads) {
+  constexpr uint32_t num_threads = 8;
+  constexpr uint32_t posts_per_thread = 10000;
+  std::vector<uint32_t> next_expected(num_threads);
+  uint32_t num_run = 0;
+  std::vector<Thread::ThreadPtr> threads;
+  for (uint32_t i = 0; i < num_threads; ++i) {
+    threads.push_back(api_->threadFactory().createThread([&, i]() {
+      for (uint32_t j = 0; j < posts_per_thread; ++j) {
+        dispatcher_->post([&, i, j]() {
+          EXPECT_EQ(next_expected[i]++, j);
+          if (++num_run == num_threads * posts_per_thread) {
+            {
+              Thread::LockGuard lock(mu_);
+              work_finished_ = true;
+            }
+            cv_.notifyOne();
+          }
+        });
+      }
+    }));
+  }
+  for (Thread::ThreadPtr& thread : threads) {
+    thread->join();
+  }
+
+  Thread::LockGuard lock(mu_);
+  while (!work_finished_) {
+    cv_.wait(mu_);
+  }
+}
+
 TEST_F(DispatcherImplTest, PostExecuteAndDestructOrder) {
   MockFunction<void()> parent_callback, deferred_delete_callback, run_callback1, delete_callback1,
       run_callback2, delete_callback2;
@@ -445,8 +531,8 @@ TEST_F(DispatcherImplTest, RunPostCallbacksLocking) {
     // Block dispatcher first to ensure that both posted events below are handled
     // by a single call to runPostCallbacks().
     //
-    // This also ensures that the post_lock_ is not held while callbacks are called,
-    // or else this would deadlock.
+    // This also ensures that posting from the destructor of a callback while the callbacks are
+    // running works, or else this would deadlock.
     Thread::LockGuard lock(mu_);
     dispatcher_->post([this]() { Thread::LockGuard lock(mu_); });
 
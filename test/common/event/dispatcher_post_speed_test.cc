@@ -0,0 +1,98 @@
+// Measures the throughput and latency of Dispatcher::post() from several producer threads to one
+// dispatcher, such as when the main thread and xDS updates post to all workers at once.
+
+#include <atomic>
+#include <chrono>
+#include <vector>
+
+#include "source/common/api/api_impl.h"
+#include "source/common/event/dispatcher_impl.h"
+
+#include "test/benchmark/main.h"
+#include "test/test_common/utility.h"
+
+#include "absl/synchronization/notification.h"
+#include "benchmark/benchmark.h"
+
+namespace Envoy {
+namespace Event {
+
+// Runs a dispatcher on its own thread for the lifetime of the object.
+class RunningDispatcher {
+public:
+  RunningDispatcher() : api_(Api::createApiForTest()) {
+    dispatcher_ = api_->allocateDispatcher("test_thread");
+    keepalive_timer_ = dispatcher_->createTimer([]() {});
+    keepalive_timer_->enableTimer(std::chrono::hours(1));
+    thread_ = api_->threadFactory().createThread(
+        [this]() { dispatcher_->run(Dispatcher::RunType::RunUntilExit); });
+  }
+
+  ~RunningDispatcher() {
+    dispatcher_->post([this]() { keepalive_timer_.reset(); });
+    dispatcher_->exit();
+    thread_->join();
+  }
+
+  Api::Api& api() { return *api_; }
+  Dispatcher& dispatcher() { return *dispatcher_; }
+
+private:
+  Api::ApiPtr api_;
+  DispatcherPtr dispatcher_;
+  TimerPtr keepalive_timer_;
+  Thread::ThreadPtr thread_;
+};
+
+// Each producer posts its callbacks as fast as it can. The latency of a callback is the time from
+// its post() until it runs on the dispatcher thread.
+static void bmPostFromProducers(::benchmark::State& state) {
+  const uint32_t num_producers = state.range(0);
+  const uint32_t posts_per_producer =
+      Envoy::benchmark::skipExpensiveBenchmarks() ? 1000 : state.range(1);
+  RunningDispatcher running;
+  TimeSource& time_source = running.api().timeSource();
+
+  uint64_t total_posts = 0;
+  // Only updated on the dispatcher thread.
+  std::chrono::nanoseconds total_latency{};
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    std::atomic<uint64_t> remaining{static_cast<uint64_t>(num_producers) * posts_per_producer};
+    absl::Notification done;
+    std::vector<Thread::ThreadPtr> producers;
+    for (uint32_t i = 0; i < num_producers; ++i) {
+      producers.push_back(running.api().threadFactory().createThread([&]() {
+        for (uint32_t j = 0; j < posts_per_producer; ++j) {
+          const MonotonicTime posted = time_source.monotonicTime();
+          running.dispatcher().post([&, posted]() {
+            total_latency += time_source.monotonicTime() - posted;
+            if (remaining.fetch_sub(1) == 1) {
+              done.Notify();
+            }
+          });
+        }
+      }));
+    }
+    for (Thread::ThreadPtr& producer : producers) {
+      producer->join();
+    }
+    done.WaitForNotification();
+    total_posts += static_cast<uint64_t>(num_producers) * posts_per_producer;
+  }
+
+  state.SetItemsProcessed(total_posts);
+  state.counters["mean_latency_us"] =
+      std::chrono::duration<double, std::micro>(total_latency).count() / total_posts;
+}
+BENCHMARK(bmPostFromProducers)
+    ->ArgNames({"producers", "posts"})
+    ->Args({1, 100000})
+    ->Args({2, 100000})
+    ->Args({4, 100000})
+    ->Args({8, 100000})
+    ->Args({16, 100000})
+    ->UseRealTime()
+    ->Unit(::benchmark::kMillisecond);
+
+} // namespace Event
+} // namespace Envoy
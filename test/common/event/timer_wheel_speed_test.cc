@@ -0,0 +1,105 @@
+// Compares the timer wheel with libevent's timer min-heap for a large number of millisecond
+// timers, such as the idle timeouts of many mostly-idle connections.
+
+#include <chrono>
+#include <random>
+#include <vector>
+
+#include "source/common/api/api_impl.h"
+#include "source/common/event/dispatcher_impl.h"
+#include "source/common/event/timer_wheel.h"
+
+#include "test/benchmark/main.h"
+#include "test/test_common/simulated_time_system.h"
+#include "test/test_common/utility.h"
+
+#include "benchmark/benchmark.h"
+
+namespace Envoy {
+namespace Event {
+
+class TimerSet {
+public:
+  TimerSet(bool wheel, Api::Api& api, uint32_t num_timers, uint32_t max_timeout_ms) {
+    TimerWheelScheduler::configure(wheel);
+    dispatcher_ = api.allocateDispatcher("test_thread");
+    TimerWheelScheduler::configure(false);
+
+    std::mt19937 rng(1);
+    std::uniform_int_distribution<uint32_t> dist(1, max_timeout_ms);
+    timers_.reserve(num_timers);
+    timeouts_.reserve(num_timers);
+    for (uint32_t i = 0; i < num_timers; ++i) {
+      timers_.push_back(dispatcher_->createTimer([this]() { ++fired_; }));
+      timeouts_.emplace_back(dist(rng));
+    }
+  }
+
+  ~TimerSet() { timers_.clear(); }
+
+  void enableAll() {
+    for (size_t i = 0; i < timers_.size(); ++i) {
+      timers_[i]->enableTimer(timeouts_[i]);
+    }
+  }
+
+  void disableAll() {
+    for (TimerPtr& timer : timers_) {
+      timer->disableTimer();
+    }
+  }
+
+  Dispatcher& dispatcher() { return *dispatcher_; }
+  uint64_t fired() const { return fired_; }
+
+private:
+  DispatcherPtr dispatcher_;
+  std::vector<TimerPtr> timers_;
+  std::vector<std::chrono::milliseconds> timeouts_;
+  uint64_t fired_{};
+};
+
+static uint32_t numTimers(::benchmark::State& state) {
+  return Envoy::benchmark::skipExpensiveBenchmarks() ? 1000 : state.range(1);
+}
+
+// Arms all timers, re-arms them as an idle timeout reset on activity would, and disables them.
+static void bmArmRearmDisable(::benchmark::State& state) {
+  Api::ApiPtr api = Api::createApiForTest();
+  TimerSet timers(state.range(0) != 0, *api, numTimers(state), 60 * 1000);
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    timers.enableAll();
+    timers.enableAll();
+    timers.disableAll();
+  }
+  state.SetItemsProcessed(state.iterations() * numTimers(state) * 3);
+}
+BENCHMARK(bmArmRearmDisable)
+    ->ArgNames({"wheel", "timers"})
+    ->Args({0, 1000000})
+    ->Args({1, 1000000})
+    ->Unit(::benchmark::kMillisecond);
+
+// Arms all timers within one second and runs the loop in simulated time until all have fired.
+static void bmExpire(::benchmark::State& state) {
+  SimulatedTimeSystem time_system;
+  Api::ApiPtr api = Api::createApiForTest(time_system);
+  TimerSet timers(state.range(0) != 0, *api, numTimers(state), 1000);
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    timers.enableAll();
+    for (uint32_t ms = 0; ms < 1000; ++ms) {
+      time_system.advanceTimeAndRun(std::chrono::milliseconds(1), timers.dispatcher(),
+                                    Dispatcher::RunType::NonBlock);
+    }
+  }
+  RELEASE_ASSERT(timers.fired() == state.iterations() * numTimers(state), "");
+  state.SetItemsProcessed(timers.fired());
+}
+BENCHMARK(bmExpire)
+    ->ArgNames({"wheel", "timers"})
+    ->Args({0, 1000000})
+    ->Args({1, 1000000})
+    ->Unit(::benchmark::kMillisecond);
+
+} // namespace Event
+} // namespace Envoy
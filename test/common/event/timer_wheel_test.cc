@@ -0,0 +1,199 @@
+#include <chrono>
+#include <vector>
+
+#include "source/common/api/api_impl.h"
+#include "source/common/common/scope_tracker.h"
+#include "source/common/event/dispatcher_impl.h"
+#include "source/common/event/timer_wheel.h"
+
+#include "test/mocks/common.h"
+#include "test/test_common/simulated_time_system.h"
+#include "test/test_common/utility.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+using testing::ElementsAre;
+using testing::MockFunction;
+
+namespace Envoy {
+namespace Event {
+namespace {
+
+class TimerWheelTest : public testing::Test {
+protected:
+  TimerWheelTest() : api_(Api::createApiForTest(time_system_)) {
+    TimerWheelScheduler::configure(true);
+    dispatcher_ = api_->allocateDispatcher("test_thread");
+    TimerWheelScheduler::configure(false);
+  }
+
+  void advance(std::chrono::microseconds duration) {
+    time_system_.advanceTimeAndRun(duration, *dispatcher_, Dispatcher::RunType::NonBlock);
+  }
+
+  TimerPtr createTimer(std::vector<int>& fired, int id) {
+    return dispatcher_->createTimer([&fired, id]() { fired.push_back(id); });
+  }
+
+  Event::SimulatedTimeSystem time_system_;
+  Api::ApiPtr api_;
+  DispatcherPtr dispatcher_;
+};
+
+TEST_F(TimerWheelTest, FiresInDeadlineOrder) {
+  std::vector<int> fired;
+  TimerPtr timer1 = createTimer(fired, 1);
+  TimerPtr timer2 = createTimer(fired, 2);
+  TimerPtr timer3 = createTimer(fired, 3);
+  timer1->enableTimer(std::chrono::milliseconds(30));
+  timer2->enableTimer(std::chrono::milliseconds(10));
+  timer3->enableTimer(std::chrono::milliseconds(20));
+  EXPECT_TRUE(timer1->enabled());
+
+  advance(std::chrono::milliseconds(9));
+  EXPECT_TRUE(fired.empty());
+  advance(std::chrono::milliseconds(1));
+  EXPECT_THAT(fired, ElementsAre(2));
+  EXPECT_FALSE(timer2->enabled());
+  advance(std::chrono::milliseconds(20));
+  EXPECT_THAT(fired, ElementsAre(2, 3, 1));
+}
+
+TEST_F(TimerWheelTest, NeverFiresEarly) {
+  std::vector<int> fired;
+  TimerPtr timer = createTimer(fired, 1);
+  advance(std::chrono::microseconds(500));
+  timer->enableTimer(std::chrono::milliseconds(1));
+  advance(std::chrono::microseconds(999));
+  EXPECT_TRUE(fired.empty());
+  advance(std::chrono::microseconds(501));
+  EXPECT_THAT(fired, ElementsAre(1));
+}
+
+// Timeouts beyond the first level, and beyond the span of the whole wheel, are moved down the
+// levels as time passes and still fire on time.
+TEST_F(TimerWheelTest, CascadesLongTimeouts) {
+  std::vector<int> fired;
+  const std::vector<std::chrono::milliseconds> timeouts{
+      std::chrono::milliseconds(300), std::chrono::seconds(70), std::chrono::hours(5),
+      std::chrono::hours(24 * 60)};
+  std::vector<TimerPtr> timers;
+  for (size_t i = 0; i < timeouts.size(); ++i) {
+    timers.push_back(createTimer(fired, i));
+    timers.back()->enableTimer(timeouts[i]);
+  }
+
+  std::chrono::milliseconds elapsed{0};
+  for (size_t i = 0; i < timeouts.size(); ++i) {
+    advance(timeouts[i] - elapsed - std::chrono::milliseconds(1));
+    EXPECT_EQ(i, fired.size());
+    advance(std::chrono::milliseconds(1));
+    EXPECT_EQ(i + 1, fired.size());
+    elapsed = timeouts[i];
+  }
+  EXPECT_THAT(fired, ElementsAre(0, 1, 2, 3));
+}
+
+TEST_F(TimerWheelTest, DisableAndReenable) {
+  std::vector<int> fired;
+  TimerPtr timer = createTimer(fired, 1);
+  timer->enableTimer(std::chrono::milliseconds(10));
+  timer->disableTimer();
+  EXPECT_FALSE(timer->enabled());
+  advance(std::chrono::milliseconds(20));
+  EXPECT_TRUE(fired.empty());
+
+  // Re-arming moves the deadline.
+  timer->enableTimer(std::chrono::milliseconds(10));
+  advance(std::chrono::milliseconds(5));
+  timer->enableTimer(std::chrono::milliseconds(10));
+  advance(std::chrono::milliseconds(9));
+  EXPECT_TRUE(fired.empty());
+  advance(std::chrono::milliseconds(1));
+  EXPECT_THAT(fired, ElementsAre(1));
+}
+
+// Zero and high resolution timeouts are handled by the wrapped scheduler.
+TEST_F(TimerWheelTest, HighResolutionFallback) {
+  std::vector<int> fired;
+  TimerPtr timer = createTimer(fired, 1);
+  timer->enableHRTimer(std::chrono::microseconds(100));
+  EXPECT_TRUE(timer->enabled());
+  advance(std::chrono::microseconds(100));
+  EXPECT_THAT(fired, ElementsAre(1));
+
+  timer->enableTimer(std::chrono::milliseconds(0));
+  dispatcher_->run(Dispatcher::RunType::NonBlock);
+  EXPECT_THAT(fired, ElementsAre(1, 1));
+
+  // Switching between the wheel and the fallback timer disarms the other one.
+  timer->enableHRTimer(std::chrono::microseconds(100));
+  timer->enableTimer(std::chrono::milliseconds(10));
+  advance(std::chrono::milliseconds(5));
+  EXPECT_THAT(fired, ElementsAre(1, 1));
+  timer->enableHRTimer(std::chrono::microseconds(100));
+  advance(std::chrono::milliseconds(10));
+  EXPECT_THAT(fired, ElementsAre(1, 1, 1));
+}
+
+// Callbacks may destroy or re-arm timers which expire in the same tick.
+TEST_F(TimerWheelTest, CallbacksModifyExpiredTimers) {
+  std::vector<int> fired;
+  TimerPtr timer2 = createTimer(fired, 2);
+  TimerPtr timer3 = createTimer(fired, 3);
+  TimerPtr timer1 = dispatcher_->createTimer([&]() {
+    fired.push_back(1);
+    timer2.reset();
+    timer3->enableTimer(std::chrono::milliseconds(5));
+  });
+  timer1->enableTimer(std::chrono::milliseconds(10));
+  timer2->enableTimer(std::chrono::milliseconds(10));
+  timer3->enableTimer(std::chrono::milliseconds(10));
+
+  advance(std::chrono::milliseconds(10));
+  EXPECT_THAT(fired, ElementsAre(1));
+  advance(std::chrono::milliseconds(5));
+  EXPECT_THAT(fired, ElementsAre(1, 3));
+}
+
+TEST_F(TimerWheelTest, PeriodicRearmFromCallback) {
+  int count = 0;
+  TimerPtr timer;
+  timer = dispatcher_->createTimer([&]() {
+    ++count;
+    timer->enableTimer(std::chrono::milliseconds(1));
+  });
+  timer->enableTimer(std::chrono::milliseconds(1));
+  for (int i = 0; i < 1000; ++i) {
+    advance(std::chrono::milliseconds(1));
+  }
+  EXPECT_EQ(1000, count);
+  timer->disableTimer();
+}
+
+TEST_F(TimerWheelTest, TracksScope) {
+  MockScopeTrackedObject scope;
+  MockFunction<void()> callback;
+  TimerPtr timer = dispatcher_->createTimer(callback.AsStdFunction());
+  timer->enableTimer(std::chrono::milliseconds(10), &scope);
+  EXPECT_CALL(callback, Call()).WillOnce([&]() {
+    EXPECT_FALSE(dispatcher_->trackedObjectStackIsEmpty());
+  });
+  advance(std::chrono::milliseconds(10));
+  EXPECT_TRUE(dispatcher_->trackedObjectStackIsEmpty());
+}
+
+TEST_F(TimerWheelTest, ScaledTimersUseWheel) {
+  MockFunction<void()> callback;
+  TimerPtr timer = dispatcher_->createScaledTimer(ScaledTimerMinimum(ScaledMinimum(UnitFloat(0.5))),
+                                                  callback.AsStdFunction());
+  timer->enableTimer(std::chrono::milliseconds(100));
+  advance(std::chrono::milliseconds(99));
+  EXPECT_CALL(callback, Call());
+  advance(std::chrono::milliseconds(1));
+}
+
+} // namespace
+} // namespace Event
+} // namespace Envoy
@@ -0,0 +1,54 @@
+#include <string>
+
+#include "source/common/http/character_set_scan.h"
+#include "source/common/http/character_set_validation.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Http {
+namespace {
+
+bool isCrOrLf(char c) { return c == '\r' || c == '\n'; }
+
+// Places each byte value at each offset of inputs which span several vectors and a tail, so that
+// both the vectorized and the scalar parts of the scans are compared with the lookup tables.
+TEST(CharacterSetScanTest, MatchesLookupTables) {
+  for (size_t size : {1, 15, 16, 17, 31, 32, 33, 64, 70}) {
+    for (size_t offset = 0; offset < size; ++offset) {
+      for (int c = 0; c < 256; ++c) {
+        std::string name(size, 'a');
+        std::string value(size, 'a');
+        name[offset] = static_cast<char>(c);
+        value[offset] = static_cast<char>(c);
+        const size_t expected_name =
+            testCharInTable(kGenericHeaderNameCharTable, c) ? absl::string_view::npos : offset;
+        const size_t expected_value =
+            testCharInTable(kHeaderValueCharTable, c) ? absl::string_view::npos : offset;
+        const size_t expected_cr_or_lf = isCrOrLf(c) ? offset : absl::string_view::npos;
+        ASSERT_EQ(expected_name, findInvalidHeaderNameChar(name))
+            << size << " " << offset << " " << c;
+        ASSERT_EQ(expected_value, findInvalidHeaderValueChar(value))
+            << size << " " << offset << " " << c;
+        ASSERT_EQ(expected_cr_or_lf, findCrOrLf(value)) << size << " " << offset << " " << c;
+      }
+    }
+  }
+}
+
+TEST(CharacterSetScanTest, FindsFirstMatch) {
+  const std::string value = std::string(40, 'x') + "\n" + std::string(10, 'x') + "\r\x7f";
+  EXPECT_EQ(40, findInvalidHeaderValueChar(value));
+  EXPECT_EQ(40, findCrOrLf(value));
+  EXPECT_EQ(3, findInvalidHeaderNameChar("abc:def"));
+}
+
+TEST(CharacterSetScanTest, Empty) {
+  EXPECT_EQ(absl::string_view::npos, findInvalidHeaderNameChar(""));
+  EXPECT_EQ(absl::string_view::npos, findInvalidHeaderValueChar(""));
+  EXPECT_EQ(absl::string_view::npos, findCrOrLf(""));
+}
+
+} // namespace
+} // namespace Http
+} // namespace Envoy
@@ -0,0 +1,176 @@
+// Note: this should be run with --compilation_mode=opt, and would benefit from a
+// quiescent system with disabled cstate power management.
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <vector>
+
+#include "envoy/http/filter_factory.h"
+
+#include "source/common/http/filter_manager.h"
+#include "source/common/memory/stats.h"
+#include "source/common/stream_info/filter_state_impl.h"
+#include "source/extensions/filters/http/common/pass_through_filter.h"
+
+#include "test/mocks/event/mocks.h"
+#include "test/mocks/http/mocks.h"
+#include "test/mocks/local_reply/mocks.h"
+#include "test/mocks/network/mocks.h"
+#include "test/mocks/server/overload_manager.h"
+#include "test/test_common/test_runtime.h"
+
+#include "benchmark/benchmark.h"
+#include "gmock/gmock.h"
+
+#if defined(__linux__)
+// On Linux the binary is linked with --wrap for these functions (see BUILD), so every operator new
+// call made by the code under test is counted here before it reaches the allocator, whichever
+// allocator is linked.
+static std::atomic<uint64_t> heap_allocations{0};
+
+// NOLINTBEGIN(readability-identifier-naming,bugprone-reserved-identifier)
+extern "C" {
+void* __real__Znwm(size_t size);
+void* __real__Znam(size_t size);
+void* __real__ZnwmSt11align_val_t(size_t size, std::align_val_t alignment);
+void* __real__ZnamSt11align_val_t(size_t size, std::align_val_t alignment);
+
+void* __wrap__Znwm(size_t size) {
+  heap_allocations.fetch_add(1, std::memory_order_relaxed);
+  return __real__Znwm(size);
+}
+void* __wrap__Znam(size_t size) {
+  heap_allocations.fetch_add(1, std::memory_order_relaxed);
+  return __real__Znam(size);
+}
+void* __wrap__ZnwmSt11align_val_t(size_t size, std::align_val_t alignment) {
+  heap_allocations.fetch_add(1, std::memory_order_relaxed);
+  return __real__ZnwmSt11align_val_t(size, alignment);
+}
+void* __wrap__ZnamSt11align_val_t(size_t size, std::align_val_t alignment) {
+  heap_allocations.fetch_add(1, std::memory_order_relaxed);
+  return __real__ZnamSt11align_val_t(size, alignment);
+}
+}
+// NOLINTEND(readability-identifier-naming,bugprone-reserved-identifier)
+#endif
+
+namespace Envoy {
+namespace Http {
+namespace {
+
+using testing::NiceMock;
+
+// Adds the same decoder, encoder and stream filters to every filter chain. The filters themselves
+// are allocated by their factories, outside of the filter manager, so they are shared here.
+class FilterChainFactoryImpl : public FilterChainFactory {
+public:
+  explicit FilterChainFactoryImpl(int64_t filters) {
+    for (int64_t i = 0; i < filters; ++i) {
+      filters_.push_back(std::make_shared<PassThroughFilter>());
+    }
+  }
+
+  // Http::FilterChainFactory
+  bool createFilterChain(FilterChainFactoryCallbacks& callbacks) const override {
+    for (size_t i = 0; i < filters_.size(); ++i) {
+      switch (i % 3) {
+      case 0:
+        callbacks.addStreamFilter(filters_[i]);
+        break;
+      case 1:
+        callbacks.addStreamDecoderFilter(filters_[i]);
+        break;
+      default:
+        callbacks.addStreamEncoderFilter(filters_[i]);
+        break;
+      }
+    }
+    return true;
+  }
+  bool createUpgradeFilterChain(absl::string_view, const UpgradeMap*,
+                                FilterChainFactoryCallbacks&) const override {
+    return false;
+  }
+
+private:
+  std::vector<std::shared_ptr<PassThroughFilter>> filters_;
+};
+
+/**
+ * Creates and destroys the filter chain of a request with state.range(0) filters, with or without
+ * the per-stream arena. Also reports the heap allocations made for each request's filter manager
+ * with its filter chain, counted on Linux, and their memory as measured by the allocator, which
+ * includes the arena's blocks and the heap allocations made without the arena alike. The memory is
+ * only reported when the allocator reports the allocated memory, i.e. when built with tcmalloc.
+ */
+static void bmFilterChain(benchmark::State& state, bool arena) {
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues(
+      {{"envoy.reloadable_features.http_stream_arena", arena ? "true" : "false"}});
+  NiceMock<MockFilterManagerCallbacks> filter_manager_callbacks;
+  NiceMock<Event::MockDispatcher> dispatcher;
+  NiceMock<Network::MockConnection> connection;
+  NiceMock<LocalReply::MockLocalReply> local_reply;
+  NiceMock<MockTimeSystem> time_source;
+  NiceMock<Server::MockOverloadManager> overload_manager;
+  StreamInfo::FilterStateSharedPtr filter_state =
+      std::make_shared<StreamInfo::FilterStateImpl>(StreamInfo::FilterState::LifeSpan::Connection);
+  FilterChainFactoryImpl filter_chain_factory(state.range(0));
+
+  auto create_filter_chain = [&]() {
+    auto filter_manager = std::make_unique<DownstreamFilterManager>(
+        filter_manager_callbacks, dispatcher, connection, 0, nullptr, true, 10000,
+        filter_chain_factory, local_reply, Protocol::Http2, time_source, filter_state,
+        overload_manager);
+    filter_manager->createDownstreamFilterChain();
+    return filter_manager;
+  };
+
+  {
+    // Keep the filter chains of many requests alive at once, so that the allocator's caches do not
+    // skew the measurement.
+    constexpr uint64_t Requests = 100;
+    std::vector<std::unique_ptr<DownstreamFilterManager>> filter_managers;
+    filter_managers.reserve(Requests);
+    const uint64_t start_bytes = Memory::Stats::totalCurrentlyAllocated();
+#if defined(__linux__)
+    const uint64_t start_allocations = heap_allocations.load(std::memory_order_relaxed);
+#endif
+    for (uint64_t i = 0; i < Requests; ++i) {
+      filter_managers.push_back(create_filter_chain());
+    }
+#if defined(__linux__)
+    state.counters["heap_allocations_per_request"] =
+        static_cast<double>(heap_allocations.load(std::memory_order_relaxed) - start_allocations) /
+        Requests;
+#endif
+    const uint64_t end_bytes = Memory::Stats::totalCurrentlyAllocated();
+    if (start_bytes != 0) {
+      state.counters["bytes_per_request"] =
+          end_bytes > start_bytes ? (end_bytes - start_bytes) / Requests : 0;
+    }
+    if (arena) {
+      state.counters["arena_blocks_per_request"] = filter_managers[0]->arena()->blocks();
+    }
+    for (auto& filter_manager : filter_managers) {
+      filter_manager->destroyFilters();
+    }
+  }
+
+  for (auto _ : state) { // NOLINT
+    create_filter_chain()->destroyFilters();
+  }
+}
+
+static void bmFilterChainHeap(benchmark::State& state) { bmFilterChain(state, false); }
+static void bmFilterChainArena(benchmark::State& state) { bmFilterChain(state, true); }
+
+BENCHMARK(bmFilterChainHeap)->RangeMultiplier(2)->Range(1, 32);
+BENCHMARK(bmFilterChainArena)->RangeMultiplier(2)->Range(1, 32);
+
+} // namespace
+} // namespace Http
+} // namespace Envoy
@@ -141,6 +141,46 @@ TEST_F(FilterManagerTest, RequestHeadersOrResponseHeadersAccess) {
   filter_manager_->destroyFilters();
 }
 
+TEST_F(FilterManagerTest, StreamArena) {
+  initialize();
+  EXPECT_EQ(nullptr, filter_manager_->arena());
+  filter_manager_->destroyFilters();
+
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues({{"envoy.reloadable_features.http_stream_arena", "true"}});
+  initialize();
+
+  auto decoder_filter = std::make_shared<NiceMock<MockStreamDecoderFilter>>();
+  auto stream_filter = std::make_shared<NiceMock<MockStreamFilter>>();
+  auto encoder_filter = std::make_shared<NiceMock<MockStreamEncoderFilter>>();
+  EXPECT_CALL(filter_factory_, createFilterChain(_))
+      .WillOnce(Invoke([&](FilterChainFactoryCallbacks& callbacks) -> bool {
+        createDecoderFilterFactoryCb(decoder_filter)(callbacks);
+        createStreamFilterFactoryCb(stream_filter)(callbacks);
+        createEncoderFilterFactoryCb(encoder_filter)(callbacks);
+        return true;
+      }));
+  filter_manager_->createDownstreamFilterChain();
+
+  // The four filter wrappers and the growth of the filter lists come from a single block.
+  ASSERT_NE(nullptr, filter_manager_->arena());
+  EXPECT_LE(4, filter_manager_->arena()->allocations());
+  EXPECT_EQ(1, filter_manager_->arena()->blocks());
+
+  RequestHeaderMapPtr request_headers{
+      new TestRequestHeaderMapImpl{{":authority", "host"}, {":path", "/"}, {":method", "GET"}}};
+  ON_CALL(filter_manager_callbacks_, requestHeaders())
+      .WillByDefault(Return(makeOptRef(*request_headers)));
+  filter_manager_->requestHeadersInitialized();
+
+  InSequence s;
+  EXPECT_CALL(*decoder_filter, decodeHeaders(_, true));
+  EXPECT_CALL(*stream_filter, decodeHeaders(_, true));
+  filter_manager_->decodeHeaders(*request_headers, true);
+
+  filter_manager_->destroyFilters();
+}
+
 // Verifies that the local reply persists the gRPC classification even if the request headers are
 // modified.
 TEST_F(FilterManagerTest, SendLocalReplyDuringDecodingGrpcClassiciation) {
@@ -1095,11 +1095,17 @@ TEST(HeaderIsValidTest, InvalidHeaderValuesAreRejected) {
 
     EXPECT_FALSE(HeaderUtility::headerValueIsValid(std::string(1, i)));
   }
+  EXPECT_FALSE(HeaderUtility::headerValueIsValid("\x7f"));
+  // Values longer than a vector are rejected wherever the invalid character is.
+  EXPECT_FALSE(HeaderUtility::headerValueIsValid(std::string(40, 'a') + "\n"));
+  EXPECT_FALSE(HeaderUtility::headerValueIsValid("\r" + std::string(40, 'a')));
 }
 
 TEST(HeaderIsValidTest, ValidHeaderValuesAreAccepted) {
   EXPECT_TRUE(HeaderUtility::headerValueIsValid("some-value"));
   EXPECT_TRUE(HeaderUtility::headerValueIsValid("Some Other Value"));
+  EXPECT_TRUE(HeaderUtility::headerValueIsValid("\ttab and obs-text \x80\xff"));
+  EXPECT_TRUE(HeaderUtility::headerValueIsValid(std::string(100, 'a')));
 }
 
 TEST(HeaderIsValidTest, AuthorityIsValid) {
@@ -0,0 +1,128 @@
+// Note: this should be run with --compilation_mode=opt, and would benefit from a
+// quiescent system with disabled cstate power management.
+
+#include <string>
+
+#include "source/common/common/assert.h"
+#include "source/common/http/header_utility.h"
+#include "source/common/http/http1/balsa_parser.h"
+
+#include "absl/strings/str_cat.h"
+#include "benchmark/benchmark.h"
+
+namespace Envoy {
+namespace Http {
+namespace Http1 {
+namespace {
+
+// Validates header values the way ConnectionImpl does, and otherwise ignores the message.
+class ValidatingCallbacks : public ParserCallbacks {
+public:
+  CallbackResult onMessageBegin() override { return CallbackResult::Success; }
+  CallbackResult onUrl(const char*, size_t) override { return CallbackResult::Success; }
+  CallbackResult onStatus(const char*, size_t) override { return CallbackResult::Success; }
+  CallbackResult onHeaderField(const char*, size_t) override { return CallbackResult::Success; }
+  CallbackResult onHeaderValue(const char* data, size_t length) override {
+    return HeaderUtility::headerValueIsValid({data, length}) ? CallbackResult::Success
+                                                             : CallbackResult::Error;
+  }
+  CallbackResult onHeadersComplete() override { return CallbackResult::Success; }
+  void bufferBody(const char*, size_t) override {}
+  CallbackResult onMessageComplete() override {
+    ++messages_;
+    return CallbackResult::Success;
+  }
+  void onChunkHeader(bool) override {}
+
+  uint64_t messages_{};
+};
+
+// A request with only the headers which curl sends.
+std::string minimalRequest() {
+  return "GET /index.html HTTP/1.1\r\n"
+         "Host: www.example.com\r\n"
+         "User-Agent: curl/8.5.0\r\n"
+         "Accept: */*\r\n"
+         "\r\n";
+}
+
+// A browser navigation, with long cookie, user agent and client hint values.
+std::string browserRequest() {
+  return absl::StrCat(
+      "GET /products/catalog/search?q=running+shoes&size=10&color=blue&page=2 HTTP/1.1\r\n"
+      "Host: shop.example.com\r\n"
+      "Connection: keep-alive\r\n"
+      "sec-ch-ua: \"Chromium\";v=\"124\", \"Google Chrome\";v=\"124\", \"Not-A.Brand\";v=\"99\"\r\n"
+      "sec-ch-ua-mobile: ?0\r\n"
+      "sec-ch-ua-platform: \"Linux\"\r\n"
+      "Upgrade-Insecure-Requests: 1\r\n"
+      "User-Agent: Mozilla/5.0 (X11; Linux x86_64) AppleWebKit/537.36 (KHTML, like Gecko) "
+      "Chrome/124.0.0.0 Safari/537.36\r\n"
+      "Accept: text/html,application/xhtml+xml,application/xml;q=0.9,image/avif,image/webp,"
+      "image/apng,*/*;q=0.8,application/signed-exchange;v=b3;q=0.7\r\n"
+      "Sec-Fetch-Site: same-origin\r\n"
+      "Sec-Fetch-Mode: navigate\r\n"
+      "Sec-Fetch-User: ?1\r\n"
+      "Sec-Fetch-Dest: document\r\n"
+      "Referer: https://shop.example.com/products/catalog?category=footwear\r\n"
+      "Accept-Encoding: gzip, deflate, br, zstd\r\n"
+      "Accept-Language: en-US,en;q=0.9,de;q=0.8\r\n"
+      "Cookie: session_id=",
+      std::string(64, 'a'), "; csrftoken=", std::string(32, 'b'),
+      "; _ga=GA1.2.1234567890.1700000000; preferences=", std::string(200, 'c'), "\r\n\r\n");
+}
+
+// An API call through a gateway, with a bearer token and tracing headers.
+std::string apiRequest() {
+  return absl::StrCat("POST /v1/accounts/12345/transactions HTTP/1.1\r\n"
+                      "Host: api.example.com\r\n"
+                      "Content-Type: application/json\r\n"
+                      "Accept: application/json\r\n"
+                      "Authorization: Bearer ",
+                      std::string(800, 'e'),
+                      "\r\n"
+                      "X-Request-Id: 2f1e6b5c-8d3a-4e7f-9b2c-1a0d3e5f7a9b\r\n"
+                      "traceparent: 00-4bf92f3577b34da6a3ce929d0e0e4736-00f067aa0ba902b7-01\r\n"
+                      "X-Forwarded-For: 203.0.113.195, 70.41.3.18, 150.172.238.178\r\n"
+                      "X-Forwarded-Proto: https\r\n"
+                      "Idempotency-Key: 8e03978e-40d5-43e8-bc93-6894a57f9324\r\n"
+                      "Content-Length: 2\r\n"
+                      "\r\n"
+                      "{}");
+}
+
+void parseRequests(benchmark::State& state, const std::string& request) {
+  ValidatingCallbacks callbacks;
+  BalsaParser parser(MessageType::Request, &callbacks, 80 * 1024, /*enable_trailers=*/false,
+                     /*allow_custom_methods=*/false);
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    const size_t parsed = parser.execute(request.data(), request.size());
+    RELEASE_ASSERT(parsed == request.size() && parser.getStatus() == ParserStatus::Ok, "");
+  }
+  RELEASE_ASSERT(callbacks.messages_ == state.iterations(), "");
+  state.SetBytesProcessed(state.iterations() * request.size());
+}
+
+void parseMinimalRequest(benchmark::State& state) { parseRequests(state, minimalRequest()); }
+BENCHMARK(parseMinimalRequest);
+
+void parseBrowserRequest(benchmark::State& state) { parseRequests(state, browserRequest()); }
+BENCHMARK(parseBrowserRequest);
+
+void parseApiRequest(benchmark::State& state) { parseRequests(state, apiRequest()); }
+BENCHMARK(parseApiRequest);
+
+// Validation of a single header value of the given length.
+void validateHeaderValue(benchmark::State& state) {
+  const std::string value(state.range(0), 'v');
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    benchmark::DoNotOptimize(HeaderUtility::headerValueIsValid(value));
+  }
+  state.SetBytesProcessed(state.iterations() * value.size());
+}
+BENCHMARK(validateHeaderValue)->Arg(8)->Arg(32)->Arg(128)->Arg(1024);
+
+} // namespace
+} // namespace Http1
+} // namespace Http
+} // namespace Envoy
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <sys/socket.h>
 
 #include "source/common/io/io_uring_worker_impl.h"
@@ -33,8 +34,10 @@ public:
 
 class IoUringWorkerTestImpl : public IoUringWorkerImpl {
 public:
-  IoUringWorkerTestImpl(IoUringPtr io_uring_instance, Event::Dispatcher& dispatcher)
-      : IoUringWorkerImpl(std::move(io_uring_instance), 8192, 1000, dispatcher) {}
+  IoUringWorkerTestImpl(IoUringPtr io_uring_instance, Event::Dispatcher& dispatcher,
+                        uint32_t provided_buffer_count = 0, bool enable_batched_submission = false)
+      : IoUringWorkerImpl(std::move(io_uring_instance), 8192, 1000, provided_buffer_count,
+                          enable_batched_submission, dispatcher) {}
 
   IoUringSocket& addTestSocket(os_fd_t fd) {
     return addSocket(std::make_unique<IoUringSocketTestImpl>(fd, *this));
@@ -335,6 +338,270 @@ TEST(IoUringWorkerImplTest, ServerSocketInjectAfterRead) {
   EXPECT_EQ(0, worker.getSockets().size());
 }
 
+// Sockets receive into the buffers provided by the worker with a multishot request, and fall back
+// to a read into their own buffer when the provided buffers run out.
+TEST(IoUringWorkerImplTest, ServerSocketReceiveIntoProvidedBuffers) {
+  Event::MockDispatcher dispatcher;
+  IoUringPtr io_uring_instance = std::make_unique<MockIoUring>();
+  MockIoUring& mock_io_uring = *dynamic_cast<MockIoUring*>(io_uring_instance.get());
+  Event::FileReadyCb file_event_callback;
+
+  EXPECT_CALL(mock_io_uring, registerEventfd());
+  EXPECT_CALL(dispatcher,
+              createFileEvent_(_, _, Event::PlatformDefaultTriggerType, Event::FileReadyType::Read))
+      .WillOnce(
+          DoAll(SaveArg<1>(&file_event_callback), ReturnNew<NiceMock<Event::MockFileEvent>>()));
+  // The count is rounded down to a power of 2.
+  EXPECT_CALL(mock_io_uring, registerBufferRing(0, 4)).WillOnce(Return(IoUringResult::Ok));
+  std::vector<uint8_t*> buffers(4);
+  EXPECT_CALL(mock_io_uring, provideBuffer(0, _, _, 8192))
+      .Times(4)
+      .WillRepeatedly(Invoke([&buffers](uint16_t, uint16_t buffer_id, uint8_t* buf, uint32_t) {
+        buffers[buffer_id] = buf;
+        return IoUringResult::Ok;
+      }));
+  auto worker =
+      std::make_unique<IoUringWorkerTestImpl>(std::move(io_uring_instance), dispatcher, 6);
+
+  os_fd_t fd = 11;
+  SET_SOCKET_INVALID(fd);
+
+  Request* recv_req = nullptr;
+  EXPECT_CALL(mock_io_uring, prepareRecvMultishot(fd, 0, _))
+      .WillOnce(DoAll(SaveArg<2>(&recv_req), Return<IoUringResult>(IoUringResult::Ok)));
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  std::string received;
+  IoUringSocket* socket = nullptr;
+  socket = &worker->addServerSocket(
+      fd,
+      [&socket, &received](uint32_t events) {
+        EXPECT_EQ(Event::FileReadyType::Read, events);
+        Buffer::Instance& buf = socket->getReadParam()->buf_;
+        received.append(buf.toString());
+        buf.drain(buf.length());
+        return absl::OkStatus();
+      },
+      false);
+
+  // The data arrives in buffer 2, which is put back into the ring once the handler drained it. The
+  // request is still in flight, so no new read is submitted.
+  std::copy_n("hello", 5, buffers[2]);
+  EXPECT_CALL(mock_io_uring, forEveryCompletion(_))
+      .WillOnce(Invoke([&recv_req](const CompletionCb& cb) {
+        recv_req->setCompletionFlags(IORING_CQE_F_BUFFER | (2 << IORING_CQE_BUFFER_SHIFT) |
+                                     IORING_CQE_F_MORE);
+        cb(recv_req, 5, false);
+      }));
+  EXPECT_CALL(mock_io_uring, provideBuffer(0, 2, buffers[2], 8192))
+      .WillOnce(Return(IoUringResult::Ok));
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  ASSERT_TRUE(file_event_callback(Event::FileReadyType::Read).ok());
+  EXPECT_EQ("hello", received);
+
+  // The ring runs dry, which ends the multishot request, and the socket reads into its own buffer.
+  Request* read_req = nullptr;
+  EXPECT_CALL(mock_io_uring, forEveryCompletion(_))
+      .WillOnce(Invoke([&recv_req](const CompletionCb& cb) {
+        recv_req->setCompletionFlags(0);
+        cb(recv_req, -ENOBUFS, false);
+      }));
+  EXPECT_CALL(mock_io_uring, prepareReadv(fd, _, _, _, _))
+      .WillOnce(DoAll(SaveArg<4>(&read_req), Return<IoUringResult>(IoUringResult::Ok)));
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  ASSERT_TRUE(file_event_callback(Event::FileReadyType::Read).ok());
+
+  // The read completes and the next receive goes back to the ring.
+  EXPECT_CALL(mock_io_uring, forEveryCompletion(_))
+      .WillOnce(Invoke([&read_req](const CompletionCb& cb) { cb(read_req, 5, false); }));
+  EXPECT_CALL(mock_io_uring, prepareRecvMultishot(fd, 0, _))
+      .WillOnce(DoAll(SaveArg<2>(&recv_req), Return<IoUringResult>(IoUringResult::Ok)));
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  ASSERT_TRUE(file_event_callback(Event::FileReadyType::Read).ok());
+  EXPECT_EQ(10, received.size());
+
+  // The worker closes the socket and unregisters the ring on destruction.
+  Request* cancel_req = nullptr;
+  EXPECT_CALL(mock_io_uring, prepareCancel(_, _))
+      .WillOnce(DoAll(SaveArg<1>(&cancel_req), Return<IoUringResult>(IoUringResult::Ok)))
+      .RetiresOnSaturation();
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  EXPECT_CALL(mock_io_uring, forEveryCompletion(_))
+      .WillOnce(Invoke([&mock_io_uring, fd, &recv_req, &cancel_req](const CompletionCb& cb) {
+        Request* close_req = nullptr;
+        EXPECT_CALL(mock_io_uring, prepareClose(fd, _))
+            .WillOnce(DoAll(SaveArg<1>(&close_req), Return<IoUringResult>(IoUringResult::Ok)))
+            .RetiresOnSaturation();
+        EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+        EXPECT_CALL(mock_io_uring, removeInjectedCompletion(fd));
+        recv_req->setCompletionFlags(0);
+        cb(recv_req, -ECANCELED, false);
+        cb(cancel_req, 0, false);
+        cb(close_req, 0, false);
+      }));
+  EXPECT_CALL(mock_io_uring, unregisterBufferRing(0));
+  EXPECT_CALL(dispatcher, deferredDelete_);
+  EXPECT_CALL(dispatcher, clearDeferredDeleteList());
+  worker.reset();
+}
+
+// Without kernel support for provided buffer rings, sockets read into their own buffers.
+TEST(IoUringWorkerImplTest, ProvidedBuffersUnsupported) {
+  Event::MockDispatcher dispatcher;
+  IoUringPtr io_uring_instance = std::make_unique<MockIoUring>();
+  MockIoUring& mock_io_uring = *dynamic_cast<MockIoUring*>(io_uring_instance.get());
+
+  EXPECT_CALL(mock_io_uring, registerEventfd());
+  EXPECT_CALL(dispatcher, createFileEvent_(_, _, Event::PlatformDefaultTriggerType,
+                                           Event::FileReadyType::Read));
+  EXPECT_CALL(mock_io_uring, registerBufferRing(0, 8)).WillOnce(Return(IoUringResult::Failed));
+  EXPECT_CALL(mock_io_uring, provideBuffer(_, _, _, _)).Times(0);
+  IoUringWorkerTestImpl worker(std::move(io_uring_instance), dispatcher, 8);
+
+  os_fd_t fd;
+  SET_SOCKET_INVALID(fd);
+  auto& io_uring_socket = worker.addTestSocket(fd);
+  EXPECT_CALL(mock_io_uring, prepareReadv(fd, _, _, _, _))
+      .WillOnce(Return<IoUringResult>(IoUringResult::Ok));
+  EXPECT_CALL(mock_io_uring, submit());
+  delete worker.submitReadRequest(io_uring_socket);
+
+  EXPECT_CALL(mock_io_uring, unregisterBufferRing(_)).Times(0);
+  EXPECT_CALL(mock_io_uring, removeInjectedCompletion(fd));
+  EXPECT_CALL(dispatcher, deferredDelete_);
+  dynamic_cast<IoUringSocketTestImpl*>(worker.getSockets().front().get())->cleanupForTest();
+  EXPECT_CALL(dispatcher, clearDeferredDeleteList());
+}
+
+// The requests prepared in a dispatcher iteration are submitted together at its end.
+TEST(IoUringWorkerImplTest, BatchedSubmission) {
+  Event::MockDispatcher dispatcher;
+  IoUringPtr io_uring_instance = std::make_unique<MockIoUring>();
+  MockIoUring& mock_io_uring = *dynamic_cast<MockIoUring*>(io_uring_instance.get());
+
+  EXPECT_CALL(mock_io_uring, registerEventfd());
+  EXPECT_CALL(dispatcher, createFileEvent_(_, _, Event::PlatformDefaultTriggerType,
+                                           Event::FileReadyType::Read));
+  auto* submit_cb = new NiceMock<Event::MockSchedulableCallback>(&dispatcher);
+  IoUringWorkerTestImpl worker(std::move(io_uring_instance), dispatcher, 0, true);
+
+  os_fd_t fd;
+  SET_SOCKET_INVALID(fd);
+  auto& io_uring_socket = worker.addTestSocket(fd);
+
+  EXPECT_CALL(mock_io_uring, prepareReadv(fd, _, _, _, _))
+      .Times(2)
+      .WillRepeatedly(Return<IoUringResult>(IoUringResult::Ok));
+  EXPECT_CALL(mock_io_uring, submit()).Times(0);
+  EXPECT_CALL(*submit_cb, scheduleCallbackCurrentIteration()).Times(2);
+  delete worker.submitReadRequest(io_uring_socket);
+  delete worker.submitReadRequest(io_uring_socket);
+  testing::Mock::VerifyAndClearExpectations(&mock_io_uring);
+
+  EXPECT_CALL(mock_io_uring, submit());
+  submit_cb->invokeCallback();
+
+  // A full submission queue is still flushed right away.
+  EXPECT_CALL(mock_io_uring, prepareReadv(fd, _, _, _, _))
+      .WillOnce(Return<IoUringResult>(IoUringResult::Failed))
+      .WillOnce(Return<IoUringResult>(IoUringResult::Ok));
+  EXPECT_CALL(mock_io_uring, submit());
+  delete worker.submitReadRequest(io_uring_socket);
+
+  // Pending requests are submitted when the worker goes away.
+  EXPECT_CALL(mock_io_uring, submit());
+  EXPECT_CALL(mock_io_uring, removeInjectedCompletion(fd));
+  EXPECT_CALL(dispatcher, deferredDelete_);
+  dynamic_cast<IoUringSocketTestImpl*>(worker.getSockets().front().get())->cleanupForTest();
+  EXPECT_CALL(dispatcher, clearDeferredDeleteList());
+}
+
+// A listening socket accepts connections with a multishot request and hands them to the listener
+// on the read event.
+TEST(IoUringWorkerImplTest, AcceptSocket) {
+  Event::MockDispatcher dispatcher;
+  IoUringPtr io_uring_instance = std::make_unique<MockIoUring>();
+  MockIoUring& mock_io_uring = *dynamic_cast<MockIoUring*>(io_uring_instance.get());
+  Event::FileReadyCb file_event_callback;
+
+  EXPECT_CALL(mock_io_uring, registerEventfd());
+  EXPECT_CALL(dispatcher,
+              createFileEvent_(_, _, Event::PlatformDefaultTriggerType, Event::FileReadyType::Read))
+      .WillOnce(
+          DoAll(SaveArg<1>(&file_event_callback), ReturnNew<NiceMock<Event::MockFileEvent>>()));
+  IoUringWorkerTestImpl worker(std::move(io_uring_instance), dispatcher);
+
+  os_fd_t fd = 11;
+  SET_SOCKET_INVALID(fd);
+
+  Request* accept_req = nullptr;
+  EXPECT_CALL(mock_io_uring, prepareAcceptMultishot(fd, _))
+      .WillOnce(DoAll(SaveArg<1>(&accept_req), Return<IoUringResult>(IoUringResult::Ok)));
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  std::vector<os_fd_t> accepted;
+  IoUringSocket* socket = nullptr;
+  socket = &worker.addAcceptSocket(
+      fd,
+      [&socket, &accepted](uint32_t events) {
+        EXPECT_EQ(Event::FileReadyType::Read, events);
+        for (os_fd_t accepted_fd = socket->takeAcceptedSocket(); SOCKET_VALID(accepted_fd);
+             accepted_fd = socket->takeAcceptedSocket()) {
+          accepted.push_back(accepted_fd);
+        }
+        return absl::OkStatus();
+      },
+      false);
+
+  // Two connections are accepted by the request, which stays in flight.
+  EXPECT_CALL(mock_io_uring, forEveryCompletion(_))
+      .WillOnce(Invoke([&accept_req](const CompletionCb& cb) {
+        accept_req->setCompletionFlags(IORING_CQE_F_MORE);
+        cb(accept_req, 20, false);
+        cb(accept_req, 21, false);
+      }));
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  ASSERT_TRUE(file_event_callback(Event::FileReadyType::Read).ok());
+  EXPECT_EQ((std::vector<os_fd_t>{20, 21}), accepted);
+
+  // A kernel without multishot accept fails the request, then each request accepts once.
+  EXPECT_CALL(mock_io_uring, forEveryCompletion(_))
+      .WillOnce(Invoke([&accept_req](const CompletionCb& cb) {
+        accept_req->setCompletionFlags(0);
+        cb(accept_req, -EINVAL, false);
+      }));
+  EXPECT_CALL(mock_io_uring, prepareAccept(fd, nullptr, nullptr, _))
+      .WillOnce(DoAll(SaveArg<3>(&accept_req), Return<IoUringResult>(IoUringResult::Ok)));
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  ASSERT_TRUE(file_event_callback(Event::FileReadyType::Read).ok());
+
+  // Closing cancels the accept request before closing the fd.
+  Request* cancel_req = nullptr;
+  EXPECT_CALL(mock_io_uring, prepareCancel(accept_req, _))
+      .WillOnce(DoAll(SaveArg<1>(&cancel_req), Return<IoUringResult>(IoUringResult::Ok)));
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  socket->close(false);
+
+  Request* close_req = nullptr;
+  EXPECT_CALL(mock_io_uring, forEveryCompletion(_))
+      .WillOnce(Invoke([&accept_req, &cancel_req](const CompletionCb& cb) {
+        cb(accept_req, -ECANCELED, false);
+        cb(cancel_req, 0, false);
+      }));
+  EXPECT_CALL(mock_io_uring, prepareClose(fd, _))
+      .WillOnce(DoAll(SaveArg<1>(&close_req), Return<IoUringResult>(IoUringResult::Ok)));
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  ASSERT_TRUE(file_event_callback(Event::FileReadyType::Read).ok());
+
+  EXPECT_CALL(mock_io_uring, forEveryCompletion(_))
+      .WillOnce(Invoke([&close_req](const CompletionCb& cb) { cb(close_req, 0, false); }));
+  EXPECT_CALL(mock_io_uring, removeInjectedCompletion(fd));
+  EXPECT_CALL(dispatcher, deferredDelete_);
+  EXPECT_CALL(mock_io_uring, submit()).Times(1).RetiresOnSaturation();
+  ASSERT_TRUE(file_event_callback(Event::FileReadyType::Read).ok());
+  EXPECT_EQ(0, worker.getSockets().size());
+
+  EXPECT_CALL(dispatcher, clearDeferredDeleteList());
+}
+
 TEST(IoUringWorkerImplTest, CloseAllSocketsWhenDestruction) {
   Event::MockDispatcher dispatcher;
   IoUringPtr io_uring_instance = std::make_unique<MockIoUring>();
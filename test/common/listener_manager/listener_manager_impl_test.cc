@@ -6364,6 +6364,18 @@ TEST_P(ListenerManagerImplWithRealFiltersTest, ReusePortListenerDisabled) {
   EXPECT_EQ(0, manager_->listeners().size());
 }
 
+TEST_P(ListenerManagerImplWithRealFiltersTest, ReusePortSteeringRequiresReusePort) {
+  auto listener = createIPv4Listener("ReusePortSteeringListener");
+  listener.mutable_enable_reuse_port()->set_value(false);
+  listener.mutable_reuse_port_steering()->set_mode(
+      envoy::config::listener::v3::Listener::ReusePortSteering::SOURCE_ADDRESS_HASH);
+
+  EXPECT_THROW_WITH_MESSAGE(addOrUpdateListener(listener), EnvoyException,
+                            "listener ReusePortSteeringListener: reuse_port_steering can only be "
+                            "used with TCP listeners using reuse_port");
+  EXPECT_EQ(0, manager_->listeners().size());
+}
+
 // Envoy throws exceptions for UDP listener with dynamic filter config.
 TEST_P(ListenerManagerImplWithRealFiltersTest, UdpListenerWithDynamicFilterConfig) {
   auto listener = createIPv4Listener("UdpListener");
@@ -7164,6 +7176,20 @@ TEST_P(ListenerManagerImplWithDispatcherStatsTest, DispatherStatsWithCorrectPref
   ASSERT_TRUE(manager_->startWorkers(guard_dog_, callback_.AsStdFunction()).ok());
 }
 
+// Validate that workers busy poll as configured in the bootstrap.
+TEST_P(ListenerManagerImplTest, WorkerBusyPoll) {
+  auto& busy_poll = *server_.bootstrap_.mutable_worker_busy_poll();
+  busy_poll.mutable_spin_duration()->set_nanos(50000);
+  busy_poll.mutable_max_idle_spin_cpu()->set_value(20);
+  EXPECT_CALL(*worker_, start(_, _));
+  EXPECT_CALL(*worker_, enableBusyPoll(_, _))
+      .WillOnce(Invoke([](const Event::BusyPollConfig& config, Stats::Scope&) {
+        EXPECT_EQ(std::chrono::microseconds(50), config.spin_duration_);
+        EXPECT_DOUBLE_EQ(0.2, config.max_idle_spin_fraction_);
+      }));
+  ASSERT_TRUE(manager_->startWorkers(guard_dog_, callback_.AsStdFunction()).ok());
+}
+
 TEST_P(ListenerManagerImplWithRealFiltersTest, ApiListener) {
   const std::string yaml = R"EOF(
 name: test_api_listener
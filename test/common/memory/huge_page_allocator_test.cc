@@ -0,0 +1,73 @@
+#include <cstdint>
+#include <vector>
+
+#include "source/common/memory/huge_page_allocator.h"
+#include "source/common/memory/stats.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Memory {
+namespace {
+
+class HugePageAllocatorTest : public testing::Test {
+protected:
+  ~HugePageAllocatorTest() override { HugePageRegions::setEnabled(false); }
+};
+
+TEST_F(HugePageAllocatorTest, DisabledUsesHeap) {
+  ASSERT_FALSE(HugePageRegions::enabled());
+  void* p = HugePageRegions::allocate(HugePageRegions::HugePageSize);
+  EXPECT_EQ(0, HugePageRegions::mappedBytes());
+  HugePageRegions::deallocate(p, HugePageRegions::HugePageSize);
+}
+
+TEST_F(HugePageAllocatorTest, SmallAllocationsUseHeap) {
+  HugePageRegions::setEnabled(true);
+  void* p = HugePageRegions::allocate(HugePageRegions::MinRegionAllocation - 1);
+  EXPECT_EQ(0, HugePageRegions::mappedBytes());
+  HugePageRegions::deallocate(p, HugePageRegions::MinRegionAllocation - 1);
+}
+
+#if defined(__linux__)
+TEST_F(HugePageAllocatorTest, LargeAllocationsAreAlignedRegions) {
+  HugePageRegions::setEnabled(true);
+  const size_t bytes = HugePageRegions::HugePageSize + 1;
+  uint8_t* p = static_cast<uint8_t*>(HugePageRegions::allocate(bytes));
+  EXPECT_EQ(0, reinterpret_cast<uintptr_t>(p) % HugePageRegions::HugePageSize);
+  // Rounded up to whole huge pages.
+  EXPECT_EQ(2 * HugePageRegions::HugePageSize, HugePageRegions::mappedBytes());
+  EXPECT_EQ(2 * HugePageRegions::HugePageSize, Stats::totalHugePageRegionBytes());
+  p[0] = 1;
+  p[bytes - 1] = 1;
+
+  // Regions are unmapped even if huge page regions were disabled in the meantime.
+  HugePageRegions::setEnabled(false);
+  HugePageRegions::deallocate(p, bytes);
+  EXPECT_EQ(0, HugePageRegions::mappedBytes());
+}
+
+TEST_F(HugePageAllocatorTest, HalfHugePageAllocationIsRoundedUp) {
+  HugePageRegions::setEnabled(true);
+  void* p = HugePageRegions::allocate(HugePageRegions::MinRegionAllocation);
+  EXPECT_EQ(0, reinterpret_cast<uintptr_t>(p) % HugePageRegions::HugePageSize);
+  EXPECT_EQ(HugePageRegions::HugePageSize, HugePageRegions::mappedBytes());
+  HugePageRegions::deallocate(p, HugePageRegions::MinRegionAllocation);
+  EXPECT_EQ(0, HugePageRegions::mappedBytes());
+}
+
+TEST_F(HugePageAllocatorTest, AllocationInVector) {
+  HugePageRegions::setEnabled(true);
+  {
+    std::vector<uint64_t, HugePageAllocator<uint64_t>> table(HugePageRegions::HugePageSize, 1);
+    EXPECT_EQ(0, reinterpret_cast<uintptr_t>(table.data()) % HugePageRegions::HugePageSize);
+    EXPECT_EQ(table.size() * sizeof(uint64_t), HugePageRegions::mappedBytes());
+    EXPECT_EQ(1, table.back());
+  }
+  EXPECT_EQ(0, HugePageRegions::mappedBytes());
+}
+#endif
+
+} // namespace
+} // namespace Memory
+} // namespace Envoy
@@ -0,0 +1,156 @@
+#include "source/common/network/connection_balancer_impl.h"
+
+#include "test/mocks/api/mocks.h"
+#include "test/mocks/filesystem/mocks.h"
+#include "test/mocks/network/mocks.h"
+#include "test/test_common/threadsafe_singleton_injector.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+using testing::_;
+using testing::DoAll;
+using testing::ElementsAre;
+using testing::NiceMock;
+using testing::Return;
+using testing::SetArgPointee;
+
+namespace Envoy {
+namespace Network {
+namespace {
+
+class TestBalancedConnectionHandler : public BalancedConnectionHandler {
+public:
+  // Network::BalancedConnectionHandler
+  uint64_t numConnections() const override { return num_connections_; }
+  void incNumConnections() override { ++num_connections_; }
+  void post(ConnectionSocketPtr&&) override {}
+  void onAcceptWorker(ConnectionSocketPtr&&, bool, bool,
+                      const absl::optional<std::string>&) override {}
+
+  uint64_t num_connections_{};
+};
+
+TEST(CpuAffinityConnectionBalancerTest, ParseCpuList) {
+  EXPECT_THAT(CpuAffinityConnectionBalancerImpl::parseCpuList("0-3,8,10-11\n"),
+              ElementsAre(0, 1, 2, 3, 8, 10, 11));
+  EXPECT_THAT(CpuAffinityConnectionBalancerImpl::parseCpuList("5"), ElementsAre(5));
+  EXPECT_TRUE(CpuAffinityConnectionBalancerImpl::parseCpuList("").empty());
+  EXPECT_TRUE(CpuAffinityConnectionBalancerImpl::parseCpuList("3-1").empty());
+  EXPECT_TRUE(CpuAffinityConnectionBalancerImpl::parseCpuList("a-b").empty());
+}
+
+TEST(CpuAffinityConnectionBalancerTest, ReadNumaTopology) {
+  NiceMock<Filesystem::MockInstance> file_system;
+  EXPECT_CALL(file_system, fileReadToEnd("/sys/devices/system/node/online"))
+      .WillOnce(Return(std::string("0-1\n")));
+  EXPECT_CALL(file_system, fileReadToEnd("/sys/devices/system/node/node0/cpulist"))
+      .WillOnce(Return(std::string("0-1\n")));
+  EXPECT_CALL(file_system, fileReadToEnd("/sys/devices/system/node/node1/cpulist"))
+      .WillOnce(Return(std::string("2,3\n")));
+  EXPECT_EQ((CpuAffinityConnectionBalancerImpl::CpuToNodeMap{{0, 0}, {1, 0}, {2, 1}, {3, 1}}),
+            CpuAffinityConnectionBalancerImpl::readNumaTopology(file_system));
+
+  EXPECT_CALL(file_system, fileReadToEnd("/sys/devices/system/node/online"))
+      .WillOnce(Return(absl::NotFoundError("no NUMA")));
+  EXPECT_TRUE(CpuAffinityConnectionBalancerImpl::readNumaTopology(file_system).empty());
+}
+
+#if defined(__linux__) && defined(SO_INCOMING_CPU)
+class CpuAffinityConnectionBalancerImplTest : public testing::Test {
+protected:
+  // Two nodes of two CPUs each.
+  CpuAffinityConnectionBalancerImplTest() : balancer_({{0, 0}, {1, 0}, {2, 1}, {3, 1}}) {}
+
+  void registerOnCpus(TestBalancedConnectionHandler& handler, std::vector<int> cpus) {
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+    for (int cpu : cpus) {
+      CPU_SET(cpu, &mask);
+    }
+    EXPECT_CALL(linux_os_sys_calls_, sched_getaffinity(0, _, _))
+        .WillOnce(DoAll(SetArgPointee<2>(mask), Return(Api::SysCallIntResult{0, 0})));
+    balancer_.registerHandler(handler);
+  }
+
+  BalancedConnectionHandler& pick(TestBalancedConnectionHandler& current_handler,
+                                  int incoming_cpu) {
+    EXPECT_CALL(socket_, getSocketOption(SOL_SOCKET, SO_INCOMING_CPU, _, _))
+        .WillOnce([incoming_cpu](int, int, void* value, socklen_t*) {
+          *static_cast<int*>(value) = incoming_cpu;
+          return Api::SysCallIntResult{0, 0};
+        });
+    return balancer_.pickTargetHandler(current_handler, socket_);
+  }
+
+  Api::MockLinuxOsSysCalls linux_os_sys_calls_;
+  TestThreadsafeSingletonInjector<Api::LinuxOsSysCallsImpl> linux_os_calls_{&linux_os_sys_calls_};
+  NiceMock<MockConnectionSocket> socket_;
+  CpuAffinityConnectionBalancerImpl balancer_;
+};
+
+TEST_F(CpuAffinityConnectionBalancerImplTest, SteersToIncomingCpu) {
+  TestBalancedConnectionHandler handler0;
+  TestBalancedConnectionHandler handler2;
+  registerOnCpus(handler0, {0});
+  registerOnCpus(handler2, {2});
+
+  EXPECT_EQ(&handler2, &pick(handler0, 2));
+  EXPECT_EQ(&handler0, &pick(handler2, 0));
+  EXPECT_EQ(&handler2, &pick(handler2, 2));
+  EXPECT_EQ(1, handler0.numConnections());
+  EXPECT_EQ(2, handler2.numConnections());
+
+  balancer_.unregisterHandler(handler0);
+  balancer_.unregisterHandler(handler2);
+}
+
+TEST_F(CpuAffinityConnectionBalancerImplTest, FallsBackToNode) {
+  TestBalancedConnectionHandler handler0;
+  TestBalancedConnectionHandler handler2;
+  TestBalancedConnectionHandler handler3;
+  registerOnCpus(handler0, {0});
+  registerOnCpus(handler2, {2});
+  registerOnCpus(handler3, {3});
+
+  // No handler runs on CPU 1, but one does on its node.
+  EXPECT_EQ(&handler0, &pick(handler2, 1));
+
+  // A handler on the node keeps the connection, otherwise the least loaded one on it is picked.
+  handler2.num_connections_ = 10;
+  balancer_.unregisterHandler(handler3);
+  registerOnCpus(handler3, {2, 3});
+  EXPECT_EQ(&handler2, &pick(handler2, 2));
+  EXPECT_EQ(&handler3, &pick(handler0, 3));
+  EXPECT_EQ(1, handler3.numConnections());
+
+  balancer_.unregisterHandler(handler0);
+  balancer_.unregisterHandler(handler2);
+  balancer_.unregisterHandler(handler3);
+}
+
+TEST_F(CpuAffinityConnectionBalancerImplTest, StaysOnCurrentHandler) {
+  TestBalancedConnectionHandler handler0;
+  TestBalancedConnectionHandler unpinned;
+  registerOnCpus(handler0, {0});
+  // Spans both nodes, so the handler is placed nowhere.
+  registerOnCpus(unpinned, {1, 2});
+
+  // Nothing is placed on node 1.
+  EXPECT_EQ(&unpinned, &pick(unpinned, 3));
+
+  // The incoming CPU is unknown.
+  EXPECT_EQ(&unpinned, &pick(unpinned, -1));
+  EXPECT_CALL(socket_, getSocketOption(SOL_SOCKET, SO_INCOMING_CPU, _, _))
+      .WillOnce(Return(Api::SysCallIntResult{-1, ENOPROTOOPT}));
+  EXPECT_EQ(&unpinned, &balancer_.pickTargetHandler(unpinned, socket_));
+  EXPECT_EQ(3, unpinned.numConnections());
+
+  balancer_.unregisterHandler(handler0);
+  balancer_.unregisterHandler(unpinned);
+}
+#endif
+
+} // namespace
+} // namespace Network
+} // namespace Envoy
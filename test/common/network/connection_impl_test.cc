@@ -359,6 +359,43 @@ TEST_P(ConnectionImplTest, GetCongestionWindow) {
   disconnect(true);
 }
 
+TEST_P(ConnectionImplTest, CanBypassBuffers) {
+  setUpBasicConnection();
+  connect();
+
+  // Both ends use the raw_buffer transport socket and have nothing buffered, but the server end
+  // has a write filter next to its read filter.
+  EXPECT_TRUE(client_connection_->canBypassBuffers());
+  EXPECT_FALSE(server_connection_->canBypassBuffers());
+
+  // A single read filter does not prevent bypassing the buffers, a second one does.
+  auto read_filter = std::make_shared<NiceMock<MockReadFilter>>();
+  client_connection_->addReadFilter(read_filter);
+  EXPECT_TRUE(client_connection_->canBypassBuffers());
+  client_connection_->addReadFilter(std::make_shared<NiceMock<MockReadFilter>>());
+  EXPECT_FALSE(client_connection_->canBypassBuffers());
+  client_connection_->removeReadFilter(read_filter);
+  EXPECT_TRUE(client_connection_->canBypassBuffers());
+
+  // Written data stays in the write buffer until the next write event.
+  Buffer::OwnedImpl data("hello");
+  client_connection_->write(data, false);
+  EXPECT_FALSE(client_connection_->canBypassBuffers());
+
+  disconnect(false);
+}
+
+TEST_P(ConnectionImplTest, CanBypassBuffersNonRawTransportSocket) {
+  ConnectionMocks mocks = createConnectionMocks(false);
+  IoHandlePtr io_handle = std::make_unique<Network::Test::IoSocketHandlePlatformImpl>(0);
+  auto server_connection = std::make_unique<Network::ServerConnectionImpl>(
+      *mocks.dispatcher_,
+      std::make_unique<ConnectionSocketImpl>(std::move(io_handle), nullptr, nullptr),
+      std::move(mocks.transport_socket_), stream_info_);
+  EXPECT_FALSE(server_connection->canBypassBuffers());
+  server_connection->close(ConnectionCloseType::NoFlush);
+}
+
 TEST_P(ConnectionImplTest, CloseDuringConnectCallback) {
   setUpBasicConnection();
 
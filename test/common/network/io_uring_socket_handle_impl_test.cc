@@ -42,6 +42,70 @@ TEST_F(IoUringSocketHandleTest, CreateClientSocket) {
   EXPECT_EQ(IoUringSocketType::Client, impl.ioUringSocketType());
 }
 
+TEST_F(IoUringSocketHandleTest, AcceptWithFileEventIfNotEnabled) {
+  Api::MockOsSysCalls os_sys_calls;
+  TestThreadsafeSingletonInjector<Api::OsSysCallsImpl> os_calls(&os_sys_calls);
+  IoUringSocketHandleTestImpl impl(factory_, false);
+  EXPECT_CALL(os_sys_calls, setsocketblocking(_, false));
+  EXPECT_CALL(os_sys_calls, listen(_, 1));
+  impl.listen(1);
+  EXPECT_EQ(IoUringSocketType::Accept, impl.ioUringSocketType());
+
+  EXPECT_CALL(factory_, acceptEnabled()).WillOnce(testing::Return(false));
+  EXPECT_CALL(factory_, getIoUringWorker())
+      .WillOnce(testing::Return(OptRef<Io::IoUringWorker>(worker_)));
+  EXPECT_CALL(worker_, addAcceptSocket(_, _, _)).Times(0);
+  EXPECT_CALL(dispatcher_, createFileEvent_(_, _, _, Event::FileReadyType::Read));
+  impl.initializeFileEvent(
+      dispatcher_, [](uint32_t) { return absl::OkStatus(); }, Event::PlatformDefaultTriggerType,
+      Event::FileReadyType::Read);
+}
+
+TEST_F(IoUringSocketHandleTest, Accept) {
+  Api::MockOsSysCalls os_sys_calls;
+  TestThreadsafeSingletonInjector<Api::OsSysCallsImpl> os_calls(&os_sys_calls);
+  IoUringSocketHandleTestImpl impl(factory_, false);
+  EXPECT_CALL(os_sys_calls, setsocketblocking(_, false));
+  EXPECT_CALL(os_sys_calls, listen(_, 1));
+  impl.listen(1);
+
+  EXPECT_CALL(factory_, acceptEnabled()).WillOnce(testing::Return(true));
+  EXPECT_CALL(factory_, getIoUringWorker())
+      .WillOnce(testing::Return(OptRef<Io::IoUringWorker>(worker_)));
+  EXPECT_CALL(worker_, addAcceptSocket(_, _, _)).WillOnce(testing::ReturnRef(socket_));
+  impl.initializeFileEvent(
+      dispatcher_, [](uint32_t) { return absl::OkStatus(); }, Event::PlatformDefaultTriggerType,
+      Event::FileReadyType::Read);
+
+  sockaddr_storage addr;
+  socklen_t addrlen = sizeof(addr);
+
+  // No connection has been accepted yet.
+  EXPECT_CALL(socket_, takeAcceptedSocket()).WillOnce(testing::Return(INVALID_SOCKET));
+  EXPECT_EQ(nullptr, impl.accept(reinterpret_cast<sockaddr*>(&addr), &addrlen));
+  EXPECT_EQ(SOCKET_ERROR_AGAIN, errno);
+
+  // The peer address is looked up for the accepted connection.
+  const os_fd_t fd = ::socket(AF_INET, SOCK_STREAM, 0);
+  ASSERT_TRUE(SOCKET_VALID(fd));
+  EXPECT_CALL(socket_, takeAcceptedSocket()).WillOnce(testing::Return(fd));
+  EXPECT_CALL(os_sys_calls, getpeername(fd, _, _))
+      .WillOnce(testing::Return(Api::SysCallIntResult{0, 0}));
+  IoHandlePtr accepted = impl.accept(reinterpret_cast<sockaddr*>(&addr), &addrlen);
+  ASSERT_NE(nullptr, accepted);
+  EXPECT_EQ(fd, accepted->fdDoNotUse());
+  // The handle was created for a server socket, so it closes the fd directly when destroyed.
+  EXPECT_CALL(factory_, currentThreadRegistered()).WillOnce(testing::Return(false));
+  accepted.reset();
+
+  // The connection is closed if the peer has already gone away.
+  EXPECT_CALL(socket_, takeAcceptedSocket()).WillOnce(testing::Return(10));
+  EXPECT_CALL(os_sys_calls, getpeername(10, _, _))
+      .WillOnce(testing::Return(Api::SysCallIntResult{-1, ENOTCONN}));
+  EXPECT_CALL(os_sys_calls, close(10)).WillOnce(testing::Return(Api::SysCallIntResult{0, 0}));
+  EXPECT_EQ(nullptr, impl.accept(reinterpret_cast<sockaddr*>(&addr), &addrlen));
+}
+
 TEST_F(IoUringSocketHandleTest, ReadError) {
   IoUringSocketHandleTestImpl impl(factory_, false);
   EXPECT_CALL(worker_, addClientSocket(_, _, _)).WillOnce(testing::ReturnRef(socket_));
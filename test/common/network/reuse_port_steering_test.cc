@@ -0,0 +1,106 @@
+#include <vector>
+
+#include "source/common/network/address_impl.h"
+#include "source/common/network/listen_socket_impl.h"
+#include "source/common/network/reuse_port_steering.h"
+#include "source/common/network/socket_option_factory.h"
+#include "source/common/network/utility.h"
+
+#include "absl/strings/str_cat.h"
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Network {
+namespace {
+
+uint32_t hashOf(const std::string& address) {
+  return ReusePortSteering::sourceAddressHash(
+      *Utility::parseInternetAddressNoThrow(address)->ip());
+}
+
+TEST(ReusePortSteeringTest, SourceAddressHash) {
+  EXPECT_EQ(0x0a000001, hashOf("10.0.0.1"));
+  // Mapped addresses arrive in IPv4 packets.
+  EXPECT_EQ(hashOf("10.0.0.1"), hashOf("::ffff:10.0.0.1"));
+  EXPECT_NE(hashOf("2001:db8::1"), hashOf("2001:db8::2"));
+}
+
+TEST(ReusePortSteeringTest, PickBySourceAddressHashIsBalanced) {
+  constexpr uint32_t num_sockets = 8;
+  constexpr uint32_t num_hashes = 80000;
+  std::vector<uint32_t> counts(num_sockets);
+  for (uint32_t hash = 0; hash < num_hashes; ++hash) {
+    counts[ReusePortSteering::pickBySourceAddressHash(hash * 2654435761U, num_sockets)]++;
+  }
+  for (uint32_t count : counts) {
+    EXPECT_NEAR(num_hashes / num_sockets, count, num_hashes / num_sockets / 10);
+  }
+}
+
+// Adding a socket only moves hashes to the new socket.
+TEST(ReusePortSteeringTest, PickBySourceAddressHashIsConsistent) {
+  uint32_t moved = 0;
+  for (uint32_t hash = 0; hash < 10000; ++hash) {
+    const uint32_t before = ReusePortSteering::pickBySourceAddressHash(hash * 2654435761U, 4);
+    const uint32_t after = ReusePortSteering::pickBySourceAddressHash(hash * 2654435761U, 5);
+    if (before != after) {
+      EXPECT_EQ(4, after);
+      moved++;
+    }
+  }
+  EXPECT_NEAR(2000, moved, 300);
+}
+
+TEST(ReusePortSteeringTest, TooManySocketsForSourceAddressHash) {
+  EXPECT_EQ(nullptr, ReusePortSteering::createSocketOption(
+                         ReusePortSteering::Mode::SourceAddressHash,
+                         ReusePortSteering::MaxSourceAddressHashSockets + 1));
+}
+
+#if defined(__linux__) && defined(SO_ATTACH_REUSEPORT_CBPF)
+// Connects from several loopback addresses to a reuse_port group and checks that each connection
+// is accepted by the socket the program picks.
+TEST(ReusePortSteeringTest, SteersConnectionsBySourceAddress) {
+  constexpr uint32_t num_sockets = 4;
+  Socket::OptionConstSharedPtr steering = ReusePortSteering::createSocketOption(
+      ReusePortSteering::Mode::SourceAddressHash, num_sockets);
+  ASSERT_NE(nullptr, steering);
+
+  std::vector<TcpListenSocketPtr> sockets;
+  Address::InstanceConstSharedPtr address = Utility::parseInternetAddressNoThrow("127.0.0.1", 0);
+  for (uint32_t i = 0; i < num_sockets; ++i) {
+    sockets.push_back(std::make_unique<TcpListenSocket>(
+        address, SocketOptionFactory::buildReusePortOptions(), true));
+    address = sockets.back()->connectionInfoProvider().localAddress();
+    ASSERT_EQ(0, sockets.back()->ioHandle().listen(16).return_value_);
+    ASSERT_TRUE(steering->setOption(*sockets.back(),
+                                    envoy::config::core::v3::SocketOption::STATE_LISTENING));
+  }
+
+  for (int host = 2; host < 12; ++host) {
+    const std::string source = absl::StrCat("127.0.0.", host);
+    const uint32_t expected =
+        ReusePortSteering::pickBySourceAddressHash(hashOf(source), num_sockets);
+
+    const os_fd_t client = ::socket(AF_INET, SOCK_STREAM, 0);
+    ASSERT_NE(-1, client);
+    Address::InstanceConstSharedPtr source_address =
+        Utility::parseInternetAddressNoThrow(source, 0);
+    ASSERT_EQ(0, ::bind(client, source_address->sockAddr(), source_address->sockAddrLen()));
+    ASSERT_EQ(0, ::connect(client, address->sockAddr(), address->sockAddrLen()));
+
+    for (uint32_t i = 0; i < num_sockets; ++i) {
+      IoHandlePtr accepted = sockets[i]->ioHandle().accept(nullptr, nullptr);
+      EXPECT_EQ(i == expected, accepted != nullptr) << source << " on socket " << i;
+      if (accepted != nullptr) {
+        accepted->close();
+      }
+    }
+    ::close(client);
+  }
+}
+#endif
+
+} // namespace
+} // namespace Network
+} // namespace Envoy
@@ -6,6 +6,7 @@
 
 #include "test/mocks/server/instance.h"
 #include "test/mocks/stream_info/mocks.h"
+#include "test/test_common/test_runtime.h"
 #include "test/test_common/utility.h"
 
 #include "benchmark/benchmark.h"
@@ -204,8 +205,13 @@ static RouteConfiguration genPrefixMatcherTreeRouteConfig(benchmark::State& stat
  * We then time how long it takes for the request to be matched against the
  * last route.
  */
-static void bmRouteTableSize(benchmark::State& state, RouteMatch::PathSpecifierCase match_type) {
+static void bmRouteTableSize(benchmark::State& state, RouteMatch::PathSpecifierCase match_type,
+                             absl::string_view runtime_feature = "") {
   // Setup router for benchmarking.
+  TestScopedRuntime scoped_runtime;
+  if (!runtime_feature.empty()) {
+    scoped_runtime.mergeValues({{std::string(runtime_feature), "true"}});
+  }
   Api::ApiPtr api = Api::createApiForTest();
   NiceMock<Server::Configuration::MockServerFactoryContext> factory_context;
   NiceMock<Envoy::StreamInfo::MockStreamInfo> stream_info;
@@ -244,6 +250,22 @@ static void bmRouteTableSizeWithExactPathMatch(benchmark::State& state) {
   bmRouteTableSize(state, RouteMatch::PathSpecifierCase::kPath);
 }
 
+/**
+ * Benchmark the path prefix matchers of bmRouteTableSizeWithPathPrefixMatch with the route index.
+ */
+static void bmRouteTableSizeWithIndexedPathPrefixMatch(benchmark::State& state) {
+  bmRouteTableSize(state, RouteMatch::PathSpecifierCase::kPrefix,
+                   "envoy.reloadable_features.route_index");
+}
+
+/**
+ * Benchmark the exact path matchers of bmRouteTableSizeWithExactPathMatch with the route index.
+ */
+static void bmRouteTableSizeWithIndexedExactPathMatch(benchmark::State& state) {
+  bmRouteTableSize(state, RouteMatch::PathSpecifierCase::kPath,
+                   "envoy.reloadable_features.route_index");
+}
+
 /**
  * Benchmark a route table with regex path matchers in the form of:
  * - /shelves/{shelf_id}/route_1
@@ -256,6 +278,15 @@ static void bmRouteTableSizeWithRegexMatch(benchmark::State& state) {
   bmRouteTableSize(state, RouteMatch::PathSpecifierCase::kSafeRegex);
 }
 
+/**
+ * Benchmark the regex path matchers of bmRouteTableSizeWithRegexMatch with all routes matched by a
+ * single multi-pattern matcher, rather than one route after another.
+ */
+static void bmRouteTableSizeWithRegexSetMatch(benchmark::State& state) {
+  bmRouteTableSize(state, RouteMatch::PathSpecifierCase::kSafeRegex,
+                   "envoy.reloadable_features.regex_route_sets");
+}
+
 /**
  * Benchmark matcher tree route matching performance with exact path matchers in the form of:
  * - /shelves/shelf_1/route_1
@@ -313,7 +344,10 @@ static void bmRouteTableSizeWithPrefixMatcherTree(benchmark::State& state) {
 
 BENCHMARK(bmRouteTableSizeWithPathPrefixMatch)->RangeMultiplier(2)->Ranges({{1, 2 << 13}});
 BENCHMARK(bmRouteTableSizeWithExactPathMatch)->RangeMultiplier(2)->Ranges({{1, 2 << 13}});
+BENCHMARK(bmRouteTableSizeWithIndexedPathPrefixMatch)->RangeMultiplier(2)->Ranges({{1, 2 << 13}});
+BENCHMARK(bmRouteTableSizeWithIndexedExactPathMatch)->RangeMultiplier(2)->Ranges({{1, 2 << 13}});
 BENCHMARK(bmRouteTableSizeWithRegexMatch)->RangeMultiplier(2)->Ranges({{1, 2 << 13}});
+BENCHMARK(bmRouteTableSizeWithRegexSetMatch)->RangeMultiplier(2)->Ranges({{1, 2 << 13}});
 
 BENCHMARK(bmRouteTableSizeWithExactMatcherTree)->RangeMultiplier(2)->Ranges({{1, 2 << 13}});
 BENCHMARK(bmRouteTableSizeWithPrefixMatcherTree)->RangeMultiplier(2)->Ranges({{1, 2 << 13}});
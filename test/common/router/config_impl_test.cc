@@ -20,6 +20,7 @@
 #include "source/common/network/address_impl.h"
 #include "source/common/router/config_impl.h"
 #include "source/common/router/string_accessor_impl.h"
+#include "source/common/runtime/runtime_features.h"
 #include "source/common/stream_info/filter_state_impl.h"
 #include "source/common/stream_info/upstream_address.h"
 
@@ -358,7 +359,11 @@ void checkPathMatchCriterion(const Route* route, const std::string& expected_mat
 
 class RouteMatcherTest : public testing::Test,
                          public ConfigImplTestBase,
-                         public TestScopedRuntime {};
+                         public TestScopedRuntime {
+protected:
+  // Matches requests against virtual hosts with routes of every path match type.
+  void testRoutes();
+};
 
 TEST_F(RouteMatcherTest, TestConnectRoutes) {
   const std::string yaml = R"EOF(
@@ -499,7 +504,7 @@ virtual_hosts:
   }
 }
 
-TEST_F(RouteMatcherTest, TestRoutes) {
+void RouteMatcherTest::testRoutes() {
   const std::string yaml = R"EOF(
 virtual_hosts:
 - name: www2
@@ -1305,6 +1310,198 @@ virtual_hosts:
   }
 }
 
+TEST_F(RouteMatcherTest, TestRoutes) { testRoutes(); }
+
+TEST_F(RouteMatcherTest, TestRoutesWithRouteIndex) {
+  mergeValues({{"envoy.reloadable_features.route_index", "true"}});
+  testRoutes();
+}
+
+TEST_F(RouteMatcherTest, TestRoutesWithRegexRouteSets) {
+  mergeValues({{"envoy.reloadable_features.regex_route_sets", "true"}});
+  testRoutes();
+}
+
+TEST_F(RouteMatcherTest, TestRoutesWithRouteIndexAndRegexRouteSets) {
+  mergeValues({{"envoy.reloadable_features.route_index", "true"},
+               {"envoy.reloadable_features.regex_route_sets", "true"}});
+  testRoutes();
+}
+
+// The route index only narrows the path match, so the first route in the list which matches the
+// whole request wins, whether it is indexed or not.
+TEST_F(RouteMatcherTest, RouteIndexPreservesRouteOrder) {
+  mergeValues({{"envoy.reloadable_features.route_index", "true"}});
+  const std::string yaml = R"EOF(
+virtual_hosts:
+- name: local_service
+  domains: ["*"]
+  routes:
+  - match:
+      prefix: "/api"
+      headers:
+      - name: x-canary
+        string_match:
+          exact: "true"
+    route: { cluster: canary }
+  - match:
+      safe_regex:
+        regex: "/api/v[0-9]+/legacy"
+    route: { cluster: legacy }
+  - match:
+      path: "/api/v1/users"
+    route: { cluster: users }
+  - match:
+      prefix: "/API/V1"
+      case_sensitive: false
+    route: { cluster: insensitive }
+  - match:
+      path_separated_prefix: "/api"
+    route: { cluster: api }
+  - match:
+      prefix: "/"
+    route: { cluster: default }
+  )EOF";
+
+  factory_context_.cluster_manager_.initializeClusters(
+      {"canary", "legacy", "users", "insensitive", "api", "default"}, {});
+  TestConfigImpl config(parseRouteConfigurationFromYaml(yaml), factory_context_, true,
+                        creation_status_);
+
+  auto cluster = [&config](Http::TestRequestHeaderMapImpl headers) {
+    return config.route(headers, 0)->routeEntry()->clusterName();
+  };
+  Http::TestRequestHeaderMapImpl canary = genHeaders("www.lyft.com", "/api/v1/users", "GET");
+  canary.addCopy("x-canary", "true");
+  EXPECT_EQ("canary", cluster(canary));
+  EXPECT_EQ("legacy", cluster(genHeaders("www.lyft.com", "/api/v2/legacy", "GET")));
+  EXPECT_EQ("users", cluster(genHeaders("www.lyft.com", "/api/v1/users?limit=1", "GET")));
+  EXPECT_EQ("insensitive", cluster(genHeaders("www.lyft.com", "/api/v1/users/1", "GET")));
+  EXPECT_EQ("api", cluster(genHeaders("www.lyft.com", "/api/v2/users", "GET")));
+  EXPECT_EQ("api", cluster(genHeaders("www.lyft.com", "/api", "GET")));
+  EXPECT_EQ("default", cluster(genHeaders("www.lyft.com", "/apiv2", "GET")));
+}
+
+// The first regex route in the list which matches the whole request wins, even when a run of
+// regex routes is matched with a single multi-pattern matcher.
+TEST_F(RouteMatcherTest, RegexRouteSetsPreserveRouteOrder) {
+  const std::string yaml = R"EOF(
+virtual_hosts:
+- name: local_service
+  domains: ["*"]
+  routes:
+  - match:
+      safe_regex:
+        regex: "/users/[0-9]+"
+      headers:
+      - name: x-canary
+        string_match:
+          exact: "true"
+    route: { cluster: canary }
+  - match:
+      safe_regex:
+        regex: "/users/[0-9]+"
+    route: { cluster: numeric }
+  - match:
+      safe_regex:
+        regex: "/users/.*"
+    route: { cluster: users }
+  - match:
+      prefix: "/users"
+    route: { cluster: prefix }
+  - match:
+      safe_regex:
+        regex: "/.*"
+    route: { cluster: default }
+  )EOF";
+
+  factory_context_.cluster_manager_.initializeClusters(
+      {"canary", "numeric", "users", "prefix", "default"}, {});
+  for (const std::string route_index : {"false", "true"}) {
+    mergeValues({{"envoy.reloadable_features.regex_route_sets", "true"},
+                 {"envoy.reloadable_features.route_index", route_index}});
+    TestConfigImpl config(parseRouteConfigurationFromYaml(yaml), factory_context_, true,
+                          creation_status_);
+
+    auto cluster = [&config](Http::TestRequestHeaderMapImpl headers) {
+      return config.route(headers, 0)->routeEntry()->clusterName();
+    };
+    Http::TestRequestHeaderMapImpl canary = genHeaders("www.lyft.com", "/users/123", "GET");
+    canary.addCopy("x-canary", "true");
+    EXPECT_EQ("canary", cluster(canary));
+    EXPECT_EQ("numeric", cluster(genHeaders("www.lyft.com", "/users/123?a=b", "GET")));
+    EXPECT_EQ("users", cluster(genHeaders("www.lyft.com", "/users/abc", "GET")));
+    EXPECT_EQ("prefix", cluster(genHeaders("www.lyft.com", "/users", "GET")));
+    EXPECT_EQ("default", cluster(genHeaders("www.lyft.com", "/other", "GET")));
+  }
+}
+
+// A new generation of a route configuration shares the virtual hosts which did not change with
+// the previous generation, as long as nothing but the virtual hosts changed.
+TEST_F(RouteMatcherTest, IncrementalRouteConfigSharesUnchangedVirtualHosts) {
+  const std::string yaml = R"EOF(
+virtual_hosts:
+- name: foo
+  domains: ["foo.com"]
+  routes:
+  - match: { prefix: "/" }
+    route: { cluster: foo }
+- name: bar
+  domains: ["bar.com"]
+  routes:
+  - match: { prefix: "/" }
+    route: { cluster: bar }
+  )EOF";
+
+  mergeValues({{"envoy.reloadable_features.incremental_route_config", "true"}});
+  auto create = [this](const envoy::config::route::v3::RouteConfiguration& proto,
+                       const ConfigImpl* previous) {
+    return *ConfigImpl::create(proto, factory_context_, ProtobufMessage::getNullValidationVisitor(),
+                               false, previous);
+  };
+  auto vhost = [](const ConfigImpl& config, const std::string& host) {
+    NiceMock<Envoy::StreamInfo::MockStreamInfo> stream_info;
+    return config.route(genHeaders(host, "/", "GET"), stream_info, 0).vhost.get();
+  };
+
+  envoy::config::route::v3::RouteConfiguration proto = parseRouteConfigurationFromYaml(yaml);
+  std::shared_ptr<ConfigImpl> first = create(proto, nullptr);
+
+  proto.mutable_virtual_hosts(1)->mutable_routes(0)->mutable_route()->set_cluster("baz");
+  std::shared_ptr<ConfigImpl> second = create(proto, first.get());
+  EXPECT_EQ(vhost(*first, "foo.com"), vhost(*second, "foo.com"));
+  EXPECT_NE(vhost(*first, "bar.com"), vhost(*second, "bar.com"));
+  NiceMock<Envoy::StreamInfo::MockStreamInfo> stream_info;
+  EXPECT_EQ("baz", second->route(genHeaders("bar.com", "/", "GET"), stream_info, 0)
+                       ->routeEntry()
+                       ->clusterName());
+
+  // The virtual hosts are built from the rest of the configuration, so changing it rebuilds them.
+  proto.add_internal_only_headers("x-internal");
+  std::shared_ptr<ConfigImpl> third = create(proto, second.get());
+  EXPECT_NE(vhost(*second, "foo.com"), vhost(*third, "foo.com"));
+
+  // So does changing a runtime feature which is read while the routes are built.
+  std::shared_ptr<ConfigImpl> fourth = create(proto, third.get());
+  EXPECT_EQ(vhost(*third, "foo.com"), vhost(*fourth, "foo.com"));
+  for (const std::string feature :
+       {"envoy.reloadable_features.route_index", "envoy.reloadable_features.regex_route_sets",
+        "envoy.reloadable_features.remove_legacy_route_formatter",
+        "envoy.reloadable_features.intern_header_parsers",
+        "envoy.reloadable_features.enable_formatter_for_ratelimit_action_descriptor_value"}) {
+    const bool enabled = Runtime::runtimeFeatureEnabled(feature);
+    mergeValues({{feature, enabled ? "false" : "true"}});
+    std::shared_ptr<ConfigImpl> next = create(proto, fourth.get());
+    EXPECT_NE(vhost(*fourth, "foo.com"), vhost(*next, "foo.com")) << feature;
+    fourth = next;
+  }
+
+  // Without the runtime feature, nothing is shared.
+  mergeValues({{"envoy.reloadable_features.incremental_route_config", "false"}});
+  std::shared_ptr<ConfigImpl> fifth = create(proto, fourth.get());
+  EXPECT_NE(vhost(*fourth, "foo.com"), vhost(*fifth, "foo.com"));
+}
+
 TEST_F(RouteMatcherTest, TestRoutesWithWildcardAndDefaultOnly) {
   const std::string yaml = R"EOF(
 virtual_hosts:
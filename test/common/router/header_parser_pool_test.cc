@@ -0,0 +1,108 @@
+#include "envoy/config/route/v3/route_components.pb.h"
+
+#include "source/common/router/header_parser_pool.h"
+
+#include "test/mocks/server/server_factory_context.h"
+#include "test/mocks/stream_info/mocks.h"
+#include "test/test_common/test_runtime.h"
+#include "test/test_common/utility.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Router {
+namespace {
+
+using testing::NiceMock;
+
+class HeaderParserPoolTest : public testing::Test {
+protected:
+  HeaderParserPoolTest() {
+    scoped_runtime_.mergeValues({{"envoy.reloadable_features.intern_header_parsers", "true"}});
+  }
+
+  HeaderParserConstSharedPtr configure(const std::string& yaml) {
+    envoy::config::route::v3::Route route;
+    TestUtility::loadFromYaml(yaml, route);
+    return HeaderParserPool::configure(route.request_headers_to_add(),
+                                       route.request_headers_to_remove(), context_)
+        .value();
+  }
+
+  size_t poolSize() {
+    return HeaderParserPool::getSharedPool(context_.singletonManager(),
+                                           context_.mainThreadDispatcher())
+        ->poolSize();
+  }
+
+  TestScopedRuntime scoped_runtime_;
+  NiceMock<Server::Configuration::MockServerFactoryContext> context_;
+};
+
+const std::string FooYaml = R"EOF(
+match: { prefix: "/" }
+direct_response: { status: 200 }
+request_headers_to_add:
+- header: { key: x-foo, value: "%PROTOCOL%" }
+request_headers_to_remove: ["x-bar"]
+)EOF";
+
+TEST_F(HeaderParserPoolTest, SharesParsersWithTheSameConfig) {
+  HeaderParserConstSharedPtr first = configure(FooYaml);
+  HeaderParserConstSharedPtr second = configure(FooYaml);
+  EXPECT_EQ(first.get(), second.get());
+  EXPECT_EQ(1, poolSize());
+
+  // Only the headers to remove differ.
+  HeaderParserConstSharedPtr third = configure(R"EOF(
+match: { prefix: "/" }
+direct_response: { status: 200 }
+request_headers_to_add:
+- header: { key: x-foo, value: "%PROTOCOL%" }
+)EOF");
+  EXPECT_NE(first.get(), third.get());
+  EXPECT_EQ(2, poolSize());
+
+  NiceMock<Envoy::StreamInfo::MockStreamInfo> stream_info;
+  stream_info.protocol_ = Http::Protocol::Http11;
+  Http::TestRequestHeaderMapImpl headers{{"x-bar", "bar"}};
+  second->evaluateHeaders(headers, stream_info);
+  EXPECT_EQ("HTTP/1.1", headers.get_("x-foo"));
+  EXPECT_FALSE(headers.has("x-bar"));
+}
+
+TEST_F(HeaderParserPoolTest, ReleasesUnusedParsers) {
+  HeaderParserConstSharedPtr first = configure(FooYaml);
+  HeaderParserConstSharedPtr second = configure(FooYaml);
+  first.reset();
+  EXPECT_EQ(1, poolSize());
+  second.reset();
+  EXPECT_EQ(0, poolSize());
+}
+
+TEST_F(HeaderParserPoolTest, InvalidConfig) {
+  envoy::config::route::v3::Route route;
+  TestUtility::loadFromYaml(R"EOF(
+match: { prefix: "/" }
+direct_response: { status: 200 }
+request_headers_to_remove: [":path"]
+)EOF",
+                            route);
+  EXPECT_EQ(HeaderParserPool::configure(route.request_headers_to_add(),
+                                        route.request_headers_to_remove(), context_)
+                .status()
+                .message(),
+            ":-prefixed or host headers may not be removed");
+  EXPECT_EQ(0, poolSize());
+}
+
+TEST_F(HeaderParserPoolTest, Disabled) {
+  scoped_runtime_.mergeValues({{"envoy.reloadable_features.intern_header_parsers", "false"}});
+  EXPECT_NE(configure(FooYaml).get(), configure(FooYaml).get());
+  EXPECT_EQ(0, poolSize());
+}
+
+} // namespace
+} // namespace Router
+} // namespace Envoy
@@ -0,0 +1,122 @@
+#include <string>
+#include <vector>
+
+#include "envoy/config/route/v3/route.pb.h"
+
+#include "source/common/common/regex.h"
+#include "source/common/router/regex_route_sets.h"
+
+#include "test/test_common/utility.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Router {
+namespace {
+
+Protobuf::RepeatedPtrField<envoy::config::route::v3::Route> parseRoutes(const std::string& yaml) {
+  envoy::config::route::v3::VirtualHost virtual_host;
+  TestUtility::loadFromYaml(yaml, virtual_host);
+  return virtual_host.routes();
+}
+
+std::vector<bool> mayMatch(const RegexRouteSets& sets, absl::string_view path, uint32_t routes) {
+  RegexRouteSets::Lookup lookup(sets, path);
+  std::vector<bool> result;
+  for (uint32_t route = 0; route < routes; ++route) {
+    result.push_back(lookup.mayMatch(route));
+  }
+  return result;
+}
+
+class UnsupportedEngine : public Regex::GoogleReEngine {
+public:
+  absl::StatusOr<Regex::CompiledSetMatcherPtr>
+  setMatcher(const std::vector<std::string>&) const override {
+    return absl::UnimplementedError("unsupported");
+  }
+};
+
+const std::string RoutesYaml = R"EOF(
+name: routes
+domains: ["*"]
+routes:
+- match: { safe_regex: { regex: "/users/[0-9]+" } }
+  direct_response: { status: 200 }
+- match: { safe_regex: { regex: "/users/.*" } }
+  direct_response: { status: 200 }
+- match: { prefix: "/users" }
+  direct_response: { status: 200 }
+- match: { safe_regex: { regex: "/status/[0-9]+" } }
+  direct_response: { status: 200 }
+- match: { safe_regex: { regex: "/status/.*" } }
+  direct_response: { status: 200 }
+- match: { safe_regex: { regex: "/health" } }
+  direct_response: { status: 200 }
+- match: { prefix: "/status" }
+  direct_response: { status: 200 }
+- match: { safe_regex: { regex: "/single/.*" } }
+  direct_response: { status: 200 }
+- match: { prefix: "/" }
+  direct_response: { status: 200 }
+)EOF";
+
+TEST(RegexRouteSetsTest, Runs) {
+  Regex::GoogleReEngine engine;
+  RegexRouteSetsConstPtr sets = RegexRouteSets::create(parseRoutes(RoutesYaml), engine);
+  ASSERT_NE(nullptr, sets);
+  // A single regex route is not a run.
+  EXPECT_EQ(5, sets->routes());
+
+  // Routes outside of runs always may match.
+  EXPECT_EQ(std::vector<bool>({true, true, true, false, false, false, true, true, true}),
+            mayMatch(*sets, "/users/123", 9));
+  EXPECT_EQ(std::vector<bool>({false, true, true, false, false, false, true, true, true}),
+            mayMatch(*sets, "/users/abc", 9));
+  EXPECT_EQ(std::vector<bool>({false, false, true, true, true, false, true, true, true}),
+            mayMatch(*sets, "/status/200", 9));
+  EXPECT_EQ(std::vector<bool>({false, false, true, false, false, true, true, true, true}),
+            mayMatch(*sets, "/health", 9));
+  EXPECT_EQ(std::vector<bool>({false, false, true, false, false, false, true, true, true}),
+            mayMatch(*sets, "/users", 9));
+}
+
+// Lookups may skip routes, as the route index does.
+TEST(RegexRouteSetsTest, SparseLookup) {
+  Regex::GoogleReEngine engine;
+  RegexRouteSetsConstPtr sets = RegexRouteSets::create(parseRoutes(RoutesYaml), engine);
+  ASSERT_NE(nullptr, sets);
+
+  RegexRouteSets::Lookup lookup(*sets, "/status/200");
+  EXPECT_TRUE(lookup.mayMatch(2));
+  EXPECT_TRUE(lookup.mayMatch(4));
+  EXPECT_FALSE(lookup.mayMatch(5));
+  EXPECT_TRUE(lookup.mayMatch(7));
+}
+
+// Routes which use the deprecated google_re2 field always use RE2, so they are not compiled with
+// the engine.
+TEST(RegexRouteSetsTest, GoogleRe2BreaksRuns) {
+  Regex::GoogleReEngine engine;
+  EXPECT_EQ(nullptr, RegexRouteSets::create(parseRoutes(R"EOF(
+name: routes
+domains: ["*"]
+routes:
+- match: { safe_regex: { regex: "/a/.*" } }
+  direct_response: { status: 200 }
+- match: { safe_regex: { google_re2: {}, regex: "/b/.*" } }
+  direct_response: { status: 200 }
+- match: { safe_regex: { regex: "/c/.*" } }
+  direct_response: { status: 200 }
+)EOF"),
+                                            engine));
+}
+
+TEST(RegexRouteSetsTest, UnsupportedEngine) {
+  UnsupportedEngine engine;
+  EXPECT_EQ(nullptr, RegexRouteSets::create(parseRoutes(RoutesYaml), engine));
+}
+
+} // namespace
+} // namespace Router
+} // namespace Envoy
@@ -0,0 +1,98 @@
+#include <vector>
+
+#include "source/common/router/route_index.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Router {
+namespace {
+
+using testing::ElementsAre;
+using testing::IsEmpty;
+
+std::vector<uint32_t> candidates(const RouteIndex& index, absl::string_view path) {
+  RouteIndex::Candidates candidates = index.candidates(path);
+  std::vector<uint32_t> result;
+  uint32_t route;
+  while (candidates.next(route)) {
+    result.push_back(route);
+  }
+  return result;
+}
+
+TEST(RouteIndexTest, Empty) {
+  RouteIndex index;
+  EXPECT_EQ(0, index.indexedRoutes());
+  EXPECT_THAT(candidates(index, "/"), IsEmpty());
+}
+
+TEST(RouteIndexTest, Prefix) {
+  RouteIndex index;
+  index.addRoute(PathMatchType::Prefix, "/foo", true);
+  index.addRoute(PathMatchType::Prefix, "/bar", true);
+  index.addRoute(PathMatchType::Prefix, "/foo/bar", true);
+  index.addRoute(PathMatchType::Prefix, "/", true);
+  index.addRoute(PathMatchType::Prefix, "/foo", true);
+  EXPECT_EQ(5, index.indexedRoutes());
+
+  EXPECT_THAT(candidates(index, "/foo/bar/baz"), ElementsAre(0, 2, 3, 4));
+  EXPECT_THAT(candidates(index, "/foobar"), ElementsAre(0, 3, 4));
+  EXPECT_THAT(candidates(index, "/bar"), ElementsAre(1, 3));
+  EXPECT_THAT(candidates(index, "/baz"), ElementsAre(3));
+  EXPECT_THAT(candidates(index, ""), IsEmpty());
+}
+
+TEST(RouteIndexTest, EmptyPrefix) {
+  RouteIndex index;
+  index.addRoute(PathMatchType::Prefix, "/foo", true);
+  index.addRoute(PathMatchType::Prefix, "", true);
+
+  EXPECT_THAT(candidates(index, "/foo"), ElementsAre(0, 1));
+  EXPECT_THAT(candidates(index, "/bar"), ElementsAre(1));
+}
+
+TEST(RouteIndexTest, Exact) {
+  RouteIndex index;
+  index.addRoute(PathMatchType::Exact, "/foo", true);
+  index.addRoute(PathMatchType::Prefix, "/foo", true);
+  index.addRoute(PathMatchType::Exact, "/foo/bar", true);
+
+  EXPECT_THAT(candidates(index, "/foo"), ElementsAre(0, 1));
+  EXPECT_THAT(candidates(index, "/foo/"), ElementsAre(1));
+  EXPECT_THAT(candidates(index, "/foo/bar"), ElementsAre(1, 2));
+  EXPECT_THAT(candidates(index, "/foo/bar/"), ElementsAre(1));
+}
+
+TEST(RouteIndexTest, PathSeparatedPrefix) {
+  RouteIndex index;
+  index.addRoute(PathMatchType::PathSeparatedPrefix, "/api", true);
+  index.addRoute(PathMatchType::Prefix, "/", true);
+
+  EXPECT_THAT(candidates(index, "/api"), ElementsAre(0, 1));
+  EXPECT_THAT(candidates(index, "/api/"), ElementsAre(0, 1));
+  EXPECT_THAT(candidates(index, "/api/v1"), ElementsAre(0, 1));
+  EXPECT_THAT(candidates(index, "/apiv1"), ElementsAre(1));
+}
+
+// Routes which are not indexed are candidates for every path, in their position in the list.
+TEST(RouteIndexTest, Unindexed) {
+  RouteIndex index;
+  index.addRoute(PathMatchType::Regex, "", true);
+  index.addRoute(PathMatchType::Prefix, "/foo", true);
+  index.addRoute(PathMatchType::Prefix, "/FOO", false);
+  index.addRoute(PathMatchType::Exact, "/bar", false);
+  index.addRoute(PathMatchType::Prefix, "/bar", true);
+  index.addRoute(PathMatchType::Template, "", true);
+  index.addRoute(PathMatchType::None, "", true);
+  EXPECT_EQ(2, index.indexedRoutes());
+
+  EXPECT_THAT(candidates(index, "/foo"), ElementsAre(0, 1, 2, 3, 5, 6));
+  EXPECT_THAT(candidates(index, "/bar"), ElementsAre(0, 2, 3, 4, 5, 6));
+  EXPECT_THAT(candidates(index, "/baz"), ElementsAre(0, 2, 3, 5, 6));
+}
+
+} // namespace
+} // namespace Router
+} // namespace Envoy
@@ -0,0 +1,63 @@
+// Note: this should be run with --compilation_mode=opt, and would benefit from a
+// quiescent system with disabled cstate power management.
+
+#include "source/common/stats/allocator_impl.h"
+#include "source/common/stats/symbol_table.h"
+
+#include "benchmark/benchmark.h"
+
+namespace Envoy {
+namespace Stats {
+namespace {
+
+// A counter shared by all benchmark threads, like a per-cluster counter incremented by every
+// worker.
+class SharedCounter {
+public:
+  explicit SharedCounter(uint32_t num_shards) : alloc_(symbol_table_), pool_(symbol_table_) {
+    alloc_.setCounterShards(num_shards);
+    counter_ = alloc_.makeCounter(pool_.add("cluster.upstream_rq_total"), StatName(), {});
+  }
+
+  Counter& counter() { return *counter_; }
+
+private:
+  SymbolTableImpl symbol_table_;
+  AllocatorImpl alloc_;
+  StatNamePool pool_;
+  CounterSharedPtr counter_;
+};
+
+Counter& sharedCounter(bool sharded) {
+  static SharedCounter regular(0);
+  static SharedCounter sharded_counter(64);
+  return sharded ? sharded_counter.counter() : regular.counter();
+}
+
+} // namespace
+
+// Measure increments of one counter from a growing number of threads. With Arg(0) all threads
+// contend on a single atomic; with Arg(1) the counter is sharded.
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void bmCounterInc(benchmark::State& state) {
+  Counter& counter = sharedCounter(state.range(0) != 0);
+  for (auto _ : state) { // NOLINT
+    counter.inc();
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(bmCounterInc)->Arg(0)->Arg(1)->ThreadRange(1, 64)->UseRealTime();
+
+// Measure the cost of latching a sharded counter, which sums its slots, as done for every
+// counter on each stats flush.
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void bmCounterLatch(benchmark::State& state) {
+  Counter& counter = sharedCounter(state.range(0) != 0);
+  for (auto _ : state) { // NOLINT
+    benchmark::DoNotOptimize(counter.latch());
+  }
+}
+BENCHMARK(bmCounterLatch)->Arg(0)->Arg(1);
+
+} // namespace Stats
+} // namespace Envoy
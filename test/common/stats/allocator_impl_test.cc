@@ -137,6 +137,72 @@ TEST_F(AllocatorImplTest, RefCountDecAllocRaceSynchronized) {
   EXPECT_FALSE(alloc_.isMutexLockedForTest());
 }
 
+// A sharded counter which is only incremented by one thread behaves like a regular counter.
+TEST_F(AllocatorImplTest, ShardedCounterSingleThread) {
+  alloc_.setCounterShards(4);
+  CounterSharedPtr counter = alloc_.makeCounter(makeStat("counter.name"), StatName(), {});
+  EXPECT_FALSE(counter->used());
+  counter->add(5);
+  counter->inc();
+  EXPECT_TRUE(counter->used());
+  EXPECT_EQ(6, counter->value());
+  EXPECT_EQ(6, counter->latch());
+  EXPECT_EQ(0, counter->latch());
+  counter->reset();
+  EXPECT_EQ(0, counter->value());
+  EXPECT_EQ(0, counter->latch());
+}
+
+// Increments from several threads are spread over the slots, and summed by value() and latch().
+TEST_F(AllocatorImplTest, ShardedCounterMultipleThreads) {
+  alloc_.setCounterShards(4);
+  CounterSharedPtr counter = alloc_.makeCounter(makeStat("counter.name"), StatName(), {});
+  // Counters created before sharding is disabled again keep their mode.
+  alloc_.setCounterShards(0);
+  counter->add(10);
+
+  Thread::ThreadFactory& thread_factory = Thread::threadFactoryForTest();
+  const uint32_t num_threads = 8;
+  const uint32_t iters = 1000;
+  std::vector<Thread::ThreadPtr> threads;
+  absl::Notification go;
+  for (uint32_t i = 0; i < num_threads; ++i) {
+    threads.push_back(thread_factory.createThread([&]() {
+      go.WaitForNotification();
+      for (uint32_t i = 0; i < iters; ++i) {
+        counter->inc();
+      }
+    }));
+  }
+  go.Notify();
+  for (auto& thread : threads) {
+    thread->join();
+  }
+
+  const uint64_t expected = 10 + num_threads * iters;
+  EXPECT_EQ(expected, counter->value());
+  EXPECT_EQ(expected, counter->latch());
+  EXPECT_EQ(0, counter->latch());
+
+  // After a reset, only new increments are reported by value(), while latch() reports every
+  // increment exactly once.
+  counter->reset();
+  EXPECT_EQ(0, counter->value());
+  threads.clear();
+  threads.push_back(thread_factory.createThread([&]() { counter->add(3); }));
+  threads[0]->join();
+  counter->add(2);
+  EXPECT_EQ(5, counter->value());
+  EXPECT_EQ(5, counter->latch());
+
+  counter->markUnused();
+  EXPECT_FALSE(counter->used());
+  threads.clear();
+  threads.push_back(thread_factory.createThread([&]() { counter->inc(); }));
+  threads[0]->join();
+  EXPECT_TRUE(counter->used());
+}
+
 TEST_F(AllocatorImplTest, HiddenGauge) {
   GaugeSharedPtr hidden_gauge =
       alloc_.makeGauge(makeStat("hidden"), StatName(), {}, Gauge::ImportMode::HiddenAccumulate);
@@ -626,6 +692,114 @@ TEST_F(AllocatorImplTest, ForEachSinkedTextReadout) {
   EXPECT_EQ(num_iterations, 0);
 }
 
+TEST_F(AllocatorImplTest, ChangedSinkedStats) {
+  CounterSharedPtr c1 = alloc_.makeCounter(makeStat("counter.1"), StatName(), {});
+  alloc_.trackChanges();
+  CounterSharedPtr c2 = alloc_.makeCounter(makeStat("counter.2"), StatName(), {});
+  GaugeSharedPtr g1 = alloc_.makeGauge(makeStat("gauge.1"), StatName(), {},
+                                       Gauge::ImportMode::Accumulate);
+  GaugeSharedPtr g2 = alloc_.makeGauge(makeStat("gauge.2"), StatName(), {},
+                                       Gauge::ImportMode::Accumulate);
+  TextReadoutSharedPtr t1 = alloc_.makeTextReadout(makeStat("text.1"), StatName(), {});
+  GaugeSharedPtr hidden = alloc_.makeGauge(makeStat("hidden"), StatName(), {},
+                                           Gauge::ImportMode::HiddenAccumulate);
+
+  std::vector<std::string> names;
+  auto collect = [this, &names]() {
+    names.clear();
+    alloc_.forEachChangedSinkedStat(
+        [&names](Counter& counter) { names.push_back(counter.name()); },
+        [&names](Gauge& gauge) { names.push_back(gauge.name()); },
+        [&names](TextReadout& text_readout) { names.push_back(text_readout.name()); });
+    return names;
+  };
+
+  // Gauges and text readouts created while changes are tracked are reported as changed, but new
+  // counters are not until they are incremented. Hidden gauges are never reported.
+  EXPECT_THAT(collect(), testing::UnorderedElementsAre("gauge.1", "gauge.2", "text.1"));
+  EXPECT_THAT(collect(), testing::IsEmpty());
+
+  c1->inc();
+  c1->add(2);
+  g2->add(1);
+  g2->sub(1);
+  t1->set("value");
+  hidden->set(1);
+  EXPECT_THAT(collect(), testing::UnorderedElementsAre("counter.1", "gauge.2", "text.1"));
+  EXPECT_THAT(collect(), testing::IsEmpty());
+
+  // A destroyed stat is forgotten.
+  c2->inc();
+  g1->set(5);
+  c2.reset();
+  EXPECT_THAT(collect(), testing::ElementsAre("gauge.1"));
+}
+
+TEST_F(AllocatorImplTest, ChangedSinkedStatsUntracked) {
+  CounterSharedPtr c1 = alloc_.makeCounter(makeStat("counter.1"), StatName(), {});
+  GaugeSharedPtr g1 = alloc_.makeGauge(makeStat("gauge.1"), StatName(), {},
+                                       Gauge::ImportMode::Accumulate);
+  c1->inc();
+  g1->set(1);
+
+  uint32_t num_stats = 0;
+  alloc_.forEachChangedSinkedStat([&num_stats](Counter&) { ++num_stats; },
+                                  [&num_stats](Gauge&) { ++num_stats; },
+                                  [&num_stats](TextReadout&) { ++num_stats; });
+  EXPECT_EQ(0, num_stats);
+}
+
+TEST_F(AllocatorImplTest, ChangedSinkedStatsWithPredicates) {
+  alloc_.trackChanges();
+  CounterSharedPtr sinked = alloc_.makeCounter(makeStat("sinked.counter"), StatName(), {});
+  CounterSharedPtr not_sinked = alloc_.makeCounter(makeStat("counter"), StatName(), {});
+  GaugeSharedPtr gauge = alloc_.makeGauge(makeStat("gauge"), StatName(), {},
+                                          Gauge::ImportMode::Accumulate);
+
+  auto predicates = std::make_unique<TestUtil::TestSinkPredicates>();
+  predicates->add(sinked->statName());
+  alloc_.setSinkPredicates(std::move(predicates));
+
+  sinked->inc();
+  not_sinked->inc();
+  gauge->set(1);
+  std::vector<std::string> names;
+  alloc_.forEachChangedSinkedStat([&names](Counter& counter) { names.push_back(counter.name()); },
+                                  [&names](Gauge& gauge) { names.push_back(gauge.name()); },
+                                  [&names](TextReadout&) {});
+  EXPECT_THAT(names, testing::ElementsAre("sinked.counter"));
+}
+
+// Stats may be changed by several threads while the changed stats are visited.
+TEST_F(AllocatorImplTest, ChangedSinkedStatsConcurrentUpdates) {
+  alloc_.trackChanges();
+  CounterSharedPtr counter = alloc_.makeCounter(makeStat("counter"), StatName(), {});
+  constexpr uint32_t NumThreads = 4;
+  constexpr uint64_t NumIncrements = 10000;
+  std::vector<Thread::ThreadPtr> threads;
+  for (uint32_t i = 0; i < NumThreads; ++i) {
+    threads.push_back(Thread::threadFactoryForTest().createThread([&counter]() {
+      for (uint64_t j = 0; j < NumIncrements; ++j) {
+        counter->inc();
+      }
+    }));
+  }
+
+  // Every increment is latched by a visit, as a counter which is changed after its flag was
+  // cleared is recorded again.
+  uint64_t latched = 0;
+  const auto visit = [this, &latched]() {
+    alloc_.forEachChangedSinkedStat([&latched](Counter& c) { latched += c.latch(); },
+                                    [](Gauge&) {}, [](TextReadout&) {});
+  };
+  for (auto& thread : threads) {
+    visit();
+    thread->join();
+  }
+  visit();
+  EXPECT_EQ(NumThreads * NumIncrements, latched);
+}
+
 } // namespace
 } // namespace Stats
 } // namespace Envoy
@@ -109,6 +109,36 @@ TEST_F(HistogramSettingsImplTest, Priority) {
   EXPECT_EQ(settings_->bins("abcd"), 1);
 }
 
+// Test that bucketed recording is enabled by any matching config which sets it.
+TEST_F(HistogramSettingsImplTest, BucketedRecording) {
+  {
+    envoy::config::metrics::v3::HistogramBucketSettings setting;
+    setting.mutable_match()->set_prefix("a");
+    setting.mutable_bins()->set_value(5);
+    buckets_configs_.push_back(setting);
+  }
+  {
+    envoy::config::metrics::v3::HistogramBucketSettings setting;
+    setting.mutable_match()->set_prefix("ab");
+    setting.set_bucketed_recording(true);
+    buckets_configs_.push_back(setting);
+  }
+
+  {
+    envoy::config::metrics::v3::HistogramBucketSettings setting;
+    setting.mutable_match()->set_prefix("b");
+    setting.set_bucketed_recording(true);
+    buckets_configs_.push_back(setting);
+  }
+
+  initialize();
+  // The first matching rule decides, even if a later matching rule enables bucketed recording.
+  EXPECT_FALSE(settings_->bucketedRecording("abcd"));
+  EXPECT_FALSE(settings_->bucketedRecording("acde"));
+  EXPECT_TRUE(settings_->bucketedRecording("bcde"));
+  EXPECT_FALSE(settings_->bucketedRecording("cdef"));
+}
+
 TEST_F(HistogramSettingsImplTest, ScaledPercent) {
   envoy::config::metrics::v3::HistogramBucketSettings setting;
   setting.mutable_match()->set_prefix("a");
@@ -532,23 +532,14 @@ TEST_F(StatNameTest, RacingSymbolCreation) {
   access.setReady();
   accesses.Wait();
 
-  // In a perfect world, we could use reader-locks in the SymbolTable
-  // implementation, and there should be zero additional contentions
-  // after latching 'create_contentions' above. And we can definitely
-  // have this world, but this slows down BM_CreateRace in
-  // symbol_table_speed_test.cc, even on a 72-core machine.
-  //
-  // Thus it is better to avoid symbol-table contention by refactoring
-  // all stat-creation code to symbolize all stat string elements at
-  // construction, as composition does not require a lock.
-  //
-  // See this commit
-  // https://github.com/envoyproxy/envoy/pull/5321/commits/ef712d0f5a11ff49831c1935e8a2ef8a0a935bc9
-  // for a working reader-lock implementation, which would pass this EXPECT:
-  //     EXPECT_EQ(create_contentions, mutex_tracer.numContentions());
+  // Names whose symbols all exist are encoded with the table lock held
+  // shared, so every thread took the shared path above. The mutex tracer
+  // is not checked here, as it also counts contentions on the mutexes
+  // used to synchronize the test threads.
   //
   // Note also that we cannot guarantee there *will* be contentions
   // as a machine or OS is free to run all threads serially.
+  EXPECT_LE(num_threads, table_.lockStats().shared_encodes_);
 
   wait.setReady();
   for (auto& thread : threads) {
@@ -600,23 +591,14 @@ TEST_F(StatNameTest, MutexContentionOnExistingSymbols) {
   access.setReady();
   accesses.Wait();
 
-  // In a perfect world, we could use reader-locks in the SymbolTable
-  // implementation, and there should be zero additional contentions
-  // after latching 'create_contentions' above. And we can definitely
-  // have this world, but this slows down BM_CreateRace in
-  // symbol_table_speed_test.cc, even on a 72-core machine.
-  //
-  // Thus it is better to avoid symbol-table contention by refactoring
-  // all stat-creation code to symbolize all stat string elements at
-  // construction, as composition does not require a lock.
-  //
-  // See this commit
-  // https://github.com/envoyproxy/envoy/pull/5321/commits/ef712d0f5a11ff49831c1935e8a2ef8a0a935bc9
-  // for a working reader-lock implementation, which would pass this EXPECT:
-  //     EXPECT_EQ(create_contentions, mutex_tracer.numContentions());
+  // Names whose symbols all exist are encoded with the table lock held
+  // shared, so every thread took the shared path above. The mutex tracer
+  // is not checked here, as it also counts contentions on the mutexes
+  // used to synchronize the test threads.
   //
   // Note also that we cannot guarantee there *will* be contentions
   // as a machine or OS is free to run all threads serially.
+  EXPECT_LE(num_threads, table_.lockStats().shared_encodes_);
 
   wait.setReady();
   for (auto& thread : threads) {
@@ -714,6 +696,44 @@ TEST_F(StatNameTest, RecentLookups) {
   EXPECT_EQ(0, num_calls);
 }
 
+TEST_F(StatNameTest, SharedEncodes) {
+  makeStat("a.b");
+  EXPECT_EQ(0, table_.lockStats().shared_encodes_);
+
+  // All symbols exist, so the shared lock is enough.
+  StatName ab = makeStat("a.b");
+  StatName ba = makeStat("b.a");
+  EXPECT_EQ(2, table_.lockStats().shared_encodes_);
+  EXPECT_EQ("a.b", table_.toString(ab));
+  EXPECT_EQ("b.a", table_.toString(ba));
+
+  // A new symbol needs the exclusive lock.
+  makeStat("a.c");
+  EXPECT_EQ(2, table_.lockStats().shared_encodes_);
+  EXPECT_EQ(3, table_.numSymbols());
+
+  // Shared encodes are still counted as recent lookups, but are not taken
+  // while recent lookups are being recorded.
+  EXPECT_EQ(4, table_.getRecentLookups([](absl::string_view, uint64_t) {}));
+  table_.setRecentLookupCapacity(10);
+  makeStat("a.b");
+  EXPECT_EQ(2, table_.lockStats().shared_encodes_);
+}
+
+TEST_F(StatNameTest, SharedFree) {
+  StatNameStorage first("a.b.a", table_);
+  StatNameStorage second("a.b", table_);
+  EXPECT_EQ(2, table_.numSymbols());
+
+  // The symbols are still referenced by the second name.
+  first.free(table_);
+  EXPECT_EQ(2, table_.numSymbols());
+  EXPECT_EQ("a.b", table_.toString(second.statName()));
+
+  second.free(table_);
+  EXPECT_EQ(0, table_.numSymbols());
+}
+
 TEST_F(StatNameTest, StatNameEmptyEquivalent) {
   StatName empty1;
   StatName empty2 = makeStat("");
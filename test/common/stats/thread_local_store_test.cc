@@ -2170,6 +2170,36 @@ TEST_F(HistogramTest, ParentHistogramBucketSummaryAndDetail) {
   EXPECT_THAT(parent_histogram->detailedIntervalBuckets(), UnorderedElementsAre(Bucket{10, 1, 1}));
 }
 
+// Values recorded in bucketed mode are counted per bucket and reported at the bucket midpoints,
+// while values above the largest bucket are recorded precisely.
+TEST_F(HistogramTest, BucketedRecording) {
+  envoy::config::metrics::v3::StatsConfig config;
+  auto* setting = config.mutable_histogram_bucket_settings()->Add();
+  setting->mutable_match()->set_prefix("bucketed");
+  setting->mutable_buckets()->Add(10);
+  setting->mutable_buckets()->Add(100);
+  setting->set_bucketed_recording(true);
+  store_->setHistogramSettings(std::make_unique<HistogramSettingsImpl>(config, context_));
+
+  Histogram& histogram = scope_.histogramFromString("bucketed", Histogram::Unit::Unspecified);
+  EXPECT_CALL(sink_, onHistogramComplete(Ref(histogram), _)).Times(4);
+  histogram.recordValue(3);
+  histogram.recordValue(10);
+  histogram.recordValue(50);
+  histogram.recordValue(1000);
+  store_->mergeHistograms([]() -> void {});
+  ASSERT_EQ(1, store_->histograms().size());
+  ParentHistogramSharedPtr parent_histogram = store_->histograms()[0];
+  EXPECT_EQ("B10(2,2) B100(3,3)", parent_histogram->bucketSummary());
+  EXPECT_EQ(4, parent_histogram->intervalStatistics().sampleCount());
+  EXPECT_EQ(1, parent_histogram->intervalStatistics().outOfBoundCount());
+
+  // The counts are cleared by the merge.
+  store_->mergeHistograms([]() -> void {});
+  EXPECT_EQ("B10(0,2) B100(0,3)", parent_histogram->bucketSummary());
+  EXPECT_EQ(4, parent_histogram->cumulativeStatistics().sampleCount());
+}
+
 TEST_F(HistogramTest, ForEachHistogram) {
   std::vector<std::reference_wrapper<Histogram>> histograms;
 
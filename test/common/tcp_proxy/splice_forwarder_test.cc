@@ -0,0 +1,355 @@
+#include <fcntl.h>
+
+#include <memory>
+
+#include "source/common/tcp_proxy/splice_forwarder.h"
+
+#include "test/mocks/api/mocks.h"
+#include "test/mocks/event/mocks.h"
+#include "test/mocks/network/connection.h"
+#include "test/mocks/network/io_handle.h"
+#include "test/mocks/network/mocks.h"
+#include "test/test_common/threadsafe_singleton_injector.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+using testing::_;
+using testing::DoAll;
+using testing::Invoke;
+using testing::NiceMock;
+using testing::Return;
+using testing::ReturnRef;
+using testing::SaveArg;
+
+namespace Envoy {
+namespace TcpProxy {
+namespace {
+
+#if defined(__linux__)
+constexpr os_fd_t DownstreamFd = 20;
+constexpr os_fd_t UpstreamFd = 30;
+constexpr os_fd_t DownstreamPipeRead = 40;
+constexpr os_fd_t DownstreamPipeWrite = 41;
+constexpr os_fd_t UpstreamPipeRead = 50;
+constexpr os_fd_t UpstreamPipeWrite = 51;
+
+Api::SysCallSizeResult wouldBlock() { return {-1, SOCKET_ERROR_AGAIN}; }
+
+auto createPipe(os_fd_t read_end, os_fd_t write_end) {
+  return [read_end, write_end](os_fd_t* fds, int) -> Api::SysCallIntResult {
+    fds[0] = read_end;
+    fds[1] = write_end;
+    return {0, 0};
+  };
+}
+
+// Moves as many bytes as requested, as splice(2) does for a socket with plenty of data.
+Api::SysCallSizeResult spliceAll(os_fd_t, os_fd_t, size_t len, unsigned int) {
+  return {static_cast<ssize_t>(len), 0};
+}
+
+class SpliceTestBase : public testing::Test {
+protected:
+  SpliceTestBase() {
+    ON_CALL(linux_os_sys_calls_, splice(_, _, _, _)).WillByDefault(Return(wouldBlock()));
+  }
+
+  void expectPipe(os_fd_t read_end, os_fd_t write_end) {
+    EXPECT_CALL(os_sys_calls_, close(read_end)).WillOnce(Return(Api::SysCallIntResult{0, 0}));
+    EXPECT_CALL(os_sys_calls_, close(write_end)).WillOnce(Return(Api::SysCallIntResult{0, 0}));
+  }
+
+  NiceMock<Api::MockOsSysCalls> os_sys_calls_;
+  TestThreadsafeSingletonInjector<Api::OsSysCallsImpl> os_calls_{&os_sys_calls_};
+  NiceMock<Api::MockLinuxOsSysCalls> linux_os_sys_calls_;
+  TestThreadsafeSingletonInjector<Api::LinuxOsSysCallsImpl> linux_os_calls_{&linux_os_sys_calls_};
+};
+
+class SplicePipeTest : public SpliceTestBase {
+protected:
+  void setUpPipe() {
+    EXPECT_CALL(linux_os_sys_calls_, pipe2(_, O_NONBLOCK | O_CLOEXEC))
+        .WillOnce(Invoke(createPipe(DownstreamPipeRead, DownstreamPipeWrite)));
+    expectPipe(DownstreamPipeRead, DownstreamPipeWrite);
+    pipe_ = SplicePipe::create();
+    ASSERT_NE(nullptr, pipe_);
+  }
+
+  SplicePipePtr pipe_;
+};
+
+TEST_F(SplicePipeTest, CreateFailure) {
+  EXPECT_CALL(linux_os_sys_calls_, pipe2(_, _))
+      .WillOnce(Return(Api::SysCallIntResult{-1, EMFILE}));
+  EXPECT_EQ(nullptr, SplicePipe::create());
+}
+
+TEST_F(SplicePipeTest, TransferUntilWouldBlock) {
+  setUpPipe();
+  EXPECT_CALL(linux_os_sys_calls_, splice(DownstreamFd, DownstreamPipeWrite, _, _))
+      .WillOnce(Return(Api::SysCallSizeResult{100, 0}))
+      .WillOnce(Return(wouldBlock()));
+  EXPECT_CALL(linux_os_sys_calls_, splice(DownstreamPipeRead, UpstreamFd, 100, _))
+      .WillOnce(Return(Api::SysCallSizeResult{100, 0}));
+
+  const SplicePipe::Result result = pipe_->transfer(DownstreamFd, UpstreamFd, 1024);
+  EXPECT_EQ(100, result.bytes_read_);
+  EXPECT_EQ(100, result.bytes_written_);
+  EXPECT_FALSE(result.more_);
+  EXPECT_EQ(0, result.error_);
+  EXPECT_EQ(0, pipe_->buffered());
+  EXPECT_FALSE(pipe_->endStream());
+}
+
+TEST_F(SplicePipeTest, PartialWriteKeepsBytesInPipe) {
+  setUpPipe();
+  EXPECT_CALL(linux_os_sys_calls_, splice(DownstreamFd, DownstreamPipeWrite, _, _))
+      .WillOnce(Return(Api::SysCallSizeResult{100, 0}))
+      .WillOnce(Return(wouldBlock()));
+  EXPECT_CALL(linux_os_sys_calls_, splice(DownstreamPipeRead, UpstreamFd, 100, _))
+      .WillOnce(Return(Api::SysCallSizeResult{40, 0}));
+  EXPECT_CALL(linux_os_sys_calls_, splice(DownstreamPipeRead, UpstreamFd, 60, _))
+      .WillOnce(Return(wouldBlock()));
+
+  const SplicePipe::Result result = pipe_->transfer(DownstreamFd, UpstreamFd, 1024);
+  EXPECT_EQ(100, result.bytes_read_);
+  EXPECT_EQ(40, result.bytes_written_);
+  EXPECT_EQ(0, result.error_);
+  EXPECT_EQ(60, pipe_->buffered());
+}
+
+TEST_F(SplicePipeTest, EndOfStream) {
+  setUpPipe();
+  EXPECT_CALL(linux_os_sys_calls_, splice(DownstreamFd, DownstreamPipeWrite, _, _))
+      .WillOnce(Return(Api::SysCallSizeResult{10, 0}))
+      .WillOnce(Return(Api::SysCallSizeResult{0, 0}));
+  EXPECT_CALL(linux_os_sys_calls_, splice(DownstreamPipeRead, UpstreamFd, 10, _))
+      .WillOnce(Return(Api::SysCallSizeResult{10, 0}));
+
+  const SplicePipe::Result result = pipe_->transfer(DownstreamFd, UpstreamFd, 1024);
+  EXPECT_EQ(10, result.bytes_read_);
+  EXPECT_EQ(10, result.bytes_written_);
+  EXPECT_EQ(0, result.error_);
+  EXPECT_TRUE(pipe_->endStream());
+
+  // The source is not read again after end of stream.
+  const SplicePipe::Result next = pipe_->transfer(DownstreamFd, UpstreamFd, 1024);
+  EXPECT_EQ(0, next.bytes_read_);
+  EXPECT_EQ(0, next.bytes_written_);
+}
+
+TEST_F(SplicePipeTest, ReadError) {
+  setUpPipe();
+  EXPECT_CALL(linux_os_sys_calls_, splice(DownstreamFd, DownstreamPipeWrite, _, _))
+      .WillOnce(Return(Api::SysCallSizeResult{-1, ECONNRESET}));
+  EXPECT_CALL(linux_os_sys_calls_, splice(DownstreamPipeRead, _, _, _)).Times(0);
+
+  const SplicePipe::Result result = pipe_->transfer(DownstreamFd, UpstreamFd, 1024);
+  EXPECT_EQ(0, result.bytes_read_);
+  EXPECT_EQ(ECONNRESET, result.error_);
+}
+
+TEST_F(SplicePipeTest, WriteError) {
+  setUpPipe();
+  EXPECT_CALL(linux_os_sys_calls_, splice(DownstreamFd, DownstreamPipeWrite, _, _))
+      .WillOnce(Return(Api::SysCallSizeResult{100, 0}));
+  EXPECT_CALL(linux_os_sys_calls_, splice(DownstreamPipeRead, UpstreamFd, 100, _))
+      .WillOnce(Return(Api::SysCallSizeResult{-1, EPIPE}));
+
+  const SplicePipe::Result result = pipe_->transfer(DownstreamFd, UpstreamFd, 1024);
+  EXPECT_EQ(100, result.bytes_read_);
+  EXPECT_EQ(0, result.bytes_written_);
+  EXPECT_EQ(EPIPE, result.error_);
+  EXPECT_EQ(100, pipe_->buffered());
+}
+
+TEST_F(SplicePipeTest, TransferLimit) {
+  setUpPipe();
+  EXPECT_CALL(linux_os_sys_calls_, splice(DownstreamFd, DownstreamPipeWrite, _, _))
+      .WillOnce(Return(Api::SysCallSizeResult{100, 0}));
+  EXPECT_CALL(linux_os_sys_calls_, splice(DownstreamPipeRead, UpstreamFd, 100, _))
+      .WillOnce(Return(Api::SysCallSizeResult{100, 0}));
+
+  const SplicePipe::Result result = pipe_->transfer(DownstreamFd, UpstreamFd, 100);
+  EXPECT_EQ(100, result.bytes_read_);
+  EXPECT_EQ(100, result.bytes_written_);
+  EXPECT_TRUE(result.more_);
+}
+
+class MockSpliceForwarderCallbacks : public SpliceForwarderCallbacks {
+public:
+  MOCK_METHOD(void, onSpliceDownstreamData, (uint64_t bytes_read, uint64_t bytes_written));
+  MOCK_METHOD(void, onSpliceUpstreamData, (uint64_t bytes_read, uint64_t bytes_written));
+  MOCK_METHOD(void, onSpliceComplete, ());
+  MOCK_METHOD(void, onSpliceError, (int error));
+};
+
+class SpliceForwarderTest : public SpliceTestBase {
+protected:
+  SpliceForwarderTest() {
+    setUpConnection(downstream_connection_, downstream_socket_, downstream_io_handle_,
+                    DownstreamFd);
+    setUpConnection(upstream_connection_, upstream_socket_, upstream_io_handle_, UpstreamFd);
+  }
+
+  void setUpConnection(NiceMock<Network::MockConnection>& connection,
+                       Network::ConnectionSocketPtr& socket, Network::MockIoHandle& io_handle,
+                       os_fd_t fd) {
+    auto mock_socket = std::make_unique<NiceMock<Network::MockConnectionSocket>>();
+    ON_CALL(*mock_socket, ioHandle()).WillByDefault(ReturnRef(io_handle));
+    socket = std::move(mock_socket);
+    ON_CALL(io_handle, fdDoNotUse()).WillByDefault(Return(fd));
+    ON_CALL(connection, getSocket()).WillByDefault(ReturnRef(socket));
+  }
+
+  void createForwarder() {
+    EXPECT_CALL(linux_os_sys_calls_, pipe2(_, O_NONBLOCK | O_CLOEXEC))
+        .WillOnce(Invoke(createPipe(DownstreamPipeRead, DownstreamPipeWrite)))
+        .WillOnce(Invoke(createPipe(UpstreamPipeRead, UpstreamPipeWrite)));
+    expectPipe(DownstreamPipeRead, DownstreamPipeWrite);
+    expectPipe(UpstreamPipeRead, UpstreamPipeWrite);
+
+    downstream_event_ = new NiceMock<Event::MockFileEvent>();
+    upstream_event_ = new NiceMock<Event::MockFileEvent>();
+    const uint32_t events = Event::FileReadyType::Read | Event::FileReadyType::Write;
+    EXPECT_CALL(dispatcher_,
+                createFileEvent_(DownstreamFd, _, Event::PlatformDefaultTriggerType, events))
+        .WillOnce(DoAll(SaveArg<1>(&downstream_cb_), Return(downstream_event_)));
+    EXPECT_CALL(dispatcher_,
+                createFileEvent_(UpstreamFd, _, Event::PlatformDefaultTriggerType, events))
+        .WillOnce(DoAll(SaveArg<1>(&upstream_cb_), Return(upstream_event_)));
+
+    forwarder_ = SpliceForwarder::create(dispatcher_, downstream_connection_, upstream_connection_,
+                                         callbacks_);
+    ASSERT_NE(nullptr, forwarder_);
+  }
+
+  NiceMock<Event::MockDispatcher> dispatcher_;
+  NiceMock<Network::MockConnection> downstream_connection_;
+  NiceMock<Network::MockConnection> upstream_connection_;
+  NiceMock<Network::MockIoHandle> downstream_io_handle_;
+  NiceMock<Network::MockIoHandle> upstream_io_handle_;
+  Network::ConnectionSocketPtr downstream_socket_;
+  Network::ConnectionSocketPtr upstream_socket_;
+  testing::StrictMock<MockSpliceForwarderCallbacks> callbacks_;
+  NiceMock<Event::MockFileEvent>* downstream_event_{};
+  NiceMock<Event::MockFileEvent>* upstream_event_{};
+  Event::FileReadyCb downstream_cb_;
+  Event::FileReadyCb upstream_cb_;
+  SpliceForwarderPtr forwarder_;
+};
+
+TEST_F(SpliceForwarderTest, CreateFailsWithoutPipes) {
+  EXPECT_CALL(linux_os_sys_calls_, pipe2(_, _))
+      .WillOnce(Invoke(createPipe(DownstreamPipeRead, DownstreamPipeWrite)))
+      .WillOnce(Return(Api::SysCallIntResult{-1, EMFILE}));
+  expectPipe(DownstreamPipeRead, DownstreamPipeWrite);
+  EXPECT_CALL(dispatcher_, createFileEvent_(_, _, _, _)).Times(0);
+
+  EXPECT_EQ(nullptr, SpliceForwarder::create(dispatcher_, downstream_connection_,
+                                             upstream_connection_, callbacks_));
+}
+
+TEST_F(SpliceForwarderTest, StartDefersFirstTransfer) {
+  createForwarder();
+  EXPECT_CALL(linux_os_sys_calls_, splice(_, _, _, _)).Times(0);
+  EXPECT_CALL(*downstream_event_, activate(Event::FileReadyType::Read));
+  forwarder_->start();
+}
+
+TEST_F(SpliceForwarderTest, ForwardsBothDirections) {
+  createForwarder();
+  EXPECT_CALL(linux_os_sys_calls_, splice(DownstreamFd, DownstreamPipeWrite, _, _))
+      .WillOnce(Return(Api::SysCallSizeResult{100, 0}))
+      .WillOnce(Return(wouldBlock()));
+  EXPECT_CALL(linux_os_sys_calls_, splice(DownstreamPipeRead, UpstreamFd, 100, _))
+      .WillOnce(Return(Api::SysCallSizeResult{100, 0}));
+  EXPECT_CALL(linux_os_sys_calls_, splice(UpstreamFd, UpstreamPipeWrite, _, _))
+      .WillOnce(Return(Api::SysCallSizeResult{50, 0}))
+      .WillOnce(Return(wouldBlock()));
+  EXPECT_CALL(linux_os_sys_calls_, splice(UpstreamPipeRead, DownstreamFd, 50, _))
+      .WillOnce(Return(Api::SysCallSizeResult{50, 0}));
+  EXPECT_CALL(callbacks_, onSpliceDownstreamData(100, 100));
+  EXPECT_CALL(callbacks_, onSpliceUpstreamData(50, 50));
+
+  EXPECT_TRUE(downstream_cb_(Event::FileReadyType::Read).ok());
+}
+
+TEST_F(SpliceForwarderTest, WouldBlockReportsNothing) {
+  createForwarder();
+  // The default splice() action reports EAGAIN in both directions.
+  EXPECT_TRUE(upstream_cb_(Event::FileReadyType::Write).ok());
+}
+
+TEST_F(SpliceForwarderTest, HalfCloseThenComplete) {
+  createForwarder();
+  EXPECT_CALL(linux_os_sys_calls_, splice(DownstreamFd, DownstreamPipeWrite, _, _))
+      .WillOnce(Return(Api::SysCallSizeResult{0, 0}));
+  EXPECT_CALL(os_sys_calls_, shutdown(UpstreamFd, ENVOY_SHUT_WR));
+  EXPECT_TRUE(downstream_cb_(Event::FileReadyType::Read).ok());
+
+  // The finished direction is not read again.
+  EXPECT_CALL(linux_os_sys_calls_, splice(UpstreamFd, UpstreamPipeWrite, _, _))
+      .WillOnce(Return(Api::SysCallSizeResult{0, 0}));
+  EXPECT_CALL(os_sys_calls_, shutdown(DownstreamFd, ENVOY_SHUT_WR));
+  EXPECT_CALL(callbacks_, onSpliceComplete());
+  EXPECT_TRUE(upstream_cb_(Event::FileReadyType::Read).ok());
+}
+
+TEST_F(SpliceForwarderTest, EndOfStreamWaitsForBufferedBytes) {
+  createForwarder();
+  EXPECT_CALL(linux_os_sys_calls_, splice(DownstreamFd, DownstreamPipeWrite, _, _))
+      .WillOnce(Return(Api::SysCallSizeResult{10, 0}))
+      .WillOnce(Return(Api::SysCallSizeResult{0, 0}));
+  EXPECT_CALL(linux_os_sys_calls_, splice(DownstreamPipeRead, UpstreamFd, 10, _))
+      .WillOnce(Return(wouldBlock()))
+      .WillOnce(Return(wouldBlock()))
+      .WillOnce(Return(Api::SysCallSizeResult{10, 0}));
+  EXPECT_CALL(callbacks_, onSpliceDownstreamData(10, 0));
+  EXPECT_CALL(os_sys_calls_, shutdown(_, _)).Times(0);
+  EXPECT_TRUE(downstream_cb_(Event::FileReadyType::Read).ok());
+
+  // The half close is only propagated once the pipe has been drained.
+  EXPECT_CALL(callbacks_, onSpliceDownstreamData(0, 10));
+  EXPECT_CALL(os_sys_calls_, shutdown(UpstreamFd, ENVOY_SHUT_WR));
+  EXPECT_TRUE(upstream_cb_(Event::FileReadyType::Write).ok());
+}
+
+TEST_F(SpliceForwarderTest, ReadErrorStopsForwarding) {
+  createForwarder();
+  EXPECT_CALL(linux_os_sys_calls_, splice(DownstreamFd, DownstreamPipeWrite, _, _))
+      .WillOnce(Return(Api::SysCallSizeResult{-1, ECONNRESET}));
+  EXPECT_CALL(linux_os_sys_calls_, splice(UpstreamFd, _, _, _)).Times(0);
+  EXPECT_CALL(callbacks_, onSpliceError(ECONNRESET));
+  EXPECT_TRUE(downstream_cb_(Event::FileReadyType::Read).ok());
+}
+
+TEST_F(SpliceForwarderTest, WriteErrorReportsReadBytes) {
+  createForwarder();
+  EXPECT_CALL(linux_os_sys_calls_, splice(DownstreamFd, DownstreamPipeWrite, _, _))
+      .WillOnce(Return(Api::SysCallSizeResult{100, 0}));
+  EXPECT_CALL(linux_os_sys_calls_, splice(DownstreamPipeRead, UpstreamFd, 100, _))
+      .WillOnce(Return(Api::SysCallSizeResult{-1, EPIPE}));
+  EXPECT_CALL(callbacks_, onSpliceDownstreamData(100, 0));
+  EXPECT_CALL(callbacks_, onSpliceError(EPIPE));
+  EXPECT_TRUE(downstream_cb_(Event::FileReadyType::Read).ok());
+}
+
+TEST_F(SpliceForwarderTest, ReactivatesAfterTransferLimit) {
+  createForwarder();
+  EXPECT_CALL(linux_os_sys_calls_, splice(DownstreamFd, DownstreamPipeWrite, _, _))
+      .WillRepeatedly(Invoke(spliceAll));
+  EXPECT_CALL(linux_os_sys_calls_, splice(DownstreamPipeRead, UpstreamFd, _, _))
+      .WillRepeatedly(Invoke(spliceAll));
+  EXPECT_CALL(callbacks_, onSpliceDownstreamData(SpliceForwarder::MaxBytesPerEvent,
+                                                 SpliceForwarder::MaxBytesPerEvent));
+  // Edge triggered events do not fire again for data which is already readable.
+  EXPECT_CALL(*downstream_event_, activate(Event::FileReadyType::Read));
+  EXPECT_TRUE(downstream_cb_(Event::FileReadyType::Read).ok());
+}
+#endif
+
+} // namespace
+} // namespace TcpProxy
+} // namespace Envoy
@@ -30,7 +30,9 @@
 
 #include "test/common/tcp_proxy/tcp_proxy_test_base.h"
 #include "test/common/upstream/utility.h"
+#include "test/mocks/api/mocks.h"
 #include "test/mocks/buffer/mocks.h"
+#include "test/mocks/network/io_handle.h"
 #include "test/mocks/network/mocks.h"
 #include "test/mocks/runtime/mocks.h"
 #include "test/mocks/server/factory_context.h"
@@ -42,6 +44,7 @@
 #include "test/mocks/upstream/host.h"
 #include "test/mocks/upstream/od_cds_api_handle.h"
 #include "test/test_common/test_runtime.h"
+#include "test/test_common/threadsafe_singleton_injector.h"
 #include "test/test_common/utility.h"
 
 #include "gmock/gmock.h"
@@ -2698,6 +2701,130 @@ TEST_P(TcpProxyTest, LargeBufferScenario) {
 
 INSTANTIATE_TEST_SUITE_P(WithOrWithoutUpstream, TcpProxyTest, ::testing::Bool());
 
+class TcpProxyKernelSpliceTest : public TcpProxyTest {
+public:
+  envoy::extensions::filters::network::tcp_proxy::v3::TcpProxy spliceConfig() {
+    auto config = defaultConfig();
+    config.set_kernel_splice(true);
+    return config;
+  }
+
+  void setUpSocket(NiceMock<Network::MockConnection>& connection,
+                   Network::ConnectionSocketPtr& socket, Network::MockIoHandle& io_handle,
+                   os_fd_t fd) {
+    auto mock_socket = std::make_unique<NiceMock<Network::MockConnectionSocket>>();
+    ON_CALL(*mock_socket, ioHandle()).WillByDefault(ReturnRef(io_handle));
+    socket = std::move(mock_socket);
+    ON_CALL(io_handle, fdDoNotUse()).WillByDefault(Return(fd));
+    ON_CALL(connection, getSocket()).WillByDefault(ReturnRef(socket));
+    ON_CALL(connection, canBypassBuffers()).WillByDefault(Return(true));
+  }
+
+#if defined(__linux__)
+  // Connects the upstream and expects the filter to hand both connections to the splice forwarder.
+  void connectAndSplice() {
+    setup(1, spliceConfig());
+    setUpSocket(filter_callbacks_.connection_, downstream_socket_, downstream_io_handle_, 20);
+    setUpSocket(*upstream_connections_.at(0), upstream_socket_, upstream_io_handle_, 30);
+
+    int next_fd = 40;
+    EXPECT_CALL(linux_os_sys_calls_, pipe2(_, _))
+        .Times(2)
+        .WillRepeatedly(Invoke([&next_fd](os_fd_t* fds, int) -> Api::SysCallIntResult {
+          fds[0] = next_fd++;
+          fds[1] = next_fd++;
+          return {0, 0};
+        }));
+    auto* downstream_event = new NiceMock<Event::MockFileEvent>();
+    auto* upstream_event = new NiceMock<Event::MockFileEvent>();
+    EXPECT_CALL(filter_callbacks_.connection_.dispatcher_, createFileEvent_(20, _, _, _))
+        .WillOnce(Return(downstream_event));
+    EXPECT_CALL(filter_callbacks_.connection_.dispatcher_, createFileEvent_(30, _, _, _))
+        .WillOnce(Return(upstream_event));
+    // The first transfer runs from the event loop rather than from the connected callback.
+    EXPECT_CALL(*downstream_event, activate(Event::FileReadyType::Read));
+    EXPECT_CALL(*upstream_connections_.at(0), readDisable(true));
+
+    // The downstream connection is not read enabled again, its socket belongs to the splice path.
+    raiseEventUpstreamConnected(0, /*expect_read_enable=*/false);
+    EXPECT_EQ(1U, config_->stats().kernel_splice_total_.value());
+  }
+
+  void expectForwarderDeleted() {
+    EXPECT_CALL(filter_callbacks_.connection_.dispatcher_, deferredDelete_(_))
+        .Times(testing::AnyNumber());
+    EXPECT_CALL(filter_callbacks_.connection_.dispatcher_,
+                deferredDelete_(testing::WhenDynamicCastTo<SpliceForwarder*>(testing::NotNull())));
+  }
+
+  NiceMock<Api::MockOsSysCalls> os_sys_calls_;
+  TestThreadsafeSingletonInjector<Api::OsSysCallsImpl> os_calls_{&os_sys_calls_};
+  NiceMock<Api::MockLinuxOsSysCalls> linux_os_sys_calls_;
+  TestThreadsafeSingletonInjector<Api::LinuxOsSysCallsImpl> linux_os_calls_{&linux_os_sys_calls_};
+#endif
+
+  NiceMock<Network::MockIoHandle> downstream_io_handle_;
+  NiceMock<Network::MockIoHandle> upstream_io_handle_;
+  Network::ConnectionSocketPtr downstream_socket_;
+  Network::ConnectionSocketPtr upstream_socket_;
+};
+
+// Without a connection which can bypass its buffers (e.g. another network filter is installed on
+// it) the proxy keeps forwarding through the buffered path.
+TEST_P(TcpProxyKernelSpliceTest, FallsBackToBufferedPath) {
+  setup(1, spliceConfig());
+  EXPECT_CALL(filter_callbacks_.connection_, canBypassBuffers()).WillRepeatedly(Return(false));
+  EXPECT_CALL(filter_callbacks_.connection_.dispatcher_, createFileEvent_(_, _, _, _)).Times(0);
+  EXPECT_CALL(*upstream_connections_.at(0), readDisable(true)).Times(0);
+  raiseEventUpstreamConnected(0);
+  EXPECT_EQ(0U, config_->stats().kernel_splice_total_.value());
+
+  Buffer::OwnedImpl buffer("hello");
+  EXPECT_CALL(*upstream_connections_.at(0), write(BufferEqual(&buffer), false));
+  filter_->onData(buffer, false);
+}
+
+// A buffered upstream connection also keeps the proxy on the buffered path.
+TEST_P(TcpProxyKernelSpliceTest, FallsBackWhenUpstreamCannotBypassBuffers) {
+  setup(1, spliceConfig());
+  ON_CALL(filter_callbacks_.connection_, canBypassBuffers()).WillByDefault(Return(true));
+  ON_CALL(*upstream_connections_.at(0), canBypassBuffers()).WillByDefault(Return(false));
+  EXPECT_CALL(filter_callbacks_.connection_.dispatcher_, createFileEvent_(_, _, _, _)).Times(0);
+  raiseEventUpstreamConnected(0);
+  EXPECT_EQ(0U, config_->stats().kernel_splice_total_.value());
+}
+
+#if defined(__linux__)
+TEST_P(TcpProxyKernelSpliceTest, FallsBackWithoutPipes) {
+  setup(1, spliceConfig());
+  setUpSocket(filter_callbacks_.connection_, downstream_socket_, downstream_io_handle_, 20);
+  setUpSocket(*upstream_connections_.at(0), upstream_socket_, upstream_io_handle_, 30);
+  EXPECT_CALL(linux_os_sys_calls_, pipe2(_, _))
+      .WillRepeatedly(Return(Api::SysCallIntResult{-1, EMFILE}));
+  EXPECT_CALL(*upstream_connections_.at(0), readDisable(true)).Times(0);
+  raiseEventUpstreamConnected(0);
+  EXPECT_EQ(0U, config_->stats().kernel_splice_total_.value());
+}
+
+TEST_P(TcpProxyKernelSpliceTest, StartSplice) { connectAndSplice(); }
+
+TEST_P(TcpProxyKernelSpliceTest, SpliceCompleteClosesDownstream) {
+  connectAndSplice();
+  expectForwarderDeleted();
+  EXPECT_CALL(filter_callbacks_.connection_, close(Network::ConnectionCloseType::NoFlush));
+  filter_->onSpliceComplete();
+}
+
+TEST_P(TcpProxyKernelSpliceTest, SpliceErrorClosesDownstream) {
+  connectAndSplice();
+  expectForwarderDeleted();
+  EXPECT_CALL(filter_callbacks_.connection_, close(Network::ConnectionCloseType::NoFlush));
+  filter_->onSpliceError(ECONNRESET);
+}
+#endif
+
+INSTANTIATE_TEST_SUITE_P(WithOrWithoutUpstream, TcpProxyKernelSpliceTest, ::testing::Bool());
+
 TEST(PerConnectionCluster, ObjectFactory) {
   const std::string name = "envoy.tcp_proxy.cluster";
   auto* factory =
@@ -5,6 +5,7 @@
 
 #include "source/common/api/os_sys_calls_impl.h"
 #include "source/common/common/hash.h"
+#include "source/common/common/safe_memcpy.h"
 #include "source/common/network/socket_impl.h"
 #include "source/common/network/socket_option_impl.h"
 #include "source/common/router/string_accessor_impl.h"
@@ -742,6 +743,204 @@ matcher:
   EXPECT_EQ(output_.front(), "fake_cluster 0 10 1 0 2");
 }
 
+// Datagrams written upstream during one event loop iteration are sent with one sendmmsg() call,
+// coalesced with UDP GSO.
+TEST_F(UdpProxyFilterTest, BatchedUpstreamWrites) {
+  setup(readConfig(R"EOF(
+stat_prefix: foo
+matcher:
+  on_no_match:
+    action:
+      name: route
+      typed_config:
+        '@type': type.googleapis.com/envoy.extensions.filters.udp.udp_proxy.v3.Route
+        cluster: fake_cluster
+batch_upstream_writes: true
+  )EOF"));
+
+  expectSessionCreate(upstream_address_);
+  auto* flush_callback =
+      new NiceMock<Event::MockSchedulableCallback>(&callbacks_.udp_listener_.dispatcher_);
+  EXPECT_CALL(*test_sessions_[0].idle_timer_, enableTimer(_, nullptr)).Times(3);
+  EXPECT_CALL(*test_sessions_[0].socket_->io_handle_, connect(_))
+      .WillOnce(Return(Api::SysCallIntResult{0, 0}));
+  EXPECT_CALL(*flush_callback, scheduleCallbackCurrentIteration());
+  recvDataFromDownstream("10.0.0.1:1000", "10.0.0.2:80", "hello");
+  recvDataFromDownstream("10.0.0.1:1000", "10.0.0.2:80", "world");
+  recvDataFromDownstream("10.0.0.1:1000", "10.0.0.2:80", "bye");
+  EXPECT_EQ(0, TestUtility::findCounter(factory_context_.server_factory_context_.cluster_manager_
+                                            .thread_local_cluster_.cluster_.info_->stats_store_,
+                                        "udp.sess_tx_datagrams")
+                   ->value());
+
+  ON_CALL(*test_sessions_[0].socket_->io_handle_, wasConnected()).WillByDefault(Return(true));
+  EXPECT_CALL(*test_sessions_[0].socket_->io_handle_, supportsMmsg()).WillOnce(Return(true));
+  EXPECT_CALL(*test_sessions_[0].socket_->io_handle_, fdDoNotUse()).WillOnce(Return(42));
+  EXPECT_CALL(os_sys_calls_, supportsUdpGso()).WillOnce(Return(true));
+  EXPECT_CALL(os_sys_calls_, sendmmsg(42, _, 1, 0))
+      .WillOnce(Invoke([](os_fd_t, struct mmsghdr* messages, unsigned int,
+                          int) -> Api::SysCallIntResult {
+        const msghdr& message = messages[0].msg_hdr;
+        EXPECT_EQ(3, message.msg_iovlen);
+        EXPECT_EQ("bye", absl::string_view(static_cast<const char*>(message.msg_iov[2].iov_base),
+                                           message.msg_iov[2].iov_len));
+        const cmsghdr* cmsg = CMSG_FIRSTHDR(&message);
+        EXPECT_EQ(UDP_SEGMENT, cmsg->cmsg_type);
+        uint16_t gso_size;
+        safeMemcpyUnsafeSrc(&gso_size, CMSG_DATA(cmsg));
+        EXPECT_EQ(5, gso_size);
+        return {1, 0};
+      }));
+  flush_callback->invokeCallback();
+
+  EXPECT_EQ(3, TestUtility::findCounter(factory_context_.server_factory_context_.cluster_manager_
+                                            .thread_local_cluster_.cluster_.info_->stats_store_,
+                                        "udp.sess_tx_datagrams")
+                   ->value());
+  EXPECT_EQ(13, factory_context_.server_factory_context_.cluster_manager_.thread_local_cluster_
+                    .cluster_.info_->traffic_stats_->upstream_cx_tx_bytes_total_.value());
+}
+
+// Datagrams which were not sent when sendmmsg() fails are counted as errors.
+TEST_F(UdpProxyFilterTest, BatchedUpstreamWritesError) {
+  setup(readConfig(R"EOF(
+stat_prefix: foo
+matcher:
+  on_no_match:
+    action:
+      name: route
+      typed_config:
+        '@type': type.googleapis.com/envoy.extensions.filters.udp.udp_proxy.v3.Route
+        cluster: fake_cluster
+batch_upstream_writes: true
+  )EOF"));
+
+  expectSessionCreate(upstream_address_);
+  auto* flush_callback =
+      new NiceMock<Event::MockSchedulableCallback>(&callbacks_.udp_listener_.dispatcher_);
+  EXPECT_CALL(*test_sessions_[0].idle_timer_, enableTimer(_, nullptr)).Times(3);
+  EXPECT_CALL(*test_sessions_[0].socket_->io_handle_, connect(_))
+      .WillOnce(Return(Api::SysCallIntResult{0, 0}));
+  recvDataFromDownstream("10.0.0.1:1000", "10.0.0.2:80", "hello");
+  recvDataFromDownstream("10.0.0.1:1000", "10.0.0.2:80", "world");
+  recvDataFromDownstream("10.0.0.1:1000", "10.0.0.2:80", "bye");
+
+  ON_CALL(*test_sessions_[0].socket_->io_handle_, wasConnected()).WillByDefault(Return(true));
+  EXPECT_CALL(*test_sessions_[0].socket_->io_handle_, supportsMmsg()).WillOnce(Return(true));
+  EXPECT_CALL(*test_sessions_[0].socket_->io_handle_, fdDoNotUse())
+      .Times(2)
+      .WillRepeatedly(Return(42));
+  EXPECT_CALL(os_sys_calls_, supportsUdpGso()).WillOnce(Return(false));
+  EXPECT_CALL(os_sys_calls_, sendmmsg(42, _, 3, 0)).WillOnce(Return(Api::SysCallIntResult{1, 0}));
+  EXPECT_CALL(os_sys_calls_, sendmmsg(42, _, 2, 0))
+      .WillOnce(Return(Api::SysCallIntResult{-1, SOCKET_ERROR_AGAIN}));
+  flush_callback->invokeCallback();
+
+  EXPECT_EQ(1, TestUtility::findCounter(factory_context_.server_factory_context_.cluster_manager_
+                                            .thread_local_cluster_.cluster_.info_->stats_store_,
+                                        "udp.sess_tx_datagrams")
+                   ->value());
+  EXPECT_EQ(2, TestUtility::findCounter(factory_context_.server_factory_context_.cluster_manager_
+                                            .thread_local_cluster_.cluster_.info_->stats_store_,
+                                        "udp.sess_tx_errors")
+                   ->value());
+  EXPECT_EQ(5, factory_context_.server_factory_context_.cluster_manager_.thread_local_cluster_
+                   .cluster_.info_->traffic_stats_->upstream_cx_tx_bytes_total_.value());
+}
+
+// If the kernel rejects a UDP GSO message, with EINVAL when the segment size exceeds the path MTU
+// or EIO when the device cannot checksum it, the datagrams are sent one by one instead.
+TEST_F(UdpProxyFilterTest, BatchedUpstreamWritesGsoFallback) {
+  setup(readConfig(R"EOF(
+stat_prefix: foo
+matcher:
+  on_no_match:
+    action:
+      name: route
+      typed_config:
+        '@type': type.googleapis.com/envoy.extensions.filters.udp.udp_proxy.v3.Route
+        cluster: fake_cluster
+batch_upstream_writes: true
+  )EOF"));
+
+  expectSessionCreate(upstream_address_);
+  auto* flush_callback =
+      new NiceMock<Event::MockSchedulableCallback>(&callbacks_.udp_listener_.dispatcher_);
+  EXPECT_CALL(*test_sessions_[0].idle_timer_, enableTimer(_, nullptr)).Times(6);
+  EXPECT_CALL(*test_sessions_[0].socket_->io_handle_, connect(_))
+      .WillOnce(Return(Api::SysCallIntResult{0, 0}));
+  ON_CALL(*test_sessions_[0].socket_->io_handle_, wasConnected()).WillByDefault(Return(true));
+  ON_CALL(*test_sessions_[0].socket_->io_handle_, supportsMmsg()).WillByDefault(Return(true));
+  ON_CALL(*test_sessions_[0].socket_->io_handle_, fdDoNotUse()).WillByDefault(Return(42));
+
+  for (const int error : {SOCKET_ERROR_INVAL, EIO}) {
+    recvDataFromDownstream("10.0.0.1:1000", "10.0.0.2:80", "hello");
+    recvDataFromDownstream("10.0.0.1:1000", "10.0.0.2:80", "world");
+    recvDataFromDownstream("10.0.0.1:1000", "10.0.0.2:80", "bye");
+
+    InSequence s;
+    EXPECT_CALL(os_sys_calls_, supportsUdpGso()).WillOnce(Return(true));
+    EXPECT_CALL(os_sys_calls_, sendmmsg(42, _, 1, 0))
+        .WillOnce(Return(Api::SysCallIntResult{-1, error}));
+    EXPECT_CALL(os_sys_calls_, sendmmsg(42, _, 3, 0))
+        .WillOnce(Invoke([](os_fd_t, struct mmsghdr* messages, unsigned int,
+                            int) -> Api::SysCallIntResult {
+          for (unsigned int i = 0; i < 3; ++i) {
+            EXPECT_EQ(1, messages[i].msg_hdr.msg_iovlen);
+            EXPECT_EQ(nullptr, messages[i].msg_hdr.msg_control);
+          }
+          return {3, 0};
+        }));
+    flush_callback->invokeCallback();
+  }
+
+  EXPECT_EQ(6, TestUtility::findCounter(factory_context_.server_factory_context_.cluster_manager_
+                                            .thread_local_cluster_.cluster_.info_->stats_store_,
+                                        "udp.sess_tx_datagrams")
+                   ->value());
+  EXPECT_EQ(0, TestUtility::findCounter(factory_context_.server_factory_context_.cluster_manager_
+                                            .thread_local_cluster_.cluster_.info_->stats_store_,
+                                        "udp.sess_tx_errors")
+                   ->value());
+}
+
+// Datagrams still queued when the session is removed are sent rather than dropped.
+TEST_F(UdpProxyFilterTest, BatchedUpstreamWritesFlushedOnSessionComplete) {
+  setup(readConfig(R"EOF(
+stat_prefix: foo
+matcher:
+  on_no_match:
+    action:
+      name: route
+      typed_config:
+        '@type': type.googleapis.com/envoy.extensions.filters.udp.udp_proxy.v3.Route
+        cluster: fake_cluster
+batch_upstream_writes: true
+  )EOF"));
+
+  expectSessionCreate(upstream_address_);
+  new NiceMock<Event::MockSchedulableCallback>(&callbacks_.udp_listener_.dispatcher_);
+  EXPECT_CALL(*test_sessions_[0].idle_timer_, enableTimer(_, nullptr)).Times(2);
+  EXPECT_CALL(*test_sessions_[0].socket_->io_handle_, connect(_))
+      .WillOnce(Return(Api::SysCallIntResult{0, 0}));
+  recvDataFromDownstream("10.0.0.1:1000", "10.0.0.2:80", "hello");
+  recvDataFromDownstream("10.0.0.1:1000", "10.0.0.2:80", "world");
+
+  ON_CALL(*test_sessions_[0].socket_->io_handle_, wasConnected()).WillByDefault(Return(true));
+  EXPECT_CALL(*test_sessions_[0].socket_->io_handle_, supportsMmsg()).WillOnce(Return(true));
+  EXPECT_CALL(*test_sessions_[0].socket_->io_handle_, fdDoNotUse()).WillOnce(Return(42));
+  EXPECT_CALL(os_sys_calls_, supportsUdpGso()).WillOnce(Return(false));
+  EXPECT_CALL(os_sys_calls_, sendmmsg(42, _, 2, 0)).WillOnce(Return(Api::SysCallIntResult{2, 0}));
+  filter_.reset();
+
+  EXPECT_EQ(2, TestUtility::findCounter(factory_context_.server_factory_context_.cluster_manager_
+                                            .thread_local_cluster_.cluster_.info_->stats_store_,
+                                        "udp.sess_tx_datagrams")
+                   ->value());
+  EXPECT_EQ(10, factory_context_.server_factory_context_.cluster_manager_.thread_local_cluster_
+                    .cluster_.info_->traffic_stats_->upstream_cx_tx_bytes_total_.value());
+}
+
 // Verify upstream connect error handling.
 TEST_F(UdpProxyFilterTest, ConnectErrorHandling) {
   InSequence s;
@@ -2,6 +2,7 @@
 
 #include "envoy/config/cluster/v3/cluster.pb.h"
 
+#include "source/common/memory/huge_page_allocator.h"
 #include "source/extensions/load_balancing_policies/maglev/maglev_lb.h"
 
 #include "test/common/upstream/utility.h"
@@ -67,6 +68,27 @@ TEST(MaglevTableLogMaglevTableTest, MaglevTableLogMaglevTableTest) {
   }
 }
 
+#if defined(__linux__)
+// The table of the default size is large enough to be backed by a huge page region.
+TEST(MaglevTableHugePageTest, DefaultTableSizeUsesHugePageRegion) {
+  Stats::IsolatedStoreImpl stats_store;
+  MaglevLoadBalancerStats stats = MaglevLoadBalancer::generateStats(*stats_store.rootScope());
+  auto host = std::make_shared<NiceMock<MockHost>>();
+  const std::string hostname = "host1";
+  ON_CALL(*host, hostname()).WillByDefault(testing::ReturnRef(hostname));
+  NormalizedHostWeightVector normalized_host_weights = {{host, 1}};
+
+  Memory::HugePageRegions::setEnabled(true);
+  {
+    OriginalMaglevTable table(normalized_host_weights, 1, MaglevTable::DefaultTableSize, true,
+                              stats);
+    EXPECT_EQ(Memory::HugePageRegions::HugePageSize, Memory::HugePageRegions::mappedBytes());
+  }
+  EXPECT_EQ(0, Memory::HugePageRegions::mappedBytes());
+  Memory::HugePageRegions::setEnabled(false);
+}
+#endif
+
 // Note: ThreadAwareLoadBalancer base is heavily tested by RingHashLoadBalancerTest. Only basic
 //       functionality is covered here.
 class MaglevLoadBalancerTest : public Event::TestUsingSimulatedTime, public testing::Test {
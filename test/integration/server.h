@@ -322,10 +322,20 @@ public:
     Thread::LockGuard lock(lock_);
     store_.forEachSinkedHistogram(f_size, f_stat);
   }
+  void trackChanges() override {
+    Thread::LockGuard lock(lock_);
+    store_.trackChanges();
+  }
+  void forEachChangedSinkedStat(StatFn<Counter> f_counter, StatFn<Gauge> f_gauge,
+                                StatFn<TextReadout> f_text_readout) override {
+    Thread::LockGuard lock(lock_);
+    store_.forEachChangedSinkedStat(f_counter, f_gauge, f_text_readout);
+  }
   void setSinkPredicates(std::unique_ptr<SinkPredicates>&& sink_predicates) override {
     UNREFERENCED_PARAMETER(sink_predicates);
   }
   OptRef<SinkPredicates> sinkPredicates() override { return OptRef<SinkPredicates>{}; }
+  void setCounterShards(uint32_t num_shards) override { UNREFERENCED_PARAMETER(num_shards); }
   void deliverHistogramToSinks(const Histogram& histogram, uint64_t value) override {
     Thread::LockGuard lock(lock_);
     store_.deliverHistogramToSinks(histogram, value);
@@ -31,6 +31,10 @@ public:
     impl_.initializeStats(scope, prefix);
   }
 
+  void enableBusyPoll(const BusyPollConfig& config, Stats::Scope& scope) override {
+    impl_.enableBusyPoll(config, scope);
+  }
+
   void clearDeferredDeleteList() override { impl_.clearDeferredDeleteList(); }
 
   Network::ServerConnectionPtr
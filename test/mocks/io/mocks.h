@@ -16,9 +16,16 @@ public:
   MOCK_METHOD(IoUringResult, prepareAccept,
               (os_fd_t fd, struct sockaddr* remote_addr, socklen_t* remote_addr_len,
                Request* user_data));
+  MOCK_METHOD(IoUringResult, prepareAcceptMultishot, (os_fd_t fd, Request* user_data));
   MOCK_METHOD(IoUringResult, prepareConnect,
               (os_fd_t fd, const Network::Address::InstanceConstSharedPtr& address,
                Request* user_data));
+  MOCK_METHOD(IoUringResult, registerBufferRing, (uint16_t group_id, uint32_t num_buffers));
+  MOCK_METHOD(void, unregisterBufferRing, (uint16_t group_id));
+  MOCK_METHOD(void, provideBuffer,
+              (uint16_t group_id, uint16_t buffer_id, uint8_t* buf, uint32_t len));
+  MOCK_METHOD(IoUringResult, prepareRecvMultishot,
+              (os_fd_t fd, uint16_t group_id, Request* user_data));
   MOCK_METHOD(IoUringResult, prepareReadv,
               (os_fd_t fd, const struct iovec* iovecs, unsigned nr_vecs, off_t offset,
                Request* user_data));
@@ -42,6 +49,7 @@ public:
   MOCK_METHOD(void, disableRead, ());
   MOCK_METHOD(void, enableCloseEvent, (bool enable));
   MOCK_METHOD(void, connect, (const Network::Address::InstanceConstSharedPtr& address));
+  MOCK_METHOD(os_fd_t, takeAcceptedSocket, ());
   MOCK_METHOD(void, write, (Buffer::Instance & data));
   MOCK_METHOD(uint64_t, write, (const Buffer::RawSlice* slices, uint64_t num_slice));
   MOCK_METHOD(void, onAccept, (Request * req, int32_t result, bool injected));
@@ -68,7 +76,10 @@ public:
                bool enable_close_event));
   MOCK_METHOD(IoUringSocket&, addClientSocket,
               (os_fd_t fd, Event::FileReadyCb cb, bool enable_close_event));
+  MOCK_METHOD(IoUringSocket&, addAcceptSocket,
+              (os_fd_t fd, Event::FileReadyCb cb, bool enable_close_event));
   MOCK_METHOD(Event::Dispatcher&, dispatcher, ());
+  MOCK_METHOD(Request*, submitAcceptRequest, (IoUringSocket & socket, bool multishot));
   MOCK_METHOD(Request*, submitConnectRequest,
               (IoUringSocket & socket, const Network::Address::InstanceConstSharedPtr& address));
   MOCK_METHOD(Request*, submitReadRequest, (IoUringSocket & socket));
@@ -85,6 +96,7 @@ public:
   MOCK_METHOD(OptRef<IoUringWorker>, getIoUringWorker, ());
   MOCK_METHOD(void, onWorkerThreadInitialized, ());
   MOCK_METHOD(bool, currentThreadRegistered, ());
+  MOCK_METHOD(bool, acceptEnabled, (), (const));
 };
 
 } // namespace Io
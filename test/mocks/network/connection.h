@@ -98,6 +98,7 @@ public:
   MOCK_METHOD(void, configureInitialCongestionWindow,                                              \
               (uint64_t bandwidth_bits_per_sec, std::chrono::microseconds rtt), ());               \
   MOCK_METHOD(absl::optional<uint64_t>, congestionWindowInBytes, (), (const));                     \
+  MOCK_METHOD(bool, canBypassBuffers, (), (const));                                                \
   MOCK_METHOD(void, dumpState, (std::ostream&, int), (const));                                     \
   MOCK_METHOD(bool, setSocketOption, (Network::SocketOptionName, absl::Span<uint8_t>), ());        \
   MOCK_METHOD(OptRef<const StreamInfo::StreamInfo>, trackedStream, (), (const));
@@ -734,7 +734,7 @@ public:
   MOCK_METHOD(void, registerHandler, (BalancedConnectionHandler & handler));
   MOCK_METHOD(void, unregisterHandler, (BalancedConnectionHandler & handler));
   MOCK_METHOD(BalancedConnectionHandler&, pickTargetHandler,
-              (BalancedConnectionHandler & current_handler));
+              (BalancedConnectionHandler & current_handler, ConnectionSocket& socket));
 };
 
 class MockListenerFilterMatcher : public ListenerFilterMatcher {
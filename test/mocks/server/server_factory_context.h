@@ -52,6 +52,7 @@ public:
   MOCK_METHOD(const Stats::SinkPredicates*, sinkPredicates, (), (const));
   MOCK_METHOD(bool, enableDeferredCreationStats, (), (const));
   MOCK_METHOD(uint32_t, evictOnFlush, (), (const));
+  MOCK_METHOD(uint32_t, fullFlushOnFlush, (), (const));
 };
 
 class MockServerFactoryContext : public virtual ServerFactoryContext {
@@ -39,6 +39,7 @@ public:
               (Network::ListenerConfig & listener, std::function<void()> completion));
   MOCK_METHOD(void, start, (OptRef<GuardDog> guard_dog, const std::function<void()>& cb));
   MOCK_METHOD(void, initializeStats, (Stats::Scope & scope));
+  MOCK_METHOD(void, enableBusyPoll, (const Event::BusyPollConfig& config, Stats::Scope& scope));
   MOCK_METHOD(void, stop, ());
   MOCK_METHOD(void, stopListener,
               (Network::ListenerConfig & listener,
@@ -700,7 +700,7 @@ TEST_F(ActiveTcpListenerTest, RedirectedRebalancer) {
   bool redirected = false;
 
   // 1. Listener1 re-balance. Set the balance target to the the active listener itself.
-  EXPECT_CALL(balancer1, pickTargetHandler(_))
+  EXPECT_CALL(balancer1, pickTargetHandler(_, _))
       .WillOnce(testing::DoAll(
           testing::WithArg<0>(Invoke([](auto& target) { target.incNumConnections(); })),
           ReturnRef(*active_listener1)));
@@ -731,7 +731,7 @@ TEST_F(ActiveTcpListenerTest, RedirectedRebalancer) {
       .WillOnce(Return(Network::BalancedConnectionHandlerOptRef(*active_listener2)));
 
   // 3. Listener2 re-balance. Set the balance target to the the active listener itself.
-  EXPECT_CALL(balancer2, pickTargetHandler(_))
+  EXPECT_CALL(balancer2, pickTargetHandler(_, _))
       .WillOnce(testing::DoAll(
           testing::WithArg<0>(Invoke([](auto& target) { target.incNumConnections(); })),
           ReturnRef(*active_listener2)));
@@ -809,7 +809,7 @@ TEST_F(ActiveTcpListenerTest, SkipRedirection) {
   Network::MockConnectionSocket* accepted_socket = new NiceMock<Network::MockConnectionSocket>();
 
   // 1. Listener1 re-balance. Set the balance target to the the active listener itself.
-  EXPECT_CALL(balancer1, pickTargetHandler(_))
+  EXPECT_CALL(balancer1, pickTargetHandler(_, _))
       .WillOnce(testing::DoAll(
           testing::WithArg<0>(Invoke([](auto& target) { target.incNumConnections(); })),
           ReturnRef(*active_listener1)));
@@ -899,7 +899,7 @@ TEST_F(ActiveTcpListenerTest, Rebalance) {
   Network::MockConnectionSocket* accepted_socket = new NiceMock<Network::MockConnectionSocket>();
 
   // active_listener1 re-balance. Set the balance target to the the active_listener2.
-  EXPECT_CALL(balancer1, pickTargetHandler(_))
+  EXPECT_CALL(balancer1, pickTargetHandler(_, _))
       .WillOnce(testing::DoAll(testing::WithArg<0>(Invoke([&active_listener2](auto&) {
                                  active_listener2->incNumConnections();
                                })),
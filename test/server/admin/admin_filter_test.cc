@@ -1,6 +1,8 @@
 #include "source/server/admin/admin.h"
 #include "source/server/admin/admin_filter.h"
 
+#include "test/mocks/buffer/mocks.h"
+#include "test/mocks/event/mocks.h"
 #include "test/mocks/server/instance.h"
 #include "test/test_common/environment.h"
 
@@ -9,7 +11,9 @@
 
 using testing::ByMove;
 using testing::InSequence;
+using testing::Invoke;
 using testing::NiceMock;
+using testing::Ref;
 using testing::Return;
 
 namespace Envoy {
@@ -73,5 +77,78 @@ TEST_P(AdminFilterTest, Trailers) {
   EXPECT_EQ(Http::FilterTrailersStatus::StopIteration, filter_.decodeTrailers(request_trailers));
 }
 
+// Produces a fixed number of single-line chunks.
+class ChunkedRequest : public Admin::Request {
+public:
+  explicit ChunkedRequest(uint32_t num_chunks) : num_chunks_(num_chunks) {}
+
+  Http::Code start(Http::ResponseHeaderMap&) override { return Http::Code::OK; }
+  bool nextChunk(Buffer::Instance& response) override {
+    response.add("chunk\n");
+    return --num_chunks_ > 0;
+  }
+
+private:
+  uint32_t num_chunks_;
+};
+
+class AdminFilterStreamingTest : public testing::Test {
+public:
+  AdminFilterStreamingTest() : filter_(admin_), request_headers_{{":path", "/"}} {
+    EXPECT_CALL(admin_, makeRequest(_))
+        .WillOnce(Return(ByMove(std::make_unique<ChunkedRequest>(3))));
+    filter_.setDecoderFilterCallbacks(callbacks_);
+  }
+
+  NiceMock<MockAdmin> admin_;
+  AdminFilter filter_;
+  NiceMock<Http::MockStreamDecoderFilterCallbacks> callbacks_;
+  Http::TestRequestHeaderMapImpl request_headers_;
+};
+
+// Each chunk after the first is sent from its own dispatcher iteration.
+TEST_F(AdminFilterStreamingTest, YieldsBetweenChunks) {
+  auto* next_chunk_cb = new NiceMock<Event::MockSchedulableCallback>(&callbacks_.dispatcher_);
+  EXPECT_CALL(callbacks_, addDownstreamWatermarkCallbacks(Ref(filter_)));
+  EXPECT_CALL(callbacks_, encodeHeaders_(_, false));
+  EXPECT_CALL(callbacks_, encodeData(BufferStringEqual("chunk\n"), false));
+  filter_.decodeHeaders(request_headers_, true);
+  EXPECT_TRUE(next_chunk_cb->enabled());
+
+  EXPECT_CALL(callbacks_, encodeData(BufferStringEqual("chunk\n"), false));
+  next_chunk_cb->invokeCallback();
+  EXPECT_TRUE(next_chunk_cb->enabled());
+
+  EXPECT_CALL(callbacks_, removeDownstreamWatermarkCallbacks(Ref(filter_)));
+  EXPECT_CALL(callbacks_, encodeData(BufferStringEqual("chunk\n"), true));
+  next_chunk_cb->invokeCallback();
+  EXPECT_FALSE(next_chunk_cb->enabled());
+  filter_.onDestroy();
+}
+
+// No further chunks are produced while the downstream is above its high watermark.
+TEST_F(AdminFilterStreamingTest, PausesAboveHighWatermark) {
+  auto* next_chunk_cb = new NiceMock<Event::MockSchedulableCallback>(&callbacks_.dispatcher_);
+  EXPECT_CALL(callbacks_, encodeData(_, false)).WillOnce(Invoke([this](Buffer::Instance&, bool) {
+    filter_.onAboveWriteBufferHighWatermark();
+  }));
+  filter_.decodeHeaders(request_headers_, true);
+  EXPECT_FALSE(next_chunk_cb->enabled());
+
+  filter_.onBelowWriteBufferLowWatermark();
+  EXPECT_TRUE(next_chunk_cb->enabled());
+}
+
+// Destroying the stream mid-response cancels the pending chunk.
+TEST_F(AdminFilterStreamingTest, DestroyedMidResponse) {
+  auto* next_chunk_cb = new NiceMock<Event::MockSchedulableCallback>(&callbacks_.dispatcher_);
+  filter_.decodeHeaders(request_headers_, true);
+  EXPECT_TRUE(next_chunk_cb->enabled());
+
+  EXPECT_CALL(callbacks_, removeDownstreamWatermarkCallbacks(Ref(filter_)));
+  filter_.onDestroy();
+  EXPECT_FALSE(next_chunk_cb->enabled());
+}
+
 } // namespace Server
 } // namespace Envoy
@@ -1443,6 +1443,183 @@ TEST_F(PrometheusStatsFormatterTest, ProtobufOutputWithClusterEndpoints) {
   }
 }
 
+// Renders each family into its own chunk when the chunk size is tiny, and produces the same
+// output as the buffered API.
+TEST_F(PrometheusStatsFormatterTest, ChunkedRequest) {
+  Stats::CustomStatNamespacesImpl custom_namespaces;
+  addCounter("cluster.test_1.upstream_cx_total", {{makeStat("a.tag-name"), makeStat("a")}});
+  addCounter("cluster.test_1.upstream_cx_total", {{makeStat("a.tag-name"), makeStat("b")}});
+  addCounter("cluster.test_2.upstream_cx_total", {});
+  addGauge("cluster.test_3.upstream_cx_active", {});
+  addTextReadout("control_plane.identifier", "CP-1", {});
+  addClusterEndpoints("cluster1", 1, {{"a.tag-name", "a.tag-value"}});
+
+  StatsParams params;
+  params.prometheus_text_readouts_ = true;
+  Buffer::OwnedImpl expected;
+  const uint64_t size =
+      PrometheusStatsFormatter::statsAsPrometheusText(counters_, gauges_, histograms_,
+                                                      textReadouts_, endpoints_helper_->cm_,
+                                                      expected, params, custom_namespaces);
+  EXPECT_EQ(9UL, size);
+
+  // Each type is visited only once rendering reaches it, once to find its families and once for
+  // the page holding them.
+  std::vector<std::string> visited;
+  PrometheusStatsFormatter::MetricSources sources;
+  sources.counters_ = [&](const Stats::StatFn<Stats::Counter>& fn) {
+    visited.push_back("counters");
+    for (const Stats::CounterSharedPtr& counter : counters_) {
+      fn(*counter);
+    }
+  };
+  sources.gauges_ = [&](const Stats::StatFn<Stats::Gauge>& fn) {
+    visited.push_back("gauges");
+    for (const Stats::GaugeSharedPtr& gauge : gauges_) {
+      fn(*gauge);
+    }
+  };
+  sources.text_readouts_ = [&](const Stats::StatFn<Stats::TextReadout>& fn) {
+    visited.push_back("text_readouts");
+    for (const Stats::TextReadoutSharedPtr& text_readout : textReadouts_) {
+      fn(*text_readout);
+    }
+  };
+  sources.histograms_ = [&](const Stats::StatFn<Stats::ParentHistogram>& fn) {
+    visited.push_back("histograms");
+    for (const Stats::ParentHistogramSharedPtr& histogram : histograms_) {
+      fn(*histogram);
+    }
+  };
+  Admin::RequestPtr request = PrometheusStatsFormatter::makeRequest(
+      std::move(sources), endpoints_helper_->cm_, Http::TestRequestHeaderMapImpl{}, params,
+      custom_namespaces, 1);
+  Http::TestResponseHeaderMapImpl response_headers;
+  EXPECT_EQ(Http::Code::OK, request->start(response_headers));
+  EXPECT_TRUE(visited.empty());
+
+  std::vector<std::string> chunks;
+  bool more = true;
+  while (more) {
+    Buffer::OwnedImpl chunk;
+    more = request->nextChunk(chunk);
+    chunks.push_back(chunk.toString());
+    if (chunks.size() == 1) {
+      EXPECT_EQ(std::vector<std::string>{"counters"}, visited);
+    }
+  }
+  EXPECT_EQ((std::vector<std::string>{"counters", "gauges", "text_readouts", "histograms"}),
+            visited);
+
+  // The counters, gauge and text readout families each get their own chunk, followed by a
+  // final chunk with the per-endpoint metrics.
+  ASSERT_EQ(5, chunks.size());
+  EXPECT_EQ(R"EOF(# TYPE envoy_cluster_test_1_upstream_cx_total counter
+envoy_cluster_test_1_upstream_cx_total{a_tag_name="a"} 0
+envoy_cluster_test_1_upstream_cx_total{a_tag_name="b"} 0
+)EOF",
+            chunks[0]);
+  EXPECT_EQ(R"EOF(# TYPE envoy_cluster_test_2_upstream_cx_total counter
+envoy_cluster_test_2_upstream_cx_total{} 0
+)EOF",
+            chunks[1]);
+  EXPECT_EQ(expected.toString(), absl::StrJoin(chunks, ""));
+}
+
+TEST_F(PrometheusStatsFormatterTest, ChunkedRequestProtobuf) {
+  Stats::CustomStatNamespacesImpl custom_namespaces;
+  addCounter("test.counter1", {});
+  addCounter("test.counter2", {});
+  addGauge("test.gauge", {});
+
+  PrometheusStatsFormatter::MetricSources sources;
+  sources.counters_ = [this](const Stats::StatFn<Stats::Counter>& fn) {
+    for (const Stats::CounterSharedPtr& counter : counters_) {
+      fn(*counter);
+    }
+  };
+  sources.gauges_ = [this](const Stats::StatFn<Stats::Gauge>& fn) {
+    for (const Stats::GaugeSharedPtr& gauge : gauges_) {
+      fn(*gauge);
+    }
+  };
+  Admin::RequestPtr request = PrometheusStatsFormatter::makeRequest(
+      std::move(sources), endpoints_helper_->cm_,
+      Http::TestRequestHeaderMapImpl{{"accept", "application/vnd.google.protobuf"}},
+      StatsParams(), custom_namespaces, 1);
+  Http::TestResponseHeaderMapImpl response_headers;
+  EXPECT_EQ(Http::Code::OK, request->start(response_headers));
+  EXPECT_EQ("application/vnd.google.protobuf; proto=io.prometheus.client.MetricFamily; "
+            "encoding=delimited",
+            response_headers.getContentTypeValue());
+
+  Buffer::OwnedImpl response;
+  uint32_t num_chunks = 0;
+  while (request->nextChunk(response)) {
+    ++num_chunks;
+  }
+  EXPECT_EQ(3, num_chunks);
+  auto families = parsePrometheusProtobuf(response.toString());
+  ASSERT_EQ(3, families.size());
+  EXPECT_EQ("envoy_test_counter1", families[0].name());
+  EXPECT_EQ("envoy_test_counter2", families[1].name());
+  EXPECT_EQ("envoy_test_gauge", families[2].name());
+}
+
+// Walks the store once per stat type and scrape, however many chunks the families are rendered
+// in, and releases each family once it has been rendered.
+TEST_F(PrometheusStatsFormatterTest, ChunkedRequestVisitsSourceOnce) {
+  Stats::CustomStatNamespacesImpl custom_namespaces;
+  addCounter("cluster.upstream_cx_total", {{makeStat("cluster"), makeStat("a")}});
+  addCounter("cluster.upstream_cx_total", {{makeStat("cluster"), makeStat("b")}});
+  addCounter("cluster.upstream_cx_total", {{makeStat("cluster"), makeStat("c")}});
+  addCounter("test.counter1", {});
+  addCounter("test.counter2", {});
+  addCounter("test.counter3", {});
+
+  Buffer::OwnedImpl expected;
+  PrometheusStatsFormatter::statsAsPrometheusText(counters_, gauges_, histograms_, textReadouts_,
+                                                  endpoints_helper_->cm_, expected, StatsParams(),
+                                                  custom_namespaces);
+
+  uint32_t num_visits = 0;
+  PrometheusStatsFormatter::MetricSources sources;
+  sources.counters_ = [&](const Stats::StatFn<Stats::Counter>& fn) {
+    ++num_visits;
+    for (const Stats::CounterSharedPtr& counter : counters_) {
+      fn(*counter);
+    }
+  };
+  Admin::RequestPtr request = PrometheusStatsFormatter::makeRequest(
+      std::move(sources), endpoints_helper_->cm_, Http::TestRequestHeaderMapImpl{}, StatsParams(),
+      custom_namespaces, 1);
+  Http::TestResponseHeaderMapImpl response_headers;
+  EXPECT_EQ(Http::Code::OK, request->start(response_headers));
+  EXPECT_EQ(0, num_visits);
+
+  // The first chunk holds the cluster family, which is released once rendered, while the test
+  // counters are still referenced until their own chunks.
+  const uint64_t cluster_use_count = counters_.front()->use_count();
+  const uint64_t counter3_use_count = counters_.back()->use_count();
+  Buffer::OwnedImpl response;
+  EXPECT_TRUE(request->nextChunk(response));
+  EXPECT_EQ(1, num_visits);
+  EXPECT_EQ(R"EOF(# TYPE envoy_cluster_upstream_cx_total counter
+envoy_cluster_upstream_cx_total{cluster="a"} 0
+envoy_cluster_upstream_cx_total{cluster="b"} 0
+envoy_cluster_upstream_cx_total{cluster="c"} 0
+)EOF",
+            response.toString());
+  EXPECT_EQ(cluster_use_count, counters_.front()->use_count());
+  EXPECT_EQ(counter3_use_count + 1, counters_.back()->use_count());
+
+  while (request->nextChunk(response)) {
+  }
+  EXPECT_EQ(1, num_visits);
+  EXPECT_EQ(counter3_use_count, counters_.back()->use_count());
+  EXPECT_EQ(expected.toString(), response.toString());
+}
+
 // Test that protobuf is chosen when it is the first accept value.
 TEST_F(PrometheusStatsFormatterTest, ContentNegotiationProtobufAcceptHeader) {
   Stats::CustomStatNamespacesImpl custom_namespaces;
@@ -5,6 +5,7 @@
 #include "source/common/http/header_map_impl.h"
 #include "source/common/stats/custom_stat_namespaces_impl.h"
 #include "source/common/stats/thread_local_store.h"
+#include "source/server/admin/prometheus_stats.h"
 #include "source/server/admin/stats_handler.h"
 
 #include "test/benchmark/main.h"
@@ -111,17 +112,7 @@ public:
     // Benchmark will be 10k clusters each with 100 counters, with 100+
     // character names. The first counter in each scope will be given a value so
     // it will be included in 'usedonly'.
-    const std::string prefix(100, 'a');
-    for (uint32_t s = 0; s < NumClusters; ++s) {
-      Stats::ScopeSharedPtr scope = store_->createScope(absl::StrCat("scope_", s));
-      scopes_.emplace_back(scope);
-      for (uint32_t c = 0; c < 100; ++c) {
-        Stats::Counter& counter = scope->counterFromString(absl::StrCat(prefix, "_", c));
-        if (c == 0) {
-          counter.inc();
-        }
-      }
-    }
+    addScopes(NumClusters);
 
     for (uint32_t s = 0; s < 100; ++s) {
       Stats::Histogram& h =
@@ -160,6 +151,32 @@ public:
     store_->mergeHistograms([]() {});
   }
 
+  void addScopes(uint32_t num_scopes) {
+    const std::string prefix(100, 'a');
+    for (uint32_t s = scopes_.size(); s < num_scopes; ++s) {
+      Stats::ScopeSharedPtr scope = store_->createScope(absl::StrCat("scope_", s));
+      scopes_.emplace_back(scope);
+      for (uint32_t c = 0; c < 100; ++c) {
+        Stats::Counter& counter = scope->counterFromString(absl::StrCat(prefix, "_", c));
+        if (c == 0) {
+          counter.inc();
+        }
+      }
+    }
+  }
+
+  /**
+   * Grows the store to the given number of scopes of 100 counters each. This
+   * is slow and changes the results of the other benchmarks, so it should only
+   * be used by benchmarks registered last.
+   */
+  void setNumScopes(uint32_t num_scopes) {
+    if (num_scopes > scopes_.size()) {
+      ENVOY_LOG_MISC(error, "Growing store to {} scopes; slow to construct...", num_scopes);
+      runOnMainBlocking([this, num_scopes]() { addScopes(num_scopes); });
+    }
+  }
+
   void initClusterInfo() {
     ENVOY_LOG_MISC(error, "Initializing cluster info; slow to construct and destruct...");
     endpoint_stats_initialized_ = true;
@@ -197,18 +214,20 @@ public:
     Buffer::OwnedImpl data;
     auto request_headers = Http::RequestHeaderMapImpl::create();
     auto response_headers = Http::ResponseHeaderMapImpl::create();
+    Admin::RequestPtr request;
     if (params.format_ == StatsFormat::Prometheus) {
-      StatsHandler::prometheusRender(*store_, custom_namespaces_, cm_, params, *request_headers,
-                                     *response_headers, data);
-      return data.length();
+      request = StatsHandler::makePrometheusRequest(*store_, custom_namespaces_, cm_, params,
+                                                    *request_headers);
+    } else {
+      request = StatsHandler::makeRequest(*store_, params, cm_);
     }
-    Admin::RequestPtr request = StatsHandler::makeRequest(*store_, params, cm_);
     request->start(*response_headers);
     uint64_t count = 0;
     bool more = true;
     do {
       more = request->nextChunk(data);
       count += data.length();
+      max_chunk_size_ = std::max<uint64_t>(max_chunk_size_, data.length());
       data.drain(data.length());
     } while (more);
     return count;
@@ -218,6 +237,7 @@ public:
   Envoy::Stats::CustomStatNamespacesImpl custom_namespaces_;
   FastMockClusterManager cm_;
   bool endpoint_stats_initialized_{false};
+  uint64_t max_chunk_size_{0};
 };
 
 } // namespace Server
@@ -504,3 +524,29 @@ static void BM_NativeHistogramsPrometheusProtobuf(benchmark::State& state) {
   state.SetLabel(label);
 }
 BENCHMARK(BM_NativeHistogramsPrometheusProtobuf)->Unit(benchmark::kMillisecond);
+
+// Streams a store of 5M counters as prometheus, checking that the response is
+// produced in bounded chunks rather than buffered in full. This grows the
+// shared store, so it must remain the last benchmark in this file.
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_LargeStoreCountersPrometheus(benchmark::State& state) {
+  Envoy::Server::StatsHandlerTest& test_context = testContext(false);
+  test_context.setNumScopes(Envoy::benchmark::skipExpensiveBenchmarks() ? 10000 : 50000);
+  Envoy::Server::StatsParams params;
+  Envoy::Buffer::OwnedImpl response;
+  params.parse("?format=prometheus&type=Counters", response);
+
+  uint64_t count;
+  test_context.max_chunk_size_ = 0;
+  for (auto _ : state) { // NOLINT
+    count = test_context.handlerStats(params);
+  }
+  RELEASE_ASSERT(test_context.max_chunk_size_ <
+                     2 * Envoy::Server::PrometheusStatsFormatter::DefaultChunkSize,
+                 "prometheus chunk exceeded its bound");
+
+  auto label = absl::StrCat("output per iteration: ", count,
+                            ", max chunk: ", test_context.max_chunk_size_);
+  state.SetLabel(label);
+}
+BENCHMARK(BM_LargeStoreCountersPrometheus)->Unit(benchmark::kMillisecond);
@@ -95,6 +95,7 @@ TEST_F(ConfigurationImplTest, DefaultStatsFlushInterval) {
   EXPECT_EQ(std::chrono::milliseconds(5000), config.statsConfig().flushInterval());
   EXPECT_FALSE(config.statsConfig().flushOnAdmin());
   EXPECT_EQ(0, config.statsConfig().evictOnFlush());
+  EXPECT_EQ(0, config.statsConfig().fullFlushOnFlush());
 }
 
 TEST_F(ConfigurationImplTest, CustomStatsFlushInterval) {
@@ -253,6 +254,34 @@ TEST_F(ConfigurationImplTest, EvictionNotMultiple) {
               testing::HasSubstr("must be a multiple"));
 }
 
+TEST_F(ConfigurationImplTest, FullFlushInterval) {
+  std::string json = R"EOF(
+  {
+    "stats_flush_interval": "0.500s",
+    "stats_full_flush_interval": "5s"
+  }
+  )EOF";
+
+  auto bootstrap = Upstream::parseBootstrapFromV3Json(json);
+  MainImpl config;
+  EXPECT_TRUE(config.initialize(bootstrap, server_, cluster_manager_factory_).ok());
+  EXPECT_EQ(10, config.statsConfig().fullFlushOnFlush());
+}
+
+TEST_F(ConfigurationImplTest, FullFlushIntervalNotMultiple) {
+  std::string json = R"EOF(
+  {
+    "stats_flush_interval": "0.500s",
+    "stats_full_flush_interval": "0.750s"
+  }
+  )EOF";
+
+  auto bootstrap = Upstream::parseBootstrapFromV3Json(json);
+  MainImpl config;
+  EXPECT_THAT(config.initialize(bootstrap, server_, cluster_manager_factory_).message(),
+              testing::HasSubstr("must be a multiple"));
+}
+
 TEST_F(ConfigurationImplTest, SetUpstreamClusterPerConnectionBufferLimit) {
   const std::string json = R"EOF(
   {
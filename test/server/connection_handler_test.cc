@@ -783,7 +783,7 @@ TEST_F(ConnectionHandlerTest, RebalanceWithMultiAddressListener) {
 
   // Send connection to the first listener, expect mock_connection_balancer1 will be called.
   // then mock_connection_balancer1 will balance the connection to the same listener.
-  EXPECT_CALL(*mock_connection_balancer1, pickTargetHandler(_))
+  EXPECT_CALL(*mock_connection_balancer1, pickTargetHandler(_, _))
       .WillOnce(ReturnRef(*current_handler1));
   EXPECT_CALL(*access_log_, log(_, _));
   EXPECT_CALL(manager_, findFilterChain(_, _)).WillOnce(Return(nullptr));
@@ -793,7 +793,7 @@ TEST_F(ConnectionHandlerTest, RebalanceWithMultiAddressListener) {
 
   // Send connection to the second listener, expect mock_connection_balancer2 will be called.
   // then mock_connection_balancer2 will balance the connection to the same listener.
-  EXPECT_CALL(*mock_connection_balancer2, pickTargetHandler(_))
+  EXPECT_CALL(*mock_connection_balancer2, pickTargetHandler(_, _))
       .WillOnce(ReturnRef(*current_handler2));
   EXPECT_CALL(*access_log_, log(_, _));
   EXPECT_CALL(manager_, findFilterChain(_, _)).WillOnce(Return(nullptr));
@@ -2327,7 +2327,7 @@ TEST_F(ConnectionHandlerTest, TcpListenerInplaceUpdate) {
   Network::MockConnectionSocket* connection = new NiceMock<Network::MockConnectionSocket>();
   current_handler->incNumConnections();
 
-  EXPECT_CALL(*mock_connection_balancer, pickTargetHandler(_))
+  EXPECT_CALL(*mock_connection_balancer, pickTargetHandler(_, _))
       .WillOnce(ReturnRef(*current_handler));
   EXPECT_CALL(manager_, findFilterChain(_, _)).Times(0);
   EXPECT_CALL(*overridden_filter_chain_manager, findFilterChain(_, _)).WillOnce(Return(nullptr));
@@ -1,5 +1,7 @@
+#include <algorithm>
 #include <cstdint>
 #include <memory>
+#include <vector>
 
 #include "envoy/stats/sink.h"
 #include "envoy/stats/stats.h"
@@ -54,14 +56,17 @@ public:
     // Create counters
     for (uint64_t idx = 0; idx < num_stats; ++idx) {
       auto stat_name = pool_.add(absl::StrCat("counter.", idx));
-      stats_store_.rootScope()->counterFromStatName(stat_name).inc();
+      Stats::Counter& counter = stats_store_.rootScope()->counterFromStatName(stat_name);
+      counter.inc();
+      counters_.push_back(&counter);
     }
     // Create gauges
     for (uint64_t idx = 0; idx < num_stats; ++idx) {
       auto stat_name = pool_.add(absl::StrCat("gauge.", idx));
-      stats_store_.rootScope()
-          ->gaugeFromStatName(stat_name, Stats::Gauge::ImportMode::NeverImport)
-          .set(idx);
+      Stats::Gauge& gauge = stats_store_.rootScope()->gaugeFromStatName(
+          stat_name, Stats::Gauge::ImportMode::NeverImport);
+      gauge.set(idx);
+      gauges_.push_back(&gauge);
     }
 
     // Create text readouts
@@ -87,6 +92,27 @@ public:
     }
   }
 
+  // Flushes incrementally after changing 1% of the counters and gauges before each flush.
+  void testIncremental(::benchmark::State& state) {
+    std::list<Stats::SinkPtr> sinks;
+    sinks.emplace_back(new testing::NiceMock<Stats::MockSink>());
+    Server::InstanceUtil::flushMetricsToSinks(sinks, stats_store_, cm_, time_system_,
+                                              Server::StatsFlushMode::FullWithChangeTracking);
+    size_t next = 0;
+    for (auto _ : state) {
+      UNREFERENCED_PARAMETER(_);
+      state.PauseTiming();
+      for (size_t i = 0; i < std::max<size_t>(counters_.size() / 100, 1); ++i) {
+        next = (next + 1) % counters_.size();
+        counters_[next]->inc();
+        gauges_[next]->inc();
+      }
+      state.ResumeTiming();
+      Server::InstanceUtil::flushMetricsToSinks(sinks, stats_store_, cm_, time_system_,
+                                                Server::StatsFlushMode::Incremental);
+    }
+  }
+
 private:
   Stats::SymbolTableImpl symbol_table_;
   Stats::StatNamePool pool_;
@@ -94,6 +120,8 @@ private:
   Stats::ThreadLocalStoreImpl stats_store_;
   Event::SimulatedTimeSystem time_system_;
   FastMockClusterManager cm_;
+  std::vector<Stats::Counter*> counters_;
+  std::vector<Stats::Gauge*> gauges_;
 };
 
 static void bmFlushToSinks(::benchmark::State& state) {
@@ -118,10 +146,25 @@ static void bmFlushToSinksWithPredicatesSet(::benchmark::State& state) {
   speed_test.test(state);
 }
 
+static void bmFlushToSinksIncremental(::benchmark::State& state) {
+  // Skip expensive benchmarks for unit tests.
+  if (benchmark::skipExpensiveBenchmarks() && state.range(0) > 100) {
+    state.SkipWithError("Skipping expensive benchmark");
+    return;
+  }
+
+  StatsSinkFlushSpeedTest speed_test(state.range(0));
+  speed_test.testIncremental(state);
+}
+
 BENCHMARK(bmFlushToSinks)->Unit(::benchmark::kMillisecond)->RangeMultiplier(10)->Range(10, 1000000);
 BENCHMARK(bmFlushToSinksWithPredicatesSet)
     ->Unit(::benchmark::kMillisecond)
     ->RangeMultiplier(10)
     ->Range(10, 1000000);
+BENCHMARK(bmFlushToSinksIncremental)
+    ->Unit(::benchmark::kMillisecond)
+    ->RangeMultiplier(10)
+    ->Range(10, 1000000);
 
 } // namespace Envoy
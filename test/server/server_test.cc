@@ -10,6 +10,7 @@
 
 #include "source/common/common/assert.h"
 #include "source/common/common/notification.h"
+#include "source/common/event/timer_wheel.h"
 #include "source/common/network/address_impl.h"
 #include "source/common/network/listen_socket_impl.h"
 #include "source/common/network/socket_option_impl.h"
@@ -163,6 +164,42 @@ TEST(ServerInstanceUtil, flushImportModeUninitializedGauges) {
   InstanceUtil::flushMetricsToSinks(sinks, store, cm, time_system);
 }
 
+TEST(ServerInstanceUtil, flushIncremental) {
+  InSequence s;
+
+  NiceMock<Upstream::MockClusterManager> cm;
+  Stats::TestUtil::TestStore store;
+  Event::SimulatedTimeSystem time_system;
+  Stats::Counter& c1 = store.counter("hello");
+  Stats::Counter& c2 = store.counter("idle");
+  c1.inc();
+  c2.inc();
+  store.gauge("world", Stats::Gauge::ImportMode::Accumulate).set(5);
+
+  std::list<Stats::SinkPtr> sinks;
+  Stats::MockSink* sink = new StrictMock<Stats::MockSink>();
+  sinks.emplace_back(sink);
+  EXPECT_CALL(*sink, flush(_)).WillOnce(Invoke([](Stats::MetricSnapshot& snapshot) {
+    EXPECT_EQ(snapshot.counters().size(), 2);
+    EXPECT_EQ(snapshot.gauges().size(), 1);
+  }));
+  InstanceUtil::flushMetricsToSinks(sinks, store, cm, time_system,
+                                    StatsFlushMode::FullWithChangeTracking);
+
+  // The isolated store does not track changes, so all stats are visited, but only the counter
+  // which was incremented is flushed.
+  c1.inc();
+  EXPECT_CALL(*sink, flush(_)).WillOnce(Invoke([](Stats::MetricSnapshot& snapshot) {
+    ASSERT_EQ(snapshot.counters().size(), 1);
+    EXPECT_EQ(snapshot.counters()[0].counter_.get().name(), "hello");
+    EXPECT_EQ(snapshot.counters()[0].delta_, 1);
+    EXPECT_EQ(snapshot.gauges().size(), 1);
+  }));
+  InstanceUtil::flushMetricsToSinks(sinks, store, cm, time_system, StatsFlushMode::Incremental);
+  EXPECT_EQ(0, c1.latch());
+  EXPECT_EQ(0, c2.latch());
+}
+
 TEST(ServerInstanceUtil, RaiseFileLimits) {
   Api::MockOsSysCalls os_sys_calls_;
   TestThreadsafeSingletonInjector<Api::OsSysCallsImpl> os_calls{&os_sys_calls_};
@@ -772,6 +809,45 @@ TEST_P(ServerInstanceImplWorkersTest, DrainCloseAfterWorkersStarted) {
   drain_thread->join();
 }
 
+// The workers' dispatchers use the timer wheel when it is enabled in the bootstrap, although they
+// are created before runtime is loaded.
+TEST_P(ServerInstanceImplTest, WorkerDispatchersUseTimerWheel) {
+  absl::Notification checked;
+  Thread::MutexBasicLockable mutex;
+  uint32_t num_threads = 0;
+  uint32_t num_wheel_timers = 0;
+
+  auto server_thread = Thread::threadFactoryForTest().createThread([&] {
+    auto hooks = CustomListenerHooks([&]() {
+      server_->threadLocal().runOnAllThreads(
+          [&]() {
+            Event::TimerPtr timer = server_->threadLocal().dispatcher().createTimer([]() {});
+            Thread::LockGuard lock(mutex);
+            ++num_threads;
+            if (dynamic_cast<Event::WheelTimerImpl*>(timer.get()) != nullptr) {
+              ++num_wheel_timers;
+            }
+          },
+          [&]() { checked.Notify(); });
+    });
+    initialize("test/server/test_data/server/timer_wheel_bootstrap.yaml", false, hooks);
+    server_->run();
+    server_ = nullptr;
+    thread_local_ = nullptr;
+  });
+
+  checked.WaitForNotification();
+  {
+    Thread::LockGuard lock(mutex);
+    // The main thread's dispatcher was created first and keeps using libevent's heap.
+    EXPECT_EQ(1 + options_.concurrency(), num_threads);
+    EXPECT_EQ(options_.concurrency(), num_wheel_timers);
+  }
+  server_->dispatcher().post([&] { server_->shutdown(); });
+  server_thread->join();
+  Event::TimerWheelScheduler::configure(false);
+}
+
 // A test target which never signals that it is ready.
 class NeverReadyTarget : public Init::TargetImpl {
 public:
@@ -4,12 +4,14 @@
 #include "source/common/event/dispatcher_impl.h"
 #include "source/server/worker_impl.h"
 
+#include "test/mocks/api/mocks.h"
 #include "test/mocks/network/mocks.h"
 #include "test/mocks/runtime/mocks.h"
 #include "test/mocks/server/guard_dog.h"
 #include "test/mocks/server/instance.h"
 #include "test/mocks/server/overload_manager.h"
 #include "test/mocks/thread_local/mocks.h"
+#include "test/test_common/threadsafe_singleton_injector.h"
 #include "test/test_common/utility.h"
 
 #include "absl/synchronization/notification.h"
@@ -35,7 +37,7 @@ public:
         no_exit_timer_(dispatcher_->createTimer([]() -> void {})),
         stat_names_(api_->rootScope().symbolTable()),
         worker_(tls_, hooks_, std::move(dispatcher_), Network::ConnectionHandlerPtr{handler_},
-                overload_manager_, *api_, stat_names_) {
+                overload_manager_, *api_, stat_names_, 0, false) {
     // In the real worker the watchdog has timers that prevent exit. Here we need to prevent event
     // loop exit since we use mock timers.
     no_exit_timer_->enableTimer(std::chrono::hours(1));
@@ -159,6 +161,42 @@ TEST_F(WorkerImplTest, WorkerInvokesProvidedCallback) {
   worker_.stop();
 }
 
+#if defined(__linux__)
+// A pinned worker runs on the CPU of its index among the CPUs the process may run on.
+TEST_F(WorkerImplTest, PinThread) {
+  Api::MockLinuxOsSysCalls linux_os_sys_calls;
+  TestThreadsafeSingletonInjector<Api::LinuxOsSysCallsImpl> linux_os_calls(&linux_os_sys_calls);
+  EXPECT_CALL(linux_os_sys_calls, sched_getaffinity(0, sizeof(cpu_set_t), _))
+      .WillOnce(Invoke([](pid_t, size_t, cpu_set_t* mask) -> Api::SysCallIntResult {
+        CPU_ZERO(mask);
+        CPU_SET(2, mask);
+        CPU_SET(5, mask);
+        CPU_SET(7, mask);
+        return {0, 0};
+      }));
+  EXPECT_CALL(linux_os_sys_calls, sched_setaffinity(0, sizeof(cpu_set_t), _))
+      .WillOnce(Invoke([](pid_t, size_t, const cpu_set_t* mask) -> Api::SysCallIntResult {
+        EXPECT_EQ(1, CPU_COUNT(mask));
+        EXPECT_TRUE(CPU_ISSET(5, mask));
+        return {0, 0};
+      }));
+
+  Event::DispatcherPtr dispatcher = api_->allocateDispatcher("pinned_worker_test");
+  Event::TimerPtr no_exit_timer = dispatcher->createTimer([]() -> void {});
+  no_exit_timer->enableTimer(std::chrono::hours(1));
+  WorkerImpl worker(tls_, hooks_, std::move(dispatcher),
+                    std::make_unique<NiceMock<Network::MockConnectionHandler>>(),
+                    overload_manager_, *api_, stat_names_, 1, true);
+
+  // The callback runs on the worker thread after it has been pinned.
+  absl::Notification callback_ran;
+  worker.start(guard_dog_, [&callback_ran]() { callback_ran.Notify(); });
+  callback_ran.WaitForNotification();
+  worker.stop();
+  no_exit_timer.reset();
+}
+#endif
+
 } // namespace
 } // namespace Server
 } // namespace Envoy